@@ -19,6 +19,7 @@
 */
 
 #include <ql/discretizedasset.hpp>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -50,5 +51,63 @@ namespace QuantLib {
         underlying_->postAdjustValues();
     }
 
-}
+    DiscretizedPortfolio::DiscretizedPortfolio(
+              const std::vector<boost::shared_ptr<DiscretizedAsset> >& assets)
+    : assets_(assets) {
+        QL_REQUIRE(!assets_.empty(), "no assets given");
+        for (Size i=0; i<assets_.size(); i++)
+            QL_REQUIRE(assets_[i], "null asset given");
+    }
+
+    std::vector<Time> DiscretizedPortfolio::mandatoryTimes() const {
+        std::vector<Time> times;
+        for (Size i=0; i<assets_.size(); i++) {
+            std::vector<Time> t = assets_[i]->mandatoryTimes();
+            times.insert(times.end(), t.begin(), t.end());
+        }
+        std::sort(times.begin(), times.end());
+        times.erase(std::unique(times.begin(), times.end()), times.end());
+        return times;
+    }
 
+    const boost::shared_ptr<Lattice>& DiscretizedPortfolio::method() const {
+        const boost::shared_ptr<Lattice>& method = assets_[0]->method();
+        QL_REQUIRE(method, "assets not initialized");
+        for (Size i=1; i<assets_.size(); i++)
+            QL_REQUIRE(assets_[i]->method() == method,
+                       "assets were initialized on different methods");
+        return method;
+    }
+
+    void DiscretizedPortfolio::rollback(Time to) {
+        const TimeGrid& grid = method()->timeGrid();
+
+        Time from = to;
+        for (Size i=0; i<assets_.size(); i++) {
+            Time t = assets_[i]->time();
+            QL_REQUIRE(t > to || close(t, to),
+                       "cannot roll the asset back to " << to
+                       << " (it is already at t = " << t << ")");
+            from = std::max(from, t);
+        }
+
+        // rolling back one step at a time performs the same
+        // operations as a full rollback of each asset.
+        for (Size i=grid.index(from); i>grid.index(to); --i) {
+            Time t = grid[i-1];
+            for (Size j=0; j<assets_.size(); j++) {
+                Time assetTime = assets_[j]->time();
+                if (assetTime > t && !close(assetTime, t))
+                    assets_[j]->rollback(t);
+            }
+        }
+    }
+
+    std::vector<Real> DiscretizedPortfolio::presentValues() const {
+        std::vector<Real> values(assets_.size());
+        for (Size i=0; i<assets_.size(); i++)
+            values[i] = assets_[i]->presentValue();
+        return values;
+    }
+
+}
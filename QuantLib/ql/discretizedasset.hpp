@@ -176,6 +176,33 @@ namespace QuantLib {
     };
 
 
+    //! Portfolio of discretized assets rolled back together
+    /*! The assets must have been initialized on the same lattice,
+        possibly at different times.  They are rolled back in
+        lockstep, one time step at a time, so that the lattice data
+        of each level are used by all the assets before moving to the
+        next one; assets initialized at earlier times join the
+        rollback when it reaches them.  The results are the same as
+        those of rolling back each asset separately.
+    */
+    class DiscretizedPortfolio {
+      public:
+        DiscretizedPortfolio(
+              const std::vector<boost::shared_ptr<DiscretizedAsset> >& assets);
+        //! union of the mandatory times of the assets
+        std::vector<Time> mandatoryTimes() const;
+        //! rolls all the assets back to the given time
+        void rollback(Time to);
+        //! present values of the assets, in the order they were given
+        std::vector<Real> presentValues() const;
+        const std::vector<boost::shared_ptr<DiscretizedAsset> >&
+        assets() const { return assets_; }
+      private:
+        const boost::shared_ptr<Lattice>& method() const;
+        std::vector<boost::shared_ptr<DiscretizedAsset> > assets_;
+    };
+
+
 
     // inline definitions
 
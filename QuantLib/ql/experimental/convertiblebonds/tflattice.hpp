@@ -90,7 +90,14 @@ namespace QuantLib {
                                           Array& newConversionProbability,
                                           Array& newSpreadAdjustedRate) const {
 
-        for (Size j=0; j<this->size(i); j++) {
+        // discount factors at level i+1, computed once per node
+        // instead of once per branch.
+        const Size n = this->size(i);
+        Array discounts(n+1);
+        for (Size j=0; j<=n; j++)
+            discounts[j] = 1.0/(1+(spreadAdjustedRate[j]*this->dt_));
+
+        for (Size j=0; j<n; j++) {
 
             // new conversion probability is calculated via backward
             // induction using up and down probabilities on tree on
@@ -105,9 +112,8 @@ namespace QuantLib {
                 newConversionProbability[j] * this->riskFreeRate_ +
                 (1-newConversionProbability[j])*(this->riskFreeRate_+creditSpread_);
 
-            newValues[j] =
-                (this->pd_*values[j]/(1+(spreadAdjustedRate[j]*this->dt_)))
-              + (this->pu_*values[j+1]/(1+(spreadAdjustedRate[j+1]*this->dt_)));
+            newValues[j] = this->pd_*values[j]*discounts[j]
+                         + this->pu_*values[j+1]*discounts[j+1];
 
         }
     }
@@ -151,9 +157,10 @@ namespace QuantLib {
                      newConversionProbability,newSpreadAdjustedRate);
 
             convertible.time() = this->t_[i];
-            convertible.values() = newValues;
-            convertible.spreadAdjustedRate() = newSpreadAdjustedRate;
-            convertible.conversionProbability() = newConversionProbability;
+            convertible.values().swap(newValues);
+            convertible.spreadAdjustedRate().swap(newSpreadAdjustedRate);
+            convertible.conversionProbability().swap(
+                                                   newConversionProbability);
 
             // skip the very last adjustment
             if (i != iTo)
@@ -0,0 +1,256 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2015 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/experimental/finitedifferences/fdmfwdeuropeangridsolver.hpp>
+#include <ql/instruments/payoffs.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearopcomposite.hpp>
+#include <ql/methods/finitedifferences/schemes/douglasscheme.hpp>
+#include <ql/methods/finitedifferences/schemes/craigsneydscheme.hpp>
+#include <ql/methods/finitedifferences/schemes/hundsdorferscheme.hpp>
+#include <ql/methods/finitedifferences/schemes/impliciteulerscheme.hpp>
+#include <ql/methods/finitedifferences/schemes/expliciteulerscheme.hpp>
+#include <ql/methods/finitedifferences/schemes/modifiedcraigsneydscheme.hpp>
+
+namespace QuantLib {
+
+    namespace {
+
+        template <class Scheme>
+        void rollForwardWith(Scheme& scheme, Array& p,
+                             Time from, Time to, Size steps) {
+            const Time dt = (to-from)/steps;
+            scheme.setStep(dt);
+            for (Size i=1; i < steps; ++i)
+                scheme.step(p, from + i*dt);
+            scheme.step(p, to);
+        }
+
+    }
+
+    FdmFwdEuropeanGridSolver::FdmFwdEuropeanGridSolver(
+        const boost::shared_ptr<FdmMesher>& mesher,
+        const boost::shared_ptr<FdmLinearOpComposite>& fwdOp,
+        const std::vector<Real>& initialState,
+        const Handle<YieldTermStructure>& riskFreeRate,
+        const FdmSchemeDesc& schemeDesc,
+        Size dampingSteps)
+    : mesher_(mesher), fwdOp_(fwdOp),
+      initialState_(initialState), riskFreeRate_(riskFreeRate),
+      schemeDesc_(schemeDesc), dampingSteps_(dampingSteps) {
+
+        const boost::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
+        const std::vector<Size>& dim = layout->dim();
+        const Size n = dim.size();
+
+        QL_REQUIRE(initialState_.size() == n,
+                   "initial state has " << initialState_.size()
+                   << " components, mesher has " << n << " directions");
+
+        // collect the 1D grids along the axes of the mesher...
+        locations_.resize(n);
+        const FdmLinearOpIterator endIter = layout->end();
+        for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
+             ++iter) {
+            const std::vector<Size>& c = iter.coordinates();
+            for (Size d=0; d < n; ++d) {
+                bool onAxis = true;
+                for (Size k=0; k < n && onAxis; ++k)
+                    onAxis = (k == d || c[k] == 0);
+                if (onAxis)
+                    locations_[d].push_back(mesher_->location(iter, d));
+            }
+        }
+
+        // ...and the corresponding trapezoidal quadrature weights
+        weights_.resize(n);
+        for (Size d=0; d < n; ++d) {
+            const std::vector<Real>& x = locations_[d];
+            const Size m = x.size();
+            QL_REQUIRE(m > 1, "at least two points needed in direction " << d);
+            weights_[d].resize(m);
+            weights_[d].front() = 0.5*(x[1]-x[0]);
+            weights_[d].back()  = 0.5*(x[m-1]-x[m-2]);
+            for (Size i=1; i < m-1; ++i)
+                weights_[d][i] = 0.5*(x[i+1]-x[i-1]);
+
+            QL_REQUIRE(initialState_[d] >= x.front()
+                       && initialState_[d] <= x.back(),
+                       "initial state " << initialState_[d]
+                       << " outside of the mesher in direction " << d);
+        }
+    }
+
+    Disposable<Array> FdmFwdEuropeanGridSolver::initialDensity() const {
+        const boost::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
+        const Size n = locations_.size();
+
+        // the delta is split linearly between the two grid points
+        // around the initial state in each direction, and normalized
+        // so that it integrates to one under the quadrature weights.
+        std::vector<std::vector<Size> > idx(n);
+        std::vector<std::vector<Real> > w(n);
+        for (Size d=0; d < n; ++d) {
+            const std::vector<Real>& x = locations_[d];
+            const Size i = std::min<Size>(
+                std::upper_bound(x.begin(), x.end(), initialState_[d])
+                                                       - x.begin(), x.size()-1);
+            const Real lambda = (x[i]-initialState_[d])/(x[i]-x[i-1]);
+
+            idx[d].push_back(i-1);
+            w[d].push_back(lambda/weights_[d][i-1]);
+            idx[d].push_back(i);
+            w[d].push_back((1.0-lambda)/weights_[d][i]);
+        }
+
+        Array p(layout->size(), 0.0);
+        std::vector<Size> coordinates(n);
+        for (Size k=0; k < (Size(1) << n); ++k) {
+            Real value = 1.0;
+            for (Size d=0; d < n; ++d) {
+                coordinates[d] = idx[d][(k >> d) & 1];
+                value *= w[d][(k >> d) & 1];
+            }
+            p[layout->index(coordinates)] += value;
+        }
+
+        return p;
+    }
+
+    void FdmFwdEuropeanGridSolver::rollForward(
+                            Array& p, Time from, Time to, Size steps) const {
+        switch (schemeDesc_.type) {
+          case FdmSchemeDesc::HundsdorferType:
+            {
+                HundsdorferScheme scheme(schemeDesc_.theta, schemeDesc_.mu,
+                                         fwdOp_);
+                rollForwardWith(scheme, p, from, to, steps);
+            }
+            break;
+          case FdmSchemeDesc::DouglasType:
+            {
+                DouglasScheme scheme(schemeDesc_.theta, fwdOp_);
+                rollForwardWith(scheme, p, from, to, steps);
+            }
+            break;
+          case FdmSchemeDesc::CraigSneydType:
+            {
+                CraigSneydScheme scheme(schemeDesc_.theta, schemeDesc_.mu,
+                                        fwdOp_);
+                rollForwardWith(scheme, p, from, to, steps);
+            }
+            break;
+          case FdmSchemeDesc::ModifiedCraigSneydType:
+            {
+                ModifiedCraigSneydScheme scheme(schemeDesc_.theta,
+                                                schemeDesc_.mu, fwdOp_);
+                rollForwardWith(scheme, p, from, to, steps);
+            }
+            break;
+          case FdmSchemeDesc::ImplicitEulerType:
+            {
+                ImplicitEulerScheme scheme(fwdOp_);
+                rollForwardWith(scheme, p, from, to, steps);
+            }
+            break;
+          case FdmSchemeDesc::ExplicitEulerType:
+            {
+                ExplicitEulerScheme scheme(fwdOp_);
+                rollForwardWith(scheme, p, from, to, steps);
+            }
+            break;
+          default:
+            QL_FAIL("Unknown scheme type");
+        }
+    }
+
+    Disposable<Matrix> FdmFwdEuropeanGridSolver::npv(
+                                    Option::Type type,
+                                    const std::vector<Time>& expiries,
+                                    const std::vector<Real>& strikes,
+                                    Size timeSteps) const {
+        QL_REQUIRE(!expiries.empty(), "no expiries given");
+        QL_REQUIRE(expiries.front() > 0.0, "positive expiries required");
+        for (Size i=1; i < expiries.size(); ++i)
+            QL_REQUIRE(expiries[i] > expiries[i-1],
+                       "expiries must be sorted and unique");
+        QL_REQUIRE(timeSteps > 0, "positive number of time steps required");
+
+        const boost::shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
+        const Size n = locations_.size();
+        const Size nx = locations_[0].size();
+
+        std::vector<boost::shared_ptr<PlainVanillaPayoff> > payoffs;
+        for (Size j=0; j < strikes.size(); ++j)
+            payoffs.push_back(boost::shared_ptr<PlainVanillaPayoff>(
+                                   new PlainVanillaPayoff(type, strikes[j])));
+
+        std::vector<Real> spots(nx);
+        for (Size i=0; i < nx; ++i)
+            spots[i] = std::exp(locations_[0][i]);
+
+        Matrix result(expiries.size(), strikes.size());
+        Array p = initialDensity();
+        Array marginal(nx);
+
+        Time t = 0.0;
+        const Time maturity = expiries.back();
+        for (Size k=0; k < expiries.size(); ++k) {
+            const Time dt = expiries[k] - t;
+            Size steps = std::max<Size>(
+                            1, Size(timeSteps*dt/maturity + 0.5));
+
+            if (k == 0 && dampingSteps_ > 0) {
+                const Size allSteps = steps + dampingSteps_;
+                const Time dampingTo = t + (dt*dampingSteps_)/allSteps;
+                ImplicitEulerScheme damping(fwdOp_);
+                rollForwardWith(damping, p, t, dampingTo, dampingSteps_);
+                t = dampingTo;
+            }
+            rollForward(p, t, expiries[k], steps);
+            t = expiries[k];
+
+            // integrate out all directions but the log-spot...
+            std::fill(marginal.begin(), marginal.end(), 0.0);
+            const FdmLinearOpIterator endIter = layout->end();
+            for (FdmLinearOpIterator iter = layout->begin();
+                 iter != endIter; ++iter) {
+                const std::vector<Size>& c = iter.coordinates();
+                Real w = 1.0;
+                for (Size d=1; d < n; ++d)
+                    w *= weights_[d][c[d]];
+                marginal[c[0]] += w*p[iter.index()];
+            }
+
+            // ...and price all strikes against the resulting density
+            const DiscountFactor df = riskFreeRate_->discount(t);
+            for (Size j=0; j < strikes.size(); ++j) {
+                Real sum = 0.0;
+                for (Size i=0; i < nx; ++i)
+                    sum += weights_[0][i]*marginal[i]
+                                         *(*payoffs[j])(spots[i]);
+                result[k][j] = df*sum;
+            }
+        }
+
+        return result;
+    }
+
+}
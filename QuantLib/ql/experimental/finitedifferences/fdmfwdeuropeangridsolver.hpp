@@ -0,0 +1,112 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2015 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmfwdeuropeangridsolver.hpp
+    \brief strike-by-expiry grid of European prices from one forward solve
+*/
+
+#ifndef quantlib_fdm_fwd_european_grid_solver_hpp
+#define quantlib_fdm_fwd_european_grid_solver_hpp
+
+#include <ql/option.hpp>
+#include <ql/handle.hpp>
+#include <ql/math/matrix.hpp>
+#include <ql/termstructures/yieldtermstructure.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
+
+namespace QuantLib {
+
+    class FdmMesher;
+    class FdmLinearOpComposite;
+
+    //! European prices on a strike-by-expiry grid from one forward solve
+    /*! The Fokker-Planck equation given by the forward operator
+        (e.g. FdmBlackScholesFwdOp or FdmHestonFwdOp) is rolled
+        forward once from a discrete Dirac delta at the initial
+        state.  At each expiry, the density of the log-spot is
+        obtained by integrating out the remaining directions of the
+        mesher, and the prices of all strikes are computed by
+        integrating the payoffs against it.  This replaces one
+        backward solve per option with a single forward solve.
+
+        The first direction of the mesher must be the log-spot.
+
+        \warning the accuracy of the prices depends on the mesher
+                 resolving the strikes; prices of options far out
+                 of the money are affected by the truncation of the
+                 density at the boundaries of the mesher.
+
+        \ingroup findiff
+
+        \test the prices of a strike-by-expiry grid under the
+              Black-Scholes model are checked against the Black
+              formula.
+
+        \test the prices of a strike-by-expiry grid under the
+              Heston model are checked against the ones of the
+              analytic Heston engine.
+    */
+    class FdmFwdEuropeanGridSolver {
+      public:
+        /*! \param initialState  the initial value of each direction
+                                 of the mesher, e.g. the log of the
+                                 spot and, for the Heston model, the
+                                 initial variance.
+            \param dampingSteps  number of implicit Euler steps used
+                                 at the start of the solve to smooth
+                                 the initial delta.
+        */
+        FdmFwdEuropeanGridSolver(
+            const boost::shared_ptr<FdmMesher>& mesher,
+            const boost::shared_ptr<FdmLinearOpComposite>& fwdOp,
+            const std::vector<Real>& initialState,
+            const Handle<YieldTermStructure>& riskFreeRate,
+            const FdmSchemeDesc& schemeDesc = FdmSchemeDesc::Douglas(),
+            Size dampingSteps = 0);
+
+        /*! returns the discounted prices of the European options of
+            the given type; rows correspond to expiries (which must be
+            sorted) and columns to strikes.  The time steps are spread
+            over the expiries in proportion to their lengths.
+        */
+        Disposable<Matrix> npv(Option::Type type,
+                               const std::vector<Time>& expiries,
+                               const std::vector<Real>& strikes,
+                               Size timeSteps) const;
+
+        //! discrete Dirac delta at the initial state
+        Disposable<Array> initialDensity() const;
+
+      private:
+        void rollForward(Array& p, Time from, Time to, Size steps) const;
+
+        const boost::shared_ptr<FdmMesher> mesher_;
+        const boost::shared_ptr<FdmLinearOpComposite> fwdOp_;
+        const std::vector<Real> initialState_;
+        const Handle<YieldTermStructure> riskFreeRate_;
+        const FdmSchemeDesc schemeDesc_;
+        const Size dampingSteps_;
+
+        // 1D grids and quadrature weights of each direction
+        std::vector<std::vector<Real> > locations_, weights_;
+    };
+
+}
+
+#endif
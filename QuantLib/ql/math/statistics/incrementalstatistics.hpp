@@ -126,6 +126,12 @@ namespace QuantLib {
             for (;begin!=end;++begin,++wbegin)
                 add(*begin, *wbegin);
         }
+        //! adds the data collected by another instance
+        /*! The resulting statistics are the same (up to rounding)
+            as if the data of both instances had been added to this
+            one; this allows to collect data on separate threads.
+        */
+        void merge(const IncrementalStatistics& other);
         //! resets the data to a null set
         void reset();
         //@}
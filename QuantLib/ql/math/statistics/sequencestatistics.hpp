@@ -139,6 +139,11 @@ namespace QuantLib {
                 stats_[i].add(*begin, weight);
 
         }
+        //! adds the data collected by another instance
+        /*! \pre the underlying statistics class must provide a
+                 merge method, as IncrementalStatistics does.
+        */
+        void merge(const GenericSequenceStatistics<StatisticsType>& other);
         //@}
       protected:
         Size dimension_;
@@ -244,6 +249,23 @@ namespace QuantLib {
         }
     }
 
+    template <class Stat>
+    void GenericSequenceStatistics<Stat>::merge(
+                                 const GenericSequenceStatistics<Stat>& other) {
+        if (other.dimension_ == 0)
+            return;
+        if (dimension_ == 0)
+            reset(other.dimension_);
+
+        QL_REQUIRE(other.dimension_ == dimension_,
+                   "sample size mismatch: " << dimension_ <<
+                   " required, " << other.dimension_ << " provided");
+
+        quadraticSum_ += other.quadraticSum_;
+        for (Size i=0; i<dimension_; ++i)
+            stats_[i].merge(other.stats_[i]);
+    }
+
     template <class Stat>
     Disposable<Matrix> GenericSequenceStatistics<Stat>::covariance() const {
         Real sampleWeight = weightSum();
@@ -50,6 +50,8 @@ namespace QuantLib {
         // operator interface
         array_type applyTo(const array_type&);
         array_type solveFor(const array_type&);
+        void applyTo(const array_type&, array_type& result);
+        void solveFor(const array_type&, array_type& result);
         static Operator identity(Size size);
 
         // operator algebra
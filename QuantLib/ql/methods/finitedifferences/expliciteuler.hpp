@@ -51,6 +51,7 @@ namespace QuantLib {
 
         // operator interface
         array_type applyTo(const array_type&);
+        void applyTo(const array_type&, array_type& result);
         static Operator identity(Size size);
 
         // operator algebra
@@ -49,6 +49,7 @@ namespace QuantLib {
 
         // operator interface
         array_type solveFor(const array_type&);
+        void solveFor(const array_type&, array_type& result);
         static Operator identity(Size size);
 
         // operator algebra
@@ -51,6 +51,8 @@ namespace QuantLib {
         // operator interface
         array_type applyTo(const array_type&);
         array_type solveFor(const array_type&);
+        void applyTo(const array_type&, array_type& result);
+        void solveFor(const array_type&, array_type& result);
         static Operator identity(Size size);
 
         // operator algebra
@@ -82,11 +84,16 @@ namespace QuantLib {
                     Real theta,
                     const bc_set& bcs)
         : L_(L), I_(operator_type::identity(L.size())),
-          dt_(0.0), theta_(theta) , bcs_(bcs) {}
+          dt_(0.0), theta_(theta) , bcs_(bcs), temp_(L.size()),
+          initialized_(false) {}
         void step(array_type& a,
                   Time t);
         void setStep(Time dt) {
+            // time-dependent parts are rebuilt at each step anyway
+            if (initialized_ && dt == dt_)
+                return;
             dt_ = dt;
+            initialized_ = true;
             if (theta_!=1.0) // there is an explicit part
                 explicitPart_ = I_-((1.0-theta_) * dt_)*L_;
             if (theta_!=0.0) // there is an implicit part
@@ -97,6 +104,10 @@ namespace QuantLib {
         Time dt_;
         Real theta_;
         bc_set bcs_;
+        // work array for the explicit part, reused across steps
+        array_type temp_;
+        // whether the parts were built by setStep
+        bool initialized_;
     };
 
 
@@ -114,7 +125,8 @@ namespace QuantLib {
             }
             for (i=0; i<bcs_.size(); i++)
                 bcs_[i]->applyBeforeApplying(explicitPart_);
-            a = explicitPart_.applyTo(a);
+            explicitPart_.applyTo(a, temp_);
+            a.swap(temp_);
             for (i=0; i<bcs_.size(); i++)
                 bcs_[i]->applyAfterApplying(a);
         }
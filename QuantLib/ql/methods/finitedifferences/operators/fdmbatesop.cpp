@@ -98,16 +98,21 @@ namespace QuantLib {
     Disposable<Array> FdmBatesOp::integro(const Array& r) const {
         const shared_ptr<FdmLinearOpLayout> layout = mesher_->layout();
         
-        QL_REQUIRE(layout->dim().size() == 2, "invalid layout dimension");
-
-        Array x(layout->dim()[0]);
-        Matrix f(layout->dim()[1], layout->dim()[0]);
+        QL_REQUIRE(layout->dim().size() >= 2, "invalid layout dimension");
+
+        // each row of f holds the values along one line in the equity
+        // direction; as the equity direction is the fastest one, the
+        // row is given by the index divided by the number of points
+        // on each line.
+        const Size nx = layout->dim()[0];
+        Array x(nx);
+        Matrix f(layout->size()/nx, nx);
         
         const FdmLinearOpIterator endIter = layout->end();
         for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
             ++iter) {
             const Size i = iter.coordinates()[0];
-            const Size j = iter.coordinates()[1];
+            const Size j = iter.index()/nx;
             
             x[i]    = mesher_->location(iter, 0);
             f[j][i] = r[iter.index()];
@@ -122,7 +127,7 @@ namespace QuantLib {
         Array integral(r.size());
         for (FdmLinearOpIterator iter=layout->begin(); iter!=endIter; ++iter) {
             const Size i = iter.coordinates()[0];
-            const Size j = iter.coordinates()[1];
+            const Size j = iter.index()/nx;
 
             integral[iter.index()] = M_1_SQRTPI* 
                 gaussHermiteIntegration_(
@@ -0,0 +1,112 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2015 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmblackscholessensitivityop.cpp
+    \brief derivatives of the Black-Scholes operator
+*/
+
+#include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/methods/finitedifferences/operators/secondderivativeop.hpp>
+#include <ql/methods/finitedifferences/operators/fdmblackscholessensitivityop.hpp>
+
+namespace QuantLib {
+
+    FdmBlackScholesSensitivityOp::FdmBlackScholesSensitivityOp(
+        const boost::shared_ptr<FdmMesher>& mesher,
+        const boost::shared_ptr<GeneralizedBlackScholesProcess>& bsProcess,
+        Real strike,
+        Parameter parameter,
+        Size direction)
+    : mesher_(mesher),
+      volTS_ (bsProcess->blackVolatility().currentLink()),
+      dxMap_ (FirstDerivativeOp(direction, mesher)),
+      dxxMap_(SecondDerivativeOp(direction, mesher)),
+      mapT_  (direction, mesher),
+      strike_(strike),
+      parameter_(parameter),
+      direction_(direction) {
+    }
+
+    void FdmBlackScholesSensitivityOp::setTime(Time t1, Time t2) {
+        const Size n = mesher_->layout()->size();
+
+        switch (parameter_) {
+          case Volatility:
+            {
+                // derivative of the forward variance rate used by
+                // FdmBlackScholesOp with respect to a parallel shift
+                // of the Black volatility
+                Real dv = 2.0*volTS_->blackVol(t2, strike_)*t2;
+                if (t1 > 0.0)
+                    dv -= 2.0*volTS_->blackVol(t1, strike_)*t1;
+                dv /= t2 - t1;
+
+                mapT_.axpyb(Array(1, -0.5*dv), dxMap_,
+                            dxxMap_.mult(Array(n, 0.5*dv)), Array());
+            }
+            break;
+          case RiskFreeRate:
+            mapT_.axpyb(Array(1, 1.0), dxMap_,
+                        dxxMap_.mult(Array(n, 0.0)), Array(1, -1.0));
+            break;
+          case DividendYield:
+            mapT_.axpyb(Array(1, -1.0), dxMap_,
+                        dxxMap_.mult(Array(n, 0.0)), Array());
+            break;
+          default:
+            QL_FAIL("unknown parameter");
+        }
+    }
+
+    Size FdmBlackScholesSensitivityOp::size() const {
+        return 1u;
+    }
+
+    Disposable<Array> FdmBlackScholesSensitivityOp::apply(
+                                                    const Array& u) const {
+        return mapT_.apply(u);
+    }
+
+    Disposable<Array> FdmBlackScholesSensitivityOp::apply_direction(
+                                    Size direction, const Array& r) const {
+        if (direction == direction_)
+            return mapT_.apply(r);
+        else {
+            Array retVal(r.size(), 0.0);
+            return retVal;
+        }
+    }
+
+    Disposable<Array> FdmBlackScholesSensitivityOp::apply_mixed(
+                                                    const Array& r) const {
+        Array retVal(r.size(), 0.0);
+        return retVal;
+    }
+
+    Disposable<Array> FdmBlackScholesSensitivityOp::solve_splitting(
+                                    Size, const Array&, Real) const {
+        QL_FAIL("derivative operators can't be inverted");
+    }
+
+    Disposable<Array> FdmBlackScholesSensitivityOp::preconditioner(
+                                    const Array&, Real) const {
+        QL_FAIL("derivative operators can't be inverted");
+    }
+}
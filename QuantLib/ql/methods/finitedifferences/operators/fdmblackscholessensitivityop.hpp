@@ -0,0 +1,79 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2015 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmblackscholessensitivityop.hpp
+    \brief derivatives of the Black-Scholes operator
+*/
+
+#ifndef quantlib_fdm_black_scholes_sensitivity_op_hpp
+#define quantlib_fdm_black_scholes_sensitivity_op_hpp
+
+#include <ql/processes/blackscholesprocess.hpp>
+#include <ql/methods/finitedifferences/operators/firstderivativeop.hpp>
+#include <ql/methods/finitedifferences/operators/triplebandlinearop.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearopcomposite.hpp>
+
+namespace QuantLib {
+
+    //! derivatives of the Black-Scholes operator
+    /*! This operator is the derivative of FdmBlackScholesOp with
+        respect to a parallel shift of either the Black volatility,
+        the risk-free rate or the dividend yield.  It is meant to be
+        used with FdmTangentLinearOp in order to obtain vega, rho and
+        dividend rho from the same backward solve as the value.
+
+        Local volatility is not supported.
+
+        \ingroup findiff
+    */
+    class FdmBlackScholesSensitivityOp : public FdmLinearOpComposite {
+      public:
+        enum Parameter { Volatility, RiskFreeRate, DividendYield };
+
+        FdmBlackScholesSensitivityOp(
+            const boost::shared_ptr<FdmMesher>& mesher,
+            const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+            Real strike,
+            Parameter parameter,
+            Size direction = 0);
+
+        Size size() const;
+        void setTime(Time t1, Time t2);
+
+        Disposable<Array> apply(const Array& r) const;
+        Disposable<Array> apply_mixed(const Array& r) const;
+        Disposable<Array> apply_direction(Size direction,
+                                          const Array& r) const;
+        Disposable<Array> solve_splitting(Size direction,
+                                          const Array& r, Real s) const;
+        Disposable<Array> preconditioner(const Array& r, Real s) const;
+
+      private:
+        const boost::shared_ptr<FdmMesher> mesher_;
+        const boost::shared_ptr<BlackVolTermStructure> volTS_;
+        const FirstDerivativeOp  dxMap_;
+        const TripleBandLinearOp dxxMap_;
+        TripleBandLinearOp mapT_;
+        const Real strike_;
+        const Parameter parameter_;
+        const Size direction_;
+    };
+}
+
+#endif
@@ -0,0 +1,122 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2015 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmtangentlinearop.cpp
+    \brief tangent-linear operator for parameter sensitivities
+*/
+
+#include <ql/methods/finitedifferences/operators/fdmtangentlinearop.hpp>
+
+namespace QuantLib {
+
+    FdmTangentLinearOp::FdmTangentLinearOp(
+        const boost::shared_ptr<FdmLinearOpComposite>& op,
+        const std::vector<boost::shared_ptr<FdmLinearOpComposite> >&
+                                                            derivativeOps)
+    : op_(op), derivativeOps_(derivativeOps) {
+        QL_REQUIRE(op_, "null operator given");
+        for (Size i=0; i < derivativeOps_.size(); ++i)
+            QL_REQUIRE(derivativeOps_[i], "null derivative operator given");
+    }
+
+    Size FdmTangentLinearOp::size() const {
+        return op_->size();
+    }
+
+    void FdmTangentLinearOp::setTime(Time t1, Time t2) {
+        op_->setTime(t1, t2);
+        for (Size i=0; i < derivativeOps_.size(); ++i)
+            derivativeOps_[i]->setTime(t1, t2);
+    }
+
+    Disposable<Array> FdmTangentLinearOp::block(const Array& r,
+                                                Size i) const {
+        const Size n = r.size()/(derivativeOps_.size()+1);
+        Array retVal(r.begin() + i*n, r.begin() + (i+1)*n);
+        return retVal;
+    }
+
+    void FdmTangentLinearOp::setBlock(Array& r, Size i,
+                                      const Array& b) const {
+        std::copy(b.begin(), b.end(), r.begin() + i*b.size());
+    }
+
+    Disposable<Array> FdmTangentLinearOp::apply(const Array& r) const {
+        const Array v = block(r, 0);
+
+        Array retVal(r.size());
+        setBlock(retVal, 0, op_->apply(v));
+        for (Size i=0; i < derivativeOps_.size(); ++i)
+            setBlock(retVal, i+1, derivativeOps_[i]->apply(v)
+                                  + op_->apply(block(r, i+1)));
+        return retVal;
+    }
+
+    Disposable<Array> FdmTangentLinearOp::apply_mixed(const Array& r) const {
+        const Array v = block(r, 0);
+
+        Array retVal(r.size());
+        setBlock(retVal, 0, op_->apply_mixed(v));
+        for (Size i=0; i < derivativeOps_.size(); ++i)
+            setBlock(retVal, i+1, derivativeOps_[i]->apply_mixed(v)
+                                  + op_->apply_mixed(block(r, i+1)));
+        return retVal;
+    }
+
+    Disposable<Array> FdmTangentLinearOp::apply_direction(
+                                    Size direction, const Array& r) const {
+        const Array v = block(r, 0);
+
+        Array retVal(r.size());
+        setBlock(retVal, 0, op_->apply_direction(direction, v));
+        for (Size i=0; i < derivativeOps_.size(); ++i)
+            setBlock(retVal, i+1,
+                     derivativeOps_[i]->apply_direction(direction, v)
+                     + op_->apply_direction(direction, block(r, i+1)));
+        return retVal;
+    }
+
+    Disposable<Array> FdmTangentLinearOp::solve_splitting(
+                            Size direction, const Array& r, Real s) const {
+        // (1 + s L) x_v = r_v and (1 + s L) x_i = r_i - s dL_i x_v
+        const Array x = op_->solve_splitting(direction, block(r, 0), s);
+
+        Array retVal(r.size());
+        setBlock(retVal, 0, x);
+        for (Size i=0; i < derivativeOps_.size(); ++i)
+            setBlock(retVal, i+1, op_->solve_splitting(
+                direction,
+                block(r, i+1)
+                    - s*derivativeOps_[i]->apply_direction(direction, x),
+                s));
+        return retVal;
+    }
+
+    Disposable<Array> FdmTangentLinearOp::preconditioner(const Array& r,
+                                                         Real s) const {
+        const Array x = op_->preconditioner(block(r, 0), s);
+
+        Array retVal(r.size());
+        setBlock(retVal, 0, x);
+        for (Size i=0; i < derivativeOps_.size(); ++i)
+            setBlock(retVal, i+1, op_->preconditioner(
+                block(r, i+1) - s*derivativeOps_[i]->apply(x), s));
+        return retVal;
+    }
+}
@@ -0,0 +1,81 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2015 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmtangentlinearop.hpp
+    \brief tangent-linear operator for parameter sensitivities
+*/
+
+#ifndef quantlib_fdm_tangent_linear_op_hpp
+#define quantlib_fdm_tangent_linear_op_hpp
+
+#include <ql/methods/finitedifferences/operators/fdmlinearopcomposite.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! tangent-linear operator for parameter sensitivities
+    /*! Given the operator \f$ L(p) \f$ of a pricing equation and the
+        operators \f$ \partial L / \partial p_i \f$ of its derivatives
+        with respect to a few parameters, this operator acts on arrays
+        made of the value \f$ V \f$ followed by its sensitivities
+        \f$ W_i = \partial V / \partial p_i \f$, each with the size of
+        the mesher layout, as the block lower-triangular operator
+        \f[
+            (V, W_1, \ldots, W_n) \mapsto
+            (L V, \partial_1 L \, V + L W_1, \ldots,
+                  \partial_n L \, V + L W_n).
+        \f]
+        Rolling back such arrays with any of the available schemes
+        thus yields the sensitivities together with the value, within
+        the same time loop and using the same splitting solves.
+
+        The derivative operators are only applied; they don't need to
+        implement solve_splitting or preconditioner.
+
+        \ingroup findiff
+    */
+    class FdmTangentLinearOp : public FdmLinearOpComposite {
+      public:
+        FdmTangentLinearOp(
+            const boost::shared_ptr<FdmLinearOpComposite>& op,
+            const std::vector<boost::shared_ptr<FdmLinearOpComposite> >&
+                                                             derivativeOps);
+
+        Size size() const;
+        void setTime(Time t1, Time t2);
+
+        Disposable<Array> apply(const Array& r) const;
+        Disposable<Array> apply_mixed(const Array& r) const;
+        Disposable<Array> apply_direction(Size direction,
+                                          const Array& r) const;
+        Disposable<Array> solve_splitting(Size direction,
+                                          const Array& r, Real s) const;
+        Disposable<Array> preconditioner(const Array& r, Real s) const;
+
+      private:
+        Disposable<Array> block(const Array& r, Size i) const;
+        void setBlock(Array& r, Size i, const Array& b) const;
+
+        const boost::shared_ptr<FdmLinearOpComposite> op_;
+        const std::vector<boost::shared_ptr<FdmLinearOpComposite> >
+                                                             derivativeOps_;
+    };
+}
+
+#endif
@@ -66,7 +66,6 @@ namespace QuantLib {
 
         Size direction_;
         boost::shared_array<Size> i0_, i2_;
-        boost::shared_array<Size> reverseIndex_;
         boost::shared_array<Real> lower_, diag_, upper_;
 
         boost::shared_ptr<FdmMesher> mesher_;
@@ -41,27 +41,37 @@ namespace QuantLib {
         bcSet_.setTime(std::max(0.0, t-dt_));
 
         bcSet_.applyBeforeApplying(*map_);
-        Array y = a + dt_*map_->apply(a);
-        bcSet_.applyAfterApplying(y);
-
-        Array y0 = y;
+        y0_ = map_->apply(a);
+        y0_ *= dt_;
+        y0_ += a;
+        bcSet_.applyAfterApplying(y0_);
 
         for (Size i=0; i < map_->size(); ++i) {
-            Array rhs = y - theta_*dt_*map_->apply_direction(i, a);
-            y = map_->solve_splitting(i, rhs, -theta_*dt_);
+            rhs_ = map_->apply_direction(i, a);
+            rhs_ *= -theta_*dt_;
+            rhs_ += (i == 0) ? y0_ : y_;
+            y_ = map_->solve_splitting(i, rhs_, -theta_*dt_);
         }
 
         bcSet_.applyBeforeApplying(*map_);
-        Array yt = y0 + mu_*dt_*map_->apply_mixed(y-a);
-        bcSet_.applyAfterApplying(yt);
+        if (diff_.size() != a.size())
+            diff_ = Array(a.size());
+        for (Size j=0; j < a.size(); ++j)
+            diff_[j] = y_[j] - a[j];
+        yt_ = map_->apply_mixed(diff_);
+        yt_ *= mu_*dt_;
+        yt_ += y0_;
+        bcSet_.applyAfterApplying(yt_);
 
         for (Size i=0; i < map_->size(); ++i) {
-            Array rhs = yt - theta_*dt_*map_->apply_direction(i, a);
-            yt = map_->solve_splitting(i, rhs, -theta_*dt_);
+            rhs_ = map_->apply_direction(i, a);
+            rhs_ *= -theta_*dt_;
+            rhs_ += yt_;
+            yt_ = map_->solve_splitting(i, rhs_, -theta_*dt_);
         }
-        bcSet_.applyAfterSolving(yt);
+        bcSet_.applyAfterSolving(yt_);
 
-        a = yt;
+        a.swap(yt_);
     }
 
     void CraigSneydScheme::setStep(Time dt) {
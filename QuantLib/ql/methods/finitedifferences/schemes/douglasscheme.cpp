@@ -38,16 +38,20 @@ namespace QuantLib {
         bcSet_.setTime(std::max(0.0, t-dt_));
 
         bcSet_.applyBeforeApplying(*map_);
-        Array y = a + dt_*map_->apply(a);
-        bcSet_.applyAfterApplying(y);
+        y0_ = map_->apply(a);
+        y0_ *= dt_;
+        y0_ += a;
+        bcSet_.applyAfterApplying(y0_);
 
         for (Size i=0; i < map_->size(); ++i) {
-            Array rhs = y - theta_*dt_*map_->apply_direction(i, a);
-            y = map_->solve_splitting(i, rhs, -theta_*dt_);
+            rhs_ = map_->apply_direction(i, a);
+            rhs_ *= -theta_*dt_;
+            rhs_ += (i == 0) ? y0_ : y_;
+            y_ = map_->solve_splitting(i, rhs_, -theta_*dt_);
         }
-        bcSet_.applyAfterSolving(y);
+        bcSet_.applyAfterSolving(y_);
 
-        a = y;
+        a.swap(y_);
     }
 
     void DouglasScheme::setStep(Time dt) {
@@ -54,6 +54,9 @@ namespace QuantLib {
         const Real theta_;
         const boost::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+
+        // work arrays, kept between time steps
+        array_type y_, y0_, rhs_;
     };
 }
 
@@ -59,6 +59,9 @@ namespace QuantLib {
 
         const boost::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+
+        // work arrays, kept between time steps
+        array_type y_, y0_, yt_, rhs_, diff_;
     };
 }
 
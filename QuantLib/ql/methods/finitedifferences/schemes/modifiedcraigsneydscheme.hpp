@@ -60,6 +60,9 @@ namespace QuantLib {
         const Real mu_;
         const boost::shared_ptr<FdmLinearOpComposite> map_;
         const BoundaryConditionSchemeHelper bcSet_;
+
+        // work arrays, kept between time steps
+        array_type y_, y0_, yt_, rhs_, diff_;
     };
 }
 
@@ -21,20 +21,25 @@
 #include <ql/methods/finitedifferences/finitedifferencemodel.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/methods/finitedifferences/operators/fdmtangentlinearop.hpp>
 #include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
 #include <ql/methods/finitedifferences/solvers/fdm1dimsolver.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmsnapshotcondition.hpp>
+#include <ql/methods/finitedifferences/stepconditions/fdmtangentstepcondition.hpp>
 
 namespace QuantLib {
 
     Fdm1DimSolver::Fdm1DimSolver(
                              const FdmSolverDesc& solverDesc,
                              const FdmSchemeDesc& schemeDesc,
-                             const boost::shared_ptr<FdmLinearOpComposite>& op)
+                             const boost::shared_ptr<FdmLinearOpComposite>& op,
+                             const std::vector<boost::shared_ptr<
+                                 FdmLinearOpComposite> >& derivativeOps)
     : solverDesc_(solverDesc),
       schemeDesc_(schemeDesc),
       op_(op),
+      derivativeOps_(derivativeOps),
       thetaCondition_(new FdmSnapshotCondition(
         0.99*std::min(1.0/365.0,
            solverDesc.condition->stoppingTimes().empty()
@@ -61,17 +66,56 @@ namespace QuantLib {
 
 
     void Fdm1DimSolver::performCalculations() const {
-        Array rhs(initialValues_.size());
+        const Size n = initialValues_.size();
+        const Size nSensitivities = derivativeOps_.size();
+
+        // the sensitivities, if any, follow the value and vanish
+        // at maturity
+        Array rhs(n*(nSensitivities+1), 0.0);
         std::copy(initialValues_.begin(), initialValues_.end(), rhs.begin());
 
-        FdmBackwardSolver(op_, solverDesc_.bcSet, conditions_, schemeDesc_)
-            .rollback(rhs, solverDesc_.maturity, 0.0,
-                      solverDesc_.timeSteps, solverDesc_.dampingSteps);
+        if (nSensitivities == 0) {
+            FdmBackwardSolver(op_, solverDesc_.bcSet, conditions_, schemeDesc_)
+                .rollback(rhs, solverDesc_.maturity, 0.0,
+                          solverDesc_.timeSteps, solverDesc_.dampingSteps);
+        }
+        else {
+            QL_REQUIRE(solverDesc_.bcSet.empty(),
+                       "boundary conditions are not supported "
+                       "together with sensitivities");
+
+            const boost::shared_ptr<FdmLinearOpComposite> tangentOp(
+                new FdmTangentLinearOp(op_, derivativeOps_));
+            const boost::shared_ptr<FdmStepConditionComposite>
+                tangentConditions(new FdmStepConditionComposite(
+                    std::list<std::vector<Time> >(
+                                        1, conditions_->stoppingTimes()),
+                    FdmStepConditionComposite::Conditions(
+                        1, boost::shared_ptr<StepCondition<Array> >(
+                               new FdmTangentStepCondition(conditions_,
+                                                           nSensitivities)))));
+
+            FdmBackwardSolver(tangentOp, solverDesc_.bcSet,
+                              tangentConditions, schemeDesc_)
+                .rollback(rhs, solverDesc_.maturity, 0.0,
+                          solverDesc_.timeSteps, solverDesc_.dampingSteps);
+        }
 
-        std::copy(rhs.begin(), rhs.end(), resultValues_.begin());
+        std::copy(rhs.begin(), rhs.begin() + n, resultValues_.begin());
         interpolation_ = boost::shared_ptr<CubicInterpolation>(new
             MonotonicCubicNaturalSpline(x_.begin(), x_.end(),
                                         resultValues_.begin()));
+
+        sensitivityValues_.resize(nSensitivities);
+        sensitivityInterpolations_.resize(nSensitivities);
+        for (Size i=0; i < nSensitivities; ++i) {
+            sensitivityValues_[i] = Array(rhs.begin() + (i+1)*n,
+                                          rhs.begin() + (i+2)*n);
+            sensitivityInterpolations_[i] =
+                boost::shared_ptr<CubicInterpolation>(new
+                    CubicNaturalSpline(x_.begin(), x_.end(),
+                                       sensitivityValues_[i].begin()));
+        }
     }
 
     Real Fdm1DimSolver::interpolateAt(Real x) const {
@@ -104,4 +148,11 @@ namespace QuantLib {
         calculate();
         return interpolation_->secondDerivative(x);
     }
+
+    Real Fdm1DimSolver::sensitivityAt(Size i, Real x) const {
+        QL_REQUIRE(i < derivativeOps_.size(),
+                   "sensitivity " << i << " out of range");
+        calculate();
+        return sensitivityInterpolations_[i]->operator()(x);
+    }
 }
@@ -37,9 +37,19 @@ namespace QuantLib {
 
     class Fdm1DimSolver : public LazyObject {
       public:
+        /*! if derivative operators are given, the sensitivities of
+            the value with respect to the corresponding parameters
+            are rolled back together with it (see FdmTangentLinearOp)
+            and are returned by sensitivityAt.  Boundary conditions
+            are not supported in this case.
+        */
         Fdm1DimSolver(const FdmSolverDesc& solverDesc,
                       const FdmSchemeDesc& schemeDesc,
-                      const boost::shared_ptr<FdmLinearOpComposite>& op);
+                      const boost::shared_ptr<FdmLinearOpComposite>& op,
+                      const std::vector<boost::shared_ptr<
+                          FdmLinearOpComposite> >& derivativeOps
+                            = std::vector<boost::shared_ptr<
+                                              FdmLinearOpComposite> >());
 
         Real interpolateAt(Real x) const;
         Real thetaAt(Real x) const;
@@ -47,6 +57,9 @@ namespace QuantLib {
         Real derivativeX(Real x) const;
         Real derivativeXX(Real x) const;
 
+        //! sensitivity with respect to the i-th parameter
+        Real sensitivityAt(Size i, Real x) const;
+
       protected:
         void performCalculations() const;
 
@@ -54,6 +67,8 @@ namespace QuantLib {
         const FdmSolverDesc solverDesc_;
         const FdmSchemeDesc schemeDesc_;
         const boost::shared_ptr<FdmLinearOpComposite> op_;
+        const std::vector<boost::shared_ptr<FdmLinearOpComposite> >
+                                                              derivativeOps_;
 
         const boost::shared_ptr<FdmSnapshotCondition> thetaCondition_;
         const boost::shared_ptr<FdmStepConditionComposite> conditions_;
@@ -61,6 +76,9 @@ namespace QuantLib {
         std::vector<Real> x_, initialValues_;
         mutable Array resultValues_;
         mutable boost::shared_ptr<CubicInterpolation> interpolation_;
+        mutable std::vector<Array> sensitivityValues_;
+        mutable std::vector<boost::shared_ptr<CubicInterpolation> >
+                                                  sensitivityInterpolations_;
     };
 }
 
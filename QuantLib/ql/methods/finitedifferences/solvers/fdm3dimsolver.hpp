@@ -23,17 +23,19 @@
 #ifndef quantlib_fdm_3_dim_solver_hpp
 #define quantlib_fdm_3_dim_solver_hpp
 
-#include <ql/math/matrix.hpp>
 #include <ql/patterns/lazyobject.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmsolverdesc.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmlocalinterpolation.hpp>
 
 
 namespace QuantLib {
 
-    class BicubicSpline;
     class FdmSnapshotCondition;
 
+    /*! The results are kept on the grid only and interpolated locally
+        at the requested points (see FdmLocalInterpolation).
+    */
     class Fdm3DimSolver : public LazyObject {
       public:
         Fdm3DimSolver(const FdmSolverDesc& solverDesc,
@@ -53,9 +55,10 @@ namespace QuantLib {
         const boost::shared_ptr<FdmSnapshotCondition> thetaCondition_;
         const boost::shared_ptr<FdmStepConditionComposite> conditions_;
 
-        std::vector<Real> x_, y_, z_, initialValues_;
-        mutable std::vector<Matrix> resultValues_;
-        mutable std::vector<boost::shared_ptr<BicubicSpline> > interpolation_;
+        const FdmLocalInterpolation interpolation_;
+
+        mutable std::vector<Real> x_;
+        mutable Array resultValues_;
     };
 }
 
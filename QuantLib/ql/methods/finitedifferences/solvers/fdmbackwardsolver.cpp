@@ -33,9 +33,101 @@
 #include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
 
 namespace QuantLib {
-    
-    FdmSchemeDesc::FdmSchemeDesc(FdmSchemeType aType, Real aTheta, Real aMu)
-    : type(aType), theta(aTheta), mu(aMu) { }
+
+    namespace {
+
+        /* rolls back using step doubling: each step of size dt is
+           compared with two steps of size dt/2.  If the estimated
+           error, relative to the largest value on the grid, is below
+           the tolerance, the Richardson extrapolation of the two is
+           kept.  The step is restarted from initialStep after
+           stopping times.
+        */
+        template <class Evolver>
+        void errorControlledRollback(
+                            Evolver& evolver, Size order,
+                            Array& a, Time from, Time to,
+                            Time initialStep, Real tolerance,
+                            const FdmStepConditionComposite& condition) {
+
+            const std::vector<Time>& stoppingTimes
+                = condition.stoppingTimes();
+
+            std::vector<Time> targets;
+            for (Size i=stoppingTimes.size(); i > 0; --i) {
+                if (stoppingTimes[i-1] < from && stoppingTimes[i-1] > to)
+                    targets.push_back(stoppingTimes[i-1]);
+            }
+            targets.push_back(to);
+
+            if (!stoppingTimes.empty() && stoppingTimes.back() == from)
+                condition.applyTo(a, from);
+
+            // Richardson estimate of the error of the half steps
+            const Real errorFactor = 1.0/(std::pow(2.0, Real(order))-1.0);
+            const Time minStep = 1e-3*initialStep;
+
+            Array coarse(a.size()), fine(a.size());
+            Time t = from, dt = initialStep;
+            for (Size i=0; i < targets.size(); ++i) {
+                const Time target = targets[i];
+                while (t > target) {
+                    // avoid leaving a tiny step before the target
+                    const Time next =
+                        (t - target < 1.1*dt) ? target : t - dt;
+                    const Time mid = 0.5*(t + next);
+
+                    std::copy(a.begin(), a.end(), coarse.begin());
+                    evolver.setStep(t - next);
+                    evolver.step(coarse, t);
+                    condition.applyTo(coarse, next);
+
+                    std::copy(a.begin(), a.end(), fine.begin());
+                    evolver.setStep(t - mid);
+                    evolver.step(fine, t);
+                    condition.applyTo(fine, mid);
+                    evolver.setStep(mid - next);
+                    evolver.step(fine, mid);
+                    condition.applyTo(fine, next);
+
+                    Real error = 0.0, scale = 0.0;
+                    for (Size j=0; j < a.size(); ++j) {
+                        error = std::max(error,
+                                         std::fabs(fine[j] - coarse[j]));
+                        scale = std::max(scale, std::fabs(fine[j]));
+                    }
+                    error *= errorFactor/std::max(scale, QL_EPSILON);
+
+                    const Time h = t - next;
+                    if (error <= tolerance || dt <= minStep) {
+                        for (Size j=0; j < a.size(); ++j)
+                            a[j] = fine[j] + errorFactor*(fine[j]-coarse[j]);
+                        t = next;
+                    }
+
+                    const Real factor = (error > 0.0)
+                        ? 0.9*std::pow(tolerance/error, 1.0/(order+1.0))
+                        : 4.0;
+                    dt = std::max(minStep,
+                                  h*std::min(4.0, std::max(0.2, factor)));
+                }
+                // refine again after the stopping time
+                dt = std::min(dt, initialStep);
+            }
+        }
+
+    }
+
+    FdmSchemeDesc::FdmSchemeDesc(FdmSchemeType aType, Real aTheta, Real aMu,
+                                 Real aTolerance)
+    : type(aType), theta(aTheta), mu(aMu), tolerance(aTolerance) {
+        QL_REQUIRE(tolerance == Null<Real>() || tolerance > 0.0,
+                   "positive tolerance required");
+    }
+
+    FdmSchemeDesc FdmSchemeDesc::withTolerance(Real aTolerance) const {
+        return FdmSchemeDesc(type, theta, mu, aTolerance);
+    }
 
     FdmSchemeDesc FdmSchemeDesc::Douglas() { 
         return FdmSchemeDesc(FdmSchemeDesc::DouglasType, 0.5, 0.0);
@@ -86,6 +178,11 @@ namespace QuantLib {
                                      Time from, Time to,
                                      Size steps, Size dampingSteps) {
 
+        if (schemeDesc_.tolerance != Null<Real>()) {
+            adaptiveRollback(rhs, from, to, steps, dampingSteps);
+            return;
+        }
+
         const Time deltaT = from - to;
         const Size allSteps = steps + dampingSteps;
         const Time dampingTo = from - (deltaT*dampingSteps)/allSteps;
@@ -156,4 +253,94 @@ namespace QuantLib {
             QL_FAIL("Unknown scheme type");
         }
     }
+
+    void FdmBackwardSolver::adaptiveRollback(
+                                     FdmBackwardSolver::array_type& rhs,
+                                     Time from, Time to,
+                                     Size steps, Size dampingSteps) {
+
+        QL_REQUIRE(from > to,
+                   "trying to roll back from " << from << " to " << to);
+        QL_REQUIRE(steps > 0, "at least one time step required");
+
+        const Time initialStep = (from - to)/steps;
+        const Real tolerance = schemeDesc_.tolerance;
+        const FdmStepConditionComposite& condition = *condition_;
+
+        Time dampingTo = from;
+        if (   dampingSteps
+            && schemeDesc_.type != FdmSchemeDesc::ImplicitEulerType) {
+            // the damping steps are error-controlled as well, since
+            // the first-order implicit Euler steps of the initial size
+            // would otherwise dominate the error
+            dampingTo = std::max(to, from - dampingSteps*initialStep);
+            ImplicitEulerScheme implicitEvolver(map_, bcSet_);
+            errorControlledRollback(implicitEvolver, 1, rhs, from, dampingTo,
+                                    initialStep/dampingSteps, tolerance,
+                                    condition);
+            if (dampingTo == to)
+                return;
+        }
+
+        // the order of the schemes in time
+        const Size order = (   schemeDesc_.type
+                                    == FdmSchemeDesc::ImplicitEulerType
+                            || schemeDesc_.type
+                                    == FdmSchemeDesc::ExplicitEulerType
+                            || (   schemeDesc_.type
+                                        == FdmSchemeDesc::DouglasType
+                                && schemeDesc_.theta != 0.5)) ? 1 : 2;
+
+        switch (schemeDesc_.type) {
+          case FdmSchemeDesc::HundsdorferType:
+            {
+                HundsdorferScheme hsEvolver(schemeDesc_.theta, schemeDesc_.mu,
+                                            map_, bcSet_);
+                errorControlledRollback(hsEvolver, order, rhs, dampingTo, to,
+                                        initialStep, tolerance, condition);
+            }
+            break;
+          case FdmSchemeDesc::DouglasType:
+            {
+                DouglasScheme dsEvolver(schemeDesc_.theta, map_, bcSet_);
+                errorControlledRollback(dsEvolver, order, rhs, dampingTo, to,
+                                        initialStep, tolerance, condition);
+            }
+            break;
+          case FdmSchemeDesc::CraigSneydType:
+            {
+                CraigSneydScheme csEvolver(schemeDesc_.theta, schemeDesc_.mu,
+                                           map_, bcSet_);
+                errorControlledRollback(csEvolver, order, rhs, dampingTo, to,
+                                        initialStep, tolerance, condition);
+            }
+            break;
+          case FdmSchemeDesc::ModifiedCraigSneydType:
+            {
+                ModifiedCraigSneydScheme csEvolver(schemeDesc_.theta,
+                                                   schemeDesc_.mu,
+                                                   map_, bcSet_);
+                errorControlledRollback(csEvolver, order, rhs, dampingTo, to,
+                                        initialStep, tolerance, condition);
+            }
+            break;
+          case FdmSchemeDesc::ImplicitEulerType:
+            {
+                ImplicitEulerScheme implicitEvolver(map_, bcSet_);
+                errorControlledRollback(implicitEvolver, order, rhs, from, to,
+                                        initialStep, tolerance, condition);
+            }
+            break;
+          case FdmSchemeDesc::ExplicitEulerType:
+            {
+                ExplicitEulerScheme explicitEvolver(map_, bcSet_);
+                errorControlledRollback(explicitEvolver, order, rhs,
+                                        dampingTo, to, initialStep,
+                                        tolerance, condition);
+            }
+            break;
+          default:
+            QL_FAIL("Unknown scheme type");
+        }
+    }
 }
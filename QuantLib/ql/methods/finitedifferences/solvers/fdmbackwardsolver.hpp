@@ -25,6 +25,7 @@
 #ifndef quantlib_fdm_backward_solver_hpp
 #define quantlib_fdm_backward_solver_hpp
 
+#include <ql/utilities/null.hpp>
 #include <ql/methods/finitedifferences/utilities/fdmboundaryconditionset.hpp>
 
 namespace QuantLib {
@@ -37,10 +38,18 @@ namespace QuantLib {
                              CraigSneydType, ModifiedCraigSneydType, 
                              ImplicitEulerType, ExplicitEulerType };
 
-        FdmSchemeDesc(FdmSchemeType type, Real theta, Real mu);
+        /*! if a tolerance is given, the rollback uses error-controlled
+            time steps (see FdmBackwardSolver::rollback.)
+        */
+        FdmSchemeDesc(FdmSchemeType type, Real theta, Real mu,
+                      Real tolerance = Null<Real>());
 
         const FdmSchemeType type;
         const Real theta, mu;
+        const Real tolerance;
+
+        //! returns the same scheme using error-controlled time steps
+        FdmSchemeDesc withTolerance(Real tolerance) const;
 
         // some default scheme descriptions
         static FdmSchemeDesc Douglas();
@@ -62,11 +71,32 @@ namespace QuantLib {
           const boost::shared_ptr<FdmStepConditionComposite> condition,
           const FdmSchemeDesc& schemeDesc);
 
+        /*! rolls back the given array with the given number of
+            uniform steps, the first dampingSteps of which are taken
+            with the implicit Euler scheme.
+
+            If the scheme description has a tolerance, the time steps
+            are error-controlled instead: the error of each step is
+            estimated by comparing it with two steps of half its size,
+            and the step is shrunk or enlarged so that the estimated
+            error, relative to the largest absolute value on the grid,
+            stays below the tolerance.  The accepted value is the
+            Richardson extrapolation of the two.  In this mode, the
+            first step and the first step after each stopping time are
+            at most of size (from-to)/steps, so that the steps are
+            refined near maturity and near dividends or exercise dates.
+            The damping steps are replaced by error-controlled implicit
+            Euler steps over an interval of dampingSteps initial steps.
+        */
         void rollback(array_type& a, 
                       Time from, Time to,
                       Size steps, Size dampingSteps);
 
       protected:
+        void adaptiveRollback(array_type& a,
+                              Time from, Time to,
+                              Size steps, Size dampingSteps);
+
         const boost::shared_ptr<FdmLinearOpComposite> map_;
         const FdmBoundaryConditionSet bcSet_;
         const boost::shared_ptr<FdmStepConditionComposite> condition_;
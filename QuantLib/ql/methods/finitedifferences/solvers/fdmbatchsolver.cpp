@@ -0,0 +1,174 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2015 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmbatchsolver.cpp
+    \brief solver for a batch of payoffs sharing one mesher
+*/
+
+#include <ql/math/interpolations/cubicinterpolation.hpp>
+#include <ql/math/interpolations/bicubicsplineinterpolation.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmbatchsolver.hpp>
+#include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
+#include <ql/methods/finitedifferences/stepconditions/fdmsnapshotcondition.hpp>
+
+namespace QuantLib {
+
+    FdmBatchSolver::FdmBatchSolver(
+                             const FdmSolverDesc& solverDesc,
+                             const FdmSchemeDesc& schemeDesc,
+                             const boost::shared_ptr<FdmLinearOpComposite>& op)
+    : solverDesc_(solverDesc),
+      schemeDesc_(schemeDesc),
+      op_(op),
+      thetaCondition_(new FdmSnapshotCondition(
+        0.99*std::min(1.0/365.0,
+           solverDesc.condition->stoppingTimes().empty()
+                    ? solverDesc.maturity
+                    : solverDesc.condition->stoppingTimes().front()))),
+      conditions_(FdmStepConditionComposite::joinConditions(thetaCondition_,
+                                                         solverDesc.condition)),
+      initialValues_(solverDesc.mesher->layout()->size()) {
+
+        const boost::shared_ptr<FdmMesher> mesher = solverDesc.mesher;
+        const boost::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
+        const std::vector<Size>& dim = layout->dim();
+
+        QL_REQUIRE(dim.size() == 2 || dim.size() == 3,
+                   "batch solver needs one or two directions for the "
+                   "underlying and one for the batch, "
+                   << dim.size() << " directions given");
+
+        nBatch_ = dim.back();
+        nx_ = dim[0];
+        ny_ = (dim.size() == 3) ? dim[1] : 1;
+
+        x_.reserve(nx_);
+        y_.reserve(ny_);
+
+        const FdmLinearOpIterator endIter = layout->end();
+        for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
+             ++iter) {
+            initialValues_[iter.index()]
+                 = solverDesc_.calculator->avgInnerValue(iter,
+                                                         solverDesc.maturity);
+
+            const std::vector<Size>& c = iter.coordinates();
+            if (c.back() == 0) {
+                if (dim.size() == 2 || c[1] == 0)
+                    x_.push_back(mesher->location(iter, 0));
+                if (dim.size() == 3 && c[0] == 0)
+                    y_.push_back(mesher->location(iter, 1));
+            }
+        }
+
+        resultValues_ = std::vector<Matrix>(nBatch_, Matrix(ny_, nx_));
+    }
+
+    Size FdmBatchSolver::size() const {
+        return nBatch_;
+    }
+
+    void FdmBatchSolver::performCalculations() const {
+        Array rhs(initialValues_.size());
+        std::copy(initialValues_.begin(), initialValues_.end(), rhs.begin());
+
+        FdmBackwardSolver(op_, solverDesc_.bcSet, conditions_, schemeDesc_)
+            .rollback(rhs, solverDesc_.maturity, 0.0,
+                      solverDesc_.timeSteps, solverDesc_.dampingSteps);
+
+        // the batch direction is the slowest one; the values of
+        // each payoff are thus stored contiguously.
+        const Size n = nx_*ny_;
+        interpolations_.resize(nBatch_);
+        splines_.resize(nBatch_);
+        for (Size i=0; i < nBatch_; ++i) {
+            std::copy(rhs.begin() + i*n, rhs.begin() + (i+1)*n,
+                      resultValues_[i].begin());
+
+            if (y_.empty()) {
+                interpolations_[i] = boost::shared_ptr<CubicInterpolation>(
+                    new MonotonicCubicNaturalSpline(
+                                        x_.begin(), x_.end(),
+                                        resultValues_[i].begin()));
+            }
+            else {
+                splines_[i] = boost::shared_ptr<BicubicSpline>(
+                    new BicubicSpline(x_.begin(), x_.end(),
+                                      y_.begin(), y_.end(),
+                                      resultValues_[i]));
+            }
+        }
+    }
+
+    Real FdmBatchSolver::interpolate(const Matrix& values,
+                                     Real x, Real y) const {
+        if (y_.empty())
+            return MonotonicCubicNaturalSpline(
+                             x_.begin(), x_.end(), values.begin())(x);
+        else
+            return BicubicSpline(x_.begin(), x_.end(),
+                                 y_.begin(), y_.end(), values)(x, y);
+    }
+
+    Real FdmBatchSolver::interpolateAt(Size i, Real x, Real y) const {
+        QL_REQUIRE(i < nBatch_, "payoff " << i << " out of range");
+        calculate();
+        if (y_.empty())
+            return interpolations_[i]->operator()(x);
+        else
+            return splines_[i]->operator()(x, y);
+    }
+
+    Real FdmBatchSolver::thetaAt(Size i, Real x, Real y) const {
+        QL_REQUIRE(i < nBatch_, "payoff " << i << " out of range");
+        QL_REQUIRE(conditions_->stoppingTimes().front() > 0.0,
+                   "stopping time at zero-> can't calculate theta");
+
+        calculate();
+        const Size n = nx_*ny_;
+        const Array& rhs = thetaCondition_->getValues();
+        Matrix thetaValues(ny_, nx_);
+        std::copy(rhs.begin() + i*n, rhs.begin() + (i+1)*n,
+                  thetaValues.begin());
+
+        return (interpolate(thetaValues, x, y) - interpolateAt(i, x, y))
+              / thetaCondition_->getTime();
+    }
+
+    Real FdmBatchSolver::derivativeX(Size i, Real x, Real y) const {
+        QL_REQUIRE(i < nBatch_, "payoff " << i << " out of range");
+        calculate();
+        if (y_.empty())
+            return interpolations_[i]->derivative(x);
+        else
+            return splines_[i]->derivativeX(x, y);
+    }
+
+    Real FdmBatchSolver::derivativeXX(Size i, Real x, Real y) const {
+        QL_REQUIRE(i < nBatch_, "payoff " << i << " out of range");
+        calculate();
+        if (y_.empty())
+            return interpolations_[i]->secondDerivative(x);
+        else
+            return splines_[i]->secondDerivativeX(x, y);
+    }
+}
@@ -0,0 +1,89 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2015 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmbatchsolver.hpp
+    \brief solver for a batch of payoffs sharing one mesher
+*/
+
+#ifndef quantlib_fdm_batch_solver_hpp
+#define quantlib_fdm_batch_solver_hpp
+
+#include <ql/math/matrix.hpp>
+#include <ql/utilities/null.hpp>
+#include <ql/patterns/lazyobject.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmsolverdesc.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
+
+namespace QuantLib {
+
+    class BicubicSpline;
+    class CubicInterpolation;
+    class FdmSnapshotCondition;
+
+    //! solver for a batch of payoffs sharing one mesher
+    /*! The last direction of the mesher enumerates the payoffs of the
+        batch, usually by means of a Predefined1dMesher with locations
+        0, 1, ..., n-1; the remaining one or two directions hold the
+        state of the underlying.  The calculator and step conditions
+        of the solver description act on each payoff through its
+        coordinate in the batch direction (see FdmBatchInnerValue),
+        so that all payoffs are rolled back at once with the same
+        operator, which doesn't act along the batch direction.
+
+        The results are returned per payoff; the y argument is only
+        used for two-dimensional underlying states.
+    */
+    class FdmBatchSolver : public LazyObject {
+      public:
+        FdmBatchSolver(const FdmSolverDesc& solverDesc,
+                       const FdmSchemeDesc& schemeDesc,
+                       const boost::shared_ptr<FdmLinearOpComposite>& op);
+
+        //! number of payoffs in the batch
+        Size size() const;
+
+        Real interpolateAt(Size i, Real x, Real y = Null<Real>()) const;
+        Real thetaAt(Size i, Real x, Real y = Null<Real>()) const;
+
+        Real derivativeX(Size i, Real x, Real y = Null<Real>()) const;
+        Real derivativeXX(Size i, Real x, Real y = Null<Real>()) const;
+
+      protected:
+        void performCalculations() const;
+
+      private:
+        Real interpolate(const Matrix& values, Real x, Real y) const;
+
+        const FdmSolverDesc solverDesc_;
+        const FdmSchemeDesc schemeDesc_;
+        const boost::shared_ptr<FdmLinearOpComposite> op_;
+
+        const boost::shared_ptr<FdmSnapshotCondition> thetaCondition_;
+        const boost::shared_ptr<FdmStepConditionComposite> conditions_;
+
+        Size nBatch_, nx_, ny_;
+        std::vector<Real> x_, y_, initialValues_;
+        mutable std::vector<Matrix> resultValues_;
+        mutable std::vector<boost::shared_ptr<CubicInterpolation> >
+                                                              interpolations_;
+        mutable std::vector<boost::shared_ptr<BicubicSpline> > splines_;
+    };
+}
+
+#endif
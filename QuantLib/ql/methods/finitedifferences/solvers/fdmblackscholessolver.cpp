@@ -22,6 +22,7 @@
 #include <ql/processes/blackscholesprocess.hpp>
 #include <ql/methods/finitedifferences/solvers/fdm1dimsolver.hpp>
 #include <ql/methods/finitedifferences/operators/fdmblackscholesop.hpp>
+#include <ql/methods/finitedifferences/operators/fdmblackscholessensitivityop.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmblackscholessolver.hpp>
 
 namespace QuantLib {
@@ -32,14 +33,18 @@ namespace QuantLib {
         const FdmSolverDesc& solverDesc,
         const FdmSchemeDesc& schemeDesc,
         bool localVol,
-        Real illegalLocalVolOverwrite)
+        Real illegalLocalVolOverwrite,
+        bool calculateSensitivities)
     : process_(process),
       strike_(strike),
       solverDesc_(solverDesc),
       schemeDesc_(schemeDesc),
       localVol_(localVol),
-      illegalLocalVolOverwrite_(illegalLocalVolOverwrite) {
+      illegalLocalVolOverwrite_(illegalLocalVolOverwrite),
+      calculateSensitivities_(calculateSensitivities) {
 
+        QL_REQUIRE(!(localVol_ && calculateSensitivities_),
+                   "sensitivities are not available with local volatility");
         registerWith(process_);
     }
 
@@ -48,8 +53,29 @@ namespace QuantLib {
                 solverDesc_.mesher, process_.currentLink(), strike_,
                 localVol_, illegalLocalVolOverwrite_));
 
+        std::vector<boost::shared_ptr<FdmLinearOpComposite> > derivativeOps;
+        if (calculateSensitivities_) {
+            const boost::shared_ptr<GeneralizedBlackScholesProcess> process
+                = process_.currentLink();
+            derivativeOps.push_back(
+                boost::shared_ptr<FdmLinearOpComposite>(
+                    new FdmBlackScholesSensitivityOp(
+                        solverDesc_.mesher, process, strike_,
+                        FdmBlackScholesSensitivityOp::Volatility)));
+            derivativeOps.push_back(
+                boost::shared_ptr<FdmLinearOpComposite>(
+                    new FdmBlackScholesSensitivityOp(
+                        solverDesc_.mesher, process, strike_,
+                        FdmBlackScholesSensitivityOp::RiskFreeRate)));
+            derivativeOps.push_back(
+                boost::shared_ptr<FdmLinearOpComposite>(
+                    new FdmBlackScholesSensitivityOp(
+                        solverDesc_.mesher, process, strike_,
+                        FdmBlackScholesSensitivityOp::DividendYield)));
+        }
+
         solver_ = boost::shared_ptr<Fdm1DimSolver>(
-            new Fdm1DimSolver(solverDesc_, schemeDesc_, op));
+            new Fdm1DimSolver(solverDesc_, schemeDesc_, op, derivativeOps));
     }
 
     Real FdmBlackScholesSolver::valueAt(Real s) const {
@@ -71,4 +97,22 @@ namespace QuantLib {
     Real FdmBlackScholesSolver::thetaAt(Real s) const {
         return solver_->thetaAt(std::log(s));
     }
+
+    Real FdmBlackScholesSolver::vegaAt(Real s) const {
+        QL_REQUIRE(calculateSensitivities_, "sensitivities not requested");
+        calculate();
+        return solver_->sensitivityAt(0, std::log(s));
+    }
+
+    Real FdmBlackScholesSolver::rhoAt(Real s) const {
+        QL_REQUIRE(calculateSensitivities_, "sensitivities not requested");
+        calculate();
+        return solver_->sensitivityAt(1, std::log(s));
+    }
+
+    Real FdmBlackScholesSolver::dividendRhoAt(Real s) const {
+        QL_REQUIRE(calculateSensitivities_, "sensitivities not requested");
+        calculate();
+        return solver_->sensitivityAt(2, std::log(s));
+    }
 }
@@ -44,13 +44,27 @@ namespace QuantLib {
             const FdmSolverDesc& solverDesc,
             const FdmSchemeDesc& schemeDesc = FdmSchemeDesc::Douglas(),
             bool localVol = false,
-            Real illegalLocalVolOverwrite = -Null<Real>());
+            Real illegalLocalVolOverwrite = -Null<Real>(),
+            bool calculateSensitivities = false);
 
         Real valueAt(Real s) const;
         Real deltaAt(Real s) const;
         Real gammaAt(Real s) const;
         Real thetaAt(Real s) const;
 
+        /*! \name Parameter sensitivities
+            These are calculated in the same backward solve as the
+            value if requested on construction; local volatility is
+            not supported.  They are the derivatives with respect to
+            parallel shifts of the Black volatility, the risk-free
+            rate and the dividend yield, respectively.
+        */
+        //@{
+        Real vegaAt(Real s) const;
+        Real rhoAt(Real s) const;
+        Real dividendRhoAt(Real s) const;
+        //@}
+
       protected:
         void performCalculations() const;
 
@@ -61,6 +75,7 @@ namespace QuantLib {
         const FdmSchemeDesc schemeDesc_;
         const bool localVol_;
         const Real illegalLocalVolOverwrite_;
+        const bool calculateSensitivities_;
 
         mutable boost::shared_ptr<Fdm1DimSolver> solver_;
     };
@@ -25,19 +25,21 @@
 
 #include <ql/patterns/lazyobject.hpp>
 #include <ql/math/interpolations/multicubicspline.hpp>
-#include <ql/methods/finitedifferences/finitedifferencemodel.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmsolverdesc.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmsnapshotcondition.hpp>
 #include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmlocalinterpolation.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
 
-#include <numeric>
-
 namespace QuantLib {
 
+    /*! The results are kept on the grid only and interpolated locally
+        at the requested points (see FdmLocalInterpolation), so that
+        no multi-dimensional spline is built on the full grid.
+    */
     template <Size N>
     class FdmNdimSolver : public LazyObject {
       public:
@@ -51,7 +53,13 @@ namespace QuantLib {
         Real thetaAt(const std::vector<Real>& x) const;
 
         // template meta programming
+        /*! \deprecated the solver no longer uses MultiCubicSpline;
+                        kept for client code filling a data table.
+        */
         typedef typename MultiCubicSpline<N>::data_table data_table;
+        /*! \deprecated the solver no longer uses MultiCubicSpline;
+                        kept for client code filling a data table.
+        */
         void static setValue(data_table& f,
                              const std::vector<Size>& x, Real value);
 
@@ -63,12 +71,8 @@ namespace QuantLib {
         const boost::shared_ptr<FdmSnapshotCondition> thetaCondition_;
         const boost::shared_ptr<FdmStepConditionComposite> conditions_;
 
-        std::vector<std::vector<Real> > x_;
-        std::vector<Real> initialValues_;
-        const std::vector<bool> extrapolation_;
-
-        mutable boost::shared_ptr<data_table> f_;
-        mutable boost::shared_ptr<MultiCubicSpline<N> > interp_;
+        const FdmLocalInterpolation interpolation_;
+        mutable Array resultValues_;
     };
 
 
@@ -87,59 +91,32 @@ namespace QuantLib {
                   solverDesc.condition->stoppingTimes().front()))),
       conditions_(FdmStepConditionComposite::joinConditions(thetaCondition_,
                                                         solverDesc.condition)),
-      x_            (solverDesc.mesher->layout()->dim().size()),
-      initialValues_(solverDesc.mesher->layout()->size()),
-      extrapolation_(std::vector<bool>(N, false)) {
-
-        const boost::shared_ptr<FdmMesher> mesher = solverDesc.mesher;
-        const boost::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
-
-        QL_REQUIRE(layout->dim().size() == N, "solver dim " << N
-                    << "does not fit to layout dim " << layout->size());
+      interpolation_(solverDesc.mesher) {
 
-        for (Size i=0; i < N; ++i) {
-            x_[i].reserve(layout->dim()[i]);
-        }
-
-        const FdmLinearOpIterator endIter = layout->end();
-        for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
-             ++iter) {
-
-            initialValues_[iter.index()] = solverDesc_.calculator
-                                ->avgInnerValue(iter, solverDesc.maturity);
-
-            const std::vector<Size>& c = iter.coordinates();
-            for (Size i=0; i < N; ++i) {
-                if (!(std::accumulate(c.begin(), c.end(), 0)-c[i])) {
-                    x_[i].push_back(mesher->location(iter, i));
-                }
-            }
-        }
-
-        f_ = boost::shared_ptr<data_table>(new data_table(x_));
+        QL_REQUIRE(solverDesc.mesher->layout()->dim().size() == N,
+                   "solver dim " << N << "does not fit to layout dim "
+                   << solverDesc.mesher->layout()->dim().size());
     }
 
 
     template <Size N> inline
     void FdmNdimSolver<N>::performCalculations() const {
-        Array rhs(initialValues_.size());
-        std::copy(initialValues_.begin(), initialValues_.end(), rhs.begin());
-
-        FdmBackwardSolver(op_, solverDesc_.bcSet, conditions_, schemeDesc_)
-                 .rollback(rhs, solverDesc_.maturity, 0.0,
-                           solverDesc_.timeSteps, solverDesc_.dampingSteps);
-
         const boost::shared_ptr<FdmLinearOpLayout> layout
                                                = solverDesc_.mesher->layout();
 
+        Array rhs(layout->size());
         const FdmLinearOpIterator endIter = layout->end();
         for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
              ++iter) {
-            setValue(*f_, iter.coordinates(), rhs[iter.index()]);
+            rhs[iter.index()] = solverDesc_.calculator
+                                ->avgInnerValue(iter, solverDesc_.maturity);
         }
 
-        interp_ = boost::shared_ptr<MultiCubicSpline<N> >(
-            new MultiCubicSpline<N>(x_, *f_, extrapolation_));
+        FdmBackwardSolver(op_, solverDesc_.bcSet, conditions_, schemeDesc_)
+                 .rollback(rhs, solverDesc_.maturity, 0.0,
+                           solverDesc_.timeSteps, solverDesc_.dampingSteps);
+
+        resultValues_.swap(rhs);
     }
 
 
@@ -148,27 +125,17 @@ namespace QuantLib {
         QL_REQUIRE(conditions_->stoppingTimes().front() > 0.0,
                    "stopping time at zero-> can't calculate theta");
         calculate();
-        const Array& rhs = thetaCondition_->getValues();
-        const boost::shared_ptr<FdmLinearOpLayout> layout
-                                            = solverDesc_.mesher->layout();
-
-        data_table f(x_);
-
-        const FdmLinearOpIterator endIter = layout->end();
-        for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
-             ++iter) {
-            setValue(f, iter.coordinates(), rhs[iter.index()]);
-        }
 
-        return (MultiCubicSpline<N>(x_, f)(x)
-                        - interpolateAt(x)) / thetaCondition_->getTime();
+        return (interpolation_(thetaCondition_->getValues(), x)
+                - interpolation_(resultValues_, x))
+                / thetaCondition_->getTime();
     }
 
     template <Size N> inline
     Real FdmNdimSolver<N>::interpolateAt(const std::vector<Real>& x) const {
         calculate();
 
-        return (*interp_)(x);
+        return interpolation_(resultValues_, x);
     }
 
     template <Size N> inline
@@ -0,0 +1,73 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2015 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmtangentstepcondition.cpp
+    \brief tangent-linear version of a step condition
+*/
+
+#include <ql/methods/finitedifferences/stepconditions/fdmtangentstepcondition.hpp>
+
+namespace QuantLib {
+
+    FdmTangentStepCondition::FdmTangentStepCondition(
+        const boost::shared_ptr<StepCondition<Array> >& condition,
+        Size nSensitivities)
+    : condition_(condition), nSensitivities_(nSensitivities) {
+        QL_REQUIRE(condition_, "null step condition given");
+    }
+
+    void FdmTangentStepCondition::applyTo(Array& a, Time t) const {
+        const Size n = a.size()/(nSensitivities_+1);
+
+        Array v(a.begin(), a.begin()+n);
+        Real vMax = 1.0;
+        for (Size j=0; j < n; ++j)
+            vMax = std::max(vMax, std::fabs(v[j]));
+
+        std::vector<Array> bumped(nSensitivities_);
+        std::vector<Real> eps(nSensitivities_, 0.0);
+        for (Size i=0; i < nSensitivities_; ++i) {
+            const Array::const_iterator w = a.begin() + (i+1)*n;
+
+            Real wMax = 0.0;
+            for (Size j=0; j < n; ++j)
+                wMax = std::max(wMax, std::fabs(w[j]));
+
+            // a vanishing sensitivity is mapped to zero
+            if (wMax > 0.0) {
+                eps[i] = std::sqrt(QL_EPSILON)*vMax/wMax;
+                bumped[i] = Array(n);
+                for (Size j=0; j < n; ++j)
+                    bumped[i][j] = v[j] + eps[i]*w[j];
+                condition_->applyTo(bumped[i], t);
+            }
+        }
+
+        condition_->applyTo(v, t);
+
+        std::copy(v.begin(), v.end(), a.begin());
+        for (Size i=0; i < nSensitivities_; ++i) {
+            if (eps[i] > 0.0) {
+                const Array::iterator w = a.begin() + (i+1)*n;
+                for (Size j=0; j < n; ++j)
+                    w[j] = (bumped[i][j] - v[j])/eps[i];
+            }
+        }
+    }
+}
@@ -0,0 +1,59 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2015 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdmtangentstepcondition.hpp
+    \brief tangent-linear version of a step condition
+*/
+
+#ifndef quantlib_fdm_tangent_step_condition_hpp
+#define quantlib_fdm_tangent_step_condition_hpp
+
+#include <ql/methods/finitedifferences/stepcondition.hpp>
+
+namespace QuantLib {
+
+    //! tangent-linear version of a step condition
+    /*! The given condition is applied to the value block of arrays
+        laid out as for FdmTangentLinearOp.  The sensitivity blocks
+        are mapped by the directional derivative of the condition,
+        obtained by applying it to the value bumped along each of
+        them.  This is exact, up to round-off and to the points at
+        which the early-exercise condition switches, for the
+        piecewise-linear conditions used for exercise and dividends.
+
+        The condition is applied to the unbumped value last, so that
+        snapshot conditions keep the value and not a bumped one.
+
+        \ingroup findiff
+    */
+    class FdmTangentStepCondition : public StepCondition<Array> {
+      public:
+        FdmTangentStepCondition(
+            const boost::shared_ptr<StepCondition<Array> >& condition,
+            Size nSensitivities);
+
+        void applyTo(Array& a, Time t) const;
+
+      private:
+        const boost::shared_ptr<StepCondition<Array> > condition_;
+        const Size nSensitivities_;
+    };
+}
+
+#endif
@@ -60,12 +60,24 @@ namespace QuantLib {
     }
 
     Disposable<Array> TridiagonalOperator::applyTo(const Array& v) const {
+        Array result(v.size());
+        applyTo(v, result);
+        return result;
+    }
+
+    void TridiagonalOperator::applyTo(const Array& v,
+                                      Array& result) const {
         QL_REQUIRE(n_!=0,
                    "uninitialized TridiagonalOperator");
         QL_REQUIRE(v.size()==n_,
                    "vector of the wrong size " << v.size() <<
                    " instead of " << n_);
-        Array result(n_);
+        QL_REQUIRE(result.size()==n_,
+                   "result vector of size " << result.size() <<
+                   " instead of " << n_);
+        QL_REQUIRE(&v != &result,
+                   "result vector cannot be the same as the input one");
+
         std::transform(diagonal_.begin(), diagonal_.end(),
                        v.begin(),
                        result.begin(),
@@ -77,8 +89,6 @@ namespace QuantLib {
             result[j] += lowerDiagonal_[j-1]*v[j-1]+
                 upperDiagonal_[j]*v[j+1];
         result[n_-1] += lowerDiagonal_[n_-2]*v[n_-2];
-
-        return result;
     }
 
     Disposable<Array> TridiagonalOperator::solveFor(const Array& rhs) const  {
@@ -83,25 +83,29 @@ namespace QuantLib {
                 }
             }
             else {
+                // interpolate along every line in the equity direction,
+                // i.e., starting from every point with a zero equity
+                // coordinate.
                 Array tmp(x_.size());
-                Size xSpacing = mesher_->layout()->spacing()[equityDirection_];
-                
-                for (Size i=0; i<mesher_->layout()->dim().size(); ++i) {
-                    if (i!=equityDirection_) {
-                        Size ySpacing = mesher_->layout()->spacing()[i];
-                        for (Size j=0; j<mesher_->layout()->dim()[i]; ++j) {
-                            for (Size k=0; k<x_.size(); ++k) {
-                                Size index = j*ySpacing + k*xSpacing;
-                                tmp[k] = aCopy[index];
-                            }
-                            LinearInterpolation interp(x_.begin(), x_.end(),
-                                                       tmp.begin());
-                            for (Size k=0; k<x_.size(); ++k) {
-                                Size index = j*ySpacing + k*xSpacing;
-                                a[index] = interp(
-                                        std::max(x_[0], x_[k]-dividend), true);
-                            }
-                        }
+                const boost::shared_ptr<FdmLinearOpLayout> layout
+                                                        = mesher_->layout();
+                const Size xSpacing = layout->spacing()[equityDirection_];
+
+                const FdmLinearOpIterator endIter = layout->end();
+                for (FdmLinearOpIterator iter = layout->begin();
+                     iter != endIter; ++iter) {
+                    if (iter.coordinates()[equityDirection_] != 0)
+                        continue;
+
+                    const Size base = iter.index();
+                    for (Size k=0; k<x_.size(); ++k) {
+                        tmp[k] = aCopy[base + k*xSpacing];
+                    }
+                    LinearInterpolation interp(x_.begin(), x_.end(),
+                                               tmp.begin());
+                    for (Size k=0; k<x_.size(); ++k) {
+                        a[base + k*xSpacing] = interp(
+                                std::max(x_[0], x_[k]-dividend), true);
                     }
                 }
             }
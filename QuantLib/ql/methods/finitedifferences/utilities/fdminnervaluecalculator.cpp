@@ -123,4 +123,25 @@ namespace QuantLib {
                                     const FdmLinearOpIterator& iter, Time t) {
         return innerValue(iter, t);
     }
+
+    FdmBatchInnerValue::FdmBatchInnerValue(
+        const std::vector<boost::shared_ptr<FdmInnerValueCalculator> >&
+                                                                  calculators,
+        Size direction)
+    : calculators_(calculators),
+      direction_(direction) {
+        QL_REQUIRE(!calculators_.empty(), "no inner value calculators given");
+    }
+
+    Real FdmBatchInnerValue::innerValue(
+                                    const FdmLinearOpIterator& iter, Time t) {
+        return calculators_[iter.coordinates()[direction_]]
+                                                    ->innerValue(iter, t);
+    }
+
+    Real FdmBatchInnerValue::avgInnerValue(
+                                    const FdmLinearOpIterator& iter, Time t) {
+        return calculators_[iter.coordinates()[direction_]]
+                                                    ->avgInnerValue(iter, t);
+    }
 }
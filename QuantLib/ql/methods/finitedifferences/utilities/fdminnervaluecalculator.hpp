@@ -78,6 +78,28 @@ namespace QuantLib {
         const boost::shared_ptr<FdmMesher> mesher_;
     };
 
+    //! inner values of a batch of payoffs priced on one mesher
+    /*! The given direction of the mesher enumerates the payoffs of
+        the batch; the inner value at each point is delegated to the
+        calculator of the payoff addressed by its coordinate in that
+        direction.
+    */
+    class FdmBatchInnerValue : public FdmInnerValueCalculator {
+      public:
+        FdmBatchInnerValue(
+            const std::vector<boost::shared_ptr<FdmInnerValueCalculator> >&
+                                                                 calculators,
+            Size direction);
+
+        Real innerValue(const FdmLinearOpIterator& iter, Time t);
+        Real avgInnerValue(const FdmLinearOpIterator& iter, Time t);
+
+      private:
+        const std::vector<boost::shared_ptr<FdmInnerValueCalculator> >
+                                                                  calculators_;
+        const Size direction_;
+    };
+
     class FdmZeroInnerValue : public FdmInnerValueCalculator {
       public:
         Real innerValue(const FdmLinearOpIterator&, Time)    { return 0.0; }
@@ -0,0 +1,160 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2015 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+/*! \file fdmlocalinterpolation.cpp
+    \brief local tensor-product interpolation of values on a mesher
+*/
+
+#include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmlocalinterpolation.hpp>
+#include <algorithm>
+
+namespace QuantLib {
+
+    FdmLocalInterpolation::FdmLocalInterpolation(
+                                const boost::shared_ptr<FdmMesher>& mesher)
+    : locations_(mesher->layout()->dim().size()),
+      spacing_(mesher->layout()->spacing()) {
+
+        const boost::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
+        const std::vector<Size>& dim = layout->dim();
+
+        for (Size i=0; i < dim.size(); ++i)
+            locations_[i].reserve(dim[i]);
+
+        const FdmLinearOpIterator endIter = layout->end();
+        for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
+             ++iter) {
+            const std::vector<Size>& c = iter.coordinates();
+            for (Size i=0; i < dim.size(); ++i) {
+                bool onAxis = true;
+                for (Size j=0; j < dim.size() && onAxis; ++j)
+                    onAxis = (j == i || c[j] == 0);
+                if (onAxis)
+                    locations_[i].push_back(mesher->location(iter, i));
+            }
+        }
+    }
+
+    const std::vector<Real>& FdmLocalInterpolation::locations(
+                                                     Size direction) const {
+        return locations_.at(direction);
+    }
+
+    void FdmLocalInterpolation::calculateWeights(Size direction, Real x,
+                                                 Size& start, Size& size,
+                                                 Real* w) const {
+        const std::vector<Real>& g = locations_[direction];
+        const Size n = g.size();
+
+        const Real eps = 1e-10*std::max(1.0, g.back()-g.front());
+        QL_REQUIRE(x >= g.front()-eps && x <= g.back()+eps,
+                   "point " << x << " is outside the grid ["
+                   << g.front() << ", " << g.back()
+                   << "] in direction " << direction);
+
+        if (n == 1) {
+            start = 0;
+            size = 1;
+            w[0] = 1.0;
+            return;
+        }
+
+        const Size i = std::min<Size>(
+            std::max<Size>(std::upper_bound(g.begin(), g.end(), x)
+                           - g.begin(), 1), n-1) - 1;
+
+        // the slope at node j is the derivative at x_j of the
+        // polynomial interpolating the (up to) five nodes around it
+        const Size m = std::min<Size>(5, n);
+        start = std::min(std::max(i, Size(2))-2, n-m);
+        const Size end = std::min(std::max(i+1, Size(2))-2, n-m) + m-1;
+
+        size = end - start + 1;
+        std::fill(w, w+6, 0.0);
+
+        const Real h = g[i+1] - g[i];
+        const Real t = (x - g[i])/h;
+
+        // cubic Hermite basis on [x_i, x_{i+1}]
+        w[i-start]   += (1.0 + 2.0*t)*(1.0 - t)*(1.0 - t);
+        w[i+1-start] += t*t*(3.0 - 2.0*t);
+
+        for (Size k=0; k < 2; ++k) {
+            const Size j = i + k;
+            const Real f = (k == 0) ? t*(1.0 - t)*(1.0 - t)*h
+                                    : t*t*(t - 1.0)*h;
+            const Size s = std::min(std::max(j, Size(2))-2, n-m);
+
+            for (Size l=s; l < s+m; ++l) {
+                Real d;
+                if (l == j) {
+                    d = 0.0;
+                    for (Size q=s; q < s+m; ++q)
+                        if (q != j)
+                            d += 1.0/(g[j] - g[q]);
+                }
+                else {
+                    d = 1.0/(g[l] - g[j]);
+                    for (Size q=s; q < s+m; ++q)
+                        if (q != j && q != l)
+                            d *= (g[j] - g[q])/(g[l] - g[q]);
+                }
+                w[l-start] += f*d;
+            }
+        }
+    }
+
+    Real FdmLocalInterpolation::operator()(
+                const Array& values, const std::vector<Real>& x) const {
+
+        const Size d = locations_.size();
+        QL_REQUIRE(x.size() == d, "point has " << x.size()
+                   << " coordinates, " << d << " required");
+
+        // per-direction stencil start, size and weights
+        std::vector<Size> start(d), size(d), index(d, 0);
+        std::vector<Real> weights(6*d);
+        for (Size i=0; i < d; ++i)
+            calculateWeights(i, x[i], start[i], size[i], &weights[6*i]);
+
+        // odometer over the tensor-product stencil
+        Real retVal = 0.0;
+        for (;;) {
+            Real w = 1.0;
+            Size offset = 0;
+            for (Size i=0; i < d; ++i) {
+                w *= weights[6*i + index[i]];
+                offset += (start[i] + index[i])*spacing_[i];
+            }
+            retVal += w*values[offset];
+
+            Size i = 0;
+            while (i < d && ++index[i] == size[i])
+                index[i++] = 0;
+            if (i == d)
+                break;
+        }
+
+        return retVal;
+    }
+
+}
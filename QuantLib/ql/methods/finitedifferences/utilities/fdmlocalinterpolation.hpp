@@ -0,0 +1,78 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2015 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+/*! \file fdmlocalinterpolation.hpp
+    \brief local tensor-product interpolation of values on a mesher
+*/
+
+#ifndef quantlib_fdm_local_interpolation_hpp
+#define quantlib_fdm_local_interpolation_hpp
+
+#include <ql/math/array.hpp>
+#include <boost/shared_ptr.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    class FdmMesher;
+
+    //! local tensor-product interpolation of values on a mesher
+    /*! Along each direction the values are interpolated by piecewise
+        cubic Hermite polynomials whose slopes are given by five-point
+        finite differences on the (possibly non-uniform) grid; the
+        tensor product of these is continuously differentiable.  Only
+        the values of the 6^N grid points surrounding the requested
+        point enter the result, so that no global spline needs to be
+        built on the full grid.  The stencil weights are calculated
+        for each call and not stored, so that the interpolation can
+        be used concurrently from several threads.
+
+        \ingroup findiff
+
+        \test tensor products of cubic polynomials are checked to be
+              reproduced exactly on non-uniform three-dimensional grids.
+    */
+    class FdmLocalInterpolation {
+      public:
+        explicit FdmLocalInterpolation(
+                                const boost::shared_ptr<FdmMesher>& mesher);
+
+        /*! interpolates the given values, laid out as by the layout
+            of the mesher, at the point x.  The point must lie within
+            the grid.
+        */
+        Real operator()(const Array& values,
+                        const std::vector<Real>& x) const;
+
+        const std::vector<Real>& locations(Size direction) const;
+
+      private:
+        // sets the start, size and (up to six) weights of the
+        // stencil along the given direction
+        void calculateWeights(Size direction, Real x,
+                              Size& start, Size& size, Real* w) const;
+
+        std::vector<std::vector<Real> > locations_;
+        std::vector<Size> spacing_;
+    };
+
+}
+
+#endif
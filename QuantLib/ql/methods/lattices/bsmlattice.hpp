@@ -84,8 +84,12 @@ namespace QuantLib {
     template <class T>
     void BlackScholesLattice<T>::stepback(Size i, const Array& values,
                                           Array& newValues) const {
-        for (Size j=0; j<size(i); j++)
-            newValues[j] = (pd_*values[j] + pu_*values[j+1])*discount_;
+        // the probabilities are the same for all nodes
+        const Real* v = values.begin();
+        Real* result = newValues.begin();
+        const Size n = size(i);
+        for (Size j=0; j<n; j++)
+            result[j] = (pd_*v[j] + pu_*v[j+1])*discount_;
     }
 
 }
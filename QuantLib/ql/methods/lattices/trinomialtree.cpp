@@ -72,5 +72,29 @@ namespace QuantLib {
         }
     }
 
-}
+    void TrinomialTree::Branching::expectation(const Array& values,
+                                               Array& newValues) const {
+        const Size n = k_.size();
+        QL_REQUIRE(values.size() == size(),
+                   "wrong number of values (" << values.size()
+                   << "), " << size() << " required");
+        QL_REQUIRE(newValues.size() == n,
+                   "wrong size of result (" << newValues.size()
+                   << "), " << n << " required");
+
+        // the probabilities of each branch are stored contiguously
+        const Real* p1 = &probs_[0][0];
+        const Real* p2 = &probs_[1][0];
+        const Real* p3 = &probs_[2][0];
+        const Integer* k = &k_[0];
+        const Real* v = values.begin();
+        Real* result = newValues.begin();
+
+        for (Size j=0; j<n; j++) {
+            // middle descendant
+            const Real* d = v + (k[j] - jMin_);
+            result[j] = p1[j]*d[-1] + p2[j]*d[0] + p3[j]*d[1];
+        }
+    }
 
+}
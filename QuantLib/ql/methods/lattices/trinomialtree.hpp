@@ -27,6 +27,7 @@
 
 #include <ql/methods/lattices/tree.hpp>
 #include <ql/timegrid.hpp>
+#include <ql/math/array.hpp>
 
 namespace QuantLib {
     class StochasticProcess1D;
@@ -52,6 +53,15 @@ namespace QuantLib {
         Real underlying(Size i, Size index) const;
         Size descendant(Size i, Size index, Size branch) const;
         Real probability(Size i, Size index, Size branch) const;
+        /*! stores in newValues the expectations, at the nodes of the
+            i-th level, of the given values at level i+1; no
+            discounting is applied.  This gives the same results as
+            summing the values at the descendants weighted by their
+            probabilities, but works on the branching data directly.
+        */
+        void expectation(Size i,
+                         const Array& values,
+                         Array& newValues) const;
 
       protected:
         std::vector<Branching> branchings_;
@@ -72,6 +82,7 @@ namespace QuantLib {
             Integer jMin() const;
             Integer jMax() const;
             void add(Integer k, Real p1, Real p2, Real p3);
+            void expectation(const Array& values, Array& newValues) const;
           private:
             std::vector<Integer> k_;
             std::vector<std::vector<Real> > probs_;
@@ -102,6 +113,12 @@ namespace QuantLib {
         return branchings_[i].probability(j, b);
     }
 
+    inline void TrinomialTree::expectation(Size i,
+                                           const Array& values,
+                                           Array& newValues) const {
+        branchings_[i].expectation(values, newValues);
+    }
+
     inline TrinomialTree::Branching::Branching()
     : probs_(3), kMin_(QL_MAX_INTEGER), jMin_(QL_MAX_INTEGER),
                  kMax_(QL_MIN_INTEGER), jMax_(QL_MIN_INTEGER) {}
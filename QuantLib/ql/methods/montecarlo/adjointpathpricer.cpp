@@ -0,0 +1,66 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2015 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/methods/montecarlo/adjointpathpricer.hpp>
+
+namespace QuantLib {
+
+    BlackScholesPathAdjoint::BlackScholesPathAdjoint(
+              const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+              const TimeGrid& timeGrid)
+    : dt_(timeGrid.size()-1), sigma_(timeGrid.size()-1),
+      driftDt_(timeGrid.size()-1) {
+        QL_REQUIRE(process, "null process given");
+        Real x0 = process->x0();
+        for (Size i=0; i<dt_.size(); ++i) {
+            Time t = timeGrid[i];
+            dt_[i] = timeGrid.dt(i);
+            sigma_[i] = process->diffusion(t, x0);
+            QL_REQUIRE(sigma_[i] > 0.0,
+                       "null volatility at t = " << t
+                       << " not allowed for pathwise greeks");
+            driftDt_[i] = process->drift(t, x0)*dt_[i];
+        }
+    }
+
+    void BlackScholesPathAdjoint::sweep(const Path& path,
+                                        const Path& adjoint,
+                                        Real& delta,
+                                        Real& vega) const {
+        Size n = path.length();
+        QL_REQUIRE(n == dt_.size()+1,
+                   "path length (" << n << ") does not match "
+                   "the time grid (" << dt_.size()+1 << " points)");
+
+        // Each node is proportional to the initial value, while its
+        // logarithm depends on the volatility through the
+        // increments of all previous steps; the adjoints are thus
+        // accumulated backwards from the last node.
+        Real sum = 0.0;
+        vega = 0.0;
+        for (Size i=n-1; i>0; --i) {
+            sum += adjoint[i]*path[i];
+            Real sigmaSqrtDtW =
+                std::log(path[i]/path[i-1]) - driftDt_[i-1];
+            vega += sum * (sigmaSqrtDtW/sigma_[i-1] - sigma_[i-1]*dt_[i-1]);
+        }
+        delta = adjoint.front() + sum/path.front();
+    }
+
+}
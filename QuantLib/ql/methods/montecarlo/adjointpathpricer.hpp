@@ -0,0 +1,163 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2015 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file adjointpathpricer.hpp
+    \brief path pricers returning pathwise adjoints
+*/
+
+#ifndef quantlib_montecarlo_adjoint_path_pricer_hpp
+#define quantlib_montecarlo_adjoint_path_pricer_hpp
+
+#include <ql/methods/montecarlo/pathpricer.hpp>
+#include <ql/methods/montecarlo/multipath.hpp>
+#include <ql/math/statistics/sequencestatistics.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+#include <boost/shared_ptr.hpp>
+
+namespace QuantLib {
+
+    //! base class for path pricers providing pathwise adjoints
+    /*! Besides the value of the option on the given path, derived
+        classes return the derivatives of such value with respect to
+        each node of the path.  All nodes of the adjoint path must
+        be written, including those the value does not depend upon.
+
+        \ingroup mcarlo
+    */
+    template <class PathType>
+    class AdjointPathPricer : public PathPricer<PathType> {
+      public:
+        using PathPricer<PathType>::operator();
+        virtual Real operator()(const PathType& path,
+                                PathType& adjoint) const = 0;
+    };
+
+
+    //! reverse sweep of path adjoints along a Black-Scholes path
+    /*! Given a path generated by a Black-Scholes process and the
+        adjoints of the path value with respect to its nodes, the
+        sweep returns the derivatives of the value with respect to
+        the initial value of the underlying and to a parallel shift
+        of the volatility.  The path itself is used as the tape: the
+        Gaussian increments are recovered from consecutive nodes, so
+        that no information needs to be stored while pricing.
+
+        \warning the results are exact when the volatility does not
+                 depend on the underlying value and the process uses
+                 the default Euler discretization.
+
+        \ingroup mcarlo
+    */
+    class BlackScholesPathAdjoint {
+      public:
+        BlackScholesPathAdjoint(
+              const boost::shared_ptr<GeneralizedBlackScholesProcess>&,
+              const TimeGrid& timeGrid);
+        void sweep(const Path& path,
+                   const Path& adjoint,
+                   Real& delta,
+                   Real& vega) const;
+      private:
+        std::vector<Real> dt_, sigma_, driftDt_;
+    };
+
+
+    namespace detail {
+
+        inline Size assetNumber(const Path&) { return 1; }
+        inline Size assetNumber(const MultiPath& path) {
+            return path.assetNumber();
+        }
+
+        inline const Path& assetPath(const Path& path, Size) {
+            return path;
+        }
+        inline const Path& assetPath(const MultiPath& path, Size j) {
+            return path[j];
+        }
+
+    }
+
+
+    //! path pricer collecting pathwise delta and vega
+    /*! This pricer forwards the calculation of the path value to an
+        adjoint path pricer and, on the same path, sweeps the
+        returned adjoints back to the initial values and the
+        volatilities of the underlyings.  The resulting greeks are
+        accumulated as a side effect, so that they are available at
+        the end of the simulation at a small fraction of the cost of
+        a bump-and-revalue calculation.
+
+        The greeks are stored as the deltas of all underlyings
+        followed by their vegas.
+
+        \ingroup mcarlo
+    */
+    template <class PathType>
+    class PathwiseGreeksPathPricer : public PathPricer<PathType> {
+      public:
+        PathwiseGreeksPathPricer(
+                const boost::shared_ptr<AdjointPathPricer<PathType> >& pricer,
+                const std::vector<BlackScholesPathAdjoint>& adjoints)
+        : pricer_(pricer), adjoints_(adjoints),
+          sample_(2*adjoints.size()) {
+            QL_REQUIRE(!adjoints_.empty(), "no path adjoints given");
+        }
+        Real operator()(const PathType& path) const;
+        //! accumulated pathwise deltas and vegas
+        const SequenceStatistics& greeks() const { return greeks_; }
+      private:
+        boost::shared_ptr<AdjointPathPricer<PathType> > pricer_;
+        std::vector<BlackScholesPathAdjoint> adjoints_;
+        mutable boost::shared_ptr<PathType> adjoint_;
+        mutable std::vector<Real> sample_;
+        mutable SequenceStatistics greeks_;
+    };
+
+
+    // inline definitions
+
+    template <class PathType>
+    inline Real PathwiseGreeksPathPricer<PathType>::operator()(
+                                                const PathType& path) const {
+        if (!adjoint_) {
+            QL_REQUIRE(detail::assetNumber(path) == adjoints_.size(),
+                       "mismatch between number of assets ("
+                       << detail::assetNumber(path)
+                       << ") and path adjoints ("
+                       << adjoints_.size() << ")");
+            adjoint_ = boost::shared_ptr<PathType>(new PathType(path));
+        }
+
+        Real value = (*pricer_)(path, *adjoint_);
+
+        Size n = adjoints_.size();
+        for (Size j=0; j<n; ++j)
+            adjoints_[j].sweep(detail::assetPath(path, j),
+                               detail::assetPath(*adjoint_, j),
+                               sample_[j], sample_[n+j]);
+        greeks_.add(sample_);
+
+        return value;
+    }
+
+}
+
+
+#endif
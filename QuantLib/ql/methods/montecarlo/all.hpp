@@ -1,7 +1,11 @@
 /* This file is automatically generated; do not edit.     */
 /* Add the files to be included into Makefile.am instead. */
 
+#include <ql/methods/montecarlo/adjointpathpricer.hpp>
+#include <ql/methods/montecarlo/basicpath.hpp>
+#include <ql/methods/montecarlo/blackscholespathgenerator.hpp>
 #include <ql/methods/montecarlo/brownianbridge.hpp>
+#include <ql/methods/montecarlo/coupledpathgenerator.hpp>
 #include <ql/methods/montecarlo/earlyexercisepathpricer.hpp>
 #include <ql/methods/montecarlo/exercisestrategy.hpp>
 #include <ql/methods/montecarlo/genericlsregression.hpp>
@@ -9,6 +13,7 @@
 #include <ql/methods/montecarlo/lsmbasissystem.hpp>
 #include <ql/methods/montecarlo/mctraits.hpp>
 #include <ql/methods/montecarlo/montecarlomodel.hpp>
+#include <ql/methods/montecarlo/multilevelmontecarlomodel.hpp>
 #include <ql/methods/montecarlo/multipath.hpp>
 #include <ql/methods/montecarlo/multipathgenerator.hpp>
 #include <ql/methods/montecarlo/nodedata.hpp>
@@ -17,4 +22,5 @@
 #include <ql/methods/montecarlo/pathgenerator.hpp>
 #include <ql/methods/montecarlo/pathpricer.hpp>
 #include <ql/methods/montecarlo/sample.hpp>
+#include <ql/methods/montecarlo/sequencecache.hpp>
 
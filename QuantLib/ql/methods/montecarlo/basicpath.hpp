@@ -0,0 +1,103 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2015 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file basicpath.hpp
+    \brief single-factor random walk with configurable precision
+*/
+
+#ifndef quantlib_montecarlo_basic_path_hpp
+#define quantlib_montecarlo_basic_path_hpp
+
+#include <ql/timegrid.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! single-factor random walk storing values of type T
+    /*! This class has the same interface as Path, but stores its
+        values in a vector of the given type.  Using \c float halves
+        the memory used by each path and lets the compiler process
+        twice as many nodes per vector instruction; it is meant for
+        simulations whose statistical error is much larger than
+        single-precision rounding.
+
+        \ingroup mcarlo
+
+        \note the path includes the initial asset value as its first point.
+    */
+    template <class T>
+    class BasicPath {
+      public:
+        typedef T value_type;
+        BasicPath(const TimeGrid& timeGrid,
+                  const std::vector<T>& values = std::vector<T>());
+        //! \name inspectors
+        //@{
+        bool empty() const { return timeGrid_.empty(); }
+        Size length() const { return timeGrid_.size(); }
+        //! asset value at the \f$ i \f$-th point
+        T operator[](Size i) const { return values_[i]; }
+        T at(Size i) const { return values_.at(i); }
+        T& operator[](Size i) { return values_[i]; }
+        T& at(Size i) { return values_.at(i); }
+        T value(Size i) const { return values_[i]; }
+        T& value(Size i) { return values_[i]; }
+        //! time at the \f$ i \f$-th point
+        Time time(Size i) const { return timeGrid_[i]; }
+        //! initial asset value
+        T front() const { return values_.front(); }
+        T& front() { return values_.front(); }
+        //! final asset value
+        T back() const { return values_.back(); }
+        T& back() { return values_.back(); }
+        //! time grid
+        const TimeGrid& timeGrid() const { return timeGrid_; }
+        //@}
+        //! \name iterators
+        //@{
+        typedef typename std::vector<T>::const_iterator iterator;
+        typedef typename std::vector<T>::const_reverse_iterator
+                                                            reverse_iterator;
+        iterator begin() const { return values_.begin(); }
+        iterator end() const { return values_.end(); }
+        reverse_iterator rbegin() const { return values_.rbegin(); }
+        reverse_iterator rend() const { return values_.rend(); }
+        //@}
+      private:
+        TimeGrid timeGrid_;
+        std::vector<T> values_;
+    };
+
+
+    // inline definitions
+
+    template <class T>
+    inline BasicPath<T>::BasicPath(const TimeGrid& timeGrid,
+                                   const std::vector<T>& values)
+    : timeGrid_(timeGrid), values_(values) {
+        if (values_.empty())
+            values_ = std::vector<T>(timeGrid_.size());
+        QL_REQUIRE(values_.size() == timeGrid_.size(),
+                   "different number of times and asset values");
+    }
+
+}
+
+
+#endif
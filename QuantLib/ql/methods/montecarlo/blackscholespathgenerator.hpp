@@ -0,0 +1,182 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2015 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file blackscholespathgenerator.hpp
+    \brief Generates Black-Scholes paths with configurable precision
+*/
+
+#ifndef quantlib_montecarlo_black_scholes_path_generator_hpp
+#define quantlib_montecarlo_black_scholes_path_generator_hpp
+
+#include <ql/methods/montecarlo/basicpath.hpp>
+#include <ql/methods/montecarlo/brownianbridge.hpp>
+#include <ql/methods/montecarlo/sequencecache.hpp>
+#include <ql/methods/montecarlo/sample.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+
+namespace QuantLib {
+
+    //! Generates Black-Scholes paths using a sequence generator
+    /*! The drift and standard deviation of the logarithm of the
+        underlying are calculated once for each step of the time
+        grid; paths are then built with arithmetic in type T.
+        Random sequences are converted to T as they're drawn, and
+        the Brownian bridge, if used, writes its output in the same
+        type.
+
+        If a sequence cache is passed, the random sequences are
+        taken from it instead of the generator.
+
+        \warning the drift and diffusion of the process are
+                 evaluated at its initial value; the paths are the
+                 same as those of PathGenerator (up to rounding) when
+                 the volatility doesn't depend on the underlying
+                 value and the process uses the default Euler
+                 discretization.
+
+        \ingroup mcarlo
+    */
+    template <class GSG, class T = float>
+    class BlackScholesPathGenerator {
+      public:
+        typedef Sample<BasicPath<T> > sample_type;
+        BlackScholesPathGenerator(
+                          const boost::shared_ptr<StochasticProcess>& process,
+                          const TimeGrid& timeGrid,
+                          const GSG& generator,
+                          bool brownianBridge,
+                          const boost::shared_ptr<SequenceCache<GSG> >& cache
+                                 = boost::shared_ptr<SequenceCache<GSG> >());
+        //! \name inspectors
+        //@{
+        const sample_type& next() const;
+        const sample_type& antithetic() const;
+        Size size() const { return dimension_; }
+        const TimeGrid& timeGrid() const { return timeGrid_; }
+        //@}
+      private:
+        const sample_type& next(bool antithetic) const;
+        bool brownianBridge_;
+        GSG generator_;
+        boost::shared_ptr<SequenceCache<GSG> > cache_;
+        mutable Size cached_;
+        Size dimension_;
+        TimeGrid timeGrid_;
+        T x0_, logX0_;
+        std::vector<T> driftDt_, stdDev_;
+        mutable sample_type next_;
+        mutable std::vector<T> temp_;
+        BrownianBridge bb_;
+    };
+
+
+    // template definitions
+
+    template <class GSG, class T>
+    BlackScholesPathGenerator<GSG,T>::BlackScholesPathGenerator(
+                          const boost::shared_ptr<StochasticProcess>& process,
+                          const TimeGrid& timeGrid,
+                          const GSG& generator,
+                          bool brownianBridge,
+                          const boost::shared_ptr<SequenceCache<GSG> >& cache)
+    : brownianBridge_(brownianBridge), generator_(generator),
+      cache_(cache), cached_(0),
+      dimension_(generator_.dimension()), timeGrid_(timeGrid),
+      driftDt_(timeGrid_.size()-1), stdDev_(timeGrid_.size()-1),
+      next_(BasicPath<T>(timeGrid_),1.0), temp_(dimension_),
+      bb_(timeGrid_) {
+        QL_REQUIRE(dimension_==timeGrid_.size()-1,
+                   "sequence generator dimensionality (" << dimension_
+                   << ") != timeSteps (" << timeGrid_.size()-1 << ")");
+        QL_REQUIRE(!cache_ || cache_->dimension() == dimension_,
+                   "sequence cache dimensionality (" << cache_->dimension()
+                   << ") != timeSteps (" << dimension_ << ")");
+
+        boost::shared_ptr<GeneralizedBlackScholesProcess> bsProcess =
+            boost::dynamic_pointer_cast<GeneralizedBlackScholesProcess>(
+                                                                   process);
+        QL_REQUIRE(bsProcess, "Black-Scholes process required");
+
+        Real x0 = bsProcess->x0();
+        QL_REQUIRE(x0 > 0.0, "positive underlying value required");
+        x0_ = static_cast<T>(x0);
+        logX0_ = static_cast<T>(std::log(x0));
+        for (Size i=0; i<driftDt_.size(); ++i) {
+            Time t = timeGrid_[i], dt = timeGrid_.dt(i);
+            driftDt_[i] = static_cast<T>(bsProcess->drift(t, x0)*dt);
+            stdDev_[i] = static_cast<T>(bsProcess->stdDeviation(t, x0, dt));
+        }
+    }
+
+    template <class GSG, class T>
+    const typename BlackScholesPathGenerator<GSG,T>::sample_type&
+    BlackScholesPathGenerator<GSG,T>::next() const {
+        return next(false);
+    }
+
+    template <class GSG, class T>
+    const typename BlackScholesPathGenerator<GSG,T>::sample_type&
+    BlackScholesPathGenerator<GSG,T>::antithetic() const {
+        return next(true);
+    }
+
+    template <class GSG, class T>
+    const typename BlackScholesPathGenerator<GSG,T>::sample_type&
+    BlackScholesPathGenerator<GSG,T>::next(bool antithetic) const {
+
+        typedef typename GSG::sample_type sequence_type;
+        const sequence_type& sequence_ =
+            cache_ ? (antithetic ? cache_->sequence(cached_-1)
+                                 : cache_->sequence(cached_++))
+                   : (antithetic ? generator_.lastSequence()
+                                 : generator_.nextSequence());
+
+        if (brownianBridge_) {
+            bb_.transform(sequence_.value.begin(),
+                          sequence_.value.end(),
+                          temp_.begin());
+        } else {
+            for (Size i=0; i<dimension_; ++i)
+                temp_[i] = static_cast<T>(sequence_.value[i]);
+        }
+
+        next_.weight = sequence_.weight;
+
+        // the increments don't depend on each other and can be
+        // calculated in a single vectorizable loop...
+        const T sign = antithetic ? T(-1) : T(1);
+        for (Size i=0; i<dimension_; ++i)
+            temp_[i] = driftDt_[i] + sign*stdDev_[i]*temp_[i];
+
+        // ...after which they're accumulated along the path.
+        BasicPath<T>& path = next_.value;
+        path.front() = x0_;
+        T logX = logX0_;
+        for (Size i=0; i<dimension_; ++i) {
+            logX += temp_[i];
+            path[i+1] = std::exp(logX);
+        }
+
+        return next_;
+    }
+
+}
+
+
+#endif
@@ -0,0 +1,345 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2015 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file coupledpathgenerator.hpp
+    \brief Generates pairs of paths on nested time grids
+*/
+
+#ifndef quantlib_coupled_path_generator_hpp
+#define quantlib_coupled_path_generator_hpp
+
+#include <ql/methods/montecarlo/multipath.hpp>
+#include <ql/methods/montecarlo/pathpricer.hpp>
+#include <ql/methods/montecarlo/sample.hpp>
+#include <ql/stochasticprocess.hpp>
+#include <utility>
+
+namespace QuantLib {
+
+    //! refines a time grid by splitting each step into equal sub-steps
+    /*! All the points of the original grid are kept, so that the
+        result is nested with respect to it.
+
+        \ingroup mcarlo
+    */
+    inline TimeGrid refinedTimeGrid(const TimeGrid& grid, Size factor) {
+        QL_REQUIRE(factor > 0, "null refinement factor");
+        if (factor == 1)
+            return grid;
+        std::vector<Time> times;
+        times.reserve((grid.size()-1)*factor+1);
+        times.push_back(grid.front());
+        for (Size i=1; i<grid.size(); ++i) {
+            Time dt = grid.dt(i-1)/factor;
+            for (Size j=1; j<factor; ++j)
+                times.push_back(grid[i-1] + j*dt);
+            times.push_back(grid[i]);
+        }
+        return TimeGrid(times.begin(), times.end());
+    }
+
+    //! prices the restriction of a path to a coarser grid
+    /*! Pricers written for the fixing dates of an instrument expect
+        paths on the corresponding grid.  This adapter extracts the
+        nodes of the original grid from a path generated on a refined
+        one and forwards the result to such a pricer.
+
+        \ingroup mcarlo
+    */
+    class RestrictedPathPricer : public PathPricer<Path> {
+      public:
+        RestrictedPathPricer(
+                       const boost::shared_ptr<PathPricer<Path> >& pricer,
+                       const TimeGrid& grid,
+                       const TimeGrid& refinedGrid)
+        : pricer_(pricer), indexes_(grid.size()), path_(grid) {
+            QL_REQUIRE(pricer_, "null path pricer");
+            for (Size i=0; i<grid.size(); ++i)
+                indexes_[i] = refinedGrid.index(grid[i]);
+        }
+        Real operator()(const Path& path) const {
+            for (Size i=0; i<indexes_.size(); ++i)
+                path_[i] = path[indexes_[i]];
+            return (*pricer_)(path_);
+        }
+      private:
+        boost::shared_ptr<PathPricer<Path> > pricer_;
+        std::vector<Size> indexes_;
+        mutable Path path_;
+    };
+
+
+    namespace detail {
+
+        /* Maps each step of the coarse grid onto the range of fine
+           steps it contains, and stores the weights needed to
+           aggregate the fine Gaussian increments into the coarse
+           ones.
+        */
+        class NestedGrids {
+          public:
+            NestedGrids() {}
+            NestedGrids(const TimeGrid& fine, const TimeGrid& coarse)
+            : begin_(coarse.empty() ? 0 : coarse.size()-1),
+              end_(coarse.empty() ? 0 : coarse.size()-1),
+              weights_(fine.size()-1) {
+                for (Size j=0; j<begin_.size(); ++j) {
+                    begin_[j] = fine.index(coarse[j]);
+                    end_[j] = fine.index(coarse[j+1]);
+                    Real sqrtDt = std::sqrt(coarse.dt(j));
+                    for (Size i=begin_[j]; i<end_[j]; ++i)
+                        weights_[i] = std::sqrt(fine.dt(i))/sqrtDt;
+                }
+            }
+            Size coarseSteps() const { return begin_.size(); }
+            Size begin(Size j) const { return begin_[j]; }
+            Size end(Size j) const { return end_[j]; }
+            Real weight(Size i) const { return weights_[i]; }
+          private:
+            std::vector<Size> begin_, end_;
+            std::vector<Real> weights_;
+        };
+
+    }
+
+
+    //! Generates coupled fine and coarse paths for multi-level Monte Carlo
+    /*! The coarse grid must be contained in the fine one.  Both paths
+        are driven by the same Brownian motion: the Gaussian increment
+        over each coarse step is obtained by aggregating the increments
+        of the fine steps it contains.
+
+        If an empty coarse grid is passed, only the fine path is
+        generated; this corresponds to the coarsest level of the
+        estimator.
+
+        \ingroup mcarlo
+    */
+    template <class GSG>
+    class CoupledPathGenerator {
+      public:
+        typedef Sample<std::pair<Path,Path> > sample_type;
+        CoupledPathGenerator(const boost::shared_ptr<StochasticProcess>&,
+                             const TimeGrid& fineGrid,
+                             const TimeGrid& coarseGrid,
+                             const GSG& generator);
+        //! \name inspectors
+        //@{
+        const sample_type& next() const;
+        const sample_type& antithetic() const;
+        Size size() const { return generator_.dimension(); }
+        //@}
+      private:
+        const sample_type& next(bool antithetic) const;
+        GSG generator_;
+        TimeGrid fineGrid_, coarseGrid_;
+        detail::NestedGrids grids_;
+        boost::shared_ptr<StochasticProcess1D> process_;
+        mutable sample_type next_;
+    };
+
+
+    //! Generates coupled fine and coarse multi-paths
+    /*! \ingroup mcarlo
+
+        \see CoupledPathGenerator
+    */
+    template <class GSG>
+    class CoupledMultiPathGenerator {
+      public:
+        typedef Sample<std::pair<MultiPath,MultiPath> > sample_type;
+        CoupledMultiPathGenerator(
+                             const boost::shared_ptr<StochasticProcess>&,
+                             const TimeGrid& fineGrid,
+                             const TimeGrid& coarseGrid,
+                             const GSG& generator);
+        //! \name inspectors
+        //@{
+        const sample_type& next() const;
+        const sample_type& antithetic() const;
+        Size size() const { return generator_.dimension(); }
+        //@}
+      private:
+        const sample_type& next(bool antithetic) const;
+        GSG generator_;
+        TimeGrid fineGrid_, coarseGrid_;
+        detail::NestedGrids grids_;
+        boost::shared_ptr<StochasticProcess> process_;
+        mutable sample_type next_;
+    };
+
+
+    // template definitions
+
+    template <class GSG>
+    CoupledPathGenerator<GSG>::CoupledPathGenerator(
+                          const boost::shared_ptr<StochasticProcess>& process,
+                          const TimeGrid& fineGrid,
+                          const TimeGrid& coarseGrid,
+                          const GSG& generator)
+    : generator_(generator), fineGrid_(fineGrid), coarseGrid_(coarseGrid),
+      grids_(fineGrid, coarseGrid),
+      process_(boost::dynamic_pointer_cast<StochasticProcess1D>(process)),
+      next_(std::make_pair(Path(fineGrid_),
+                           Path(coarseGrid_.empty() ? fineGrid_
+                                                    : coarseGrid_)),
+            1.0) {
+        QL_REQUIRE(process_, "1-D stochastic process required");
+        QL_REQUIRE(generator_.dimension() == fineGrid_.size()-1,
+                   "sequence generator dimensionality ("
+                   << generator_.dimension()
+                   << ") != fine time steps (" << fineGrid_.size()-1 << ")");
+    }
+
+    template <class GSG>
+    inline const typename CoupledPathGenerator<GSG>::sample_type&
+    CoupledPathGenerator<GSG>::next() const {
+        return next(false);
+    }
+
+    template <class GSG>
+    inline const typename CoupledPathGenerator<GSG>::sample_type&
+    CoupledPathGenerator<GSG>::antithetic() const {
+        return next(true);
+    }
+
+    template <class GSG>
+    const typename CoupledPathGenerator<GSG>::sample_type&
+    CoupledPathGenerator<GSG>::next(bool antithetic) const {
+
+        typedef typename GSG::sample_type sequence_type;
+        const sequence_type& sequence_ =
+            antithetic ? generator_.lastSequence()
+                       : generator_.nextSequence();
+        const Real sign = antithetic ? -1.0 : 1.0;
+
+        next_.weight = sequence_.weight;
+
+        Path& fine = next_.value.first;
+        fine.front() = process_->x0();
+        for (Size i=1; i<fine.length(); i++) {
+            fine[i] = process_->evolve(fineGrid_[i-1], fine[i-1],
+                                       fineGrid_.dt(i-1),
+                                       sign*sequence_.value[i-1]);
+        }
+
+        Path& coarse = next_.value.second;
+        coarse.front() = process_->x0();
+        for (Size j=0; j<grids_.coarseSteps(); j++) {
+            Real dw = 0.0;
+            for (Size i=grids_.begin(j); i<grids_.end(j); i++)
+                dw += grids_.weight(i)*sequence_.value[i];
+            coarse[j+1] = process_->evolve(coarseGrid_[j], coarse[j],
+                                           coarseGrid_.dt(j), sign*dw);
+        }
+
+        return next_;
+    }
+
+
+    template <class GSG>
+    CoupledMultiPathGenerator<GSG>::CoupledMultiPathGenerator(
+                          const boost::shared_ptr<StochasticProcess>& process,
+                          const TimeGrid& fineGrid,
+                          const TimeGrid& coarseGrid,
+                          const GSG& generator)
+    : generator_(generator), fineGrid_(fineGrid), coarseGrid_(coarseGrid),
+      grids_(fineGrid, coarseGrid), process_(process),
+      next_(std::make_pair(MultiPath(process->size(), fineGrid_),
+                           MultiPath(process->size(),
+                                     coarseGrid_.empty() ? fineGrid_
+                                                         : coarseGrid_)),
+            1.0) {
+        QL_REQUIRE(generator_.dimension() ==
+                   process_->factors()*(fineGrid_.size()-1),
+                   "dimension (" << generator_.dimension()
+                   << ") is not equal to ("
+                   << process_->factors() << " * " << fineGrid_.size()-1
+                   << ") the number of factors "
+                   << "times the number of fine time steps");
+    }
+
+    template <class GSG>
+    inline const typename CoupledMultiPathGenerator<GSG>::sample_type&
+    CoupledMultiPathGenerator<GSG>::next() const {
+        return next(false);
+    }
+
+    template <class GSG>
+    inline const typename CoupledMultiPathGenerator<GSG>::sample_type&
+    CoupledMultiPathGenerator<GSG>::antithetic() const {
+        return next(true);
+    }
+
+    template <class GSG>
+    const typename CoupledMultiPathGenerator<GSG>::sample_type&
+    CoupledMultiPathGenerator<GSG>::next(bool antithetic) const {
+
+        typedef typename GSG::sample_type sequence_type;
+        const sequence_type& sequence_ =
+            antithetic ? generator_.lastSequence()
+                       : generator_.nextSequence();
+        const Real sign = antithetic ? -1.0 : 1.0;
+
+        next_.weight = sequence_.weight;
+
+        Size m = process_->size();
+        Size n = process_->factors();
+        Array dw(n);
+
+        MultiPath& fine = next_.value.first;
+        Array asset = process_->initialValues();
+        for (Size j=0; j<m; j++)
+            fine[j].front() = asset[j];
+        for (Size i=1; i<fine.pathSize(); i++) {
+            Size offset = (i-1)*n;
+            for (Size k=0; k<n; k++)
+                dw[k] = sign*sequence_.value[offset+k];
+            asset = process_->evolve(fineGrid_[i-1], asset,
+                                     fineGrid_.dt(i-1), dw);
+            for (Size j=0; j<m; j++)
+                fine[j][i] = asset[j];
+        }
+
+        MultiPath& coarse = next_.value.second;
+        asset = process_->initialValues();
+        for (Size j=0; j<m; j++)
+            coarse[j].front() = asset[j];
+        for (Size l=0; l<grids_.coarseSteps(); l++) {
+            std::fill(dw.begin(), dw.end(), 0.0);
+            for (Size i=grids_.begin(l); i<grids_.end(l); i++) {
+                Size offset = i*n;
+                for (Size k=0; k<n; k++)
+                    dw[k] += grids_.weight(i)*sequence_.value[offset+k];
+            }
+            for (Size k=0; k<n; k++)
+                dw[k] *= sign;
+            asset = process_->evolve(coarseGrid_[l], asset,
+                                     coarseGrid_.dt(l), dw);
+            for (Size j=0; j<m; j++)
+                coarse[j][l+1] = asset[j];
+        }
+
+        return next_;
+    }
+
+}
+
+
+#endif
@@ -27,6 +27,8 @@
 
 #include <ql/methods/montecarlo/pathgenerator.hpp>
 #include <ql/methods/montecarlo/multipathgenerator.hpp>
+#include <ql/methods/montecarlo/coupledpathgenerator.hpp>
+#include <ql/methods/montecarlo/blackscholespathgenerator.hpp>
 #include <ql/methods/montecarlo/pathpricer.hpp>
 #include <ql/math/randomnumbers/rngtraits.hpp>
 
@@ -42,6 +44,7 @@ namespace QuantLib {
         typedef PathPricer<path_type> path_pricer_type;
         typedef typename RNG::rsg_type rsg_type;
         typedef PathGenerator<rsg_type> path_generator_type;
+        typedef CoupledPathGenerator<rsg_type> coupled_path_generator_type;
         enum { allowsErrorEstimate = RNG::allowsErrorEstimate };
     };
 
@@ -53,6 +56,23 @@ namespace QuantLib {
         typedef PathPricer<path_type> path_pricer_type;
         typedef typename RNG::rsg_type rsg_type;
         typedef MultiPathGenerator<rsg_type> path_generator_type;
+        typedef CoupledMultiPathGenerator<rsg_type>
+                                                 coupled_path_generator_type;
+        enum { allowsErrorEstimate = RNG::allowsErrorEstimate };
+    };
+
+    //! Monte Carlo traits for single-precision Black-Scholes paths
+    /*! Paths are generated and priced in single precision; the
+        values returned by the path pricers, and thus the
+        statistics, are still in double precision.
+    */
+    template <class RNG = PseudoRandom>
+    struct SingleVariateFloat {
+        typedef RNG rng_traits;
+        typedef BasicPath<float> path_type;
+        typedef PathPricer<path_type> path_pricer_type;
+        typedef typename RNG::rsg_type rsg_type;
+        typedef BlackScholesPathGenerator<rsg_type,float> path_generator_type;
         enum { allowsErrorEstimate = RNG::allowsErrorEstimate };
     };
 
@@ -0,0 +1,185 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2015 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file multilevelmontecarlomodel.hpp
+    \brief Multi-level Monte Carlo model
+*/
+
+#ifndef quantlib_multilevel_montecarlo_model_hpp
+#define quantlib_multilevel_montecarlo_model_hpp
+
+#include <ql/methods/montecarlo/mctraits.hpp>
+#include <ql/math/statistics/statistics.hpp>
+#include <boost/shared_ptr.hpp>
+
+namespace QuantLib {
+
+    //! Multi-level Monte Carlo model for path samples
+    /*! The model holds a hierarchy of levels, each one estimating
+        the expected difference between the values of the option on
+        a fine and a coarse path driven by the same Brownian motion.
+        The coarsest level has no coarse path and estimates the
+        value itself, so that the sum of the means over the levels
+        telescopes to the value on the finest grid.
+
+        See M.B. Giles, <i>Multilevel Monte Carlo path
+        simulation</i>, Operations Research 56(3), 2008.
+
+        The template arguments have the same meaning as in the
+        MonteCarloModel class; the traits must also define a
+        coupled_path_generator_type.
+
+        \ingroup mcarlo
+    */
+    template <template <class> class MC, class RNG, class S = Statistics>
+    class MultiLevelMonteCarloModel {
+      public:
+        typedef MC<RNG> mc_traits;
+        typedef RNG rng_traits;
+        typedef typename MC<RNG>::coupled_path_generator_type
+                                                         path_generator_type;
+        typedef typename MC<RNG>::path_pricer_type path_pricer_type;
+        typedef typename path_generator_type::sample_type sample_type;
+        typedef typename path_pricer_type::result_type result_type;
+        typedef S stats_type;
+        //! \name modifiers
+        //@{
+        /*! The coarse pricer must be null for the first level and
+            given for all the others.  The cost is the relative
+            computational effort of a sample at this level and is
+            used to allocate samples across levels.
+        */
+        void addLevel(
+               const boost::shared_ptr<path_generator_type>& pathGenerator,
+               const boost::shared_ptr<path_pricer_type>& finePathPricer,
+               const boost::shared_ptr<path_pricer_type>& coarsePathPricer,
+               Real cost);
+        void addSamples(Size level, Size samples);
+        //@}
+        //! \name inspectors
+        //@{
+        Size levels() const { return levels_.size(); }
+        Real cost(Size level) const;
+        const stats_type& levelAccumulator(Size level) const;
+        //! sum over the levels of the mean corrections
+        result_type mean() const;
+        //! standard error of the multi-level estimator
+        result_type errorEstimate() const;
+        //! total number of samples over all levels
+        Size samples() const;
+        //@}
+      private:
+        struct Level {
+            boost::shared_ptr<path_generator_type> pathGenerator;
+            boost::shared_ptr<path_pricer_type> finePathPricer;
+            boost::shared_ptr<path_pricer_type> coarsePathPricer;
+            Real cost;
+            stats_type sampleAccumulator;
+        };
+        std::vector<Level> levels_;
+    };
+
+
+    // inline definitions
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MultiLevelMonteCarloModel<MC,RNG,S>::addLevel(
+               const boost::shared_ptr<path_generator_type>& pathGenerator,
+               const boost::shared_ptr<path_pricer_type>& finePathPricer,
+               const boost::shared_ptr<path_pricer_type>& coarsePathPricer,
+               Real cost) {
+        QL_REQUIRE(pathGenerator, "null path generator");
+        QL_REQUIRE(finePathPricer, "null fine path pricer");
+        QL_REQUIRE(levels_.empty() || coarsePathPricer,
+                   "coarse path pricer required for level "
+                   << levels_.size());
+        QL_REQUIRE(cost > 0.0, "level cost must be positive");
+        Level level;
+        level.pathGenerator = pathGenerator;
+        level.finePathPricer = finePathPricer;
+        level.coarsePathPricer =
+            levels_.empty() ? boost::shared_ptr<path_pricer_type>()
+                            : coarsePathPricer;
+        level.cost = cost;
+        levels_.push_back(level);
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MultiLevelMonteCarloModel<MC,RNG,S>::addSamples(
+                                                 Size level, Size samples) {
+        QL_REQUIRE(level < levels_.size(),
+                   "level " << level << " not available ("
+                   << levels_.size() << " levels)");
+        Level& l = levels_[level];
+        for (Size j = 1; j <= samples; j++) {
+            const sample_type& path = l.pathGenerator->next();
+            result_type price = (*l.finePathPricer)(path.value.first);
+            if (l.coarsePathPricer)
+                price -= (*l.coarsePathPricer)(path.value.second);
+            l.sampleAccumulator.add(price, path.weight);
+        }
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline Real MultiLevelMonteCarloModel<MC,RNG,S>::cost(Size level) const {
+        QL_REQUIRE(level < levels_.size(),
+                   "level " << level << " not available");
+        return levels_[level].cost;
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline const typename MultiLevelMonteCarloModel<MC,RNG,S>::stats_type&
+    MultiLevelMonteCarloModel<MC,RNG,S>::levelAccumulator(Size level) const {
+        QL_REQUIRE(level < levels_.size(),
+                   "level " << level << " not available");
+        return levels_[level].sampleAccumulator;
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline typename MultiLevelMonteCarloModel<MC,RNG,S>::result_type
+    MultiLevelMonteCarloModel<MC,RNG,S>::mean() const {
+        result_type sum = 0.0;
+        for (Size l=0; l<levels_.size(); l++)
+            sum += levels_[l].sampleAccumulator.mean();
+        return sum;
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline typename MultiLevelMonteCarloModel<MC,RNG,S>::result_type
+    MultiLevelMonteCarloModel<MC,RNG,S>::errorEstimate() const {
+        result_type sum = 0.0;
+        for (Size l=0; l<levels_.size(); l++) {
+            result_type error = levels_[l].sampleAccumulator.errorEstimate();
+            sum += error*error;
+        }
+        return std::sqrt(sum);
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline Size MultiLevelMonteCarloModel<MC,RNG,S>::samples() const {
+        Size n = 0;
+        for (Size l=0; l<levels_.size(); l++)
+            n += levels_[l].sampleAccumulator.samples();
+        return n;
+    }
+
+}
+
+
+#endif
@@ -29,6 +29,7 @@
 
 #include <ql/methods/montecarlo/multipath.hpp>
 #include <ql/methods/montecarlo/sample.hpp>
+#include <ql/methods/montecarlo/sequencecache.hpp>
 #include <ql/stochasticprocess.hpp>
 
 namespace QuantLib {
@@ -42,6 +43,9 @@ namespace QuantLib {
         };
         \endcode
 
+        If a sequence cache is passed, the random sequences are
+        taken from it instead of the generator.
+
         \ingroup mcarlo
 
         \test the generated paths are checked against cached results
@@ -53,7 +57,9 @@ namespace QuantLib {
         MultiPathGenerator(const boost::shared_ptr<StochasticProcess>&,
                            const TimeGrid&,
                            GSG generator,
-                           bool brownianBridge = false);
+                           bool brownianBridge = false,
+                           const boost::shared_ptr<SequenceCache<GSG> >& cache
+                                 = boost::shared_ptr<SequenceCache<GSG> >());
         const sample_type& next() const;
         const sample_type& antithetic() const;
       private:
@@ -61,6 +67,8 @@ namespace QuantLib {
         bool brownianBridge_;
         boost::shared_ptr<StochasticProcess> process_;
         GSG generator_;
+        boost::shared_ptr<SequenceCache<GSG> > cache_;
+        mutable Size cached_;
         mutable sample_type next_;
     };
 
@@ -72,9 +80,11 @@ namespace QuantLib {
                    const boost::shared_ptr<StochasticProcess>& process,
                    const TimeGrid& times,
                    GSG generator,
-                   bool brownianBridge)
+                   bool brownianBridge,
+                   const boost::shared_ptr<SequenceCache<GSG> >& cache)
     : brownianBridge_(brownianBridge), process_(process),
-      generator_(generator), next_(MultiPath(process->size(), times), 1.0) {
+      generator_(generator), cache_(cache), cached_(0),
+      next_(MultiPath(process->size(), times), 1.0) {
 
         QL_REQUIRE(generator_.dimension() ==
                    process->factors()*(times.size()-1),
@@ -85,6 +95,10 @@ namespace QuantLib {
                    << "times the number of time steps");
         QL_REQUIRE(times.size() > 1,
                    "no times given");
+        QL_REQUIRE(!cache_ || cache_->dimension() == generator_.dimension(),
+                   "sequence cache dimensionality (" << cache_->dimension()
+                   << ") != generator dimensionality ("
+                   << generator_.dimension() << ")");
     }
 
     template <class GSG>
@@ -111,8 +125,10 @@ namespace QuantLib {
 
             typedef typename GSG::sample_type sequence_type;
             const sequence_type& sequence_ =
-                antithetic ? generator_.lastSequence()
-                           : generator_.nextSequence();
+                cache_ ? (antithetic ? cache_->sequence(cached_-1)
+                                     : cache_->sequence(cached_++))
+                       : (antithetic ? generator_.lastSequence()
+                                     : generator_.nextSequence());
 
             Size m = process_->size();
             Size n = process_->factors();
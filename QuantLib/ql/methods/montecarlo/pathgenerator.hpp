@@ -27,6 +27,7 @@
 #define quantlib_montecarlo_path_generator_hpp
 
 #include <ql/methods/montecarlo/brownianbridge.hpp>
+#include <ql/methods/montecarlo/sequencecache.hpp>
 #include <ql/stochasticprocess.hpp>
 
 namespace QuantLib {
@@ -36,6 +37,11 @@ namespace QuantLib {
     /*! Generates random paths with drift(S,t) and variance(S,t)
         using a gaussian sequence generator
 
+        If a sequence cache is passed, the random sequences are
+        taken from it instead of the generator, so that path
+        generators sharing the same cache produce paths driven by
+        the same draws.
+
         \ingroup mcarlo
 
         \test the generated paths are checked against cached results
@@ -53,7 +59,9 @@ namespace QuantLib {
         PathGenerator(const boost::shared_ptr<StochasticProcess>&,
                       const TimeGrid& timeGrid,
                       const GSG& generator,
-                      bool brownianBridge);
+                      bool brownianBridge,
+                      const boost::shared_ptr<SequenceCache<GSG> >& cache
+                                 = boost::shared_ptr<SequenceCache<GSG> >());
         //! \name inspectors
         //@{
         const sample_type& next() const;
@@ -65,6 +73,8 @@ namespace QuantLib {
         const sample_type& next(bool antithetic) const;
         bool brownianBridge_;
         GSG generator_;
+        boost::shared_ptr<SequenceCache<GSG> > cache_;
+        mutable Size cached_;
         Size dimension_;
         TimeGrid timeGrid_;
         boost::shared_ptr<StochasticProcess1D> process_;
@@ -83,7 +93,7 @@ namespace QuantLib {
                           Size timeSteps,
                           const GSG& generator,
                           bool brownianBridge)
-    : brownianBridge_(brownianBridge), generator_(generator),
+    : brownianBridge_(brownianBridge), generator_(generator), cached_(0),
       dimension_(generator_.dimension()), timeGrid_(length, timeSteps),
       process_(boost::dynamic_pointer_cast<StochasticProcess1D>(process)),
       next_(Path(timeGrid_),1.0), temp_(dimension_), bb_(timeGrid_) {
@@ -97,14 +107,19 @@ namespace QuantLib {
                           const boost::shared_ptr<StochasticProcess>& process,
                           const TimeGrid& timeGrid,
                           const GSG& generator,
-                          bool brownianBridge)
+                          bool brownianBridge,
+                          const boost::shared_ptr<SequenceCache<GSG> >& cache)
     : brownianBridge_(brownianBridge), generator_(generator),
+      cache_(cache), cached_(0),
       dimension_(generator_.dimension()), timeGrid_(timeGrid),
       process_(boost::dynamic_pointer_cast<StochasticProcess1D>(process)),
       next_(Path(timeGrid_),1.0), temp_(dimension_), bb_(timeGrid_) {
         QL_REQUIRE(dimension_==timeGrid_.size()-1,
                    "sequence generator dimensionality (" << dimension_
                    << ") != timeSteps (" << timeGrid_.size()-1 << ")");
+        QL_REQUIRE(!cache_ || cache_->dimension() == dimension_,
+                   "sequence cache dimensionality (" << cache_->dimension()
+                   << ") != timeSteps (" << dimension_ << ")");
     }
 
     template <class GSG>
@@ -125,8 +140,10 @@ namespace QuantLib {
 
         typedef typename GSG::sample_type sequence_type;
         const sequence_type& sequence_ =
-            antithetic ? generator_.lastSequence()
-                       : generator_.nextSequence();
+            cache_ ? (antithetic ? cache_->sequence(cached_-1)
+                                 : cache_->sequence(cached_++))
+                   : (antithetic ? generator_.lastSequence()
+                                 : generator_.nextSequence());
 
         if (brownianBridge_) {
             bb_.transform(sequence_.value.begin(),
@@ -0,0 +1,78 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2015 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file sequencecache.hpp
+    \brief Storage of random sequences for common random numbers
+*/
+
+#ifndef quantlib_sequence_cache_hpp
+#define quantlib_sequence_cache_hpp
+
+#include <ql/errors.hpp>
+#include <deque>
+
+namespace QuantLib {
+
+    //! records and replays the sequences drawn from a generator
+    /*! The i-th sequence is drawn from the stored generator the
+        first time it is requested and returned from memory
+        afterwards.  Path generators sharing a cache are thus driven
+        by the same random numbers, which makes it possible to
+        re-price bumped scenarios on the draws of a first simulation
+        (common random numbers) without generating them again.
+
+        \warning all sequences are kept in memory; the required
+                 storage is the number of samples times the
+                 dimension of the generator.
+
+        \ingroup mcarlo
+    */
+    template <class GSG>
+    class SequenceCache {
+      public:
+        typedef typename GSG::sample_type sample_type;
+        explicit SequenceCache(const GSG& generator)
+        : generator_(generator) {}
+        //! returns the i-th sequence, drawing it if needed
+        const sample_type& sequence(Size i) const;
+        //! number of sequences stored so far
+        Size size() const { return sequences_.size(); }
+        Size dimension() const { return generator_.dimension(); }
+      private:
+        GSG generator_;
+        // a deque doesn't invalidate references to its elements
+        // when new ones are appended
+        mutable std::deque<sample_type> sequences_;
+    };
+
+
+    // inline definitions
+
+    template <class GSG>
+    inline const typename SequenceCache<GSG>::sample_type&
+    SequenceCache<GSG>::sequence(Size i) const {
+        while (sequences_.size() <= i)
+            sequences_.push_back(generator_.nextSequence());
+        return sequences_[i];
+    }
+
+}
+
+
+#endif
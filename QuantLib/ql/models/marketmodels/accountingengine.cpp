@@ -35,11 +35,38 @@ namespace QuantLib {
       numberProducts_(product->numberOfProducts()),
       numerairesHeld_(product->numberOfProducts()),
       numberCashFlowsThisStep_(product->numberOfProducts()),
-      cashFlowsGenerated_(product->numberOfProducts()) {
-        for (Size i=0; i<numberProducts_; ++i)
-            cashFlowsGenerated_[i].resize(
-                       product_->maxNumberOfCashFlowsPerProductPerStep());
+      cashFlowsGenerated_(product->numberOfProducts(),
+                          product->maxNumberOfCashFlowsPerProductPerStep()) {
+        initialize();
+    }
 
+    AccountingEngine::AccountingEngine(
+                    const boost::shared_ptr<MarketModelBlockEvolver>& evolver,
+                    const Clone<MarketModelMultiProduct>& product,
+                    Real initialNumeraireValue)
+    : blockEvolver_(evolver), product_(product),
+      initialNumeraireValue_(initialNumeraireValue),
+      numberProducts_(product->numberOfProducts()),
+      numerairesHeld_(product->numberOfProducts()),
+      numberCashFlowsThisStep_(product->numberOfProducts()),
+      cashFlowsGenerated_(product->numberOfProducts(),
+                          product->maxNumberOfCashFlowsPerProductPerStep()) {
+        initialize();
+
+        Size blockSize = blockEvolver_->blockSize();
+        products_ = std::vector<Clone<MarketModelMultiProduct> >(blockSize,
+                                                                 product_);
+        blockNumerairesHeld_ = std::vector<std::vector<Real> >(
+                                          blockSize,
+                                          std::vector<Real>(numberProducts_));
+        principals_ = std::vector<Real>(blockSize);
+        weights_ = std::vector<Real>(blockSize);
+        stepWeights_ = std::vector<Real>(blockSize);
+        done_ = std::vector<bool>(blockSize);
+        values_ = std::vector<Real>(numberProducts_);
+    }
+
+    void AccountingEngine::initialize() {
         const std::vector<Time>& cashFlowTimes =
             product_->possibleCashFlowTimes();
         const std::vector<Rate>& rateTimes = product_->evolution().rateTimes();
@@ -47,7 +74,33 @@ namespace QuantLib {
         for (Size j=0; j<cashFlowTimes.size(); ++j)
             discounters_.push_back(MarketModelDiscounter(cashFlowTimes[j],
                                                          rateTimes));
+    }
 
+    void AccountingEngine::collectCashFlows(
+                                  const CurveState& curveState,
+                                  Size numeraire,
+                                  Real principalInNumerairePortfolio,
+                                  std::vector<Real>& numerairesHeld) {
+        // for each product...
+        for (Size i=0; i<numberProducts_; ++i) {
+            // ...and each cash flow...
+            MarketModelMultiProduct::CashFlowBuffer::const_iterator
+                cashflows = cashFlowsGenerated_[i];
+            for (Size j=0; j<numberCashFlowsThisStep_[i]; ++j) {
+                // ...convert the cash flow to numeraires.
+                // This is done by calculating the number of
+                // numeraire bonds corresponding to such cash flow...
+                const MarketModelDiscounter& discounter =
+                    discounters_[cashflows[j].timeIndex];
+
+                Real bonds = cashflows[j].amount *
+                    discounter.numeraireBonds(curveState, numeraire);
+
+                // ...and adding the newly bought bonds to the number
+                // of numeraires held.
+                numerairesHeld[i] += bonds/principalInNumerairePortfolio;
+            }
+        }
     }
 
     Real AccountingEngine::singlePathValues(std::vector<Real>& values) {
@@ -66,27 +119,9 @@ namespace QuantLib {
             Size numeraire =
                 evolver_->numeraires()[thisStep];
 
-            // for each product...
-            for (Size i=0; i<numberProducts_; ++i) {
-                // ...and each cash flow...
-                const std::vector<MarketModelMultiProduct::CashFlow>& cashflows =
-                    cashFlowsGenerated_[i];
-                for (Size j=0; j<numberCashFlowsThisStep_[i]; ++j) {
-                    // ...convert the cash flow to numeraires.
-                    // This is done by calculating the number of
-                    // numeraire bonds corresponding to such cash flow...
-                    const MarketModelDiscounter& discounter =
-                        discounters_[cashflows[j].timeIndex];
-
-                    Real bonds = cashflows[j].amount *
-                        discounter.numeraireBonds(evolver_->currentState(),
-                                                  numeraire);
-
-                    // ...and adding the newly bought bonds to the number
-                    // of numeraires held.
-                    numerairesHeld_[i] += bonds/principalInNumerairePortfolio;
-                }
-            }
+            collectCashFlows(evolver_->currentState(), numeraire,
+                             principalInNumerairePortfolio,
+                             numerairesHeld_);
 
             if (!done) {
 
@@ -112,9 +147,70 @@ namespace QuantLib {
         return weight;
     }
 
+    void AccountingEngine::blockPathValues(Size paths,
+                                           SequenceStatisticsInc& stats) {
+        blockEvolver_->startNewPaths(paths, weights_);
+        for (Size p=0; p<paths; ++p) {
+            std::fill(blockNumerairesHeld_[p].begin(),
+                      blockNumerairesHeld_[p].end(), 0.0);
+            products_[p]->reset();
+            principals_[p] = 1.0;
+            done_[p] = false;
+        }
+
+        // the block is evolved until the products on all its paths
+        // are done; the same steps as in singlePathValues are then
+        // performed for each path still alive.
+        Size pathsLeft = paths;
+        while (pathsLeft > 0) {
+            Size thisStep = blockEvolver_->currentStep();
+            blockEvolver_->advanceStep(stepWeights_);
+            Size numeraire = blockEvolver_->numeraires()[thisStep];
+
+            for (Size p=0; p<paths; ++p) {
+                if (done_[p])
+                    continue;
+
+                weights_[p] *= stepWeights_[p];
+                const CurveState& curveState =
+                    blockEvolver_->currentState(p);
+                done_[p] = products_[p]->nextTimeStep(
+                                                   curveState,
+                                                   numberCashFlowsThisStep_,
+                                                   cashFlowsGenerated_);
+
+                collectCashFlows(curveState, numeraire, principals_[p],
+                                 blockNumerairesHeld_[p]);
+
+                if (!done_[p]) {
+                    Size nextNumeraire =
+                        blockEvolver_->numeraires()[thisStep+1];
+                    principals_[p] *=
+                        curveState.discountRatio(numeraire, nextNumeraire);
+                } else {
+                    --pathsLeft;
+                }
+            }
+        }
+
+        for (Size p=0; p<paths; ++p) {
+            for (Size i=0; i<numberProducts_; ++i)
+                values_[i] = blockNumerairesHeld_[p][i]
+                           * initialNumeraireValue_;
+            stats.add(values_, weights_[p]);
+        }
+    }
+
     void AccountingEngine::multiplePathValues(SequenceStatisticsInc& stats,
                                               Size numberOfPaths)
     {
+        if (blockEvolver_) {
+            Size blockSize = blockEvolver_->blockSize();
+            for (Size i=0; i<numberOfPaths; i+=blockSize)
+                blockPathValues(std::min(blockSize, numberOfPaths-i), stats);
+            return;
+        }
+
         std::vector<Real> values(product_->numberOfProducts());
         for (Size i=0; i<numberOfPaths; ++i) {
             Real weight = singlePathValues(values);
@@ -122,4 +218,5 @@ namespace QuantLib {
         }
     }
 
+
 }
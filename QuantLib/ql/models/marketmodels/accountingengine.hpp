@@ -34,6 +34,7 @@
 namespace QuantLib {
 
     class MarketModelEvolver;
+    class MarketModelBlockEvolver;
 
     //class MarketModelDiscounter;
     //class SequenceStatistics;
@@ -41,17 +42,32 @@ namespace QuantLib {
     //struct MarketModelMultiProduct::CashFlow;
 
     //! Engine collecting cash flows along a market-model simulation
+    /*! When a block evolver is passed, the paths are simulated in
+        blocks; a copy of the product is kept for each path of the
+        block.
+    */
     class AccountingEngine {
       public:
         AccountingEngine(const boost::shared_ptr<MarketModelEvolver>& evolver,
                          const Clone<MarketModelMultiProduct>& product,
                          Real initialNumeraireValue);
+        AccountingEngine(
+                   const boost::shared_ptr<MarketModelBlockEvolver>& evolver,
+                   const Clone<MarketModelMultiProduct>& product,
+                   Real initialNumeraireValue);
         void multiplePathValues(SequenceStatisticsInc& stats,
                                 Size numberOfPaths);
       private:
+        void initialize();
         Real singlePathValues(std::vector<Real>& values);
+        void blockPathValues(Size paths, SequenceStatisticsInc& stats);
+        void collectCashFlows(const CurveState& curveState,
+                              Size numeraire,
+                              Real principalInNumerairePortfolio,
+                              std::vector<Real>& numerairesHeld);
 
         boost::shared_ptr<MarketModelEvolver> evolver_;
+        boost::shared_ptr<MarketModelBlockEvolver> blockEvolver_;
         Clone<MarketModelMultiProduct> product_;
 
         Real initialNumeraireValue_;
@@ -60,10 +76,15 @@ namespace QuantLib {
         // workspace
         std::vector<Real> numerairesHeld_;
         std::vector<Size> numberCashFlowsThisStep_;
-        std::vector<std::vector<MarketModelMultiProduct::CashFlow> >
-                                                         cashFlowsGenerated_;
+        MarketModelMultiProduct::CashFlowBuffer cashFlowsGenerated_;
         std::vector<MarketModelDiscounter> discounters_;
 
+        // block workspace
+        std::vector<Clone<MarketModelMultiProduct> > products_;
+        std::vector<std::vector<Real> > blockNumerairesHeld_;
+        std::vector<Real> principals_, weights_, stepWeights_;
+        std::vector<bool> done_;
+        std::vector<Real> values_;
     };
 
 }
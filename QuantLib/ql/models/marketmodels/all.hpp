@@ -3,6 +3,7 @@
 
 #include <ql/models/marketmodels/accountingengine.hpp>
 #include <ql/models/marketmodels/browniangenerator.hpp>
+#include <ql/models/marketmodels/cashflowbuffer.hpp>
 #include <ql/models/marketmodels/constrainedevolver.hpp>
 #include <ql/models/marketmodels/curvestate.hpp>
 #include <ql/models/marketmodels/discounter.hpp>
@@ -15,6 +16,7 @@
 #include <ql/models/marketmodels/marketmodel.hpp>
 #include <ql/models/marketmodels/marketmodeldifferences.hpp>
 #include <ql/models/marketmodels/multiproduct.hpp>
+#include <ql/models/marketmodels/parallelaccountingengine.hpp>
 #include <ql/models/marketmodels/pathwiseaccountingengine.hpp>
 #include <ql/models/marketmodels/pathwisemultiproduct.hpp>
 #include <ql/models/marketmodels/pathwisediscounter.hpp>
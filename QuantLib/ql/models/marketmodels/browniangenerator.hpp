@@ -37,6 +37,13 @@ namespace QuantLib {
 
         virtual Size numberOfFactors() const = 0;
         virtual Size numberOfSteps() const = 0;
+
+        //! skips the given number of paths
+        /*! The default implementation draws all the steps of the
+            skipped paths and discards them; derived classes can
+            override it with a cheaper implementation.
+        */
+        virtual void skip(Size paths);
     };
 
     class BrownianGeneratorFactory {
@@ -47,6 +54,50 @@ namespace QuantLib {
                                                             Size steps) const = 0;
     };
 
+    //! Factory of Brownian generators starting further down the sequence
+    /*! The generators created by this factory are the ones created
+        by the underlying factory, after the given number of paths
+        were skipped.  It allows to partition the stream of paths
+        of the underlying factory among several simulations, e.g.,
+        run by different threads.
+    */
+    class OffsetBrownianGeneratorFactory : public BrownianGeneratorFactory {
+      public:
+        OffsetBrownianGeneratorFactory(
+                   const boost::shared_ptr<BrownianGeneratorFactory>& factory,
+                   Size pathsToSkip);
+        boost::shared_ptr<BrownianGenerator> create(Size factors,
+                                                    Size steps) const;
+      private:
+        boost::shared_ptr<BrownianGeneratorFactory> factory_;
+        Size pathsToSkip_;
+    };
+
+
+    // inline definitions
+
+    inline void BrownianGenerator::skip(Size paths) {
+        std::vector<Real> variates(numberOfFactors());
+        for (Size i=0; i<paths; ++i) {
+            nextPath();
+            for (Size j=0; j<numberOfSteps(); ++j)
+                nextStep(variates);
+        }
+    }
+
+    inline OffsetBrownianGeneratorFactory::OffsetBrownianGeneratorFactory(
+                   const boost::shared_ptr<BrownianGeneratorFactory>& factory,
+                   Size pathsToSkip)
+    : factory_(factory), pathsToSkip_(pathsToSkip) {}
+
+    inline boost::shared_ptr<BrownianGenerator>
+    OffsetBrownianGeneratorFactory::create(Size factors, Size steps) const {
+        boost::shared_ptr<BrownianGenerator> generator =
+            factory_->create(factors, steps);
+        generator->skip(pathsToSkip_);
+        return generator;
+    }
+
 }
 
 #endif
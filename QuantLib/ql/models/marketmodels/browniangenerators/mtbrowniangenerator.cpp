@@ -56,6 +56,13 @@ namespace QuantLib {
 
     Size MTBrownianGenerator::numberOfSteps() const { return steps_; }
 
+    void MTBrownianGenerator::skip(Size paths) {
+        // the uniform sequences are drawn, but not transformed
+        for (Size i=0; i<paths; ++i)
+            generator_.nextSequence();
+        lastStep_ = 0;
+    }
+
 
     MTBrownianGeneratorFactory::MTBrownianGeneratorFactory(unsigned long seed)
     : seed_(seed) {}
@@ -51,6 +51,8 @@ namespace QuantLib {
 
         Size numberOfFactors() const;
         Size numberOfSteps() const;
+
+        void skip(Size paths);
       private:
         Size factors_, steps_;
         Size lastStep_;
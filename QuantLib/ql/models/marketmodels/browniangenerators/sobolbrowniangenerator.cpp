@@ -114,9 +114,10 @@ namespace QuantLib {
                                         unsigned long seed,
                                         SobolRsg::DirectionIntegers integers)
     : factors_(factors), steps_(steps), ordering_(ordering),
+      seed_(seed), integers_(integers),
       generator_(SobolRsg(factors*steps, seed, integers),
                  InverseCumulativeNormal()),
-      bridge_(steps), lastStep_(0),
+      bridge_(steps), pathsDrawn_(0), lastStep_(0),
       orderedIndices_(factors, std::vector<Size>(steps)),
       bridgedVariates_(factors, std::vector<Real>(steps)) {
 
@@ -142,6 +143,7 @@ namespace QuantLib {
             sample_type;
 
         const sample_type& sample = generator_.nextSequence();
+        ++pathsDrawn_;
         // Brownian-bridge the variates according to the ordered indices
         for (Size i=0; i<factors_; ++i) {
             bridge_.transform(boost::make_permutation_iterator(
@@ -208,6 +210,19 @@ namespace QuantLib {
 
     Size SobolBrownianGenerator::numberOfSteps() const { return steps_; }
 
+    void SobolBrownianGenerator::skip(Size paths) {
+        // the uniform sequence is moved forward directly, without
+        // drawing or inverting the skipped samples.  skipTo counts
+        // from the start of the sequence, so it's called on a new
+        // generator.
+        pathsDrawn_ += paths;
+        SobolRsg sobol(factors_*steps_, seed_, integers_);
+        sobol.skipTo(pathsDrawn_);
+        generator_ = InverseCumulativeRsg<SobolRsg,InverseCumulativeNormal>(
+                                            sobol, InverseCumulativeNormal());
+        lastStep_ = 0;
+    }
+
 
 
     SobolBrownianGeneratorFactory::SobolBrownianGeneratorFactory(
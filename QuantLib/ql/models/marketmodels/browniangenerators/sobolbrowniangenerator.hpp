@@ -59,6 +59,8 @@ namespace QuantLib {
 
         Size numberOfFactors() const;
         Size numberOfSteps() const;
+
+        void skip(Size paths);
         
         // test interface
         const std::vector<std::vector<Size> >& orderedIndices() const;
@@ -68,9 +70,12 @@ namespace QuantLib {
       private:
         Size factors_, steps_;
         Ordering ordering_;
+        unsigned long seed_;
+        SobolRsg::DirectionIntegers integers_;
         InverseCumulativeRsg<SobolRsg,InverseCumulativeNormal> generator_;
         BrownianBridge bridge_;
         // work variables
+        unsigned long pathsDrawn_;
         Size lastStep_;
         std::vector<std::vector<Size> > orderedIndices_;
         std::vector<std::vector<Real> > bridgedVariates_;
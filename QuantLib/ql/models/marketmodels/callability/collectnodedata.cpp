@@ -53,9 +53,8 @@ namespace QuantLib {
         // the same exercise---not evolution---times)
 
         std::vector<Size> numberCashFlowsThisStep(1);
-        std::vector<std::vector<CashFlow> > cashFlowsGenerated(1);
-        cashFlowsGenerated[0].resize(
-                           product.maxNumberOfCashFlowsPerProductPerStep());
+        MarketModelMultiProduct::CashFlowBuffer cashFlowsGenerated(
+                        1, product.maxNumberOfCashFlowsPerProductPerStep());
 
 
         std::vector<Time> rateTimes = product.evolution().rateTimes();
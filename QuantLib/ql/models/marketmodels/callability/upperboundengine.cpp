@@ -28,7 +28,14 @@
 #include <ql/models/marketmodels/discounter.hpp>
 #include <ql/models/marketmodels/evolver.hpp>
 #include <ql/models/marketmodels/callability/exercisevalue.hpp>
+#include <ql/models/marketmodels/browniangenerator.hpp>
+#include <ql/utilities/dataformatters.hpp>
 #include <algorithm>
+#include <string>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace QuantLib {
 
@@ -42,10 +49,8 @@ namespace QuantLib {
 
                 Size N = product.numberOfProducts();
                 numberCashFlowsThisStep_.resize(N);
-                cashFlowsGenerated_.resize(N);
-                for (Size i=0; i<N; ++i)
-                    cashFlowsGenerated_[i].resize(
-                            product.maxNumberOfCashFlowsPerProductPerStep());
+                cashFlowsGenerated_ = CashFlowBuffer(
+                            N, product.maxNumberOfCashFlowsPerProductPerStep());
 
                 clear();
             }
@@ -64,7 +69,7 @@ namespace QuantLib {
             bool nextTimeStep(
                     const CurveState& currentState,
                     std::vector<Size>& numberCashFlowsThisStep,
-                    std::vector<std::vector<CashFlow> >& cashFlowsGenerated) {
+                    CashFlowBuffer& cashFlowsGenerated) {
                 if (recording_)
                     savedStates_.push_back(currentState);
                 return CallSpecifiedMultiProduct::nextTimeStep(
@@ -100,7 +105,27 @@ namespace QuantLib {
             Size lastSavedStep_;
             bool recording_;
             std::vector<Size> numberCashFlowsThisStep_;
-            std::vector<std::vector<CashFlow> > cashFlowsGenerated_;
+            CashFlowBuffer cashFlowsGenerated_;
+        };
+
+        // keeps track of the last generator it created, so that it
+        // can be moved forward from outside the evolver using it
+        class GeneratorKeeper : public BrownianGeneratorFactory {
+          public:
+            GeneratorKeeper(
+                  const boost::shared_ptr<BrownianGeneratorFactory>& factory)
+            : factory_(factory) {}
+            boost::shared_ptr<BrownianGenerator> create(Size factors,
+                                                        Size steps) const {
+                generator_ = factory_->create(factors, steps);
+                return generator_;
+            }
+            const boost::shared_ptr<BrownianGenerator>& generator() const {
+                return generator_;
+            }
+          private:
+            boost::shared_ptr<BrownianGeneratorFactory> factory_;
+            mutable boost::shared_ptr<BrownianGenerator> generator_;
         };
 
     }
@@ -150,9 +175,8 @@ namespace QuantLib {
                                      hedgeStrategy.exerciseTimes());
 
         numberCashFlowsThisStep_.resize(numberOfProducts_);
-        cashFlowsGenerated_.resize(numberOfProducts_);
-        for (Size i=0; i<numberOfProducts_; ++i)
-            cashFlowsGenerated_[i].resize(
+        cashFlowsGenerated_ = MarketModelMultiProduct::CashFlowBuffer(
+                          numberOfProducts_,
                           composite_.maxNumberOfCashFlowsPerProductPerStep());
 
         const std::vector<Time>& cashFlowTimes =
@@ -332,8 +356,8 @@ namespace QuantLib {
         // For each product in range...
         for (Size i=beginProduct; i<endProduct; ++i) {
             // ...and for each cash flow...
-            const std::vector<MarketModelMultiProduct::CashFlow>& cashflows =
-                cashFlowsGenerated_[i];
+            MarketModelMultiProduct::CashFlowBuffer::const_iterator
+                cashflows = cashFlowsGenerated_[i];
             for (Size j=0; j<numberCashFlowsThisStep_[i]; ++j) {
                 // ...convert the cash flow to numeraires.  This is
                 // done by calculating the number of numeraire bonds
@@ -349,5 +373,105 @@ namespace QuantLib {
         return numeraireUnits/principalInNumerairePortfolio;
     }
 
-}
 
+
+    ParallelUpperBoundEngine::ParallelUpperBoundEngine(
+            const boost::shared_ptr<MarketModelEvolverFactory>& evolverFactory,
+            const boost::shared_ptr<BrownianGeneratorFactory>& generatorFactory,
+            const std::vector<boost::shared_ptr<MarketModelEvolverFactory> >&
+                                                        innerEvolverFactories,
+            const std::vector<boost::shared_ptr<BrownianGeneratorFactory> >&
+                                                      innerGeneratorFactories,
+            const MarketModelMultiProduct& underlying,
+            const MarketModelExerciseValue& rebate,
+            const MarketModelMultiProduct& hedge,
+            const MarketModelExerciseValue& hedgeRebate,
+            const ExerciseStrategy<CurveState>& hedgeStrategy,
+            Real initialNumeraireValue,
+            Size workers)
+    : evolverFactory_(evolverFactory), generatorFactory_(generatorFactory),
+      innerEvolverFactories_(innerEvolverFactories),
+      innerGeneratorFactories_(innerGeneratorFactories),
+      underlying_(underlying), hedge_(hedge),
+      rebate_(rebate), hedgeRebate_(hedgeRebate),
+      hedgeStrategy_(hedgeStrategy),
+      initialNumeraireValue_(initialNumeraireValue), workers_(workers) {
+        QL_REQUIRE(innerEvolverFactories_.size() ==
+                   innerGeneratorFactories_.size(),
+                   "mismatch between inner evolver factories ("
+                   << innerEvolverFactories_.size()
+                   << ") and inner generator factories ("
+                   << innerGeneratorFactories_.size() << ")");
+    }
+
+
+    void ParallelUpperBoundEngine::multiplePathValues(Statistics& stats,
+                                                      Size outerPaths,
+                                                      Size innerPaths) {
+        Size workers = workers_;
+        if (workers == 0) {
+            #ifdef _OPENMP
+            workers = omp_get_max_threads();
+            #else
+            workers = 1;
+            #endif
+        }
+        workers = std::max<Size>(1, std::min(workers, outerPaths));
+
+        // Each worker builds its own engine and set of evolvers, and
+        // simulates a contiguous block of outer paths; its generators
+        // are moved forward once over the paths of the blocks before
+        // its own.
+        evolverFactory_->prepare();
+        for (Size j=0; j<innerEvolverFactories_.size(); ++j)
+            innerEvolverFactories_[j]->prepare();
+
+        std::vector<std::pair<Real,Real> > results(outerPaths);
+        std::vector<std::string> errors(workers);
+
+        #pragma omp parallel for schedule(static,1) num_threads(int(workers)) if(workers>1)
+        for (int w=0; w<int(workers); ++w) {
+            Size begin = (outerPaths*w)/workers,
+                 end = (outerPaths*(w+1))/workers;
+            try {
+                GeneratorKeeper keeper(generatorFactory_);
+                boost::shared_ptr<MarketModelEvolver> evolver =
+                    evolverFactory_->create(keeper);
+                if (begin > 0)
+                    keeper.generator()->skip(begin);
+
+                // each outer path runs innerPaths paths on each
+                // inner evolver
+                std::vector<boost::shared_ptr<MarketModelEvolver> >
+                    innerEvolvers;
+                for (Size j=0; j<innerEvolverFactories_.size(); ++j) {
+                    GeneratorKeeper innerKeeper(innerGeneratorFactories_[j]);
+                    innerEvolvers.push_back(
+                        innerEvolverFactories_[j]->create(innerKeeper));
+                    if (begin > 0)
+                        innerKeeper.generator()->skip(begin*innerPaths);
+                }
+
+                UpperBoundEngine engine(evolver, innerEvolvers,
+                                        *underlying_, *rebate_,
+                                        *hedge_, *hedgeRebate_,
+                                        *hedgeStrategy_,
+                                        initialNumeraireValue_);
+                for (Size i=begin; i<end; ++i)
+                    results[i] = engine.singlePathValue(innerPaths);
+            } catch (std::exception& e) {
+                errors[w] = e.what();
+            } catch (...) {
+                errors[w] = "unknown error";
+            }
+        }
+
+        for (Size w=0; w<workers; ++w)
+            QL_REQUIRE(errors[w].empty(),
+                       io::ordinal(w+1) << " worker failed: " << errors[w]);
+
+        for (Size i=0; i<outerPaths; ++i)
+            stats.add(results[i].first, results[i].second);
+    }
+
+}
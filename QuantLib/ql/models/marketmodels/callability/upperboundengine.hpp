@@ -23,6 +23,7 @@
 #define quantlib_upper_bound_engine_hpp
 
 #include <ql/models/marketmodels/products/multiproductcomposite.hpp>
+#include <ql/models/marketmodels/callability/exercisevalue.hpp>
 #include <ql/methods/montecarlo/exercisestrategy.hpp>
 #include <ql/math/statistics/sequencestatistics.hpp>
 #include <ql/utilities/clone.hpp>
@@ -32,6 +33,8 @@
 namespace QuantLib {
 
     class MarketModelEvolver;
+    class MarketModelEvolverFactory;
+    class BrownianGeneratorFactory;
     class MarketModelDiscounter;
     class MarketModelMultiProduct;
     class MarketModelExerciseValue;
@@ -75,11 +78,63 @@ namespace QuantLib {
 
         // workspace
         std::vector<Size> numberCashFlowsThisStep_;
-        std::vector<std::vector<MarketModelMultiProduct::CashFlow> >
-                                                         cashFlowsGenerated_;
+        MarketModelMultiProduct::CashFlowBuffer cashFlowsGenerated_;
         std::vector<MarketModelDiscounter> discounters_;
     };
 
+
+    //! Market-model %engine for upper-bound estimation on several threads
+    /*! Outer paths are split into contiguous blocks, one for each
+        worker; the blocks are simulated in parallel when QuantLib
+        is compiled with OpenMP support, and one after the other
+        otherwise.  Each worker owns an UpperBoundEngine with its
+        own copies of the evolvers and products, so that memory
+        grows with the number of workers rather than with the
+        number of paths.
+
+        The generators of each worker are moved forward once over
+        the paths of the preceding blocks; therefore, the results
+        are the same as the ones of a serial UpperBoundEngine built
+        on evolvers from the same factories, regardless of the
+        number of workers.
+
+        \warning the cost of skipping paths depends on the
+                 generator; with a linear cost, the last worker
+                 skips nearly all the paths before its block.
+    */
+    class ParallelUpperBoundEngine {
+      public:
+        ParallelUpperBoundEngine(
+            const boost::shared_ptr<MarketModelEvolverFactory>& evolverFactory,
+            const boost::shared_ptr<BrownianGeneratorFactory>& generatorFactory,
+            const std::vector<boost::shared_ptr<MarketModelEvolverFactory> >&
+                                                        innerEvolverFactories,
+            const std::vector<boost::shared_ptr<BrownianGeneratorFactory> >&
+                                                      innerGeneratorFactories,
+            const MarketModelMultiProduct& underlying,
+            const MarketModelExerciseValue& rebate,
+            const MarketModelMultiProduct& hedge,
+            const MarketModelExerciseValue& hedgeRebate,
+            const ExerciseStrategy<CurveState>& hedgeStrategy,
+            Real initialNumeraireValue,
+            Size workers = 0);
+        void multiplePathValues(Statistics& stats,
+                                Size outerPaths,
+                                Size innerPaths);
+      private:
+        boost::shared_ptr<MarketModelEvolverFactory> evolverFactory_;
+        boost::shared_ptr<BrownianGeneratorFactory> generatorFactory_;
+        std::vector<boost::shared_ptr<MarketModelEvolverFactory> >
+                                                       innerEvolverFactories_;
+        std::vector<boost::shared_ptr<BrownianGeneratorFactory> >
+                                                     innerGeneratorFactories_;
+        Clone<MarketModelMultiProduct> underlying_, hedge_;
+        Clone<MarketModelExerciseValue> rebate_, hedgeRebate_;
+        Clone<ExerciseStrategy<CurveState> > hedgeStrategy_;
+        Real initialNumeraireValue_;
+        Size workers_;
+    };
+
 }
 
 #endif
@@ -0,0 +1,93 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2015 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file cashflowbuffer.hpp
+    \brief flat storage for the cash flows generated by market-model products
+*/
+
+#ifndef quantlib_market_model_cash_flow_buffer_hpp
+#define quantlib_market_model_cash_flow_buffer_hpp
+
+#include <ql/types.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    //! flat storage for the cash flows generated at each step
+    /*! The buffer holds a fixed number of cash-flow slots for each of
+        the products in a multi-product, stored contiguously in a
+        single vector.  It is allocated once by the engine driving
+        the products and reused at every step of every path;
+        <tt>buffer[i][k]</tt> gives access to the k-th cash flow of
+        the i-th product as it would for a vector of vectors.
+
+        The slots are copied from the passed prototype at
+        construction, so that cash flows holding their own storage
+        (such as the vector of amounts of pathwise products) are
+        sized in advance as well.
+    */
+    template <class CashFlowType>
+    class MarketModelCashFlowBuffer {
+      public:
+        typedef CashFlowType value_type;
+        typedef typename std::vector<CashFlowType>::iterator iterator;
+        typedef typename std::vector<CashFlowType>::const_iterator
+                                                            const_iterator;
+        MarketModelCashFlowBuffer()
+        : numberOfProducts_(0), maxCashFlowsPerProduct_(0) {}
+        MarketModelCashFlowBuffer(Size numberOfProducts,
+                                  Size maxCashFlowsPerProduct,
+                                  const CashFlowType& prototype =
+                                                              CashFlowType())
+        : numberOfProducts_(numberOfProducts),
+          maxCashFlowsPerProduct_(maxCashFlowsPerProduct),
+          cashFlows_(numberOfProducts*maxCashFlowsPerProduct, prototype) {}
+        //! \name Inspectors
+        //@{
+        Size numberOfProducts() const { return numberOfProducts_; }
+        Size maxCashFlowsPerProduct() const {
+            return maxCashFlowsPerProduct_;
+        }
+        //@}
+        //! \name Element access
+        //@{
+        //! first cash-flow slot of the given product
+        iterator operator[](Size product) {
+            return cashFlows_.begin() + product*maxCashFlowsPerProduct_;
+        }
+        const_iterator operator[](Size product) const {
+            return cashFlows_.begin() + product*maxCashFlowsPerProduct_;
+        }
+        //@}
+        //! \name Iterator access
+        //@{
+        iterator begin() { return cashFlows_.begin(); }
+        iterator end() { return cashFlows_.end(); }
+        const_iterator begin() const { return cashFlows_.begin(); }
+        const_iterator end() const { return cashFlows_.end(); }
+        //@}
+      private:
+        Size numberOfProducts_, maxCashFlowsPerProduct_;
+        std::vector<CashFlowType> cashFlows_;
+    };
+
+}
+
+
+#endif
@@ -35,7 +35,9 @@ namespace QuantLib {
       irrCMSwapRates_(numberOfRates_),
       irrCMSwapAnnuities_(numberOfRates_, rateTaus_[numberOfRates_-1]),
       cotSwapRates_(numberOfRates_),
-      cotAnnuities_(numberOfRates_, rateTaus_[numberOfRates_-1]) {}
+      cotAnnuities_(numberOfRates_, rateTaus_[numberOfRates_-1]),
+      forwardRatesComped_(false), cotSwapRatesComped_(false),
+      irrSpanningForwards_(0) {}
 
     void CMSwapCurveState::setOnCMSwapRates(const std::vector<Rate>& rates,
                                             Size firstValidIndex) {
@@ -82,6 +84,9 @@ namespace QuantLib {
         cmSwapRates_[first_]*cmSwapAnnuities_[first_];
 
         // lazy evaluation of forward and coterminal swap rates&annuities
+        forwardRatesComped_ = false;
+        cotSwapRatesComped_ = false;
+        irrSpanningForwards_ = 0;
     }
 
     Real CMSwapCurveState::discountRatio(Size i, Size j) const {
@@ -94,8 +99,10 @@ namespace QuantLib {
     Rate CMSwapCurveState::forwardRate(Size i) const {
         QL_REQUIRE(first_<numberOfRates_, "curve state not initialized yet");
         QL_REQUIRE(i>=first_ && i<=numberOfRates_, "invalid index");
-        forwardsFromDiscountRatios(first_, discRatios_, rateTaus_, forwardRates_);
-        return forwardRates_[i];
+        if (forwardRatesComped_)
+            return forwardRates_[i];
+        return (discRatios_[i]-discRatios_[i+1])/
+            (discRatios_[i+1]*rateTaus_[i]);
     }
 
     Rate CMSwapCurveState::coterminalSwapAnnuity(Size numeraire,
@@ -104,18 +111,14 @@ namespace QuantLib {
         QL_REQUIRE(numeraire>=first_ && numeraire<=numberOfRates_,
                    "invalid numeraire");
         QL_REQUIRE(i>=first_ && i<=numberOfRates_, "invalid index");
-        coterminalFromDiscountRatios(first_,
-                                     discRatios_, rateTaus_,
-                                     cotSwapRates_, cotAnnuities_);
+        computeCoterminalSwapRates();
         return cotAnnuities_[i]/discRatios_[numeraire];
     }
 
     Rate CMSwapCurveState::coterminalSwapRate(Size i) const {
         QL_REQUIRE(first_<numberOfRates_, "curve state not initialized yet");
         QL_REQUIRE(i>=first_ && i<=numberOfRates_, "invalid index");
-        coterminalFromDiscountRatios(first_,
-                                     discRatios_, rateTaus_,
-                                     cotSwapRates_, cotAnnuities_);
+        computeCoterminalSwapRates();
         return cotSwapRates_[i];
     }
 
@@ -129,10 +132,7 @@ namespace QuantLib {
         if (spanningForwards==spanningFwds_)
             return cmSwapAnnuities_[i]/discRatios_[numeraire];
         else {
-            constantMaturityFromDiscountRatios(spanningForwards, first_,
-                                               discRatios_, rateTaus_,
-                                               irrCMSwapRates_,
-                                               irrCMSwapAnnuities_);
+            computeIrrCMSwapRates(spanningForwards);
             return irrCMSwapAnnuities_[i]/discRatios_[numeraire];
         }
     }
@@ -144,25 +144,24 @@ namespace QuantLib {
         if (spanningForwards==spanningFwds_)
             return cmSwapRates_[i];
         else {
-            constantMaturityFromDiscountRatios(spanningForwards, first_,
-                                               discRatios_, rateTaus_,
-                                               irrCMSwapRates_,
-                                               irrCMSwapAnnuities_);
+            computeIrrCMSwapRates(spanningForwards);
             return irrCMSwapRates_[i];
         }
     }
 
     const std::vector<Rate>& CMSwapCurveState::forwardRates() const {
         QL_REQUIRE(first_<numberOfRates_, "curve state not initialized yet");
-        forwardsFromDiscountRatios(first_, discRatios_, rateTaus_, forwardRates_);
+        if (!forwardRatesComped_) {
+            forwardsFromDiscountRatios(first_, discRatios_, rateTaus_,
+                                       forwardRates_);
+            forwardRatesComped_ = true;
+        }
         return forwardRates_;
     }
 
     const std::vector<Rate>& CMSwapCurveState::coterminalSwapRates() const {
         QL_REQUIRE(first_<numberOfRates_, "curve state not initialized yet");
-        coterminalFromDiscountRatios(first_,
-                                     discRatios_, rateTaus_,
-                                     cotSwapRates_, cotAnnuities_);
+        computeCoterminalSwapRates();
         return cotSwapRates_;
     }
 
@@ -171,10 +170,29 @@ namespace QuantLib {
         if (spanningForwards==spanningFwds_)
             return cmSwapRates_;
         else {
+            computeIrrCMSwapRates(spanningForwards);
+            return irrCMSwapRates_;
+        }
+    }
+
+    void CMSwapCurveState::computeIrrCMSwapRates(
+                                            Size spanningForwards) const {
+        // the rates are cached for the last spanning requested
+        if (spanningForwards != irrSpanningForwards_) {
             constantMaturityFromDiscountRatios(spanningForwards, first_,
                                                discRatios_, rateTaus_,
-                                               irrCMSwapRates_, irrCMSwapAnnuities_);
-            return irrCMSwapRates_;
+                                               irrCMSwapRates_,
+                                               irrCMSwapAnnuities_);
+            irrSpanningForwards_ = spanningForwards;
+        }
+    }
+
+    void CMSwapCurveState::computeCoterminalSwapRates() const {
+        if (!cotSwapRatesComped_) {
+            coterminalFromDiscountRatios(first_,
+                                         discRatios_, rateTaus_,
+                                         cotSwapRates_, cotAnnuities_);
+            cotSwapRatesComped_ = true;
         }
     }
 
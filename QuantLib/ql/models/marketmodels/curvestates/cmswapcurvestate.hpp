@@ -60,6 +60,8 @@ namespace QuantLib {
         }
         //@}
       private:
+        void computeIrrCMSwapRates(Size spanningForwards) const;
+        void computeCoterminalSwapRates() const;
         Size spanningFwds_;
         Size first_;
         std::vector<DiscountFactor> discRatios_;
@@ -72,6 +74,9 @@ namespace QuantLib {
         mutable std::vector<Real> irrCMSwapAnnuities_;
         mutable std::vector<Rate> cotSwapRates_;
         mutable std::vector<Real> cotAnnuities_;
+        mutable bool forwardRatesComped_;
+        mutable bool cotSwapRatesComped_;
+        mutable Size irrSpanningForwards_;
     };
 
 }
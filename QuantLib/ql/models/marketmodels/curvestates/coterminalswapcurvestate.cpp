@@ -32,7 +32,8 @@ namespace QuantLib {
       cmSwapRates_(numberOfRates_),
       cmSwapAnnuities_(numberOfRates_, rateTaus_[numberOfRates_-1]),
       cotSwapRates_(numberOfRates_),
-      cotAnnuities_(numberOfRates_, rateTaus_[numberOfRates_-1]) {}
+      cotAnnuities_(numberOfRates_, rateTaus_[numberOfRates_-1]),
+      forwardRatesComped_(false), cmSpanningForwards_(0) {}
 
       void CoterminalSwapCurveState::setOnCoterminalSwapRates(
                                         const std::vector<Rate>& rates,
@@ -45,24 +46,44 @@ namespace QuantLib {
                        "first valid index must be less than " <<
                        numberOfRates_ << ": " <<
                        firstValidIndex << " not allowed");
-        // first copy input...
+        // first copy input, keeping track of the last rate that
+        // changed (rates that were not valid count as changed)...
+        Size oldFirst = first_;
         first_ = firstValidIndex;
-        std::copy(rates.begin()+first_, rates.end(),
-                  cotSwapRates_.begin()+first_);
+        Size lastChanged = numberOfRates_;
+        for (Size i=first_; i<numberOfRates_; ++i) {
+            if (i < oldFirst || rates[i] != cotSwapRates_[i]) {
+                cotSwapRates_[i] = rates[i];
+                lastChanged = i;
+            }
+        }
+
+        if (lastChanged == numberOfRates_)
+            return;
+        // annuities were only calculated down to the old first
+        // index, so the ones before it must be calculated anyway
+        if (first_ < oldFirst && oldFirst < numberOfRates_)
+            lastChanged = std::max(lastChanged, oldFirst);
+
         // ...then calculate discount ratios and coterminal annuities:
         // reference discount bond =  P(n) (the last one)
         // discRatios_[numberOfRates_] = P(n)/P(n) = 1.0 by construction/definition
-        cotAnnuities_[numberOfRates_-1] = rateTaus_[numberOfRates_-1];
+        // cotAnnuities_[numberOfRates_-1] = rateTaus_[numberOfRates_-1]
+        // also taken care of at construction time. Discount ratios
+        // and annuities after the last changed rate don't depend on
+        // it and are kept.
         // j < n
-        for (Size i=numberOfRates_-1; i>first_; --i) {
+        for (Size i=lastChanged; i>first_; --i) {
             discRatios_[i] = 1.0 + cotSwapRates_[i] * cotAnnuities_[i];
             cotAnnuities_[i-1] = cotAnnuities_[i] + rateTaus_[i-1] * discRatios_[i];
         }
         discRatios_[first_] = 1.0 + cotSwapRates_[first_] * cotAnnuities_[first_];
 
-        // Insert here lazy evaluation of:
+        // lazy evaluation of:
         // - forward rates
         // - constant maturity swap rates/annuities
+        forwardRatesComped_ = false;
+        cmSpanningForwards_ = 0;
     }
 
     Real CoterminalSwapCurveState::discountRatio(Size i, Size j) const {
@@ -75,8 +96,10 @@ namespace QuantLib {
     Rate CoterminalSwapCurveState::forwardRate(Size i) const {
         QL_REQUIRE(first_<numberOfRates_, "curve state not initialized yet");
         QL_REQUIRE(i>=first_ && i<=numberOfRates_, "invalid index");
-        forwardsFromDiscountRatios(first_, discRatios_, rateTaus_, forwardRates_);
-        return forwardRates_[i];
+        if (forwardRatesComped_)
+            return forwardRates_[i];
+        return (discRatios_[i]-discRatios_[i+1])/
+            (discRatios_[i+1]*rateTaus_[i]);
     }
 
     Rate CoterminalSwapCurveState::coterminalSwapAnnuity(Size numeraire,
@@ -102,10 +125,7 @@ namespace QuantLib {
                    "invalid numeraire");
         QL_REQUIRE(i>=first_ && i<=numberOfRates_, "invalid index");
 
-        // consider lazy evaluation here
-        constantMaturityFromDiscountRatios(spanningForwards, first_,
-                                           discRatios_, rateTaus_,
-                                           cmSwapRates_, cmSwapAnnuities_);
+        computeCMSwapRates(spanningForwards);
         return cmSwapAnnuities_[i]/discRatios_[numeraire];
     }
 
@@ -114,16 +134,17 @@ namespace QuantLib {
         QL_REQUIRE(first_<numberOfRates_, "curve state not initialized yet");
         QL_REQUIRE(i>=first_ && i<=numberOfRates_, "invalid index");
 
-        // consider lazy evaluation here
-        constantMaturityFromDiscountRatios(spanningForwards, first_,
-                                           discRatios_, rateTaus_,
-                                           cmSwapRates_, cmSwapAnnuities_);
+        computeCMSwapRates(spanningForwards);
         return cmSwapRates_[i];
     }
 
     const std::vector<Rate>& CoterminalSwapCurveState::forwardRates() const {
         QL_REQUIRE(first_<numberOfRates_, "curve state not initialized yet");
-        forwardsFromDiscountRatios(first_, discRatios_, rateTaus_, forwardRates_);
+        if (!forwardRatesComped_) {
+            forwardsFromDiscountRatios(first_, discRatios_, rateTaus_,
+                                       forwardRates_);
+            forwardRatesComped_ = true;
+        }
         return forwardRates_;
     }
 
@@ -134,10 +155,20 @@ namespace QuantLib {
 
     const std::vector<Rate>& CoterminalSwapCurveState::cmSwapRates(Size spanningForwards) const {
         QL_REQUIRE(first_<numberOfRates_, "curve state not initialized yet");
-        constantMaturityFromDiscountRatios(spanningForwards, first_,
-                                           discRatios_, rateTaus_,
-                                           cmSwapRates_, cmSwapAnnuities_);
+        computeCMSwapRates(spanningForwards);
         return cmSwapRates_;
     }
 
+    void CoterminalSwapCurveState::computeCMSwapRates(
+                                            Size spanningForwards) const {
+        // the rates are cached for the last spanning requested
+        if (spanningForwards != cmSpanningForwards_) {
+            constantMaturityFromDiscountRatios(spanningForwards, first_,
+                                               discRatios_, rateTaus_,
+                                               cmSwapRates_,
+                                               cmSwapAnnuities_);
+            cmSpanningForwards_ = spanningForwards;
+        }
+    }
+
 }
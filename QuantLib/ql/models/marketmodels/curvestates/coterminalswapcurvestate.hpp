@@ -35,6 +35,11 @@ namespace QuantLib {
         to other engines such as a coterminal swap rate engine.
         Many products will not need expired rates and others will only require
         the first rate.
+
+        When new swap rates are set, discount ratios and annuities are
+        only recalculated from the last changed rate backwards; forward
+        and constant-maturity swap rates are calculated lazily and
+        cached until the next change.
     */
     class CoterminalSwapCurveState : public CurveState {
     /* There will n+1 rate times expressing payment and reset times
@@ -77,6 +82,7 @@ namespace QuantLib {
                 new CoterminalSwapCurveState(*this));
         }
       private:
+        void computeCMSwapRates(Size spanningForwards) const;
         Size first_;
         std::vector<DiscountFactor> discRatios_;
         mutable std::vector<Rate> forwardRates_;
@@ -84,6 +90,8 @@ namespace QuantLib {
         mutable std::vector<Real> cmSwapAnnuities_;
         std::vector<Rate> cotSwapRates_;
         std::vector<Real> cotAnnuities_;
+        mutable bool forwardRatesComped_;
+        mutable Size cmSpanningForwards_;
     };
 
 }
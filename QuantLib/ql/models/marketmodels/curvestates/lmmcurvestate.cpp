@@ -35,7 +35,9 @@ namespace QuantLib {
       cotSwapRates_(numberOfRates_),
       cotAnnuities_(numberOfRates_,
       rateTaus_[numberOfRates_-1]),
-      firstCotAnnuityComped_(numberOfRates_)
+      firstDiscRatioComped_(numberOfRates_),
+      firstCotAnnuityComped_(numberOfRates_),
+      cmSpanningForwards_(0), cotSwapRatesComped_(false)
     {}
 
     void LMMCurveState::setOnForwardRates(const std::vector<Rate>& rates,
@@ -49,22 +51,33 @@ namespace QuantLib {
                        numberOfRates_ << ": " <<
                        firstValidIndex << " not allowed");
 
-        // first copy input...
+        // first copy input, keeping track of the last rate that
+        // changed (rates that were not valid count as changed)...
+        Size oldFirst = first_;
         first_ = firstValidIndex;
-        std::copy(rates.begin()+first_, rates.end(),
-                  forwardRates_.begin()+first_);
-        // ...then calculate discount ratios
-
-        // taken care at constructor time
-        //discRatios_[numberOfRates_] = 1.0;
-        for (Size i=first_; i<numberOfRates_; ++i)
-            discRatios_[i+1]=discRatios_[i]/(1.0+forwardRates_[i]*rateTaus_[i]);
-
-        // lazy evaluation of:
-        // - coterminal swap rates/annuities
-        // - constant maturity swap rates/annuities
+        Size lastChanged = numberOfRates_;
+        for (Size i=first_; i<numberOfRates_; ++i) {
+            if (i < oldFirst || rates[i] != forwardRates_[i]) {
+                forwardRates_[i] = rates[i];
+                lastChanged = i;
+            }
+        }
 
-        firstCotAnnuityComped_ = numberOfRates_;
+        if (lastChanged == numberOfRates_)
+            return;
+
+        // ...then invalidate what depends on it. Discount ratios
+        // are normalized to the last one (taken care of at
+        // constructor time) so that discRatios_[i] only depends on
+        // the forwards from i onwards, and annuity i only depends on
+        // the discount ratios after i.  The rest is recalculated
+        // lazily when requested.
+        firstDiscRatioComped_ =
+            std::max(firstDiscRatioComped_, lastChanged+1);
+        firstCotAnnuityComped_ =
+            std::max(firstCotAnnuityComped_, lastChanged);
+        cmSpanningForwards_ = 0;
+        cotSwapRatesComped_ = false;
     }
 
     void LMMCurveState::setOnDiscountRatios(const std::vector<DiscountFactor>& discRatios,
@@ -92,13 +105,24 @@ namespace QuantLib {
         // - coterminal swap rates/annuities
         // - constant maturity swap rates/annuities
 
+        firstDiscRatioComped_ = first_;
         firstCotAnnuityComped_ = numberOfRates_;
+        cmSpanningForwards_ = 0;
+        cotSwapRatesComped_ = false;
+    }
+
+    void LMMCurveState::computeDiscountRatios(Size i) const {
+        for (Size k=firstDiscRatioComped_; k>i; --k)
+            discRatios_[k-1] =
+                discRatios_[k]*(1.0+forwardRates_[k-1]*rateTaus_[k-1]);
+        firstDiscRatioComped_ = std::min(firstDiscRatioComped_, i);
     }
 
     Real LMMCurveState::discountRatio(Size i, Size j) const {
         QL_REQUIRE(first_<numberOfRates_, "curve state not initialized yet");
         QL_REQUIRE(std::min(i, j)>=first_, "invalid index");
         QL_REQUIRE(std::max(i, j)<=numberOfRates_, "invalid index");
+        computeDiscountRatios(std::min(i, j));
         return discRatios_[i]/discRatios_[j];
     }
 
@@ -118,6 +142,8 @@ namespace QuantLib {
         //                                   discRatios_, rateTaus_,
         //                                 cotSwapRates_, cotAnnuities_);
 
+        computeDiscountRatios(std::min(i, numeraire));
+
         if (firstCotAnnuityComped_ <=i)
             return  cotAnnuities_[i]/discRatios_[numeraire];
 
@@ -143,6 +169,7 @@ namespace QuantLib {
         //                             cotSwapRates_, cotAnnuities_);
         //      return cotSwapRates_[i];
 
+        computeDiscountRatios(i);
         Real res = (discRatios_[i]/ discRatios_[numberOfRates_] -1.0)/coterminalSwapAnnuity(numberOfRates_,i);
         return res;
     }
@@ -155,10 +182,7 @@ namespace QuantLib {
                    "invalid numeraire");
         QL_REQUIRE(i>=first_ && i<=numberOfRates_, "invalid index");
 
-        // consider lazy evaluation here
-        constantMaturityFromDiscountRatios(spanningForwards, first_,
-                                           discRatios_, rateTaus_,
-                                           cmSwapRates_, cmSwapAnnuities_);
+        computeCMSwapRates(spanningForwards);
         return cmSwapAnnuities_[i]/discRatios_[numeraire];
     }
 
@@ -167,10 +191,7 @@ namespace QuantLib {
         QL_REQUIRE(first_<numberOfRates_, "curve state not initialized yet");
         QL_REQUIRE(i>=first_ && i<=numberOfRates_, "invalid index");
 
-        // consider lazy evaluation here
-        constantMaturityFromDiscountRatios(spanningForwards, first_,
-                                           discRatios_, rateTaus_,
-                                           cmSwapRates_, cmSwapAnnuities_);
+        computeCMSwapRates(spanningForwards);
         return cmSwapRates_[i];
     }
 
@@ -181,18 +202,33 @@ namespace QuantLib {
 
     const std::vector<Rate>& LMMCurveState::coterminalSwapRates() const {
         QL_REQUIRE(first_<numberOfRates_, "curve state not initialized yet");
-        coterminalFromDiscountRatios(first_,
-                                     discRatios_, rateTaus_,
-                                     cotSwapRates_, cotAnnuities_);
+        if (!cotSwapRatesComped_) {
+            computeDiscountRatios(first_);
+            coterminalFromDiscountRatios(first_,
+                                         discRatios_, rateTaus_,
+                                         cotSwapRates_, cotAnnuities_);
+            firstCotAnnuityComped_ = first_;
+            cotSwapRatesComped_ = true;
+        }
         return cotSwapRates_;
     }
 
     const std::vector<Rate>& LMMCurveState::cmSwapRates(Size spanningForwards) const {
         QL_REQUIRE(first_<numberOfRates_, "curve state not initialized yet");
-        constantMaturityFromDiscountRatios(spanningForwards, first_,
-                                           discRatios_, rateTaus_,
-                                           cmSwapRates_, cmSwapAnnuities_);
+        computeCMSwapRates(spanningForwards);
         return cmSwapRates_;
     }
 
+    void LMMCurveState::computeCMSwapRates(Size spanningForwards) const {
+        // the rates are cached for the last spanning requested
+        if (spanningForwards != cmSpanningForwards_) {
+            computeDiscountRatios(first_);
+            constantMaturityFromDiscountRatios(spanningForwards, first_,
+                                               discRatios_, rateTaus_,
+                                               cmSwapRates_,
+                                               cmSwapAnnuities_);
+            cmSpanningForwards_ = spanningForwards;
+        }
+    }
+
 }
@@ -35,6 +35,15 @@ namespace QuantLib {
         to other engines such as a coterminal swap rate engine.
         Many products will not need expired rates and others will only require
         the first rate.
+
+        Discount ratios are normalized to the last rate time and
+        calculated lazily, from the last one backwards, down to the
+        earliest one requested; coterminal annuities are also
+        accumulated backwards as needed.  When new forward rates are
+        set, only the discount ratios and annuities depending on the
+        rates that actually changed are invalidated.  Constant-maturity
+        and coterminal swap-rate vectors are cached until the next
+        change.
     */
     class LMMCurveState : public CurveState {
     /* There will n+1 rate times expressing payment and reset times
@@ -82,15 +91,20 @@ namespace QuantLib {
         }
 
       private:
+        void computeDiscountRatios(Size i) const;
+        void computeCMSwapRates(Size spanningForwards) const;
         Size first_;
-        std::vector<DiscountFactor> discRatios_;
+        mutable std::vector<DiscountFactor> discRatios_;
         std::vector<Rate> forwardRates_;
         mutable std::vector<Rate> cmSwapRates_;
         mutable std::vector<Real> cmSwapAnnuities_;
         mutable std::vector<Rate> cotSwapRates_;
         mutable std::vector<Real> cotAnnuities_;
 
+        mutable Size firstDiscRatioComped_;
         mutable Size firstCotAnnuityComped_;
+        mutable Size cmSpanningForwards_;
+        mutable bool cotSwapRatesComped_;
     };
 
 }
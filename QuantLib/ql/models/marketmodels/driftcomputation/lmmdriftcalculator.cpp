@@ -181,4 +181,98 @@ namespace QuantLib {
         }
     }
 
+    void LMMDriftCalculator::compute(const Matrix& fwds,
+                                     Matrix& drifts) const {
+        #if defined(QL_EXTRA_SAFETY_CHECKS)
+            QL_REQUIRE(fwds.rows()==numberOfRates_, "numberOfRates <> dim");
+            QL_REQUIRE(drifts.rows()==numberOfRates_, "drifts.rows() <> dim");
+            QL_REQUIRE(drifts.columns()==fwds.columns(),
+                       "drifts.columns() <> fwds.columns()");
+        #endif
+
+        if (isFullFactor_)
+            computePlain(fwds, drifts);
+        else
+            computeReduced(fwds, drifts);
+    }
+
+    void LMMDriftCalculator::computePlain(const Matrix& forwards,
+                                          Matrix& drifts) const {
+
+        Size paths = forwards.columns();
+        if (tmpBlock_.columns() != paths)
+            tmpBlock_ = Matrix(numberOfRates_, paths, 0.0);
+
+        // Precompute forwards factor
+        Size i, j, p;
+        for (i=alive_; i<numberOfRates_; ++i)
+            for (p=0; p<paths; ++p)
+                tmpBlock_[i][p] = (forwards[i][p]+displacements_[i]) /
+                                  (oneOverTaus_[i]+forwards[i][p]);
+
+        // Compute drifts as the product of a band of the covariance
+        // matrix times the forwards factors
+        for (i=alive_; i<numberOfRates_; ++i) {
+            Real sign = (numeraire_>i+1) ? -1.0 : 1.0;
+            std::fill(drifts.row_begin(i), drifts.row_end(i), 0.0);
+            for (j=downs_[i]; j<ups_[i]; ++j) {
+                Real c = sign*C_[i][j];
+                for (p=0; p<paths; ++p)
+                    drifts[i][p] += c*tmpBlock_[j][p];
+            }
+        }
+    }
+
+    void LMMDriftCalculator::computeReduced(const Matrix& forwards,
+                                            Matrix& drifts) const {
+
+        Size paths = forwards.columns();
+        if (tmpBlock_.columns() != paths)
+            tmpBlock_ = Matrix(numberOfRates_, paths, 0.0);
+        if (eBlock_.columns() != paths)
+            eBlock_ = Matrix(numberOfFactors_, paths, 0.0);
+
+        // Precompute forwards factor
+        Size r, p;
+        for (Size i=alive_; i<numberOfRates_; ++i)
+            for (p=0; p<paths; ++p)
+                tmpBlock_[i][p] = (forwards[i][p]+displacements_[i]) /
+                                  (oneOverTaus_[i]+forwards[i][p]);
+
+        // Same three steps as in the single-path version; eBlock_
+        // holds the running sums of the current rate for all paths.
+
+        // 1st step
+        if (numeraire_>0)
+            std::fill(drifts.row_begin(numeraire_-1),
+                      drifts.row_end(numeraire_-1), 0.0);
+
+        // 2nd step
+        std::fill(eBlock_.begin(), eBlock_.end(), 0.0);
+        for (Integer i=static_cast<Integer>(numeraire_)-2;
+             i>=static_cast<Integer>(alive_); --i) {
+            std::fill(drifts.row_begin(i), drifts.row_end(i), 0.0);
+            for (r=0; r<numberOfFactors_; ++r) {
+                Real a = pseudo_[i+1][r], b = pseudo_[i][r];
+                for (p=0; p<paths; ++p) {
+                    eBlock_[r][p] += tmpBlock_[i+1][p] * a;
+                    drifts[i][p] -= eBlock_[r][p] * b;
+                }
+            }
+        }
+
+        // 3rd step
+        std::fill(eBlock_.begin(), eBlock_.end(), 0.0);
+        for (Size i=numeraire_; i<numberOfRates_; ++i) {
+            std::fill(drifts.row_begin(i), drifts.row_end(i), 0.0);
+            for (r=0; r<numberOfFactors_; ++r) {
+                Real a = pseudo_[i][r];
+                for (p=0; p<paths; ++p) {
+                    eBlock_[r][p] += tmpBlock_[i][p] * a;
+                    drifts[i][p] += eBlock_[r][p] * a;
+                }
+            }
+        }
+    }
+
 }
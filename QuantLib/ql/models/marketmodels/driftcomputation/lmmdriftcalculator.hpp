@@ -64,6 +64,16 @@ namespace QuantLib {
         void computeReduced(const std::vector<Rate>& fwds,
                             std::vector<Real>& drifts) const;
 
+        /*! Computes the drifts for a block of paths. Each column of
+            the passed matrices corresponds to a path; the loops are
+            arranged so that the innermost one runs across paths. */
+        void compute(const Matrix& fwds,
+                     Matrix& drifts) const;
+        void computePlain(const Matrix& fwds,
+                          Matrix& drifts) const;
+        void computeReduced(const Matrix& fwds,
+                            Matrix& drifts) const;
+
       private:
         Size numberOfRates_, numberOfFactors_;
         bool isFullFactor_;
@@ -74,6 +84,7 @@ namespace QuantLib {
         // temporary variables to be added later
         mutable std::vector<Real> tmp_;
         mutable Matrix e_;
+        mutable Matrix tmpBlock_, eBlock_;
         std::vector<Size> downs_, ups_;
     };
 
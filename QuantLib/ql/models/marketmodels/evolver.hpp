@@ -21,12 +21,15 @@
 #ifndef quantlib_market_model_evolver_hpp
 #define quantlib_market_model_evolver_hpp
 
+#include <ql/models/marketmodels/marketmodel.hpp>
 #include <ql/types.hpp>
+#include <boost/shared_ptr.hpp>
 #include <vector>
 
 namespace QuantLib {
 
     class CurveState;
+    class BrownianGeneratorFactory;
 
     //! Market-model evolver
     /*! Abstract base class. The evolver does the actual gritty work of
@@ -44,6 +47,84 @@ namespace QuantLib {
         virtual void setInitialState(const CurveState&) = 0;
     };
 
+    //! Market-model evolver factory
+    /*! Abstract base class. It builds evolvers drawing their
+        Brownian increments from generators created by the passed
+        factory; it is used by engines that need several instances
+        of the same evolver, e.g., one per thread.
+
+        The create() method might be called concurrently by several
+        threads; engines doing so call prepare() beforehand on the
+        calling thread, and derived classes must perform there any
+        lazy initialization of the data read by create().
+    */
+    class MarketModelEvolverFactory {
+      public:
+        virtual ~MarketModelEvolverFactory() {}
+
+        virtual boost::shared_ptr<MarketModelEvolver> create(
+                                   const BrownianGeneratorFactory&) const = 0;
+        virtual void prepare() const {}
+    };
+
+    //! Factory for the evolvers with the usual constructor signature
+    /*! The Evolver class must provide a constructor taking a market
+        model, a Brownian-generator factory, the numeraires and the
+        initial step, as most of the available evolvers do.
+    */
+    template <class Evolver>
+    class GenericMarketModelEvolverFactory
+        : public MarketModelEvolverFactory {
+      public:
+        GenericMarketModelEvolverFactory(
+                            const boost::shared_ptr<MarketModel>& marketModel,
+                            const std::vector<Size>& numeraires,
+                            Size initialStep = 0)
+        : marketModel_(marketModel), numeraires_(numeraires),
+          initialStep_(initialStep) {}
+        boost::shared_ptr<MarketModelEvolver> create(
+                            const BrownianGeneratorFactory& factory) const {
+            return boost::shared_ptr<MarketModelEvolver>(
+                        new Evolver(marketModel_, factory,
+                                    numeraires_, initialStep_));
+        }
+        void prepare() const {
+            // the covariance matrices are calculated lazily by the
+            // model; doing it here avoids a race among the threads
+            // creating evolvers.
+            marketModel_->totalCovariance(marketModel_->numberOfSteps()-1);
+        }
+      private:
+        boost::shared_ptr<MarketModel> marketModel_;
+        std::vector<Size> numeraires_;
+        Size initialStep_;
+    };
+
+    //! Market-model evolver working on blocks of paths
+    /*! Abstract base class. The evolver advances a number of paths
+        at the same time, so that the calculations of each step
+        (e.g., drifts and diffusion terms) can be performed on all
+        of them in a single pass.
+    */
+    class MarketModelBlockEvolver {
+      public:
+        virtual ~MarketModelBlockEvolver() {}
+
+        virtual const std::vector<Size>& numeraires() const = 0;
+        //! maximum number of paths evolved at the same time
+        virtual Size blockSize() const = 0;
+        /*! starts the given number of paths (at most blockSize())
+            and writes their weights into the passed vector.
+        */
+        virtual void startNewPaths(Size paths,
+                                   std::vector<Real>& weights) = 0;
+        //! writes the weights of the current step for each path
+        virtual void advanceStep(std::vector<Real>& weights) = 0;
+        virtual Size currentStep() const = 0;
+        virtual const CurveState& currentState(Size path) const = 0;
+        virtual void setInitialState(const CurveState&) = 0;
+    };
+
 }
 
 #endif
@@ -9,6 +9,7 @@
 #include <ql/models/marketmodels/evolvers/lognormalfwdrateiballand.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdrateipc.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdratepc.hpp>
+#include <ql/models/marketmodels/evolvers/lognormalfwdratepcblock.hpp>
 #include <ql/models/marketmodels/evolvers/marketmodelvolprocess.hpp>
 #include <ql/models/marketmodels/evolvers/normalfwdratepc.hpp>
 #include <ql/models/marketmodels/evolvers/svddfwdratepc.hpp>
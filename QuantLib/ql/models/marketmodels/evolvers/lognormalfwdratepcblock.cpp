@@ -0,0 +1,224 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2015 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/models/marketmodels/evolvers/lognormalfwdratepcblock.hpp>
+#include <ql/models/marketmodels/marketmodel.hpp>
+#include <ql/models/marketmodels/evolutiondescription.hpp>
+#include <ql/models/marketmodels/browniangenerator.hpp>
+
+namespace QuantLib {
+
+    LogNormalFwdRatePcBlock::LogNormalFwdRatePcBlock(
+                           const boost::shared_ptr<MarketModel>& marketModel,
+                           const BrownianGeneratorFactory& factory,
+                           const std::vector<Size>& numeraires,
+                           Size blockSize,
+                           Size initialStep)
+    : marketModel_(marketModel),
+      numeraires_(numeraires),
+      blockSize_(blockSize),
+      initialStep_(initialStep),
+      numberOfRates_(marketModel->numberOfRates()),
+      numberOfFactors_(marketModel_->numberOfFactors()),
+      curveStates_(blockSize,
+                   LMMCurveState(marketModel->evolution().rateTimes())),
+      currentStep_(initialStep), paths_(0),
+      displacements_(marketModel->displacements()),
+      initialLogForwards_(numberOfRates_), initialDrifts_(numberOfRates_),
+      forwards_(numberOfRates_, blockSize),
+      logForwards_(numberOfRates_, blockSize),
+      drifts1_(numberOfRates_, blockSize),
+      drifts2_(numberOfRates_, blockSize),
+      brownian_(numberOfFactors_), diffusion_(blockSize),
+      pathForwards_(numberOfRates_),
+      alive_(marketModel->evolution().firstAliveRate())
+    {
+        QL_REQUIRE(blockSize > 0, "null block size");
+        checkCompatibility(marketModel->evolution(), numeraires);
+
+        Size steps = marketModel->evolution().numberOfSteps();
+
+        generator_ = factory.create(numberOfFactors_, steps-initialStep_);
+
+        brownians_ = std::vector<Matrix>(
+                            steps-initialStep_,
+                            Matrix(numberOfFactors_, blockSize_, 0.0));
+        stepWeights_ = Matrix(steps-initialStep_, blockSize_, 1.0);
+
+        const std::vector<Rate>& initialRates = marketModel_->initialRates();
+        for (Size i=0; i<numberOfRates_; ++i)
+            std::fill(forwards_.row_begin(i), forwards_.row_end(i),
+                      initialRates[i]);
+
+        calculators_.reserve(steps);
+        fixedDrifts_.reserve(steps);
+        for (Size j=0; j<steps; ++j) {
+            const Matrix& A = marketModel_->pseudoRoot(j);
+            calculators_.push_back(
+                LMMDriftCalculator(A,
+                                   displacements_,
+                                   marketModel->evolution().rateTaus(),
+                                   numeraires[j],
+                                   alive_[j]));
+            std::vector<Real> fixed(numberOfRates_);
+            for (Size k=0; k<numberOfRates_; ++k) {
+                Real variance =
+                    std::inner_product(A.row_begin(k), A.row_end(k),
+                                       A.row_begin(k), 0.0);
+                fixed[k] = -0.5*variance;
+            }
+            fixedDrifts_.push_back(fixed);
+        }
+
+        setForwards(initialRates);
+    }
+
+    const std::vector<Size>& LogNormalFwdRatePcBlock::numeraires() const {
+        return numeraires_;
+    }
+
+    Size LogNormalFwdRatePcBlock::blockSize() const {
+        return blockSize_;
+    }
+
+    void LogNormalFwdRatePcBlock::setForwards(
+                                          const std::vector<Real>& forwards) {
+        QL_REQUIRE(forwards.size()==numberOfRates_,
+                   "mismatch between forwards and rateTimes");
+        for (Size i=0; i<numberOfRates_; ++i)
+             initialLogForwards_[i] = std::log(forwards[i] +
+                                               displacements_[i]);
+        calculators_[initialStep_].compute(forwards, initialDrifts_);
+    }
+
+    void LogNormalFwdRatePcBlock::setInitialState(const CurveState& cs) {
+        setForwards(cs.forwardRates());
+    }
+
+    void LogNormalFwdRatePcBlock::startNewPaths(Size paths,
+                                                std::vector<Real>& weights) {
+        QL_REQUIRE(paths > 0 && paths <= blockSize_,
+                   "number of paths (" << paths << ") must be between "
+                   "1 and the block size (" << blockSize_ << ")");
+        QL_REQUIRE(weights.size() >= paths,
+                   "weight vector too short (" << weights.size()
+                   << " elements instead of " << paths << ")");
+
+        paths_ = paths;
+        currentStep_ = initialStep_;
+
+        // draw the whole paths from the generator, one after the
+        // other, so that they're the same as in the one-path case
+        for (Size p=0; p<paths_; ++p) {
+            weights[p] = generator_->nextPath();
+            for (Size s=0; s<brownians_.size(); ++s) {
+                stepWeights_[s][p] = generator_->nextStep(brownian_);
+                for (Size f=0; f<numberOfFactors_; ++f)
+                    brownians_[s][f][p] = brownian_[f];
+            }
+        }
+
+        for (Size i=0; i<numberOfRates_; ++i)
+            std::fill(logForwards_.row_begin(i), logForwards_.row_end(i),
+                      initialLogForwards_[i]);
+    }
+
+    void LogNormalFwdRatePcBlock::updateForwards(Size alive) {
+        for (Size i=alive; i<numberOfRates_; ++i) {
+            Matrix::const_row_iterator logF = logForwards_.row_begin(i);
+            Matrix::row_iterator f = forwards_.row_begin(i);
+            for (Size p=0; p<blockSize_; ++p)
+                f[p] = std::exp(logF[p]) - displacements_[i];
+        }
+    }
+
+    void LogNormalFwdRatePcBlock::advanceStep(std::vector<Real>& weights) {
+        // we're going from T1 to T2
+
+        Size i, f, p, alive = alive_[currentStep_];
+
+        // a) compute drifts D1 at T1;
+        if (currentStep_ > initialStep_) {
+            calculators_[currentStep_].compute(forwards_, drifts1_);
+        } else {
+            for (i=0; i<numberOfRates_; ++i)
+                std::fill(drifts1_.row_begin(i), drifts1_.row_end(i),
+                          initialDrifts_[i]);
+        }
+
+        // b) evolve forwards up to T2 using D1; the diffusion terms
+        //    are the product of the pseudo-root times the matrix of
+        //    Brownian increments for all paths;
+        const Matrix& A = marketModel_->pseudoRoot(currentStep_);
+        const Matrix& Z = brownians_[currentStep_-initialStep_];
+        const std::vector<Real>& fixedDrift = fixedDrifts_[currentStep_];
+
+        for (i=alive; i<numberOfRates_; ++i) {
+            std::fill(diffusion_.begin(), diffusion_.end(), 0.0);
+            for (f=0; f<numberOfFactors_; ++f) {
+                Real a = A[i][f];
+                Matrix::const_row_iterator z = Z.row_begin(f);
+                for (p=0; p<blockSize_; ++p)
+                    diffusion_[p] += a*z[p];
+            }
+            Matrix::row_iterator logF = logForwards_.row_begin(i);
+            Matrix::const_row_iterator d1 = drifts1_.row_begin(i);
+            for (p=0; p<blockSize_; ++p) {
+                logF[p] += d1[p] + fixedDrift[i];
+                logF[p] += diffusion_[p];
+            }
+        }
+        updateForwards(alive);
+
+        // c) recompute drifts D2 using the predicted forwards;
+        calculators_[currentStep_].compute(forwards_, drifts2_);
+
+        // d) correct forwards using both drifts
+        for (i=alive; i<numberOfRates_; ++i) {
+            Matrix::row_iterator logF = logForwards_.row_begin(i);
+            Matrix::const_row_iterator d1 = drifts1_.row_begin(i);
+            Matrix::const_row_iterator d2 = drifts2_.row_begin(i);
+            for (p=0; p<blockSize_; ++p)
+                logF[p] += (d2[p]-d1[p])/2.0;
+        }
+        updateForwards(alive);
+
+        // e) update curve states
+        for (p=0; p<paths_; ++p) {
+            std::copy(forwards_.column_begin(p), forwards_.column_end(p),
+                      pathForwards_.begin());
+            curveStates_[p].setOnForwardRates(pathForwards_);
+            weights[p] = stepWeights_[currentStep_-initialStep_][p];
+        }
+
+        ++currentStep_;
+    }
+
+    Size LogNormalFwdRatePcBlock::currentStep() const {
+        return currentStep_;
+    }
+
+    const CurveState& LogNormalFwdRatePcBlock::currentState(Size p) const {
+        #if defined(QL_EXTRA_SAFETY_CHECKS)
+        QL_REQUIRE(p < paths_, "path index out of range");
+        #endif
+        return curveStates_[p];
+    }
+
+}
@@ -0,0 +1,94 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2015 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file lognormalfwdratepcblock.hpp
+    \brief Predictor-corrector evolver working on blocks of paths
+*/
+
+#ifndef quantlib_forward_rate_pc_block_evolver_hpp
+#define quantlib_forward_rate_pc_block_evolver_hpp
+
+#include <ql/models/marketmodels/evolver.hpp>
+#include <ql/models/marketmodels/curvestates/lmmcurvestate.hpp>
+#include <ql/models/marketmodels/driftcomputation/lmmdriftcalculator.hpp>
+
+namespace QuantLib {
+
+    class MarketModel;
+    class BrownianGenerator;
+    class BrownianGeneratorFactory;
+
+    //! Predictor-Corrector on blocks of paths
+    /*! This evolver uses the same discretization as
+        LogNormalFwdRatePc, but advances a block of paths at each
+        call; the drifts and the products of the pseudo-roots times
+        the Brownian increments are calculated for all the paths of
+        the block at once.  Forward rates and increments are stored
+        as matrices with a column per path.
+
+        The Brownian increments of each path in the block are drawn
+        from the generator when the paths are started, so that the
+        evolved paths are the same as those of LogNormalFwdRatePc
+        using the same generator.
+    */
+    class LogNormalFwdRatePcBlock : public MarketModelBlockEvolver {
+      public:
+        LogNormalFwdRatePcBlock(const boost::shared_ptr<MarketModel>&,
+                                const BrownianGeneratorFactory&,
+                                const std::vector<Size>& numeraires,
+                                Size blockSize,
+                                Size initialStep = 0);
+        //! \name MarketModelBlockEvolver interface
+        //@{
+        const std::vector<Size>& numeraires() const;
+        Size blockSize() const;
+        void startNewPaths(Size paths, std::vector<Real>& weights);
+        void advanceStep(std::vector<Real>& weights);
+        Size currentStep() const;
+        const CurveState& currentState(Size path) const;
+        void setInitialState(const CurveState&);
+        //@}
+      private:
+        void setForwards(const std::vector<Real>& forwards);
+        void updateForwards(Size alive);
+        // inputs
+        boost::shared_ptr<MarketModel> marketModel_;
+        std::vector<Size> numeraires_;
+        Size blockSize_, initialStep_;
+        boost::shared_ptr<BrownianGenerator> generator_;
+        // fixed variables
+        std::vector<std::vector<Real> > fixedDrifts_;
+        // working variables
+        Size numberOfRates_, numberOfFactors_;
+        std::vector<LMMCurveState> curveStates_;
+        Size currentStep_, paths_;
+        std::vector<Rate> displacements_, initialLogForwards_;
+        std::vector<Real> initialDrifts_;
+        Matrix forwards_, logForwards_, drifts1_, drifts2_;
+        std::vector<Matrix> brownians_;
+        Matrix stepWeights_;
+        std::vector<Real> brownian_, diffusion_, pathForwards_;
+        std::vector<Size> alive_;
+        // helper classes
+        std::vector<LMMDriftCalculator> calculators_;
+    };
+
+}
+
+#endif
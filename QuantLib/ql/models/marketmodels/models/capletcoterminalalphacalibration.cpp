@@ -90,6 +90,45 @@ namespace QuantLib {
             std::vector<Real>& b,
 
             std::vector<Matrix>& swapCovariancePseudoRoots) {
+        return capletAlphaFormCalibration(
+            evolution, corr, displacedSwapVariances, capletVols,
+            cs, displacement, alphaInitial, alphaMax, alphaMin,
+            maximizeHomogeneity, parametricForm, numberOfFactors,
+            maxIterations, tolerance, alpha, a, b,
+            swapCovariancePseudoRoots,
+            CTSMMCapletCalibration::correlationPseudoRoots(corr,
+                                                           numberOfFactors),
+            inverse(SwapForwardMappings::coterminalSwapZedMatrix(
+                                                        cs, displacement)));
+    }
+
+    Natural CTSMMCapletAlphaFormCalibration::capletAlphaFormCalibration(
+            const EvolutionDescription& evolution,
+            const PiecewiseConstantCorrelation& corr,
+            const std::vector<boost::shared_ptr<
+                PiecewiseConstantVariance> >&
+                    displacedSwapVariances,
+            const std::vector<Volatility>& capletVols,
+            const CurveState& cs,
+            const Spread displacement,
+
+            const std::vector<Real>& alphaInitial,
+            const std::vector<Real>& alphaMax,
+            const std::vector<Real>& alphaMin,
+            bool maximizeHomogeneity,
+            boost::shared_ptr<AlphaForm> parametricForm,
+
+            const Size numberOfFactors,
+            Integer maxIterations,
+            Real tolerance,
+
+            std::vector<Real>& alpha,
+            std::vector<Real>& a,
+            std::vector<Real>& b,
+
+            std::vector<Matrix>& swapCovariancePseudoRoots,
+            const std::vector<Matrix>& corrPseudo,
+            const Matrix& invertedZedMatrix) {
 
         CTSMMCapletCalibration::performChecks(evolution, corr,
             displacedSwapVariances, capletVols, cs);
@@ -112,17 +151,14 @@ namespace QuantLib {
         a.resize(numberOfRates);
         b.resize(numberOfRates);
 
-        // factor reduction
-        std::vector<Matrix> corrPseudo(corr.times().size());
-        for (Size i=0; i<corrPseudo.size(); ++i)
-            corrPseudo[i] = rankReducedSqrt(corr.correlation(i),
-                                            numberOfFactors, 1.0,
-                                            SalvagingAlgorithm::None);
-
-        // get Zinverse, we can get wj later
-        Matrix zedMatrix =
-            SwapForwardMappings::coterminalSwapZedMatrix(cs, displacement);
-        Matrix invertedZedMatrix = inverse(zedMatrix);
+        QL_REQUIRE(corrPseudo.size()==corr.times().size(),
+                   "mismatch between correlation times (" <<
+                   corr.times().size() << ") and pseudo-roots (" <<
+                   corrPseudo.size() << ")");
+        QL_REQUIRE(invertedZedMatrix.rows()==numberOfRates,
+                   "mismatch between number of rates (" << numberOfRates <<
+                   ") and inverted zed matrix rows (" <<
+                   invertedZedMatrix.rows() << ")");
 
         // vectors for new vol
         std::vector<std::vector<Volatility> > newVols;
@@ -262,6 +298,8 @@ namespace QuantLib {
                                           a_,
                                           b_,
 
-                                          swapCovariancePseudoRoots_);
+                                          swapCovariancePseudoRoots_,
+                                          corrPseudoRoots_,
+                                          invertedZedMatrix_);
     }
 }
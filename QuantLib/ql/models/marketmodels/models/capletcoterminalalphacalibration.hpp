@@ -72,6 +72,37 @@ namespace QuantLib {
             std::vector<Real>& b,
 
             std::vector<Matrix>& swapCovariancePseudoRoots);
+        /*! as above, with precomputed factor reduction of the
+            correlations and inverse of the coterminal-swap zed matrix
+        */
+        static Natural capletAlphaFormCalibration(
+            const EvolutionDescription& evolution,
+            const PiecewiseConstantCorrelation& corr,
+            const std::vector<boost::shared_ptr<
+                PiecewiseConstantVariance> >&
+                    displacedSwapVariances,
+            const std::vector<Volatility>& capletVols,
+            const CurveState& cs,
+            const Spread displacement,
+
+            const std::vector<Real>& alphaInitial,
+            const std::vector<Real>& alphaMax,
+            const std::vector<Real>& alphaMin,
+            bool maximizeHomogeneity,
+            boost::shared_ptr<AlphaForm> parametricForm,
+
+            const Size numberOfFactors,
+            Integer steps,
+            Real toleranceForAlphaSolving,
+
+            std::vector<Real>& alpha,
+            std::vector<Real>& a,
+            std::vector<Real>& b,
+
+            std::vector<Matrix>& swapCovariancePseudoRoots,
+
+            const std::vector<Matrix>& corrPseudoRoots,
+            const Matrix& invertedZedMatrix);
       private:
         Natural calibrationImpl_(Natural numberOfFactors, 
                                  Natural maxIterations,
@@ -280,6 +280,36 @@ namespace QuantLib {
         Real& totalSwaptionError, // ret value
         std::vector<Matrix>& swapCovariancePseudoRoots) 
     {
+            return capletMaxHomogeneityCalibration(
+                    evolution, corr, displacedSwapVariances, capletVols,
+                    cs, displacement, caplet0Swaption1Priority,
+                    numberOfFactors, maxIterations, tolerance,
+                    deformationSize, totalSwaptionError,
+                    swapCovariancePseudoRoots,
+                    CTSMMCapletCalibration::correlationPseudoRoots(
+                                                     corr, numberOfFactors),
+                    inverse(SwapForwardMappings::coterminalSwapZedMatrix(
+                                                       cs, displacement)));
+    }
+
+    Natural CTSMMCapletMaxHomogeneityCalibration::capletMaxHomogeneityCalibration(
+        const EvolutionDescription& evolution,
+        const PiecewiseConstantCorrelation& corr,
+        const std::vector<boost::shared_ptr<
+        PiecewiseConstantVariance> >& displacedSwapVariances,
+        const std::vector<Volatility>& capletVols,
+        const CurveState& cs,
+        const Spread displacement,
+        Real caplet0Swaption1Priority, 
+        const Size numberOfFactors,
+        Size maxIterations,
+        Real tolerance,
+        Real& deformationSize,  // ret value
+        Real& totalSwaptionError, // ret value
+        std::vector<Matrix>& swapCovariancePseudoRoots,
+        const std::vector<Matrix>& corrPseudo,
+        const Matrix& invertedZedMatrix) 
+    {
 
             CTSMMCapletCalibration::performChecks(evolution, corr,
                 displacedSwapVariances, capletVols, cs);
@@ -302,17 +332,14 @@ namespace QuantLib {
             totalSwaptionError = 0.0;
             deformationSize = 0.0;
 
-            // factor reduction
-            std::vector<Matrix> corrPseudo(corr.times().size());
-            for (Size i=0; i<corrPseudo.size(); ++i)
-                corrPseudo[i] = rankReducedSqrt(corr.correlation(i),
-                numberOfFactors, 1.0,
-                SalvagingAlgorithm::None);
-
-            // get Zinverse, we can get wj later
-            Matrix zedMatrix =
-                SwapForwardMappings::coterminalSwapZedMatrix(cs, displacement);
-            Matrix invertedZedMatrix = inverse(zedMatrix);
+            QL_REQUIRE(corrPseudo.size()==corr.times().size(),
+                       "mismatch between correlation times (" <<
+                       corr.times().size() << ") and pseudo-roots (" <<
+                       corrPseudo.size() << ")");
+            QL_REQUIRE(invertedZedMatrix.rows()==numberOfRates,
+                       "mismatch between number of rates (" << numberOfRates <<
+                       ") and inverted zed matrix rows (" <<
+                       invertedZedMatrix.rows() << ")");
 
             // vectors for the new vol of all swap rates
             std::vector<std::vector<Volatility> > newVols;
@@ -417,7 +444,9 @@ namespace QuantLib {
                 deformationSize_,
                 totalSwaptionError_,
 
-                swapCovariancePseudoRoots_);
+                swapCovariancePseudoRoots_,
+                corrPseudoRoots_,
+                invertedZedMatrix_);
     }
 
 }
@@ -55,6 +55,27 @@ namespace QuantLib {
                     Real& deformationSize,
                     Real& totalSwaptionError, // ?
                     std::vector<Matrix>& swapCovariancePseudoRoots); // the thing we really want the pseudo root for each time step
+        /*! as above, with precomputed factor reduction of the
+            correlations and inverse of the coterminal-swap zed matrix
+        */
+        static Natural capletMaxHomogeneityCalibration(
+                    const EvolutionDescription& evolution,
+                    const PiecewiseConstantCorrelation& corr,
+                    const std::vector<boost::shared_ptr<
+                        PiecewiseConstantVariance> >&
+                            displacedSwapVariances,
+                    const std::vector<Volatility>& capletVols,
+                    const CurveState& cs,
+                    const Spread displacement,
+                    Real caplet0Swaption1Priority,
+                    Size numberOfFactors,
+                    Size maxIterations,
+                    Real tolerance,
+                    Real& deformationSize,
+                    Real& totalSwaptionError,
+                    std::vector<Matrix>& swapCovariancePseudoRoots,
+                    const std::vector<Matrix>& corrPseudoRoots,
+                    const Matrix& invertedZedMatrix);
 
       private:
         Natural calibrationImpl_(Natural numberOfFactors, 
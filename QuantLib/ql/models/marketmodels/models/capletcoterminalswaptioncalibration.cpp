@@ -67,6 +67,32 @@ namespace QuantLib {
                             //Real tolerance,
 
                             std::vector<Matrix>& swapCovariancePseudoRoots) {
+        return calibrationFunction(
+                    evolution, corr, displacedSwapVariances, capletVols,
+                    cs, displacement, alpha, lowestRoot, useFullAprox,
+                    numberOfFactors, swapCovariancePseudoRoots,
+                    CTSMMCapletCalibration::correlationPseudoRoots(
+                                                     corr, numberOfFactors),
+                    inverse(SwapForwardMappings::coterminalSwapZedMatrix(
+                                                       cs, displacement)));
+    }
+
+    Natural CTSMMCapletOriginalCalibration::calibrationFunction(
+                            const EvolutionDescription& evolution,
+                            const PiecewiseConstantCorrelation& corr,
+                            const std::vector<boost::shared_ptr<
+                                PiecewiseConstantVariance> >&
+                                    displacedSwapVariances,
+                            const std::vector<Volatility>& capletVols,
+                            const CurveState& cs,
+                            Spread displacement,
+                            const std::vector<Real>& alpha,
+                            bool lowestRoot,
+                            bool useFullAprox,
+                            Size numberOfFactors,
+                            std::vector<Matrix>& swapCovariancePseudoRoots,
+                            const std::vector<Matrix>& corrPseudo,
+                            const Matrix& invertedZedMatrix) {
 
         CTSMMCapletCalibration::performChecks(evolution, corr,
             displacedSwapVariances, capletVols, cs);
@@ -86,16 +112,14 @@ namespace QuantLib {
         Natural failures = 0;
         Real extraMultiplier = useFullAprox ? 1.0 : 0.0;
 
-        // factor reduction
-        std::vector<Matrix> corrPseudo(corr.times().size());
-        for (Size i=0; i<corrPseudo.size(); ++i)
-            corrPseudo[i] = rankReducedSqrt(corr.correlation(i),
-                                            numberOfFactors, 1.0,
-                                            SalvagingAlgorithm::None);
-
-        Matrix zedMatrix =
-            SwapForwardMappings::coterminalSwapZedMatrix(cs, displacement);
-        Matrix invertedZedMatrix = inverse(zedMatrix);
+        QL_REQUIRE(corrPseudo.size()==corr.times().size(),
+                   "mismatch between correlation times (" <<
+                   corr.times().size() << ") and pseudo-roots (" <<
+                   corrPseudo.size() << ")");
+        QL_REQUIRE(invertedZedMatrix.rows()==numberOfRates,
+                   "mismatch between number of rates (" << numberOfRates <<
+                   ") and inverted zed matrix rows (" <<
+                   invertedZedMatrix.rows() << ")");
 
 
 
@@ -348,7 +372,9 @@ namespace QuantLib {
 
                                    numberOfFactors,
 
-                                   swapCovariancePseudoRoots_);
+                                   swapCovariancePseudoRoots_,
+                                   corrPseudoRoots_,
+                                   invertedZedMatrix_);
     }
 
 }
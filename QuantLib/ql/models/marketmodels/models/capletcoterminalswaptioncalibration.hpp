@@ -59,6 +59,25 @@ namespace QuantLib {
                             //Real tolerance,
 
                             std::vector<Matrix>& swapCovariancePseudoRoots);
+        /*! as above, with precomputed factor reduction of the
+            correlations and inverse of the coterminal-swap zed matrix
+        */
+        static Natural calibrationFunction(
+                            const EvolutionDescription& evolution,
+                            const PiecewiseConstantCorrelation& corr,
+                            const std::vector<boost::shared_ptr<
+                                PiecewiseConstantVariance> >&
+                                    displacedSwapVariances,
+                            const std::vector<Volatility>& capletVols,
+                            const CurveState& cs,
+                            Spread displacement,
+                            const std::vector<Real>& alpha,
+                            bool lowestRoot,
+                            bool useFullApprox,
+                            Size numberOfFactors,
+                            std::vector<Matrix>& swapCovariancePseudoRoots,
+                            const std::vector<Matrix>& corrPseudoRoots,
+                            const Matrix& invertedZedMatrix);
       private:
         Natural calibrationImpl_(Natural numberOfFactors,
                                  Natural ,
@@ -27,6 +27,7 @@
 #include <ql/math/matrixutilities/pseudosqrt.hpp>
 #include <ql/math/comparison.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <string>
 
 namespace QuantLib {
 
@@ -48,7 +49,9 @@ namespace QuantLib {
       mktSwaptionVols_(evolution_.numberOfRates()),
       mdlSwaptionVols_(evolution_.numberOfRates()),
       cs_(cs), displacement_(displacement),
-      numberOfRates_(evolution_.numberOfRates())
+      numberOfRates_(evolution_.numberOfRates()),
+      capletVolAdjustments_(numberOfRates_, 1.0),
+      corrPseudoRootsFactors_(0)
     {
         performChecks(evolution_, *corr_, displacedSwapVariances_,
                       mktCapletVols_, *cs_);
@@ -57,6 +60,56 @@ namespace QuantLib {
 
     }
 
+    void CTSMMCapletCalibration::setCapletVolAdjustments(
+                                     const std::vector<Real>& adjustments) {
+        QL_REQUIRE(adjustments.size()==numberOfRates_,
+                   "mismatch between number of rates (" << numberOfRates_ <<
+                   ") and caplet vol adjustments (" << adjustments.size() <<
+                   ")");
+        for (Size i=0; i<numberOfRates_; ++i)
+            QL_REQUIRE(adjustments[i]>0.0,
+                       "non-positive caplet vol adjustment (" <<
+                       adjustments[i] << ") at index " << i);
+        capletVolAdjustments_ = adjustments;
+    }
+
+    std::vector<Matrix> CTSMMCapletCalibration::correlationPseudoRoots(
+                                    const PiecewiseConstantCorrelation& corr,
+                                    Size numberOfFactors) {
+        QL_REQUIRE(numberOfFactors<=corr.numberOfRates(),
+                   "number of factors (" << numberOfFactors <<
+                   ") cannot be greater than numberOfRates (" <<
+                   corr.numberOfRates() << ")");
+        QL_REQUIRE(numberOfFactors>0,
+                   "number of factors (" << numberOfFactors <<
+                   ") must be greater than zero");
+
+        Size n = corr.times().size();
+        std::vector<Matrix> corrPseudo(n);
+        // exceptions can't escape a parallel region; they're stored
+        // and rethrown afterwards
+        std::vector<std::string> errors(n);
+
+        #pragma omp parallel for schedule(dynamic) if(n>1)
+        for (int i=0; i<int(n); ++i) {
+            try {
+                corrPseudo[i] = rankReducedSqrt(corr.correlation(i),
+                                                numberOfFactors, 1.0,
+                                                SalvagingAlgorithm::None);
+            } catch (std::exception& e) {
+                errors[i] = e.what();
+            } catch (...) {
+                errors[i] = "unknown error";
+            }
+        }
+
+        for (Size i=0; i<n; ++i)
+            QL_REQUIRE(errors[i].empty(),
+                       "factor reduction failed at step " << i << ": " <<
+                       errors[i]);
+        return corrPseudo;
+    }
+
     const std::vector<Volatility>&
     CTSMMCapletCalibration::timeDependentUnCalibratedSwaptionVols(Size i) const
     {
@@ -142,8 +195,21 @@ namespace QuantLib {
         capletRmsError_ = swaptionRmsError_ = 987654321;
         capletMaxError_ = swaptionMaxError_ = 987654321;
 
-        // initialize working variables
+        // initialize working variables, possibly starting from a
+        // previous solution
         usedCapletVols_ = mktCapletVols_;
+        for (Size i=0; i<numberOfRates_; ++i)
+            usedCapletVols_[i] *= capletVolAdjustments_[i];
+
+        // these don't change between iterations
+        if (corrPseudoRootsFactors_ != numberOfFactors) {
+            corrPseudoRoots_ = correlationPseudoRoots(*corr_,
+                                                      numberOfFactors);
+            corrPseudoRootsFactors_ = numberOfFactors;
+        }
+        invertedZedMatrix_ = inverse(
+            SwapForwardMappings::coterminalSwapZedMatrix(*cs_,
+                                                         displacement_));
 
         for (Size i=0; i<numberOfRates_; ++i)
             mktSwaptionVols_[i]=displacedSwapVariances_[i]->totalVolatility(i);
@@ -195,6 +261,14 @@ namespace QuantLib {
         } while (iterations<maxIterations &&
                  capletRmsError_>capletVolTolerance);
 
+        // the adjustments are kept only if the calibration succeeded;
+        // otherwise, the next one starts again from the previous ones
+        if (failures_==0) {
+            for (Size i=0; i<numberOfRates_; ++i)
+                capletVolAdjustments_[i] =
+                    usedCapletVols_[i]/mktCapletVols_[i];
+        }
+
          boost::shared_ptr<MarketModel> ctsmm(new
                 PseudoRootFacade(swapCovariancePseudoRoots_,
                                  rateTimes,
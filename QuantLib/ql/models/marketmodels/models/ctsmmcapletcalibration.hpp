@@ -24,14 +24,30 @@
 #include <ql/models/marketmodels/curvestate.hpp>
 #include <ql/models/marketmodels/evolutiondescription.hpp>
 #include <ql/models/marketmodels/piecewiseconstantcorrelation.hpp>
+#include <ql/math/matrix.hpp>
 #include <boost/shared_ptr.hpp>
 #include <vector>
 
 namespace QuantLib {
 
     class PiecewiseConstantVariance;
-    class Matrix;
 
+    //! base class for caplet calibrations of coterminal-swap market models
+    /*! The calibration iterates on the caplet vols used as targets
+        until the model reproduces the market ones.  The factor
+        reduction of the correlation matrices doesn't change between
+        iterations and is computed once (and kept between calibrations
+        with the same number of factors); so is the inverse of the
+        coterminal-swap zed matrix.
+
+        The ratios between target and market caplet vols found by a
+        calibration can be passed to another calibrator, e.g., one
+        built on later market data, so that it starts from the
+        previous solution and needs fewer iterations.  The ratios
+        are updated only by a successful calibration (i.e., one
+        returning \c true) or by setCapletVolAdjustments(); after a
+        failed one, they are left as they were.
+    */
     class CTSMMCapletCalibration {
       public:
         virtual ~CTSMMCapletCalibration();
@@ -81,6 +97,22 @@ namespace QuantLib {
             const std::vector<Volatility>& mktCapletVols,
             const CurveState& cs);
 
+        //! \name Warm start
+        //@{
+        //! ratios found by the last successful calibration, if any
+        const std::vector<Real>& capletVolAdjustments() const;
+        //! sets the ratios from which the next calibration starts
+        void setCapletVolAdjustments(const std::vector<Real>& adjustments);
+        //@}
+
+        //! factor reduction of the correlation matrix at each step
+        /*! The reductions are independent of one another and are
+            performed in parallel when OpenMP is enabled.
+        */
+        static std::vector<Matrix> correlationPseudoRoots(
+                                    const PiecewiseConstantCorrelation& corr,
+                                    Size numberOfFactors);
+
         const boost::shared_ptr<CurveState>& curveState() const;
         std::vector<Spread> displacements() const;
       protected:
@@ -103,6 +135,10 @@ namespace QuantLib {
         Size numberOfRates_;
         // working variables
         std::vector<Volatility> usedCapletVols_;
+        std::vector<Real> capletVolAdjustments_;
+        std::vector<Matrix> corrPseudoRoots_;
+        Size corrPseudoRootsFactors_;
+        Matrix invertedZedMatrix_;
         // results
         bool calibrated_;
         Natural failures_;
@@ -181,6 +217,11 @@ namespace QuantLib {
         return swapCovariancePseudoRoots_[i];
     }
 
+    inline const std::vector<Real>&
+    CTSMMCapletCalibration::capletVolAdjustments() const {
+        return capletVolAdjustments_;
+    }
+
     inline const boost::shared_ptr<CurveState>&
     CTSMMCapletCalibration::curveState() const {
         return cs_;
@@ -21,7 +21,7 @@
 #ifndef quantlib_market_model_multi_product_hpp
 #define quantlib_market_model_multi_product_hpp
 
-#include <ql/types.hpp>
+#include <ql/models/marketmodels/cashflowbuffer.hpp>
 #include <vector>
 #include <memory>
 
@@ -45,6 +45,10 @@ namespace QuantLib {
         callable product then this would encompass the product and its
         exercise strategy.
 
+        The cash flows are written into a flat buffer, allocated once
+        by the engine with room for
+        maxNumberOfCashFlowsPerProductPerStep() cash flows for each
+        product and reused at each step.
     */
 
     class MarketModelMultiProduct {
@@ -53,6 +57,7 @@ namespace QuantLib {
             Size timeIndex;
             Real amount;
         };
+        typedef MarketModelCashFlowBuffer<CashFlow> CashFlowBuffer;
         virtual ~MarketModelMultiProduct() {}
 
         virtual std::vector<Size> suggestedNumeraires() const = 0;
@@ -66,7 +71,7 @@ namespace QuantLib {
         virtual bool nextTimeStep(
             const CurveState& currentState,
             std::vector<Size>& numberCashFlowsThisStep,
-            std::vector<std::vector<CashFlow> >& cashFlowsGenerated) = 0;
+            CashFlowBuffer& cashFlowsGenerated) = 0;
         //! returns a newly-allocated copy of itself
         virtual std::auto_ptr<MarketModelMultiProduct> clone() const = 0;
     };
@@ -0,0 +1,251 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2015 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/models/marketmodels/parallelaccountingengine.hpp>
+#include <ql/models/marketmodels/accountingengine.hpp>
+#include <ql/models/marketmodels/pathwiseaccountingengine.hpp>
+#include <ql/models/marketmodels/evolvers/lognormalfwdrateeuler.hpp>
+#include <ql/models/marketmodels/browniangenerator.hpp>
+#include <ql/models/marketmodels/evolver.hpp>
+#include <ql/models/marketmodels/marketmodel.hpp>
+#include <algorithm>
+#include <string>
+#include <cmath>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace QuantLib {
+
+    namespace {
+
+        Size actualWorkers(Size requested, Size numberOfPaths) {
+            Size workers = requested;
+            if (workers == 0) {
+                #ifdef _OPENMP
+                workers = omp_get_max_threads();
+                #else
+                workers = 1;
+                #endif
+            }
+            return std::max<Size>(1, std::min(workers, numberOfPaths));
+        }
+
+        // first path of the range assigned to the given worker
+        Size firstPath(Size worker, Size workers, Size numberOfPaths) {
+            return (worker*numberOfPaths)/workers;
+        }
+
+        // exceptions can't escape a parallel region; they're stored
+        // by each worker and rethrown afterwards
+        void checkErrors(const std::vector<std::string>& errors) {
+            for (Size i=0; i<errors.size(); ++i)
+                QL_REQUIRE(errors[i].empty(),
+                           "worker " << i << " failed: " << errors[i]);
+        }
+
+        boost::shared_ptr<LogNormalFwdRateEuler> eulerEvolver(
+                     const MarketModelEvolverFactory& evolverFactory,
+                     const BrownianGeneratorFactory& generatorFactory) {
+            boost::shared_ptr<LogNormalFwdRateEuler> evolver =
+                boost::dynamic_pointer_cast<LogNormalFwdRateEuler>(
+                                   evolverFactory.create(generatorFactory));
+            QL_REQUIRE(evolver, "log-normal Euler evolver required");
+            return evolver;
+        }
+
+    }
+
+
+    ParallelAccountingEngine::ParallelAccountingEngine(
+           const boost::shared_ptr<MarketModelEvolverFactory>& evolverFactory,
+           const boost::shared_ptr<BrownianGeneratorFactory>& generatorFactory,
+           const Clone<MarketModelMultiProduct>& product,
+           Real initialNumeraireValue,
+           Size workers)
+    : evolverFactory_(evolverFactory), generatorFactory_(generatorFactory),
+      product_(product), initialNumeraireValue_(initialNumeraireValue),
+      workers_(workers) {}
+
+    void ParallelAccountingEngine::multiplePathValues(
+                                                SequenceStatisticsInc& stats,
+                                                Size numberOfPaths) {
+        QL_REQUIRE(numberOfPaths > 0, "null number of paths");
+
+        Size workers = actualWorkers(workers_, numberOfPaths);
+        std::vector<SequenceStatisticsInc> partialStats(workers);
+        std::vector<std::string> errors(workers);
+
+        evolverFactory_->prepare();
+        #pragma omp parallel for schedule(static,1) if(workers>1)
+        for (int w=0; w<int(workers); ++w) {
+            try {
+                Size begin = firstPath(w, workers, numberOfPaths),
+                     end = firstPath(w+1, workers, numberOfPaths);
+                OffsetBrownianGeneratorFactory factory(generatorFactory_,
+                                                       begin);
+                AccountingEngine engine(evolverFactory_->create(factory),
+                                        product_, initialNumeraireValue_);
+                engine.multiplePathValues(partialStats[w], end-begin);
+            } catch (std::exception& e) {
+                errors[w] = e.what();
+            } catch (...) {
+                errors[w] = "unknown error";
+            }
+        }
+
+        checkErrors(errors);
+        for (Size w=0; w<workers; ++w)
+            stats.merge(partialStats[w]);
+    }
+
+
+    ParallelPathwiseAccountingEngine::ParallelPathwiseAccountingEngine(
+           const boost::shared_ptr<MarketModelEvolverFactory>& evolverFactory,
+           const boost::shared_ptr<BrownianGeneratorFactory>& generatorFactory,
+           const Clone<MarketModelPathwiseMultiProduct>& product,
+           const boost::shared_ptr<MarketModel>& pseudoRootStructure,
+           Real initialNumeraireValue,
+           Size workers)
+    : evolverFactory_(evolverFactory), generatorFactory_(generatorFactory),
+      product_(product), pseudoRootStructure_(pseudoRootStructure),
+      initialNumeraireValue_(initialNumeraireValue), workers_(workers) {}
+
+    void ParallelPathwiseAccountingEngine::multiplePathValues(
+                                                SequenceStatisticsInc& stats,
+                                                Size numberOfPaths) {
+        QL_REQUIRE(numberOfPaths > 0, "null number of paths");
+
+        Size workers = actualWorkers(workers_, numberOfPaths);
+        std::vector<SequenceStatisticsInc> partialStats(workers);
+        std::vector<std::string> errors(workers);
+
+        evolverFactory_->prepare();
+        #pragma omp parallel for schedule(static,1) if(workers>1)
+        for (int w=0; w<int(workers); ++w) {
+            try {
+                Size begin = firstPath(w, workers, numberOfPaths),
+                     end = firstPath(w+1, workers, numberOfPaths);
+                OffsetBrownianGeneratorFactory factory(generatorFactory_,
+                                                       begin);
+                PathwiseAccountingEngine engine(
+                                      eulerEvolver(*evolverFactory_, factory),
+                                      product_, pseudoRootStructure_,
+                                      initialNumeraireValue_);
+                engine.multiplePathValues(partialStats[w], end-begin);
+            } catch (std::exception& e) {
+                errors[w] = e.what();
+            } catch (...) {
+                errors[w] = "unknown error";
+            }
+        }
+
+        checkErrors(errors);
+        for (Size w=0; w<workers; ++w)
+            stats.merge(partialStats[w]);
+    }
+
+
+    ParallelPathwiseVegasOuterAccountingEngine::
+    ParallelPathwiseVegasOuterAccountingEngine(
+           const boost::shared_ptr<MarketModelEvolverFactory>& evolverFactory,
+           const boost::shared_ptr<BrownianGeneratorFactory>& generatorFactory,
+           const Clone<MarketModelPathwiseMultiProduct>& product,
+           const boost::shared_ptr<MarketModel>& pseudoRootStructure,
+           const std::vector<std::vector<Matrix> >& vegaBumps,
+           Real initialNumeraireValue,
+           Size workers)
+    : evolverFactory_(evolverFactory), generatorFactory_(generatorFactory),
+      product_(product), pseudoRootStructure_(pseudoRootStructure),
+      vegaBumps_(vegaBumps), initialNumeraireValue_(initialNumeraireValue),
+      workers_(workers) {}
+
+    void ParallelPathwiseVegasOuterAccountingEngine::
+    multiplePathValuesElementary(std::vector<Real>& means,
+                                 std::vector<Real>& errors,
+                                 Size numberOfPaths) {
+        QL_REQUIRE(numberOfPaths > 0, "null number of paths");
+
+        Size workers = actualWorkers(workers_, numberOfPaths);
+        std::vector<std::vector<Real> > sums(workers), sumsqs(workers);
+        std::vector<std::string> failures(workers);
+
+        evolverFactory_->prepare();
+        #pragma omp parallel for schedule(static,1) if(workers>1)
+        for (int w=0; w<int(workers); ++w) {
+            try {
+                Size begin = firstPath(w, workers, numberOfPaths),
+                     end = firstPath(w+1, workers, numberOfPaths);
+                OffsetBrownianGeneratorFactory factory(generatorFactory_,
+                                                       begin);
+                PathwiseVegasOuterAccountingEngine engine(
+                                      eulerEvolver(*evolverFactory_, factory),
+                                      product_, pseudoRootStructure_,
+                                      vegaBumps_, initialNumeraireValue_);
+                engine.accumulatePathValuesElementary(sums[w], sumsqs[w],
+                                                      end-begin);
+            } catch (std::exception& e) {
+                failures[w] = e.what();
+            } catch (...) {
+                failures[w] = "unknown error";
+            }
+        }
+
+        checkErrors(failures);
+
+        // the sums are added in range order, which keeps the result
+        // independent of the scheduling of the workers
+        std::vector<Real>& totalSums = sums[0];
+        std::vector<Real>& totalSumsqs = sumsqs[0];
+        for (Size w=1; w<workers; ++w) {
+            for (Size j=0; j<totalSums.size(); ++j) {
+                totalSums[j] += sums[w][j];
+                totalSumsqs[j] += sumsqs[w][j];
+            }
+        }
+
+        means.resize(totalSums.size());
+        errors.resize(totalSums.size());
+        for (Size j=0; j<totalSums.size(); ++j) {
+            means[j] = totalSums[j]/numberOfPaths;
+            Real meanSq = totalSumsqs[j]/numberOfPaths;
+            Real variance = meanSq - means[j]*means[j];
+            errors[j] = std::sqrt(variance/numberOfPaths);
+        }
+    }
+
+    void ParallelPathwiseVegasOuterAccountingEngine::multiplePathValues(
+                                                  std::vector<Real>& means,
+                                                  std::vector<Real>& errors,
+                                                  Size numberOfPaths) {
+        std::vector<Real> allMeans, allErrors;
+        multiplePathValuesElementary(allMeans, allErrors, numberOfPaths);
+
+        // the bumps are applied by an engine working on the
+        // unskipped generator; no path is drawn from it.
+        PathwiseVegasOuterAccountingEngine engine(
+                              eulerEvolver(*evolverFactory_,
+                                           *generatorFactory_),
+                              product_, pseudoRootStructure_,
+                              vegaBumps_, initialNumeraireValue_);
+        engine.vegasFromElementary(allMeans, allErrors, means, errors);
+    }
+
+}
@@ -0,0 +1,149 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2015 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file parallelaccountingengine.hpp
+    \brief Accounting engines simulating paths on several threads
+*/
+
+#ifndef quantlib_parallel_accounting_engine_hpp
+#define quantlib_parallel_accounting_engine_hpp
+
+#include <ql/models/marketmodels/multiproduct.hpp>
+#include <ql/models/marketmodels/pathwisemultiproduct.hpp>
+#include <ql/math/statistics/sequencestatistics.hpp>
+#include <ql/math/matrix.hpp>
+#include <ql/utilities/clone.hpp>
+#include <vector>
+
+namespace QuantLib {
+
+    class MarketModel;
+    class MarketModelEvolverFactory;
+    class BrownianGeneratorFactory;
+
+    //! Accounting engine running the simulation on several threads
+    /*! The paths to be simulated are split into contiguous ranges,
+        one for each worker.  Each worker builds its own evolver
+        (from the passed evolver factory) and its own copy of the
+        product and runs an AccountingEngine on its range of paths;
+        its Brownian generator is created by the passed factory and
+        moved forward to the start of the range, so that the paths
+        are the same as in a serial simulation.  The statistics
+        collected by the workers are merged in range order.
+
+        When QuantLib is compiled with OpenMP support, workers run on
+        separate threads; otherwise, they run one after the other.
+        If no number of workers is passed, the maximum number of
+        OpenMP threads is used.
+
+        \warning the market model and the product passed to the
+                 engine are accessed concurrently from the workers
+                 (for reading only) and must be thread-safe in this
+                 respect.
+    */
+    class ParallelAccountingEngine {
+      public:
+        ParallelAccountingEngine(
+            const boost::shared_ptr<MarketModelEvolverFactory>& evolverFactory,
+            const boost::shared_ptr<BrownianGeneratorFactory>& generatorFactory,
+            const Clone<MarketModelMultiProduct>& product,
+            Real initialNumeraireValue,
+            Size workers = 0);
+        void multiplePathValues(SequenceStatisticsInc& stats,
+                                Size numberOfPaths);
+      private:
+        boost::shared_ptr<MarketModelEvolverFactory> evolverFactory_;
+        boost::shared_ptr<BrownianGeneratorFactory> generatorFactory_;
+        Clone<MarketModelMultiProduct> product_;
+        Real initialNumeraireValue_;
+        Size workers_;
+    };
+
+
+    //! Pathwise-delta accounting engine running on several threads
+    /*! Paths are split among workers as in ParallelAccountingEngine;
+        each worker runs a PathwiseAccountingEngine.  The evolver
+        factory must build LogNormalFwdRateEuler instances.
+    */
+    class ParallelPathwiseAccountingEngine {
+      public:
+        ParallelPathwiseAccountingEngine(
+            const boost::shared_ptr<MarketModelEvolverFactory>& evolverFactory,
+            const boost::shared_ptr<BrownianGeneratorFactory>& generatorFactory,
+            const Clone<MarketModelPathwiseMultiProduct>& product,
+            const boost::shared_ptr<MarketModel>& pseudoRootStructure,
+            Real initialNumeraireValue,
+            Size workers = 0);
+        void multiplePathValues(SequenceStatisticsInc& stats,
+                                Size numberOfPaths);
+      private:
+        boost::shared_ptr<MarketModelEvolverFactory> evolverFactory_;
+        boost::shared_ptr<BrownianGeneratorFactory> generatorFactory_;
+        Clone<MarketModelPathwiseMultiProduct> product_;
+        boost::shared_ptr<MarketModel> pseudoRootStructure_;
+        Real initialNumeraireValue_;
+        Size workers_;
+    };
+
+
+    //! Pathwise-vega accounting engine running on several threads
+    /*! Paths are split among workers as in ParallelAccountingEngine;
+        each worker runs a PathwiseVegasOuterAccountingEngine and
+        accumulates sums and sums of squares of the vegas with
+        respect to the pseudo-root elements.  Sums are added up in
+        range order before being combined with the vega bumps, so
+        that the bucketed vegas are the same (up to rounding) as
+        the ones returned by a serial simulation.
+
+        The evolver factory must build LogNormalFwdRateEuler
+        instances.
+    */
+    class ParallelPathwiseVegasOuterAccountingEngine {
+      public:
+        ParallelPathwiseVegasOuterAccountingEngine(
+            const boost::shared_ptr<MarketModelEvolverFactory>& evolverFactory,
+            const boost::shared_ptr<BrownianGeneratorFactory>& generatorFactory,
+            const Clone<MarketModelPathwiseMultiProduct>& product,
+            const boost::shared_ptr<MarketModel>& pseudoRootStructure,
+            const std::vector<std::vector<Matrix> >& vegaBumps,
+            Real initialNumeraireValue,
+            Size workers = 0);
+
+        //! Use to get vegas with respect to VegaBumps
+        void multiplePathValues(std::vector<Real>& means,
+                                std::vector<Real>& errors,
+                                Size numberOfPaths);
+
+        //! Use to get vegas with respect to pseudo-root-elements
+        void multiplePathValuesElementary(std::vector<Real>& means,
+                                          std::vector<Real>& errors,
+                                          Size numberOfPaths);
+      private:
+        boost::shared_ptr<MarketModelEvolverFactory> evolverFactory_;
+        boost::shared_ptr<BrownianGeneratorFactory> generatorFactory_;
+        Clone<MarketModelPathwiseMultiProduct> product_;
+        boost::shared_ptr<MarketModel> pseudoRootStructure_;
+        std::vector<std::vector<Matrix> > vegaBumps_;
+        Real initialNumeraireValue_;
+        Size workers_;
+    };
+
+}
+
+#endif
@@ -37,7 +37,6 @@ namespace QuantLib {
         doDeflation_(!product->alreadyDeflated()),
         numerairesHeld_(product->numberOfProducts()),
         numberCashFlowsThisStep_(product->numberOfProducts()),
-        cashFlowsGenerated_(product->numberOfProducts()) ,
         deflatorAndDerivatives_(pseudoRootStructure_->numberOfRates()+1)
     {
 
@@ -61,14 +60,15 @@ namespace QuantLib {
 
         numberCashFlowsThisIndex_.resize(numberProducts_);
 
+        MarketModelPathwiseMultiProduct::CashFlow cashFlow;
+        cashFlow.amount.resize(numberRates_+1);
+        cashFlowsGenerated_ = MarketModelPathwiseMultiProduct::CashFlowBuffer(
+                            numberProducts_,
+                            product_->maxNumberOfCashFlowsPerProductPerStep(),
+                            cashFlow);
+
         for (Size i=0; i<numberProducts_; ++i)
         {
-            cashFlowsGenerated_[i].resize(
-                product_->maxNumberOfCashFlowsPerProductPerStep());
-
-            for (Size j=0; j < cashFlowsGenerated_[i].size(); ++j)
-                cashFlowsGenerated_[i][j].amount.resize(numberRates_+1);
-
             numberCashFlowsThisIndex_[i].resize(product_->possibleCashFlowTimes().size());
 
             V_.push_back(VModel);
@@ -336,7 +336,6 @@ namespace QuantLib {
         doDeflation_(!product->alreadyDeflated()),
         numerairesHeld_(product->numberOfProducts()),
         numberCashFlowsThisStep_(product->numberOfProducts()),
-        cashFlowsGenerated_(product->numberOfProducts()),
         stepsDiscounts_(pseudoRootStructure_->numberOfRates()+1),
         vegasThisPath_(product->numberOfProducts(),vegaBumps[0].size()),
         deflatorAndDerivatives_(pseudoRootStructure_->numberOfRates()+1)
@@ -389,14 +388,15 @@ namespace QuantLib {
 
         numberCashFlowsThisIndex_.resize(numberProducts_);
 
+        MarketModelPathwiseMultiProduct::CashFlow cashFlow;
+        cashFlow.amount.resize(numberRates_+1);
+        cashFlowsGenerated_ = MarketModelPathwiseMultiProduct::CashFlowBuffer(
+                            numberProducts_,
+                            product_->maxNumberOfCashFlowsPerProductPerStep(),
+                            cashFlow);
+
         for (Size i=0; i<numberProducts_; ++i)
         {
-            cashFlowsGenerated_[i].resize(
-                product_->maxNumberOfCashFlowsPerProductPerStep());
-
-            for (Size j=0; j < cashFlowsGenerated_[i].size(); ++j)
-                cashFlowsGenerated_[i][j].amount.resize(numberRates_+1);
-
             numberCashFlowsThisIndex_[i].resize(product_->possibleCashFlowTimes().size());
 
             V_.push_back(VModel);
@@ -729,7 +729,6 @@ namespace QuantLib {
         doDeflation_(!product->alreadyDeflated()),
         numerairesHeld_(product->numberOfProducts()),
         numberCashFlowsThisStep_(product->numberOfProducts()),
-        cashFlowsGenerated_(product->numberOfProducts()),
         stepsDiscounts_(pseudoRootStructure_->numberOfRates()+1),
         elementary_vegas_ThisPath_(product->numberOfProducts()),
         deflatorAndDerivatives_(pseudoRootStructure_->numberOfRates()+1)
@@ -787,14 +786,15 @@ namespace QuantLib {
 
         numberCashFlowsThisIndex_.resize(numberProducts_);
 
+        MarketModelPathwiseMultiProduct::CashFlow cashFlow;
+        cashFlow.amount.resize(numberRates_+1);
+        cashFlowsGenerated_ = MarketModelPathwiseMultiProduct::CashFlowBuffer(
+                            numberProducts_,
+                            product_->maxNumberOfCashFlowsPerProductPerStep(),
+                            cashFlow);
+
         for (Size i=0; i<numberProducts_; ++i)
         {
-            cashFlowsGenerated_[i].resize(
-                product_->maxNumberOfCashFlowsPerProductPerStep());
-
-            for (Size j=0; j < cashFlowsGenerated_[i].size(); ++j)
-                cashFlowsGenerated_[i][j].amount.resize(numberRates_+1);
-
             numberCashFlowsThisIndex_[i].resize(product_->possibleCashFlowTimes().size());
 
             V_.push_back(VModel);
@@ -1118,18 +1118,21 @@ namespace QuantLib {
     
 }
 
-    void PathwiseVegasOuterAccountingEngine::multiplePathValuesElementary(std::vector<Real>& means, std::vector<Real>& errors,
-        Size numberOfPaths)
+    void PathwiseVegasOuterAccountingEngine::accumulatePathValuesElementary(
+                                                   std::vector<Real>& sums,
+                                                   std::vector<Real>& sumsqs,
+                                                   Size numberOfPaths)
     {
         Size numberOfElementaryVegas = numberRates_*numberSteps_*factors_;
 
         std::vector<Real> values(product_->numberOfProducts()*(1+numberRates_+numberOfElementaryVegas));
-        means.resize(values.size());
-        errors.resize(values.size());
-        std::vector<Real> sums(values.size(),0.0);
-        std::vector<Real> sumsqs(values.size(),0.0);
-
-
+        if (sums.empty())
+            sums.resize(values.size(),0.0);
+        if (sumsqs.empty())
+            sumsqs.resize(values.size(),0.0);
+        QL_REQUIRE(sums.size() == values.size() &&
+                   sumsqs.size() == values.size(),
+                   "size mismatch between sums and path values");
 
         for (Size i=0; i<numberOfPaths; ++i)
         {
@@ -1142,8 +1145,18 @@ namespace QuantLib {
 
             }
         }
+    }
 
-        for (Size j=0; j < values.size(); ++j)
+    void PathwiseVegasOuterAccountingEngine::multiplePathValuesElementary(std::vector<Real>& means, std::vector<Real>& errors,
+        Size numberOfPaths)
+    {
+        std::vector<Real> sums, sumsqs;
+        accumulatePathValuesElementary(sums, sumsqs, numberOfPaths);
+
+        means.resize(sums.size());
+        errors.resize(sums.size());
+
+        for (Size j=0; j < sums.size(); ++j)
             {
                 means[j] = sums[j]/numberOfPaths;
                 Real meanSq = sumsqs[j]/numberOfPaths;
@@ -1160,6 +1173,14 @@ namespace QuantLib {
 
             multiplePathValuesElementary(allMeans,allErrors,numberOfPaths);
 
+            vegasFromElementary(allMeans,allErrors,means,errors);
+        }
+
+        void PathwiseVegasOuterAccountingEngine::vegasFromElementary(const std::vector<Real>& allMeans,
+                                                                     const std::vector<Real>& allErrors,
+                                                                     std::vector<Real>& means,
+                                                                     std::vector<Real>& errors) const
+        {
             Size outDataPerProduct = 1+numberRates_+numberBumps_;
             Size inDataPerProduct = 1+numberRates_+numberElementaryVegas_;
 
@@ -72,8 +72,7 @@ namespace QuantLib {
         // workspace
         std::vector<Real> numerairesHeld_;
         std::vector<Size> numberCashFlowsThisStep_;
-        std::vector<std::vector<MarketModelPathwiseMultiProduct::CashFlow> >
-                                                         cashFlowsGenerated_;
+        MarketModelPathwiseMultiProduct::CashFlowBuffer cashFlowsGenerated_;
         std::vector<MarketModelPathwiseDiscounter> discounters_;
 
         std::vector<Matrix> V_;  // one V for each product, with components for each time step and rate
@@ -147,8 +146,7 @@ namespace QuantLib {
         std::vector<Real> currentForwards_, lastForwards_;
         std::vector<Real> numerairesHeld_;
         std::vector<Size> numberCashFlowsThisStep_;
-        std::vector<std::vector<MarketModelPathwiseMultiProduct::CashFlow> >
-                                                         cashFlowsGenerated_;
+        MarketModelPathwiseMultiProduct::CashFlowBuffer cashFlowsGenerated_;
         std::vector<MarketModelPathwiseDiscounter> discounters_;
 
         std::vector<Matrix> V_;  // one V for each product, with components for each time step and rate
@@ -208,6 +206,21 @@ namespace QuantLib {
                                 std::vector<Real>& errors,
                                 Size numberOfPaths);
 
+        //! Adds sums and sums of squares of the path values with respect to pseudo-root-elements
+        /*! Empty vectors are resized and filled with zeros; this
+            allows to accumulate paths in several batches, e.g., on
+            different threads, and add up the results exactly.
+        */
+        void accumulatePathValuesElementary(std::vector<Real>& sums,
+                                std::vector<Real>& sumsqs,
+                                Size numberOfPaths);
+
+        //! Turns means with respect to pseudo-root-elements into vegas with respect to VegaBumps
+        void vegasFromElementary(const std::vector<Real>& elementaryMeans,
+                                 const std::vector<Real>& elementaryErrors,
+                                 std::vector<Real>& means,
+                                 std::vector<Real>& errors) const;
+
       private:
           Real singlePathValues(std::vector<Real>& values);
 
@@ -236,8 +249,7 @@ namespace QuantLib {
         std::vector<Real> currentForwards_, lastForwards_;
         std::vector<Real> numerairesHeld_;
         std::vector<Size> numberCashFlowsThisStep_;
-        std::vector<std::vector<MarketModelPathwiseMultiProduct::CashFlow> >
-                                                         cashFlowsGenerated_;
+        MarketModelPathwiseMultiProduct::CashFlowBuffer cashFlowsGenerated_;
         std::vector<MarketModelPathwiseDiscounter> discounters_;
 
         std::vector<Matrix> V_;  // one V for each product, with components for each time step and rate
@@ -21,7 +21,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #ifndef quantlib_market_model_pathwise_multi_product_hpp
 #define quantlib_market_model_pathwise_multi_product_hpp
 
-#include <ql/types.hpp>
+#include <ql/models/marketmodels/cashflowbuffer.hpp>
 #include <vector>
 #include <memory>
 
@@ -48,6 +48,9 @@ namespace QuantLib {
     This class differs from market-model multi-product in that it also returns the
     derivative of the pay-off with respect to each forward rate
 
+    As for market-model multi-products, cash flows are written into a
+    flat buffer allocated once by the engine; the amount vectors of
+    its cash flows are also sized in advance.
     */
 
     class MarketModelPathwiseMultiProduct 
@@ -57,6 +60,7 @@ namespace QuantLib {
             Size timeIndex;
             std::vector<Real > amount;
         };
+        typedef MarketModelCashFlowBuffer<CashFlow> CashFlowBuffer;
         virtual ~MarketModelPathwiseMultiProduct() {}
 
         virtual std::vector<Size> suggestedNumeraires() const = 0;
@@ -73,7 +77,7 @@ namespace QuantLib {
         virtual bool nextTimeStep(
             const CurveState& currentState,
             std::vector<Size>& numberCashFlowsThisStep,
-            std::vector<std::vector<MarketModelPathwiseMultiProduct::CashFlow> >& cashFlowsGenerated) = 0;
+            CashFlowBuffer& cashFlowsGenerated) = 0;
         //! returns a newly-allocated copy of itself
         virtual std::auto_ptr<MarketModelPathwiseMultiProduct> clone() const = 0;
     };
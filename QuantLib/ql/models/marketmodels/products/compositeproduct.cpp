@@ -107,10 +107,9 @@ namespace QuantLib {
             i->numberOfCashflows =
                 std::vector<Size>(i->product->numberOfProducts());
             i->cashflows =
-                std::vector<std::vector<CashFlow> >(
-                     i->product->numberOfProducts(),
-                     std::vector<CashFlow>(i->product
-                                  ->maxNumberOfCashFlowsPerProductPerStep()));
+                CashFlowBuffer(i->product->numberOfProducts(),
+                               i->product
+                                  ->maxNumberOfCashFlowsPerProductPerStep());
         }
 
         // all information having been collected, we can sort and
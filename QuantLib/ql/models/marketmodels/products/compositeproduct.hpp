@@ -61,7 +61,7 @@ namespace QuantLib {
             Clone<MarketModelMultiProduct> product;
             Real multiplier;
             std::vector<Size> numberOfCashflows;
-            std::vector<std::vector<CashFlow> > cashflows;
+            CashFlowBuffer cashflows;
             std::vector<Size> timeIndices;
             bool done;
         };
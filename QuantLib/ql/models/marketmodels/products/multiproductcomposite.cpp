@@ -42,7 +42,7 @@ namespace QuantLib {
     bool MultiProductComposite::nextTimeStep(
                      const CurveState& currentState,
                      std::vector<Size>& numberCashFlowsThisStep,
-                     std::vector<std::vector<CashFlow> >& cashFlowsGenerated) {
+                     CashFlowBuffer& cashFlowsGenerated) {
         QL_REQUIRE(finalized_, "composite not finalized");
         bool done = true;
         Size n = 0, offset = 0;
@@ -79,9 +79,7 @@ namespace QuantLib {
 
         dummyCashFlowsThisStep_ = std::vector<Size>(products, 0);
         Size n = rebate_->maxNumberOfCashFlowsPerProductPerStep();
-        dummyCashFlowsGenerated_ =
-            std::vector<std::vector<CashFlow> >(products,
-                                                std::vector<CashFlow>(n));
+        dummyCashFlowsGenerated_ = CashFlowBuffer(products, n);
     }
 
     std::vector<Size>
@@ -126,7 +124,7 @@ namespace QuantLib {
     bool CallSpecifiedMultiProduct::nextTimeStep(
             const CurveState& currentState,
             std::vector<Size>& numberCashFlowsThisStep,
-            std::vector<std::vector<CashFlow> >& cashFlowsGenerated) 
+            CashFlowBuffer& cashFlowsGenerated) 
     {
 
         bool isUnderlyingTime = isPresent_[0][currentIndex_];
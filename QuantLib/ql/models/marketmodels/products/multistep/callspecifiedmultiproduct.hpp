@@ -47,7 +47,7 @@ namespace QuantLib {
         bool nextTimeStep(
                     const CurveState& currentState,
                     std::vector<Size>& numberCashFlowsThisStep,
-                    std::vector<std::vector<CashFlow> >& cashFlowsGenerated);
+                    CashFlowBuffer& cashFlowsGenerated);
         std::auto_ptr<MarketModelMultiProduct> clone() const;
         //@}
         const MarketModelMultiProduct& underlying() const;
@@ -65,7 +65,7 @@ namespace QuantLib {
         Size rebateOffset_;
         bool wasCalled_;
         std::vector<Size> dummyCashFlowsThisStep_;
-        std::vector<std::vector<CashFlow> > dummyCashFlowsGenerated_;
+        CashFlowBuffer dummyCashFlowsGenerated_;
         Size currentIndex_;
         bool callable_;
     };
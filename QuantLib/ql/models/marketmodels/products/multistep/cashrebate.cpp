@@ -81,7 +81,7 @@ namespace QuantLib {
     bool MarketModelCashRebate::nextTimeStep(
             const CurveState&,
             std::vector<Size>& numberCashFlowsThisStep,
-            std::vector<std::vector<MarketModelMultiProduct::CashFlow> >&
+            MarketModelMultiProduct::CashFlowBuffer&
                                                                genCashFlows)
     {
         for (Size i=0; i<numberOfProducts_; ++i) 
@@ -31,7 +31,7 @@ namespace QuantLib {
     bool ExerciseAdapter::nextTimeStep(
             const CurveState& currentState,
             std::vector<Size>& numberCashFlowsThisStep,
-            std::vector<std::vector<MarketModelMultiProduct::CashFlow> >&
+            MarketModelMultiProduct::CashFlowBuffer&
                                                          generatedCashFlows) {
         std::fill(numberCashFlowsThisStep.begin(),
                   numberCashFlowsThisStep.end(), 0);
@@ -40,7 +40,7 @@ namespace QuantLib {
     bool MultiStepCoinitialSwaps::nextTimeStep(
             const CurveState& currentState,
             std::vector<Size>& numberCashFlowsThisStep,
-            std::vector<std::vector<MarketModelMultiProduct::CashFlow> >&
+            MarketModelMultiProduct::CashFlowBuffer&
                                                                genCashFlows) {
         Rate liborRate = currentState.forwardRate(currentIndex_);
         std::fill(numberCashFlowsThisStep.begin(),
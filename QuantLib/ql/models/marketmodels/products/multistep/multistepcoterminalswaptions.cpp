@@ -38,7 +38,7 @@ namespace QuantLib {
     bool MultiStepCoterminalSwaptions::nextTimeStep(
             const CurveState& currentState,
             std::vector<Size>& numberCashFlowsThisStep,
-            std::vector<std::vector<MarketModelMultiProduct::CashFlow> >&
+            MarketModelMultiProduct::CashFlowBuffer&
                                                                genCashFlows)
     {
         genCashFlows[currentIndex_][0].timeIndex = currentIndex_;
@@ -42,7 +42,7 @@ namespace QuantLib {
         bool nextTimeStep(
                      const CurveState& currentState,
                      std::vector<Size>& numberCashFlowsThisStep,
-                     std::vector<std::vector<CashFlow> >& cashFlowsGenerated);
+                     CashFlowBuffer& cashFlowsGenerated);
         std::auto_ptr<MarketModelMultiProduct> clone() const;
          //@}
 
@@ -40,7 +40,7 @@ namespace QuantLib {
         bool nextTimeStep(
                      const CurveState& currentState,
                      std::vector<Size>& numberCashFlowsThisStep,
-                     std::vector<std::vector<CashFlow> >& cashFlowsGenerated);
+                     CashFlowBuffer& cashFlowsGenerated);
         std::auto_ptr<MarketModelMultiProduct> clone() const;
         //@}
       private:
@@ -56,7 +56,7 @@ namespace QuantLib {
     bool MultiStepInverseFloater::nextTimeStep(
         const CurveState& currentState,
         std::vector<Size>& numberCashFlowsThisStep,
-        std::vector<std::vector<MarketModelMultiProduct::CashFlow> >&
+        MarketModelMultiProduct::CashFlowBuffer&
         genCashFlows)
     {
          Rate liborRate = currentState.forwardRate(currentIndex_);
@@ -30,7 +30,7 @@ namespace QuantLib {
     bool MultiStepNothing::nextTimeStep(
         const CurveState&,
         std::vector<Size>& numberCashFlowsThisStep,
-        std::vector<std::vector<MarketModelMultiProduct::CashFlow> >&) {
+        MarketModelMultiProduct::CashFlowBuffer&) {
         std::fill(numberCashFlowsThisStep.begin(),
                   numberCashFlowsThisStep.end(),
                   0);
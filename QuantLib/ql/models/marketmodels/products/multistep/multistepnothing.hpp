@@ -38,7 +38,7 @@ namespace QuantLib {
         void reset();
         bool nextTimeStep(const CurveState&,
                           std::vector<Size>&,
-                          std::vector<std::vector<CashFlow> >&);
+                          CashFlowBuffer&);
         std::auto_ptr<MarketModelMultiProduct> clone() const;
         //@}
       private:
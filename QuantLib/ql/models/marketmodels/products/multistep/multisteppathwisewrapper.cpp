@@ -25,14 +25,15 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 namespace QuantLib 
 {
     MultiProductPathwiseWrapper::MultiProductPathwiseWrapper(const MarketModelPathwiseMultiProduct& innerProduct)
-        :  innerProduct_(innerProduct), cashFlowsGenerated_ (innerProduct.numberOfProducts(), std::vector<MarketModelPathwiseMultiProduct::CashFlow>(innerProduct.maxNumberOfCashFlowsPerProductPerStep())),
+        :  innerProduct_(innerProduct),
         numberOfProducts_(innerProduct.numberOfProducts())
     {
-
-        for (Size i=0; i < cashFlowsGenerated_.size(); ++i)
-            for (Size j=0; j < cashFlowsGenerated_[i].size(); ++j)
-                    cashFlowsGenerated_[i][j].amount.resize(1+innerProduct.evolution().numberOfRates());
-        
+        MarketModelPathwiseMultiProduct::CashFlow cashFlow;
+        cashFlow.amount.resize(1+innerProduct.evolution().numberOfRates());
+        cashFlowsGenerated_ = MarketModelPathwiseMultiProduct::CashFlowBuffer(
+                           numberOfProducts_,
+                           innerProduct.maxNumberOfCashFlowsPerProductPerStep(),
+                           cashFlow);
     }
 
         std::vector<Time>  MultiProductPathwiseWrapper::possibleCashFlowTimes() const
@@ -58,7 +59,7 @@ namespace QuantLib
         bool  MultiProductPathwiseWrapper::nextTimeStep(
                      const CurveState& currentState,
                      std::vector<Size>& numberCashFlowsThisStep,
-                     std::vector<std::vector<CashFlow> >& cashFlowsGenerated)
+                     CashFlowBuffer& cashFlowsGenerated)
         {
             bool done = innerProduct_->nextTimeStep(currentState, numberCashFlowsThisStep,cashFlowsGenerated_);
 
@@ -47,14 +47,14 @@ namespace QuantLib
         bool nextTimeStep(
                      const CurveState& currentState,
                      std::vector<Size>& numberCashFlowsThisStep,
-                     std::vector<std::vector<CashFlow> >& cashFlowsGenerated);
+                     CashFlowBuffer& cashFlowsGenerated);
         std::auto_ptr<MarketModelMultiProduct> clone() const;
             std::vector<Size> suggestedNumeraires() const;
         const EvolutionDescription& evolution() const;
 
       private:
           Clone<MarketModelPathwiseMultiProduct> innerProduct_;
-          std::vector<std::vector<MarketModelPathwiseMultiProduct::CashFlow> > cashFlowsGenerated_;
+          MarketModelPathwiseMultiProduct::CashFlowBuffer cashFlowsGenerated_;
           Size numberOfProducts_;
      
     };
@@ -76,7 +76,7 @@ namespace QuantLib {
     bool MultiStepPeriodCapletSwaptions::nextTimeStep(
             const CurveState& currentState,
             std::vector<Size>& numberCashFlowsThisStep,
-            std::vector<std::vector<MarketModelMultiProduct::CashFlow> >&
+            MarketModelMultiProduct::CashFlowBuffer&
                                                                genCashFlows)
     {
 
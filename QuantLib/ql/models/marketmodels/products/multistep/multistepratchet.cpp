@@ -46,7 +46,7 @@ namespace QuantLib {
     bool MultiStepRatchet::nextTimeStep(
             const CurveState& currentState,
             std::vector<Size>& numberCashFlowsThisStep,
-            std::vector<std::vector<MarketModelMultiProduct::CashFlow> >&
+            MarketModelMultiProduct::CashFlowBuffer&
                                                                  genCashFlows)
     {
         Rate liborRate = currentState.forwardRate(currentIndex_);
@@ -39,7 +39,7 @@ namespace QuantLib {
     bool MultiStepSwap::nextTimeStep(
             const CurveState& currentState,
             std::vector<Size>& numberCashFlowsThisStep,
-            std::vector<std::vector<MarketModelMultiProduct::CashFlow> >&
+            MarketModelMultiProduct::CashFlowBuffer&
                                                                  genCashFlows)
     {
         Rate liborRate = currentState.forwardRate(currentIndex_);
@@ -42,7 +42,7 @@ namespace QuantLib {
     bool MultiStepSwaption::nextTimeStep(
             const CurveState& currentState,
             std::vector<Size>& numberCashFlowsThisStep,
-            std::vector<std::vector<MarketModelMultiProduct::CashFlow> >&
+            MarketModelMultiProduct::CashFlowBuffer&
                                                                genCashFlows)
     {
         if (currentIndex_ == startIndex_)
@@ -55,7 +55,7 @@ namespace QuantLib {
     bool MultiStepTarn::nextTimeStep(
             const CurveState& currentState,
             std::vector<Size>& numberCashFlowsThisStep,
-            std::vector<std::vector<MarketModelMultiProduct::CashFlow> >&
+            MarketModelMultiProduct::CashFlowBuffer&
                                                                  genCashFlows)
     {
         Rate liborRate = currentState.forwardRate(currentIndex_);
@@ -41,7 +41,7 @@ namespace QuantLib {
     bool OneStepCoinitialSwaps::nextTimeStep(
             const CurveState& currentState,
             std::vector<Size>& numberCashFlowsThisStep,
-            std::vector<std::vector<MarketModelMultiProduct::CashFlow> >&
+            MarketModelMultiProduct::CashFlowBuffer&
                                                                genCashFlows) {
         std::fill(numberCashFlowsThisStep.begin(),
                   numberCashFlowsThisStep.end(),0);
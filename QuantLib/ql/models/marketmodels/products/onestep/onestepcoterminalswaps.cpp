@@ -40,7 +40,7 @@ namespace QuantLib {
     bool OneStepCoterminalSwaps::nextTimeStep(
             const CurveState& currentState,
             std::vector<Size>& numberCashFlowsThisStep,
-            std::vector<std::vector<MarketModelMultiProduct::CashFlow> >&
+            MarketModelMultiProduct::CashFlowBuffer&
                                                                genCashFlows) {
         std::fill(numberCashFlowsThisStep.begin(),
                   numberCashFlowsThisStep.end(),0);
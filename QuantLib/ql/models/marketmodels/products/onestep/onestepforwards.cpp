@@ -35,7 +35,7 @@ namespace QuantLib {
     bool OneStepForwards::nextTimeStep(
             const CurveState& currentState,
             std::vector<Size>& numberCashFlowsThisStep,
-            std::vector<std::vector<MarketModelMultiProduct::CashFlow> >&
+            MarketModelMultiProduct::CashFlowBuffer&
                                                                genCashFlows) {
         for (Size i=0; i<strikes_.size(); ++i) {
             Rate liborRate = currentState.forwardRate(i);
@@ -91,8 +91,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
             modelCashFlow.amount.resize(d1.numberOfRates()+1);
 
             dummyCashFlowsGenerated_ =
-                std::vector<std::vector<CashFlow> >(products,
-                std::vector<CashFlow>(n, modelCashFlow));
+                CashFlowBuffer(products, n, modelCashFlow);
         }
 
         bool CallSpecifiedPathwiseMultiProduct:: alreadyDeflated() const
@@ -142,7 +141,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
         bool CallSpecifiedPathwiseMultiProduct::nextTimeStep(
             const CurveState& currentState,
             std::vector<Size>& numberCashFlowsThisStep,
-            std::vector<std::vector<CashFlow> >& cashFlowsGenerated) 
+            CashFlowBuffer& cashFlowsGenerated) 
         {
 
             bool isUnderlyingTime = isPresent_[0][currentIndex_];
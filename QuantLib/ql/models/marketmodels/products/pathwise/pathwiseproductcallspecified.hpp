@@ -56,7 +56,7 @@ namespace QuantLib
         virtual bool nextTimeStep(
             const CurveState& currentState,
             std::vector<Size>& numberCashFlowsThisStep,
-            std::vector<std::vector<MarketModelPathwiseMultiProduct::CashFlow> >& cashFlowsGenerated) ;
+            MarketModelPathwiseMultiProduct::CashFlowBuffer& cashFlowsGenerated) ;
 
         virtual std::auto_ptr<MarketModelPathwiseMultiProduct> clone() const;
           
@@ -79,7 +79,7 @@ namespace QuantLib
         Size rebateOffset_;
         bool wasCalled_;
         std::vector<Size> dummyCashFlowsThisStep_;
-        std::vector<std::vector<CashFlow> > dummyCashFlowsGenerated_;
+        CashFlowBuffer dummyCashFlowsGenerated_;
         Size currentIndex_;
         bool callable_;
     };
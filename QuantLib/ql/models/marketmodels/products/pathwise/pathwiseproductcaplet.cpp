@@ -70,7 +70,7 @@ namespace QuantLib {
     bool MarketModelPathwiseMultiCaplet::nextTimeStep(
         const CurveState& currentState,
         std::vector<Size>& numberCashFlowsThisStep,
-        std::vector<std::vector<MarketModelPathwiseMultiProduct::CashFlow> >& cashFlowsGenerated) 
+        MarketModelPathwiseMultiProduct::CashFlowBuffer& cashFlowsGenerated) 
     {
         Rate liborRate = currentState.forwardRate(currentIndex_);
         cashFlowsGenerated[currentIndex_][0].timeIndex = currentIndex_;
@@ -210,7 +210,7 @@ namespace QuantLib {
     bool MarketModelPathwiseMultiDeflatedCaplet::nextTimeStep(
         const CurveState& currentState,
         std::vector<Size>& numberCashFlowsThisStep,
-        std::vector<std::vector<MarketModelPathwiseMultiProduct::CashFlow> >& cashFlowsGenerated) 
+        MarketModelPathwiseMultiProduct::CashFlowBuffer& cashFlowsGenerated) 
     {
         Rate liborRate = currentState.forwardRate(currentIndex_);
         cashFlowsGenerated[currentIndex_][0].timeIndex = currentIndex_;
@@ -297,15 +297,12 @@ namespace QuantLib {
         }
 
         innerCashFlowSizes_.resize(accruals.size());
-        innerCashFlowsGenerated_.resize(accruals.size());
-        for (Size i=0; i <  innerCashFlowsGenerated_.size(); ++i)
-        {
-            innerCashFlowsGenerated_[i].resize(underlyingCaplets_.maxNumberOfCashFlowsPerProductPerStep());
-            for (Size j=0; j < underlyingCaplets_.maxNumberOfCashFlowsPerProductPerStep(); ++j)
-                innerCashFlowsGenerated_[i][j].amount.resize(accruals.size()+1);
-
-
-        }
+        CashFlow innerCashFlow;
+        innerCashFlow.amount.resize(accruals.size()+1);
+        innerCashFlowsGenerated_ =
+            CashFlowBuffer(accruals.size(),
+                           underlyingCaplets_.maxNumberOfCashFlowsPerProductPerStep(),
+                           innerCashFlow);
  
     }
 
@@ -352,7 +349,7 @@ namespace QuantLib {
     bool MarketModelPathwiseMultiDeflatedCap::nextTimeStep(
         const CurveState& currentState,
         std::vector<Size>& numberCashFlowsThisStep,
-        std::vector<std::vector<MarketModelPathwiseMultiProduct::CashFlow> >& cashFlowsGenerated)
+        MarketModelPathwiseMultiProduct::CashFlowBuffer& cashFlowsGenerated)
     {
 
         bool done = underlyingCaplets_.nextTimeStep(currentState, innerCashFlowSizes_, innerCashFlowsGenerated_);
@@ -71,7 +71,7 @@ namespace QuantLib {
           virtual bool nextTimeStep(
             const CurveState& currentState,
             std::vector<Size>& numberCashFlowsThisStep,
-            std::vector<std::vector<MarketModelPathwiseMultiProduct::CashFlow> >& cashFlowsGenerated) ;
+            MarketModelPathwiseMultiProduct::CashFlowBuffer& cashFlowsGenerated) ;
 
         //! returns a newly-allocated copy of itself
         virtual std::auto_ptr<MarketModelPathwiseMultiProduct> clone() const;
@@ -123,7 +123,7 @@ namespace QuantLib {
           virtual bool nextTimeStep(
             const CurveState& currentState,
             std::vector<Size>& numberCashFlowsThisStep,
-            std::vector<std::vector<MarketModelPathwiseMultiProduct::CashFlow> >& cashFlowsGenerated) ;
+            MarketModelPathwiseMultiProduct::CashFlowBuffer& cashFlowsGenerated) ;
 
         //! returns a newly-allocated copy of itself
         virtual std::auto_ptr<MarketModelPathwiseMultiProduct> clone() const;
@@ -178,7 +178,7 @@ namespace QuantLib {
           virtual bool nextTimeStep(
             const CurveState& currentState,
             std::vector<Size>& numberCashFlowsThisStep,
-            std::vector<std::vector<MarketModelPathwiseMultiProduct::CashFlow> >& cashFlowsGenerated) ;
+            MarketModelPathwiseMultiProduct::CashFlowBuffer& cashFlowsGenerated) ;
 
         //! returns a newly-allocated copy of itself
         virtual std::auto_ptr<MarketModelPathwiseMultiProduct> clone() const;
@@ -193,7 +193,7 @@ namespace QuantLib {
         // things that vary in a path
         Size currentIndex_;
         std::vector<Size> innerCashFlowSizes_;
-        std::vector<std::vector<MarketModelPathwiseMultiProduct::CashFlow> > innerCashFlowsGenerated_;
+        MarketModelPathwiseMultiProduct::CashFlowBuffer innerCashFlowsGenerated_;
 
     };
 
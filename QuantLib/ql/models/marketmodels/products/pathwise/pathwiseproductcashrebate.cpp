@@ -89,7 +89,7 @@ namespace QuantLib
     bool MarketModelPathwiseCashRebate::nextTimeStep(
             const CurveState&,
             std::vector<Size>& numberCashFlowsThisStep,
-            std::vector<std::vector<MarketModelPathwiseMultiProduct::CashFlow> >& cashFlowsGenerated) 
+            MarketModelPathwiseMultiProduct::CashFlowBuffer& cashFlowsGenerated) 
     {
         for (Size i=0; i<numberOfProducts_; ++i) 
         {
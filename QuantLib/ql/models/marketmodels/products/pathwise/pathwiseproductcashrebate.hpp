@@ -60,7 +60,7 @@ namespace QuantLib {
 
         virtual bool nextTimeStep(const CurveState& currentState,
                                   std::vector<Size>& numberCashFlowsThisStep,
-                                  std::vector<std::vector<MarketModelPathwiseMultiProduct::CashFlow> >& cashFlowsGenerated);
+                                  MarketModelPathwiseMultiProduct::CashFlowBuffer& cashFlowsGenerated);
 
         virtual std::auto_ptr<MarketModelPathwiseMultiProduct> clone() const;
 
@@ -68,7 +68,7 @@ namespace QuantLib
     bool MarketModelPathwiseInverseFloater::nextTimeStep(
         const CurveState& currentState,
         std::vector<Size>& numberCashFlowsThisStep,
-        std::vector<std::vector<MarketModelPathwiseMultiProduct::CashFlow> >& cashFlowsGenerated) 
+        MarketModelPathwiseMultiProduct::CashFlowBuffer& cashFlowsGenerated) 
     {
         numberCashFlowsThisStep[0] =1 ;
         for (Size i=1; i <= lastIndex_; ++i)
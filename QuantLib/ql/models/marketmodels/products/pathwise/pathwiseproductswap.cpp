@@ -66,7 +66,7 @@ namespace QuantLib
     bool MarketModelPathwiseSwap::nextTimeStep(
             const CurveState& currentState,
             std::vector<Size>& numberCashFlowsThisStep,
-            std::vector<std::vector<MarketModelPathwiseMultiProduct::CashFlow> >& cashFlowsGenerated) 
+            MarketModelPathwiseMultiProduct::CashFlowBuffer& cashFlowsGenerated) 
     {
         Rate liborRate = currentState.forwardRate(currentIndex_);
         cashFlowsGenerated[0][0].timeIndex = currentIndex_+1;
@@ -68,7 +68,7 @@ class MarketModelPathwiseSwap : public MarketModelPathwiseMultiProduct
         virtual bool nextTimeStep(
             const CurveState& currentState,
             std::vector<Size>& numberCashFlowsThisStep,
-            std::vector<std::vector<MarketModelPathwiseMultiProduct::CashFlow> >& cashFlowsGenerated) ;
+            MarketModelPathwiseMultiProduct::CashFlowBuffer& cashFlowsGenerated) ;
 
         //! returns a newly-allocated copy of itself
         virtual std::auto_ptr<MarketModelPathwiseMultiProduct> clone() const;
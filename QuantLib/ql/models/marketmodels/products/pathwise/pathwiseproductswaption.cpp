@@ -56,7 +56,7 @@ namespace QuantLib {
     bool MarketModelPathwiseCoterminalSwaptionsDeflated::nextTimeStep(
             const CurveState& currentState,
             std::vector<Size>& numberCashFlowsThisStep,
-            std::vector<std::vector<MarketModelPathwiseMultiProduct::CashFlow> >& cashFlowsGenerated) 
+            MarketModelPathwiseMultiProduct::CashFlowBuffer& cashFlowsGenerated) 
     {
         Rate swapRate = currentState.coterminalSwapRate(currentIndex_);
         cashFlowsGenerated[currentIndex_][0].timeIndex = currentIndex_;
@@ -164,7 +164,7 @@ namespace QuantLib {
     bool MarketModelPathwiseCoterminalSwaptionsNumericalDeflated::nextTimeStep(
             const CurveState& currentState,
             std::vector<Size>& numberCashFlowsThisStep,
-            std::vector<std::vector<MarketModelPathwiseMultiProduct::CashFlow> >& cashFlowsGenerated) 
+            MarketModelPathwiseMultiProduct::CashFlowBuffer& cashFlowsGenerated) 
     {
         Rate swapRate = currentState.coterminalSwapRate(currentIndex_);
         cashFlowsGenerated[currentIndex_][0].timeIndex = currentIndex_;
@@ -64,7 +64,7 @@ class MarketModelPathwiseCoterminalSwaptionsDeflated : public MarketModelPathwis
         virtual bool nextTimeStep(
             const CurveState& currentState,
             std::vector<Size>& numberCashFlowsThisStep,
-            std::vector<std::vector<MarketModelPathwiseMultiProduct::CashFlow> >& cashFlowsGenerated) ;
+            MarketModelPathwiseMultiProduct::CashFlowBuffer& cashFlowsGenerated) ;
 
         //! returns a newly-allocated copy of itself
         virtual std::auto_ptr<MarketModelPathwiseMultiProduct> clone() const;
@@ -111,7 +111,7 @@ class MarketModelPathwiseCoterminalSwaptionsNumericalDeflated : public MarketMod
         virtual bool nextTimeStep(
             const CurveState& currentState,
             std::vector<Size>& numberCashFlowsThisStep,
-            std::vector<std::vector<MarketModelPathwiseMultiProduct::CashFlow> >& cashFlowsGenerated) ;
+            MarketModelPathwiseMultiProduct::CashFlowBuffer& cashFlowsGenerated) ;
 
         //! returns a newly-allocated copy of itself
         virtual std::auto_ptr<MarketModelPathwiseMultiProduct> clone() const;
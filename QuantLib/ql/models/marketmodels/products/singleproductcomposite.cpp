@@ -37,7 +37,7 @@ namespace QuantLib {
     bool SingleProductComposite::nextTimeStep(
                      const CurveState& currentState,
                      std::vector<Size>& numberCashFlowsThisStep,
-                     std::vector<std::vector<CashFlow> >& cashFlowsGenerated) {
+                     CashFlowBuffer& cashFlowsGenerated) {
         QL_REQUIRE(finalized_, "composite not finalized");
         bool done = true;
         Size n = 0, totalCashflows = 0;
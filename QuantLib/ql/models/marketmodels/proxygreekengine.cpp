@@ -45,11 +45,8 @@ namespace QuantLib {
       numberProducts_(product->numberOfProducts()),
       numerairesHeld_(product->numberOfProducts()),
       numberCashFlowsThisStep_(product->numberOfProducts()),
-      cashFlowsGenerated_(product->numberOfProducts()) {
-        for (Size i=0; i<numberProducts_; ++i)
-            cashFlowsGenerated_[i].resize(
-                       product_->maxNumberOfCashFlowsPerProductPerStep());
-
+      cashFlowsGenerated_(product->numberOfProducts(),
+                          product->maxNumberOfCashFlowsPerProductPerStep()) {
         const std::vector<Time>& cashFlowTimes =
             product_->possibleCashFlowTimes();
         const std::vector<Rate>& rateTimes = product_->evolution().rateTimes();
@@ -149,8 +146,8 @@ namespace QuantLib {
             // for each product...
             for (Size i=0; i<numberProducts_; ++i) {
                 // ...and each cash flow...
-                const std::vector<MarketModelMultiProduct::CashFlow>& cashflows =
-                    cashFlowsGenerated_[i];
+                MarketModelMultiProduct::CashFlowBuffer::const_iterator
+                    cashflows = cashFlowsGenerated_[i];
                 for (Size j=0; j<numberCashFlowsThisStep_[i]; ++j) {
                     // ...convert the cash flow to numeraires.
                     // This is done by calculating the number of
@@ -73,8 +73,7 @@ namespace QuantLib {
         std::valarray<bool> constraintsActive_;
         std::vector<Real> numerairesHeld_;
         std::vector<Size> numberCashFlowsThisStep_;
-        std::vector<std::vector<MarketModelMultiProduct::CashFlow> >
-                                                         cashFlowsGenerated_;
+        MarketModelMultiProduct::CashFlowBuffer cashFlowsGenerated_;
         std::vector<MarketModelDiscounter> discounters_;
 
     };
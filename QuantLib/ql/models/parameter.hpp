@@ -28,6 +28,7 @@
 #include <ql/handle.hpp>
 #include <ql/math/optimization/constraint.hpp>
 #include <vector>
+#include <algorithm>
 
 namespace QuantLib {
 
@@ -170,8 +171,12 @@ namespace QuantLib {
                 values_.clear();
             }
             Real value(const Array&, Time t) const {
+                // times are usually set in increasing order while
+                // fitting a tree, which allows a binary search
                 std::vector<Time>::const_iterator result =
-                    std::find(times_.begin(), times_.end(), t);
+                    std::lower_bound(times_.begin(), times_.end(), t);
+                if (result == times_.end() || *result != t)
+                    result = std::find(times_.begin(), times_.end(), t);
                 QL_REQUIRE(result!=times_.end(),
                            "fitting parameter not set!");
                 return values_[result - times_.begin()];
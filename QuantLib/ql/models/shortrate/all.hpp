@@ -2,6 +2,7 @@
 /* Add the files to be included into Makefile.am instead. */
 
 #include <ql/models/shortrate/onefactormodel.hpp>
+#include <ql/models/shortrate/shortratetreecache.hpp>
 #include <ql/models/shortrate/twofactormodel.hpp>
 
 #include <ql/models/shortrate/calibrationhelpers/all.hpp>
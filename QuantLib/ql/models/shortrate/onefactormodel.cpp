@@ -89,6 +89,19 @@ namespace QuantLib {
     : TreeLattice1D<OneFactorModel::ShortRateTree>(timeGrid, tree->size(1)),
       tree_(tree), dynamics_(dynamics) {}
 
+    void OneFactorModel::ShortRateTree::stepback(Size i,
+                                                 const Array& values,
+                                                 Array& newValues) const {
+        // same as the generic implementation, but the expectations
+        // are taken on the branching data of the trinomial tree
+        tree_->expectation(i, values, newValues);
+        Time t = timeGrid()[i], dt = timeGrid().dt(i);
+        for (Size j=0; j<newValues.size(); j++) {
+            Rate r = dynamics_->shortRate(t, tree_->underlying(i, j));
+            newValues[j] *= std::exp(-r*dt);
+        }
+    }
+
     OneFactorModel::OneFactorModel(Size nArguments)
     : ShortRateModel(nArguments) {}
 
@@ -0,0 +1,84 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2015 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+#include <ql/models/shortrate/shortratetreecache.hpp>
+
+namespace QuantLib {
+
+    ShortRateTreeCache::ShortRateTreeCache(Size maxSize)
+    : maxSize_(maxSize) {
+        QL_REQUIRE(maxSize > 0, "cache size must be positive");
+    }
+
+    boost::shared_ptr<Lattice> ShortRateTreeCache::tree(
+                            const boost::shared_ptr<ShortRateModel>& model,
+                            const TimeGrid& grid) {
+        QL_REQUIRE(model, "null model");
+
+        const Array params = model->params();
+
+        for (std::list<Entry>::iterator i = entries_.begin();
+             i != entries_.end(); ++i) {
+            if (i->model == model
+                && i->params.size() == params.size()
+                && std::equal(params.begin(), params.end(),
+                              i->params.begin())
+                && sameGrid(i->times, grid)) {
+                // move to the front as the most recently used
+                entries_.splice(entries_.begin(), entries_, i);
+                return entries_.front().tree;
+            }
+        }
+
+        Entry entry;
+        entry.model = model;
+        entry.params = params;
+        entry.times = std::vector<Time>(grid.begin(), grid.end());
+        entry.tree = model->tree(grid);
+
+        registerWith(model);
+        entries_.push_front(entry);
+        if (entries_.size() > maxSize_)
+            entries_.pop_back();
+
+        return entries_.front().tree;
+    }
+
+    Size ShortRateTreeCache::size() const {
+        return entries_.size();
+    }
+
+    void ShortRateTreeCache::clear() {
+        entries_.clear();
+        unregisterWithAll();
+    }
+
+    void ShortRateTreeCache::update() {
+        // we can't unregister while the model is notifying us
+        entries_.clear();
+    }
+
+    bool ShortRateTreeCache::sameGrid(const std::vector<Time>& times,
+                                      const TimeGrid& grid) {
+        return times.size() == grid.size()
+            && std::equal(times.begin(), times.end(), grid.begin());
+    }
+
+}
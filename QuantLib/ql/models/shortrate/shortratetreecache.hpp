@@ -0,0 +1,83 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2015 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+
+/*! \file shortratetreecache.hpp
+    \brief cache of short-rate trees shared among engines
+*/
+
+#ifndef quantlib_short_rate_tree_cache_hpp
+#define quantlib_short_rate_tree_cache_hpp
+
+#include <ql/models/model.hpp>
+#include <list>
+
+namespace QuantLib {
+
+    //! cache of short-rate trees shared among engines
+    /*! Building and fitting a short-rate tree is usually the most
+        expensive part of pricing an instrument on a lattice.  This
+        class keeps the most recently used trees, keyed on the model,
+        its parameters and the time grid, so that engines pricing
+        instruments with the same mandatory times (see
+        LatticeShortRateModelEngine::setTreeCache) share a single tree.
+
+        The cache is emptied whenever any of the models it holds trees
+        for notifies a change, e.g., after a calibration or a change
+        in the fitted term structure.
+
+        \ingroup shortrate
+    */
+    class ShortRateTreeCache : public Observer {
+      public:
+        explicit ShortRateTreeCache(Size maxSize = 16);
+
+        /*! returns the tree of the given model on the given grid,
+            building it if it's not in the cache.
+        */
+        boost::shared_ptr<Lattice> tree(
+                            const boost::shared_ptr<ShortRateModel>& model,
+                            const TimeGrid& grid);
+
+        //! number of trees currently cached
+        Size size() const;
+        //! removes all trees and releases the models
+        void clear();
+
+        //! \name Observer interface
+        //@{
+        void update();
+        //@}
+      private:
+        struct Entry {
+            boost::shared_ptr<ShortRateModel> model;
+            Array params;
+            std::vector<Time> times;
+            boost::shared_ptr<Lattice> tree;
+        };
+        static bool sameGrid(const std::vector<Time>& times,
+                             const TimeGrid& grid);
+
+        Size maxSize_;
+        std::list<Entry> entries_;
+    };
+
+}
+
+#endif
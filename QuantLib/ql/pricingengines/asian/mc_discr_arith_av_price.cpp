@@ -51,4 +51,41 @@ namespace QuantLib {
         return discount_ * payoff_(averagePrice);
     }
 
+    Real ArithmeticAPOPathPricer::operator()(const Path& path,
+                                             Path& adjoint) const  {
+        Size n = path.length();
+        QL_REQUIRE(n>1, "the path cannot be empty");
+
+        Real sum;
+        Size fixings;
+        bool includeInitial = (path.timeGrid().mandatoryTimes()[0]==0.0);
+        if (includeInitial) {
+            // include initial fixing
+            sum = std::accumulate(path.begin(),path.end(),runningSum_);
+            fixings = pastFixings_ + n;
+        } else {
+            sum = std::accumulate(path.begin()+1,path.end(),runningSum_);
+            fixings = pastFixings_ + n - 1;
+        }
+        Real averagePrice = sum/fixings;
+
+        Real slope;
+        switch (payoff_.optionType()) {
+          case Option::Call:
+            slope = averagePrice > payoff_.strike() ? 1.0 : 0.0;
+            break;
+          case Option::Put:
+            slope = averagePrice < payoff_.strike() ? -1.0 : 0.0;
+            break;
+          default:
+            QL_FAIL("unknown option type");
+        }
+        Real fixingAdjoint = discount_ * slope / fixings;
+        adjoint.front() = includeInitial ? fixingAdjoint : 0.0;
+        for (Size i=1; i<n; ++i)
+            adjoint[i] = fixingAdjoint;
+
+        return discount_ * payoff_(averagePrice);
+    }
+
 }
@@ -40,8 +40,15 @@ namespace QuantLib {
 
          \ingroup asianengines
 
-         \test the correctness of the returned value is tested by
-               reproducing results available in literature.
+         Pathwise delta and vega can be obtained in the same
+         simulation by sweeping the adjoints of the payoff backwards
+         along each path.
+
+         \test
+         - the correctness of the returned value is tested by
+           reproducing results available in literature.
+         - the correctness of the returned pathwise greeks is tested
+           by checking them against bump-and-revalue results.
     */
     template <class RNG = PseudoRandom, class S = Statistics>
     class MCDiscreteArithmeticAPEngine
@@ -64,7 +71,10 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed);
+             BigNatural seed,
+             bool pathwiseGreeks = false,
+             bool commonRandomNumbers = false,
+             Real timeBudget = Null<Real>());
       protected:
         boost::shared_ptr<path_pricer_type> pathPricer() const;
         boost::shared_ptr<path_pricer_type> controlPathPricer() const;
@@ -76,7 +86,7 @@ namespace QuantLib {
     };
 
 
-    class ArithmeticAPOPathPricer : public PathPricer<Path> {
+    class ArithmeticAPOPathPricer : public AdjointPathPricer<Path> {
       public:
         ArithmeticAPOPathPricer(Option::Type type,
                                 Real strike,
@@ -84,6 +94,7 @@ namespace QuantLib {
                                 Real runningSum = 0.0,
                                 Size pastFixings = 0);
         Real operator()(const Path& path) const;
+        Real operator()(const Path& path, Path& adjoint) const;
       private:
         PlainVanillaPayoff payoff_;
         DiscountFactor discount_;
@@ -104,7 +115,10 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed)
+             BigNatural seed,
+             bool pathwiseGreeks,
+             bool commonRandomNumbers,
+             Real timeBudget)
     : MCDiscreteAveragingAsianEngine<RNG,S>(process,
                                             brownianBridge,
                                             antitheticVariate,
@@ -112,7 +126,10 @@ namespace QuantLib {
                                             requiredSamples,
                                             requiredTolerance,
                                             maxSamples,
-                                            seed) {}
+                                            seed,
+                                            pathwiseGreeks,
+                                            commonRandomNumbers,
+                                            timeBudget) {}
 
     template <class RNG, class S>
     inline
@@ -130,15 +147,25 @@ namespace QuantLib {
                 this->arguments_.exercise);
         QL_REQUIRE(exercise, "wrong exercise given");
 
-        return boost::shared_ptr<typename
-            MCDiscreteArithmeticAPEngine<RNG,S>::path_pricer_type>(
+        TimeGrid grid = this->timeGrid();
+        boost::shared_ptr<ArithmeticAPOPathPricer> pricer(
                 new ArithmeticAPOPathPricer(
                     payoff->optionType(),
                     payoff->strike(),
-                    this->process_->riskFreeRate()->discount(
-                                                     this->timeGrid().back()),
+                    this->process_->riskFreeRate()->discount(grid.back()),
                     this->arguments_.runningAccumulator,
                     this->arguments_.pastFixings));
+
+        if (!this->pathwiseGreeks_)
+            return pricer;
+
+        this->greeksPricer_ =
+            boost::shared_ptr<PathwiseGreeksPathPricer<Path> >(
+                new PathwiseGreeksPathPricer<Path>(
+                    pricer,
+                    std::vector<BlackScholesPathAdjoint>(
+                        1, BlackScholesPathAdjoint(this->process_, grid))));
+        return this->greeksPricer_;
     }
 
     template <class RNG, class S>
@@ -182,13 +209,18 @@ namespace QuantLib {
         MakeMCDiscreteArithmeticAPEngine& withSeed(BigNatural seed);
         MakeMCDiscreteArithmeticAPEngine& withAntitheticVariate(bool b = true);
         MakeMCDiscreteArithmeticAPEngine& withControlVariate(bool b = true);
+        MakeMCDiscreteArithmeticAPEngine& withPathwiseGreeks(bool b = true);
+        MakeMCDiscreteArithmeticAPEngine& withCommonRandomNumbers(
+                                                            bool b = true);
+        MakeMCDiscreteArithmeticAPEngine& withTimeBudget(Real seconds);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
       private:
         boost::shared_ptr<GeneralizedBlackScholesProcess> process_;
-        bool antithetic_, controlVariate_;
+        bool antithetic_, controlVariate_, pathwiseGreeks_;
+        bool commonRandomNumbers_;
         Size samples_, maxSamples_;
-        Real tolerance_;
+        Real tolerance_, timeBudget_;
         bool brownianBridge_;
         BigNatural seed_;
     };
@@ -198,14 +230,18 @@ namespace QuantLib {
     MakeMCDiscreteArithmeticAPEngine<RNG,S>::MakeMCDiscreteArithmeticAPEngine(
              const boost::shared_ptr<GeneralizedBlackScholesProcess>& process)
     : process_(process), antithetic_(false), controlVariate_(false),
+      pathwiseGreeks_(false), commonRandomNumbers_(false),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), brownianBridge_(true), seed_(0) {}
+      tolerance_(Null<Real>()), timeBudget_(Null<Real>()),
+      brownianBridge_(true), seed_(0) {}
 
     template <class RNG, class S>
     inline MakeMCDiscreteArithmeticAPEngine<RNG,S>&
     MakeMCDiscreteArithmeticAPEngine<RNG,S>::withSamples(Size samples) {
         QL_REQUIRE(tolerance_ == Null<Real>(),
                    "tolerance already set");
+        QL_REQUIRE(timeBudget_ == Null<Real>(),
+                   "time budget already set");
         samples_ = samples;
         return *this;
     }
@@ -258,6 +294,29 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCDiscreteArithmeticAPEngine<RNG,S>&
+    MakeMCDiscreteArithmeticAPEngine<RNG,S>::withPathwiseGreeks(bool b) {
+        pathwiseGreeks_ = b;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMCDiscreteArithmeticAPEngine<RNG,S>&
+    MakeMCDiscreteArithmeticAPEngine<RNG,S>::withCommonRandomNumbers(bool b) {
+        commonRandomNumbers_ = b;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMCDiscreteArithmeticAPEngine<RNG,S>&
+    MakeMCDiscreteArithmeticAPEngine<RNG,S>::withTimeBudget(Real seconds) {
+        QL_REQUIRE(samples_ == Null<Size>(),
+                   "number of samples already set");
+        timeBudget_ = seconds;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCDiscreteArithmeticAPEngine<RNG,S>::operator boost::shared_ptr<PricingEngine>()
@@ -268,7 +327,10 @@ namespace QuantLib {
                                                 antithetic_, controlVariate_,
                                                 samples_, tolerance_,
                                                 maxSamples_,
-                                                seed_));
+                                                seed_,
+                                                pathwiseGreeks_,
+                                                commonRandomNumbers_,
+                                                timeBudget_));
     }
 
 
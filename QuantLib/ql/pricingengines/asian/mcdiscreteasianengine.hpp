@@ -27,13 +27,24 @@
 #define quantlib_mcdiscreteasian_engine_hpp
 
 #include <ql/pricingengines/mcsimulation.hpp>
+#include <ql/methods/montecarlo/adjointpathpricer.hpp>
 #include <ql/instruments/asianoption.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 
 namespace QuantLib {
 
     //! Pricing engine for discrete average Asians using Monte Carlo simulation
-    /*! \warning control-variate calculation is disabled under VC++6.
+    /*! When common random numbers are enabled, the random sequences
+        drawn in the first calculation are stored and reused by the
+        following ones, so that bumped scenarios are priced on the
+        same draws.
+
+        When a time budget (in seconds of wall-clock time) is given,
+        samples are added until it is used up, or until the required
+        tolerance, if any, is reached.  The number of samples used
+        is returned as the "samples" additional result.
+
+        \warning control-variate calculation is disabled under VC++6.
 
         \ingroup asianengines
     */
@@ -58,11 +69,15 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed);
+             BigNatural seed,
+             bool pathwiseGreeks = false,
+             bool commonRandomNumbers = false,
+             Real timeBudget = Null<Real>());
         void calculate() const {
             McSimulation<SingleVariate,RNG,S>::calculate(requiredTolerance_,
                                                          requiredSamples_,
-                                                         maxSamples_);
+                                                         maxSamples_,
+                                                         timeBudget_);
             results_.value = this->mcModel_->sampleAccumulator().mean();
             
             if (this->controlVariate_) {
@@ -74,6 +89,16 @@ namespace QuantLib {
             if (RNG::allowsErrorEstimate)
             results_.errorEstimate =
                 this->mcModel_->sampleAccumulator().errorEstimate();
+            results_.additionalResults["samples"] =
+                this->mcModel_->sampleAccumulator().samples();
+
+            if (pathwiseGreeks_) {
+                QL_REQUIRE(greeksPricer_,
+                           "engine does not provide pathwise greeks");
+                std::vector<Real> greeks = greeksPricer_->greeks().mean();
+                results_.delta = greeks[0];
+                results_.vega = greeks[1];
+            }
         }
       protected:
         // McSimulation implementation
@@ -83,6 +108,17 @@ namespace QuantLib {
             TimeGrid grid = this->timeGrid();
             typename RNG::rsg_type gen =
                 RNG::make_sequence_generator(grid.size()-1,seed_);
+            if (commonRandomNumbers_) {
+                if (!sequenceCache_ ||
+                    sequenceCache_->dimension() != gen.dimension())
+                    sequenceCache_ = boost::shared_ptr<
+                        SequenceCache<typename RNG::rsg_type> >(
+                            new SequenceCache<typename RNG::rsg_type>(gen));
+                return boost::shared_ptr<path_generator_type>(
+                         new path_generator_type(process_, grid,
+                                                 gen, brownianBridge_,
+                                                 sequenceCache_));
+            }
             return boost::shared_ptr<path_generator_type>(
                          new path_generator_type(process_, grid,
                                                  gen, brownianBridge_));
@@ -91,9 +127,15 @@ namespace QuantLib {
         // data members
         boost::shared_ptr<GeneralizedBlackScholesProcess> process_;
         Size requiredSamples_, maxSamples_;
-        Real requiredTolerance_;
+        Real requiredTolerance_, timeBudget_;
         bool brownianBridge_;
         BigNatural seed_;
+        bool pathwiseGreeks_;
+        mutable boost::shared_ptr<PathwiseGreeksPathPricer<Path> >
+                                                               greeksPricer_;
+        bool commonRandomNumbers_;
+        mutable boost::shared_ptr<SequenceCache<typename RNG::rsg_type> >
+                                                              sequenceCache_;
     };
 
 
@@ -109,11 +151,16 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed)
+             BigNatural seed,
+             bool pathwiseGreeks,
+             bool commonRandomNumbers,
+             Real timeBudget)
     : McSimulation<SingleVariate,RNG,S>(antitheticVariate, controlVariate),
       process_(process), requiredSamples_(requiredSamples),
       maxSamples_(maxSamples), requiredTolerance_(requiredTolerance),
-      brownianBridge_(brownianBridge), seed_(seed) {
+      timeBudget_(timeBudget), brownianBridge_(brownianBridge), seed_(seed),
+      pathwiseGreeks_(pathwiseGreeks),
+      commonRandomNumbers_(commonRandomNumbers) {
         registerWith(process_);
     }
 
@@ -0,0 +1,261 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2015 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file mlmc_discr_arith_av_price.hpp
+    \brief Multi-level Monte Carlo engine for discrete arithmetic
+           average price Asian
+*/
+
+#ifndef quantlib_mlmc_discrete_arithmetic_average_price_asian_engine_hpp
+#define quantlib_mlmc_discrete_arithmetic_average_price_asian_engine_hpp
+
+#include <ql/pricingengines/asian/mc_discr_arith_av_price.hpp>
+#include <ql/pricingengines/mlmcsimulation.hpp>
+
+namespace QuantLib {
+
+    //! Multi-level Monte Carlo engine for discrete arithmetic average price Asian
+    /*! The coarsest level simulates the underlying on the fixing
+        dates; finer levels add intermediate steps between them,
+        which reduces the discretization error when the drift and
+        volatility of the process are not constant.  The paths of
+        each level are restricted to the fixing dates before being
+        passed to an ArithmeticAPOPathPricer.
+
+        \ingroup asianengines
+
+        \test the correctness of the returned value is tested by
+              checking it against a single-level Monte Carlo engine.
+    */
+    template <class RNG = PseudoRandom, class S = Statistics>
+    class MLMCDiscreteArithmeticAPEngine
+        : public DiscreteAveragingAsianOption::engine,
+          public MultiLevelMcSimulation<SingleVariate,RNG,S> {
+      public:
+        typedef typename MultiLevelMcSimulation<SingleVariate,RNG,S>::
+                                      path_generator_type path_generator_type;
+        typedef typename MultiLevelMcSimulation<SingleVariate,RNG,S>::
+                                            path_pricer_type path_pricer_type;
+        typedef typename MultiLevelMcSimulation<SingleVariate,RNG,S>::
+                                                        stats_type stats_type;
+        // constructor
+        MLMCDiscreteArithmeticAPEngine(
+             const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+             Real requiredTolerance,
+             Size refinementFactor,
+             Size minLevels,
+             Size maxLevels,
+             Size initialSamples,
+             BigNatural seed);
+        void calculate() const {
+            MultiLevelMcSimulation<SingleVariate,RNG,S>::calculate(
+                                                          requiredTolerance_);
+            results_.value = this->mlmcModel_->mean();
+            if (RNG::allowsErrorEstimate)
+            results_.errorEstimate = this->mlmcModel_->errorEstimate();
+        }
+      protected:
+        // MultiLevelMcSimulation implementation
+        TimeGrid timeGrid() const;
+        boost::shared_ptr<path_generator_type> pathGenerator(
+                                                const TimeGrid& fineGrid,
+                                                const TimeGrid& coarseGrid,
+                                                Size level) const {
+            typename RNG::rsg_type gen =
+                RNG::make_sequence_generator(fineGrid.size()-1,
+                                             seed_ == 0 ? 0 : seed_+level);
+            return boost::shared_ptr<path_generator_type>(
+                   new path_generator_type(process_, fineGrid, coarseGrid,
+                                           gen));
+        }
+        boost::shared_ptr<path_pricer_type> pathPricer(
+                                                const TimeGrid& grid) const;
+        // data members
+        boost::shared_ptr<GeneralizedBlackScholesProcess> process_;
+        Real requiredTolerance_;
+        BigNatural seed_;
+    };
+
+
+    //! Multi-level Monte Carlo arithmetic Asian engine factory
+    template <class RNG = PseudoRandom, class S = Statistics>
+    class MakeMLMCDiscreteArithmeticAPEngine {
+      public:
+        MakeMLMCDiscreteArithmeticAPEngine(
+            const boost::shared_ptr<GeneralizedBlackScholesProcess>& process);
+        // named parameters
+        MakeMLMCDiscreteArithmeticAPEngine& withAbsoluteTolerance(
+                                                              Real tolerance);
+        MakeMLMCDiscreteArithmeticAPEngine& withRefinementFactor(Size factor);
+        MakeMLMCDiscreteArithmeticAPEngine& withMinLevels(Size levels);
+        MakeMLMCDiscreteArithmeticAPEngine& withMaxLevels(Size levels);
+        MakeMLMCDiscreteArithmeticAPEngine& withInitialSamples(Size samples);
+        MakeMLMCDiscreteArithmeticAPEngine& withSeed(BigNatural seed);
+        // conversion to pricing engine
+        operator boost::shared_ptr<PricingEngine>() const;
+      private:
+        boost::shared_ptr<GeneralizedBlackScholesProcess> process_;
+        Size refinementFactor_, minLevels_, maxLevels_, initialSamples_;
+        Real tolerance_;
+        BigNatural seed_;
+    };
+
+
+    // inline definitions
+
+    template <class RNG, class S>
+    inline
+    MLMCDiscreteArithmeticAPEngine<RNG,S>::MLMCDiscreteArithmeticAPEngine(
+             const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+             Real requiredTolerance,
+             Size refinementFactor,
+             Size minLevels,
+             Size maxLevels,
+             Size initialSamples,
+             BigNatural seed)
+    : MultiLevelMcSimulation<SingleVariate,RNG,S>(refinementFactor,
+                                                  minLevels, maxLevels,
+                                                  initialSamples),
+      process_(process), requiredTolerance_(requiredTolerance), seed_(seed) {
+        registerWith(process_);
+    }
+
+    template <class RNG, class S>
+    inline TimeGrid MLMCDiscreteArithmeticAPEngine<RNG,S>::timeGrid() const {
+
+        Date referenceDate = process_->riskFreeRate()->referenceDate();
+        DayCounter voldc = process_->blackVolatility()->dayCounter();
+        std::vector<Time> fixingTimes;
+        for (Size i=0; i<arguments_.fixingDates.size(); i++) {
+            if (arguments_.fixingDates[i]>=referenceDate) {
+                Time t = voldc.yearFraction(referenceDate,
+                                            arguments_.fixingDates[i]);
+                fixingTimes.push_back(t);
+            }
+        }
+
+        return TimeGrid(fixingTimes.begin(), fixingTimes.end());
+    }
+
+    template <class RNG, class S>
+    inline
+    boost::shared_ptr<
+        typename MLMCDiscreteArithmeticAPEngine<RNG,S>::path_pricer_type>
+    MLMCDiscreteArithmeticAPEngine<RNG,S>::pathPricer(
+                                                 const TimeGrid& grid) const {
+
+        boost::shared_ptr<PlainVanillaPayoff> payoff =
+            boost::dynamic_pointer_cast<PlainVanillaPayoff>(
+                this->arguments_.payoff);
+        QL_REQUIRE(payoff, "non-plain payoff given");
+
+        boost::shared_ptr<EuropeanExercise> exercise =
+            boost::dynamic_pointer_cast<EuropeanExercise>(
+                this->arguments_.exercise);
+        QL_REQUIRE(exercise, "wrong exercise given");
+
+        TimeGrid fixingGrid = this->timeGrid();
+        boost::shared_ptr<path_pricer_type> pricer(
+                new ArithmeticAPOPathPricer(
+                    payoff->optionType(),
+                    payoff->strike(),
+                    process_->riskFreeRate()->discount(fixingGrid.back()),
+                    this->arguments_.runningAccumulator,
+                    this->arguments_.pastFixings));
+
+        return boost::shared_ptr<path_pricer_type>(
+                       new RestrictedPathPricer(pricer, fixingGrid, grid));
+    }
+
+
+    template <class RNG, class S>
+    inline MakeMLMCDiscreteArithmeticAPEngine<RNG,S>::
+    MakeMLMCDiscreteArithmeticAPEngine(
+             const boost::shared_ptr<GeneralizedBlackScholesProcess>& process)
+    : process_(process), refinementFactor_(2), minLevels_(3),
+      maxLevels_(10), initialSamples_(1000),
+      tolerance_(Null<Real>()), seed_(0) {}
+
+    template <class RNG, class S>
+    inline MakeMLMCDiscreteArithmeticAPEngine<RNG,S>&
+    MakeMLMCDiscreteArithmeticAPEngine<RNG,S>::withAbsoluteTolerance(
+                                                             Real tolerance) {
+        QL_REQUIRE(RNG::allowsErrorEstimate,
+                   "chosen random generator policy "
+                   "does not allow an error estimate");
+        tolerance_ = tolerance;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCDiscreteArithmeticAPEngine<RNG,S>&
+    MakeMLMCDiscreteArithmeticAPEngine<RNG,S>::withRefinementFactor(
+                                                                Size factor) {
+        refinementFactor_ = factor;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCDiscreteArithmeticAPEngine<RNG,S>&
+    MakeMLMCDiscreteArithmeticAPEngine<RNG,S>::withMinLevels(Size levels) {
+        minLevels_ = levels;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCDiscreteArithmeticAPEngine<RNG,S>&
+    MakeMLMCDiscreteArithmeticAPEngine<RNG,S>::withMaxLevels(Size levels) {
+        maxLevels_ = levels;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCDiscreteArithmeticAPEngine<RNG,S>&
+    MakeMLMCDiscreteArithmeticAPEngine<RNG,S>::withInitialSamples(
+                                                               Size samples) {
+        initialSamples_ = samples;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCDiscreteArithmeticAPEngine<RNG,S>&
+    MakeMLMCDiscreteArithmeticAPEngine<RNG,S>::withSeed(BigNatural seed) {
+        seed_ = seed;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline
+    MakeMLMCDiscreteArithmeticAPEngine<RNG,S>::
+    operator boost::shared_ptr<PricingEngine>() const {
+        QL_REQUIRE(tolerance_ != Null<Real>(), "tolerance not given");
+        return boost::shared_ptr<PricingEngine>(new
+            MLMCDiscreteArithmeticAPEngine<RNG,S>(process_,
+                                                  tolerance_,
+                                                  refinementFactor_,
+                                                  minLevels_,
+                                                  maxLevels_,
+                                                  initialSamples_,
+                                                  seed_));
+    }
+
+}
+
+
+#endif
@@ -248,4 +248,83 @@ namespace QuantLib {
         }
     }
 
+
+    SmoothedBarrierPathPricer::SmoothedBarrierPathPricer(
+                    Barrier::Type barrierType,
+                    Real barrier,
+                    Real rebate,
+                    Option::Type type,
+                    Real strike,
+                    const std::vector<DiscountFactor>& discounts,
+                    const boost::shared_ptr<StochasticProcess1D>& diffProcess)
+    : barrierType_(barrierType), barrier_(barrier),
+      rebate_(rebate), diffProcess_(diffProcess),
+      payoff_(type, strike), discounts_(discounts) {
+        QL_REQUIRE(strike>=0.0,
+                   "strike less than zero not allowed");
+        QL_REQUIRE(barrier>0.0,
+                   "barrier less/equal zero not allowed");
+    }
+
+
+    Real SmoothedBarrierPathPricer::operator()(const Path& path) const {
+        Size n = path.length();
+        QL_REQUIRE(n>1, "the path cannot be empty");
+
+        bool isUp;
+        switch (barrierType_) {
+          case Barrier::UpIn:
+          case Barrier::UpOut:
+            isUp = true;
+            break;
+          case Barrier::DownIn:
+          case Barrier::DownOut:
+            isUp = false;
+            break;
+          default:
+            QL_FAIL("unknown barrier type");
+        }
+
+        TimeGrid timeGrid = path.timeGrid();
+        // probability that the barrier was not touched up to the
+        // current node, and discounted rebate paid at the nodes
+        // following a crossing
+        Real survival = 1.0, knockedRebate = 0.0;
+        Real asset_price = path.front();
+        for (Size i=0; i<n-1 && survival>0.0; i++) {
+            Real new_asset_price = path[i+1];
+            Real crossing;
+            if (isUp ? (asset_price >= barrier_ ||
+                        new_asset_price >= barrier_)
+                     : (asset_price <= barrier_ ||
+                        new_asset_price <= barrier_)) {
+                crossing = 1.0;
+            } else {
+                // terminal or initial vol?
+                Volatility vol =
+                    diffProcess_->diffusion(timeGrid[i],asset_price);
+                Time dt = timeGrid.dt(i);
+                crossing = std::exp(-2.0*std::log(asset_price/barrier_)
+                                    *std::log(new_asset_price/barrier_)
+                                    /(vol*vol*dt));
+            }
+            knockedRebate += survival*crossing*discounts_[i+1];
+            survival *= 1.0-crossing;
+            asset_price = new_asset_price;
+        }
+
+        Real payoff = payoff_(path.back()) * discounts_.back();
+        switch (barrierType_) {
+          case Barrier::UpIn:
+          case Barrier::DownIn:
+            return payoff*(1.0-survival)
+                + rebate_*discounts_.back()*survival;
+          case Barrier::UpOut:
+          case Barrier::DownOut:
+            return payoff*survival + rebate_*knockedRebate;
+          default:
+            QL_FAIL("unknown barrier type");
+        }
+    }
+
 }
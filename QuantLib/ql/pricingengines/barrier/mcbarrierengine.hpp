@@ -47,6 +47,10 @@ namespace QuantLib {
         Journal of Derivatives; Winter 1998; 6, 2; pg. 65-83
         </i>
 
+        If a time budget (in seconds of wall-clock time) is given,
+        the number of samples used is returned as the "samples"
+        additional result.
+
         \ingroup barrierengines
 
         \test the correctness of the returned value is tested by
@@ -74,18 +78,22 @@ namespace QuantLib {
              Real requiredTolerance,
              Size maxSamples,
              bool isBiased,
-             BigNatural seed);
+             BigNatural seed,
+             Real timeBudget = Null<Real>());
         void calculate() const {
             Real spot = process_->x0();
             QL_REQUIRE(spot >= 0.0, "negative or null underlying given");
             QL_REQUIRE(!triggered(spot), "barrier touched");
             McSimulation<SingleVariate,RNG,S>::calculate(requiredTolerance_,
                                                          requiredSamples_,
-                                                         maxSamples_);
+                                                         maxSamples_,
+                                                         timeBudget_);
             results_.value = this->mcModel_->sampleAccumulator().mean();
             if (RNG::allowsErrorEstimate)
             results_.errorEstimate =
                 this->mcModel_->sampleAccumulator().errorEstimate();
+            results_.additionalResults["samples"] =
+                this->mcModel_->sampleAccumulator().samples();
         }
       protected:
         // McSimulation implementation
@@ -103,7 +111,7 @@ namespace QuantLib {
         boost::shared_ptr<GeneralizedBlackScholesProcess> process_;
         Size timeSteps_, timeStepsPerYear_;
         Size requiredSamples_, maxSamples_;
-        Real requiredTolerance_;
+        Real requiredTolerance_, timeBudget_;
         bool isBiased_;
         bool brownianBridge_;
         BigNatural seed_;
@@ -126,13 +134,14 @@ namespace QuantLib {
         MakeMCBarrierEngine& withMaxSamples(Size samples);
         MakeMCBarrierEngine& withBias(bool b = true);
         MakeMCBarrierEngine& withSeed(BigNatural seed);
+        MakeMCBarrierEngine& withTimeBudget(Real seconds);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
       private:
         boost::shared_ptr<GeneralizedBlackScholesProcess> process_;
         bool brownianBridge_, antithetic_, biased_;
         Size steps_, stepsPerYear_, samples_, maxSamples_;
-        Real tolerance_;
+        Real tolerance_, timeBudget_;
         BigNatural seed_;
     };
 
@@ -178,6 +187,35 @@ namespace QuantLib {
     };
 
 
+    //! Barrier path pricer weighting paths by their survival probability
+    /*! Instead of drawing the crossings between the nodes of the
+        path, the payoff is weighted with the Brownian-bridge
+        probability that the barrier was not crossed.  The result
+        is a smooth function of the path, which keeps the values
+        on a fine and a coarse grid close when the paths are; this
+        is the estimator used by multi-level Monte Carlo.
+    */
+    class SmoothedBarrierPathPricer : public PathPricer<Path> {
+      public:
+        SmoothedBarrierPathPricer(
+                    Barrier::Type barrierType,
+                    Real barrier,
+                    Real rebate,
+                    Option::Type type,
+                    Real strike,
+                    const std::vector<DiscountFactor>& discounts,
+                    const boost::shared_ptr<StochasticProcess1D>& diffProcess);
+        Real operator()(const Path& path) const;
+      private:
+        Barrier::Type barrierType_;
+        Real barrier_;
+        Real rebate_;
+        boost::shared_ptr<StochasticProcess1D> diffProcess_;
+        PlainVanillaPayoff payoff_;
+        std::vector<DiscountFactor> discounts_;
+    };
+
+
 
     // template definitions
 
@@ -192,12 +230,13 @@ namespace QuantLib {
              Real requiredTolerance,
              Size maxSamples,
              bool isBiased,
-             BigNatural seed)
+             BigNatural seed,
+             Real timeBudget)
     : McSimulation<SingleVariate,RNG,S>(antitheticVariate, false),
       process_(process), timeSteps_(timeSteps),
       timeStepsPerYear_(timeStepsPerYear),
       requiredSamples_(requiredSamples), maxSamples_(maxSamples),
-      requiredTolerance_(requiredTolerance),
+      requiredTolerance_(requiredTolerance), timeBudget_(timeBudget),
       isBiased_(isBiased),
       brownianBridge_(brownianBridge), seed_(seed) {
         QL_REQUIRE(timeSteps != Null<Size>() ||
@@ -278,7 +317,7 @@ namespace QuantLib {
     : process_(process), brownianBridge_(false), antithetic_(false),
       biased_(false), steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), seed_(0) {}
+      tolerance_(Null<Real>()), timeBudget_(Null<Real>()), seed_(0) {}
 
     template <class RNG, class S>
     inline MakeMCBarrierEngine<RNG,S>&
@@ -313,6 +352,8 @@ namespace QuantLib {
     MakeMCBarrierEngine<RNG,S>::withSamples(Size samples) {
         QL_REQUIRE(tolerance_ == Null<Real>(),
                    "tolerance already set");
+        QL_REQUIRE(timeBudget_ == Null<Real>(),
+                   "time budget already set");
         samples_ = samples;
         return *this;
     }
@@ -350,6 +391,15 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCBarrierEngine<RNG,S>&
+    MakeMCBarrierEngine<RNG,S>::withTimeBudget(Real seconds) {
+        QL_REQUIRE(samples_ == Null<Size>(),
+                   "number of samples already set");
+        timeBudget_ = seconds;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCBarrierEngine<RNG,S>::operator boost::shared_ptr<PricingEngine>()
@@ -367,7 +417,8 @@ namespace QuantLib {
                                    samples_, tolerance_,
                                    maxSamples_,
                                    biased_,
-                                   seed_));
+                                   seed_,
+                                   timeBudget_));
     }
 
 }
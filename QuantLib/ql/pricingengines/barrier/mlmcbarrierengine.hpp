@@ -0,0 +1,323 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2015 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file mlmcbarrierengine.hpp
+    \brief Multi-level Monte Carlo barrier option engine
+*/
+
+#ifndef quantlib_mlmc_barrier_engine_hpp
+#define quantlib_mlmc_barrier_engine_hpp
+
+#include <ql/pricingengines/barrier/mcbarrierengine.hpp>
+#include <ql/pricingengines/mlmcsimulation.hpp>
+
+namespace QuantLib {
+
+    //! Pricing engine for barrier options using multi-level Monte Carlo
+    /*! The coarsest level monitors the barrier on the given number
+        of time steps; finer levels refine the grid until the
+        estimated bias with respect to continuous monitoring is
+        below the required tolerance.  Unless the biased pricer is
+        requested, the payoff on each level is weighted with the
+        Brownian-bridge probability of not crossing the barrier
+        between nodes (see SmoothedBarrierPathPricer.)  Unlike
+        drawn crossings, this keeps the fine and coarse values of
+        each sample close, so that the variance of the corrections
+        decreases with the level; it also greatly reduces the bias,
+        and therefore the number of levels needed.
+
+        \ingroup barrierengines
+
+        \test
+        - the correctness of the returned value is tested by
+          checking it against analytic results.
+        - the variances of the level corrections are checked to
+          decrease with the level.
+    */
+    template <class RNG = PseudoRandom, class S = Statistics>
+    class MLMCBarrierEngine
+        : public BarrierOption::engine,
+          public MultiLevelMcSimulation<SingleVariate,RNG,S> {
+      public:
+        typedef typename MultiLevelMcSimulation<SingleVariate,RNG,S>::
+                                      path_generator_type path_generator_type;
+        typedef typename MultiLevelMcSimulation<SingleVariate,RNG,S>::
+                                            path_pricer_type path_pricer_type;
+        typedef typename MultiLevelMcSimulation<SingleVariate,RNG,S>::
+                                                        stats_type stats_type;
+        // constructor
+        MLMCBarrierEngine(
+             const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+             Size timeSteps,
+             Size timeStepsPerYear,
+             Real requiredTolerance,
+             Size refinementFactor,
+             Size minLevels,
+             Size maxLevels,
+             Size initialSamples,
+             bool isBiased,
+             BigNatural seed);
+        void calculate() const {
+            Real spot = process_->x0();
+            QL_REQUIRE(spot >= 0.0, "negative or null underlying given");
+            QL_REQUIRE(!triggered(spot), "barrier touched");
+            MultiLevelMcSimulation<SingleVariate,RNG,S>::calculate(
+                                                          requiredTolerance_);
+            results_.value = this->mlmcModel_->mean();
+            if (RNG::allowsErrorEstimate)
+            results_.errorEstimate = this->mlmcModel_->errorEstimate();
+        }
+      protected:
+        // MultiLevelMcSimulation implementation
+        TimeGrid timeGrid() const;
+        boost::shared_ptr<path_generator_type> pathGenerator(
+                                                const TimeGrid& fineGrid,
+                                                const TimeGrid& coarseGrid,
+                                                Size level) const {
+            typename RNG::rsg_type gen =
+                RNG::make_sequence_generator(fineGrid.size()-1,
+                                             seed_ == 0 ? 0 : seed_+level);
+            return boost::shared_ptr<path_generator_type>(
+                   new path_generator_type(process_, fineGrid, coarseGrid,
+                                           gen));
+        }
+        boost::shared_ptr<path_pricer_type> pathPricer(
+                                                const TimeGrid& grid) const;
+        // data members
+        boost::shared_ptr<GeneralizedBlackScholesProcess> process_;
+        Size timeSteps_, timeStepsPerYear_;
+        Real requiredTolerance_;
+        bool isBiased_;
+        BigNatural seed_;
+    };
+
+
+    //! Multi-level Monte Carlo barrier-option engine factory
+    template <class RNG = PseudoRandom, class S = Statistics>
+    class MakeMLMCBarrierEngine {
+      public:
+        MakeMLMCBarrierEngine(
+                    const boost::shared_ptr<GeneralizedBlackScholesProcess>&);
+        // named parameters
+        MakeMLMCBarrierEngine& withSteps(Size steps);
+        MakeMLMCBarrierEngine& withStepsPerYear(Size steps);
+        MakeMLMCBarrierEngine& withAbsoluteTolerance(Real tolerance);
+        MakeMLMCBarrierEngine& withRefinementFactor(Size factor);
+        MakeMLMCBarrierEngine& withMinLevels(Size levels);
+        MakeMLMCBarrierEngine& withMaxLevels(Size levels);
+        MakeMLMCBarrierEngine& withInitialSamples(Size samples);
+        MakeMLMCBarrierEngine& withBias(bool b = true);
+        MakeMLMCBarrierEngine& withSeed(BigNatural seed);
+        // conversion to pricing engine
+        operator boost::shared_ptr<PricingEngine>() const;
+      private:
+        boost::shared_ptr<GeneralizedBlackScholesProcess> process_;
+        bool biased_;
+        Size steps_, stepsPerYear_;
+        Size refinementFactor_, minLevels_, maxLevels_, initialSamples_;
+        Real tolerance_;
+        BigNatural seed_;
+    };
+
+
+    // template definitions
+
+    template <class RNG, class S>
+    inline MLMCBarrierEngine<RNG,S>::MLMCBarrierEngine(
+             const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+             Size timeSteps,
+             Size timeStepsPerYear,
+             Real requiredTolerance,
+             Size refinementFactor,
+             Size minLevels,
+             Size maxLevels,
+             Size initialSamples,
+             bool isBiased,
+             BigNatural seed)
+    : MultiLevelMcSimulation<SingleVariate,RNG,S>(refinementFactor,
+                                                  minLevels, maxLevels,
+                                                  initialSamples),
+      process_(process), timeSteps_(timeSteps),
+      timeStepsPerYear_(timeStepsPerYear),
+      requiredTolerance_(requiredTolerance),
+      isBiased_(isBiased), seed_(seed) {
+        QL_REQUIRE(timeSteps != Null<Size>() ||
+                   timeStepsPerYear != Null<Size>(),
+                   "no time steps provided");
+        QL_REQUIRE(timeSteps == Null<Size>() ||
+                   timeStepsPerYear == Null<Size>(),
+                   "both time steps and time steps per year were provided");
+        QL_REQUIRE(timeSteps != 0,
+                   "timeSteps must be positive, " << timeSteps <<
+                   " not allowed");
+        QL_REQUIRE(timeStepsPerYear != 0,
+                   "timeStepsPerYear must be positive, " << timeStepsPerYear <<
+                   " not allowed");
+        registerWith(process_);
+    }
+
+    template <class RNG, class S>
+    inline TimeGrid MLMCBarrierEngine<RNG,S>::timeGrid() const {
+
+        Time residualTime = process_->time(arguments_.exercise->lastDate());
+        if (timeSteps_ != Null<Size>()) {
+            return TimeGrid(residualTime, timeSteps_);
+        } else if (timeStepsPerYear_ != Null<Size>()) {
+            Size steps = static_cast<Size>(timeStepsPerYear_*residualTime);
+            return TimeGrid(residualTime, std::max<Size>(steps, 1));
+        } else {
+            QL_FAIL("time steps not specified");
+        }
+    }
+
+    template <class RNG, class S>
+    inline
+    boost::shared_ptr<typename MLMCBarrierEngine<RNG,S>::path_pricer_type>
+    MLMCBarrierEngine<RNG,S>::pathPricer(const TimeGrid& grid) const {
+        boost::shared_ptr<PlainVanillaPayoff> payoff =
+            boost::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
+        QL_REQUIRE(payoff, "non-plain payoff given");
+
+        std::vector<DiscountFactor> discounts(grid.size());
+        for (Size i=0; i<grid.size(); i++)
+            discounts[i] = process_->riskFreeRate()->discount(grid[i]);
+
+        if (isBiased_) {
+            return boost::shared_ptr<path_pricer_type>(
+                new BiasedBarrierPathPricer(
+                       arguments_.barrierType,
+                       arguments_.barrier,
+                       arguments_.rebate,
+                       payoff->optionType(),
+                       payoff->strike(),
+                       discounts));
+        } else {
+            return boost::shared_ptr<path_pricer_type>(
+                new SmoothedBarrierPathPricer(
+                    arguments_.barrierType,
+                    arguments_.barrier,
+                    arguments_.rebate,
+                    payoff->optionType(),
+                    payoff->strike(),
+                    discounts,
+                    process_));
+        }
+    }
+
+
+    template <class RNG, class S>
+    inline MakeMLMCBarrierEngine<RNG,S>::MakeMLMCBarrierEngine(
+             const boost::shared_ptr<GeneralizedBlackScholesProcess>& process)
+    : process_(process), biased_(false),
+      steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
+      refinementFactor_(2), minLevels_(3), maxLevels_(10),
+      initialSamples_(1000), tolerance_(Null<Real>()), seed_(0) {}
+
+    template <class RNG, class S>
+    inline MakeMLMCBarrierEngine<RNG,S>&
+    MakeMLMCBarrierEngine<RNG,S>::withSteps(Size steps) {
+        steps_ = steps;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCBarrierEngine<RNG,S>&
+    MakeMLMCBarrierEngine<RNG,S>::withStepsPerYear(Size steps) {
+        stepsPerYear_ = steps;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCBarrierEngine<RNG,S>&
+    MakeMLMCBarrierEngine<RNG,S>::withAbsoluteTolerance(Real tolerance) {
+        QL_REQUIRE(RNG::allowsErrorEstimate,
+                   "chosen random generator policy "
+                   "does not allow an error estimate");
+        tolerance_ = tolerance;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCBarrierEngine<RNG,S>&
+    MakeMLMCBarrierEngine<RNG,S>::withRefinementFactor(Size factor) {
+        refinementFactor_ = factor;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCBarrierEngine<RNG,S>&
+    MakeMLMCBarrierEngine<RNG,S>::withMinLevels(Size levels) {
+        minLevels_ = levels;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCBarrierEngine<RNG,S>&
+    MakeMLMCBarrierEngine<RNG,S>::withMaxLevels(Size levels) {
+        maxLevels_ = levels;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCBarrierEngine<RNG,S>&
+    MakeMLMCBarrierEngine<RNG,S>::withInitialSamples(Size samples) {
+        initialSamples_ = samples;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCBarrierEngine<RNG,S>&
+    MakeMLMCBarrierEngine<RNG,S>::withBias(bool biased) {
+        biased_ = biased;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCBarrierEngine<RNG,S>&
+    MakeMLMCBarrierEngine<RNG,S>::withSeed(BigNatural seed) {
+        seed_ = seed;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline
+    MakeMLMCBarrierEngine<RNG,S>::operator boost::shared_ptr<PricingEngine>()
+                                                                      const {
+        QL_REQUIRE(steps_ != Null<Size>() || stepsPerYear_ != Null<Size>(),
+                   "number of steps not given");
+        QL_REQUIRE(steps_ == Null<Size>() || stepsPerYear_ == Null<Size>(),
+                   "number of steps overspecified");
+        QL_REQUIRE(tolerance_ != Null<Real>(), "tolerance not given");
+        return boost::shared_ptr<PricingEngine>(new
+            MLMCBarrierEngine<RNG,S>(process_,
+                                     steps_,
+                                     stepsPerYear_,
+                                     tolerance_,
+                                     refinementFactor_,
+                                     minLevels_,
+                                     maxLevels_,
+                                     initialSamples_,
+                                     biased_,
+                                     seed_));
+    }
+
+}
+
+
+#endif
@@ -44,5 +44,66 @@ namespace QuantLib {
         return (*payoff_)(finalPrice) * discount_;
     }
 
+    Real EuropeanMultiPathPricer::operator()(const MultiPath& multiPath,
+                                             MultiPath& adjoint) const {
+        Size n = multiPath.pathSize();
+        QL_REQUIRE(n>0, "the path cannot be empty");
+
+        Size numAssets = multiPath.assetNumber();
+        QL_REQUIRE(numAssets>0, "there must be some paths");
+
+        Size i, j;
+        Array finalPrice(numAssets, 0.0);
+        for (j = 0; j < numAssets; j++) {
+            finalPrice[j] = multiPath[j].back();
+            for (i = 0; i < n; i++)
+                adjoint[j][i] = 0.0;
+        }
+
+        boost::shared_ptr<PlainVanillaPayoff> basePayoff =
+            boost::dynamic_pointer_cast<PlainVanillaPayoff>(
+                                                  payoff_->basePayoff());
+        QL_REQUIRE(basePayoff,
+                   "plain-vanilla base payoff required for pathwise greeks");
+
+        Real accumulated = payoff_->accumulate(finalPrice);
+        Real slope;
+        switch (basePayoff->optionType()) {
+          case Option::Call:
+            slope = accumulated > basePayoff->strike() ? 1.0 : 0.0;
+            break;
+          case Option::Put:
+            slope = accumulated < basePayoff->strike() ? -1.0 : 0.0;
+            break;
+          default:
+            QL_FAIL("unknown option type");
+        }
+        slope *= discount_;
+
+        // adjoints of the accumulated value with respect to the
+        // final prices of the assets
+        if (boost::dynamic_pointer_cast<MaxBasketPayoff>(payoff_)) {
+            j = std::max_element(finalPrice.begin(), finalPrice.end())
+                - finalPrice.begin();
+            adjoint[j].back() = slope;
+        } else if (boost::dynamic_pointer_cast<MinBasketPayoff>(payoff_)) {
+            j = std::min_element(finalPrice.begin(), finalPrice.end())
+                - finalPrice.begin();
+            adjoint[j].back() = slope;
+        } else if (boost::shared_ptr<AverageBasketPayoff> average =
+                   boost::dynamic_pointer_cast<AverageBasketPayoff>(payoff_)) {
+            const Array& weights = average->weights();
+            for (j = 0; j < numAssets; j++)
+                adjoint[j].back() = slope*weights[j];
+        } else if (boost::dynamic_pointer_cast<SpreadBasketPayoff>(payoff_)) {
+            adjoint[0].back() = slope;
+            adjoint[1].back() = -slope;
+        } else {
+            QL_FAIL("unsupported basket payoff for pathwise greeks");
+        }
+
+        return (*basePayoff)(accumulated) * discount_;
+    }
+
 }
 
@@ -27,6 +27,7 @@
 
 #include <ql/instruments/basketoption.hpp>
 #include <ql/pricingengines/mcsimulation.hpp>
+#include <ql/methods/montecarlo/adjointpathpricer.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 #include <ql/processes/stochasticprocessarray.hpp>
 #include <ql/exercise.hpp>
@@ -34,10 +35,17 @@
 namespace QuantLib {
 
     //! Pricing engine for European basket options using Monte Carlo simulation
-    /*! \ingroup basketengines
+    /*! When pathwise greeks are enabled, the deltas and vegas of
+        all the underlyings are obtained in the same simulation and
+        returned as the "deltas" and "vegas" additional results.
 
-        \test the correctness of the returned value is tested by
-              reproducing results available in literature.
+        \ingroup basketengines
+
+        \test
+        - the correctness of the returned value is tested by
+          reproducing results available in literature.
+        - the correctness of the returned pathwise greeks is tested
+          by checking them against bump-and-revalue results.
     */
     template <class RNG = PseudoRandom, class S = Statistics>
     class MCEuropeanBasketEngine  : public BasketOption::engine,
@@ -58,7 +66,8 @@ namespace QuantLib {
                                Size requiredSamples,
                                Real requiredTolerance,
                                Size maxSamples,
-                               BigNatural seed);
+                               BigNatural seed,
+                               bool pathwiseGreeks = false);
         void calculate() const {
             McSimulation<MultiVariate,RNG,S>::calculate(requiredTolerance_,
                                                         requiredSamples_,
@@ -67,6 +76,15 @@ namespace QuantLib {
             if (RNG::allowsErrorEstimate)
             results_.errorEstimate =
                 this->mcModel_->sampleAccumulator().errorEstimate();
+
+            if (pathwiseGreeks_) {
+                std::vector<Real> greeks = greeksPricer_->greeks().mean();
+                Size n = processes_->size();
+                results_.additionalResults["deltas"] =
+                    std::vector<Real>(greeks.begin(), greeks.begin()+n);
+                results_.additionalResults["vegas"] =
+                    std::vector<Real>(greeks.begin()+n, greeks.end());
+            }
         }
       protected:
         // McSimulation implementation
@@ -97,6 +115,9 @@ namespace QuantLib {
         Real requiredTolerance_;
         bool brownianBridge_;
         BigNatural seed_;
+        bool pathwiseGreeks_;
+        mutable boost::shared_ptr<PathwiseGreeksPathPricer<MultiPath> >
+                                                               greeksPricer_;
     };
 
 
@@ -115,22 +136,29 @@ namespace QuantLib {
         MakeMCEuropeanBasketEngine& withAbsoluteTolerance(Real tolerance);
         MakeMCEuropeanBasketEngine& withMaxSamples(Size samples);
         MakeMCEuropeanBasketEngine& withSeed(BigNatural seed);
+        MakeMCEuropeanBasketEngine& withPathwiseGreeks(bool b = true);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
       private:
         boost::shared_ptr<StochasticProcessArray> process_;
-        bool brownianBridge_, antithetic_;
+        bool brownianBridge_, antithetic_, pathwiseGreeks_;
         Size steps_, stepsPerYear_, samples_, maxSamples_;
         Real tolerance_;
         BigNatural seed_;
     };
 
 
-    class EuropeanMultiPathPricer : public PathPricer<MultiPath> {
+    class EuropeanMultiPathPricer : public AdjointPathPricer<MultiPath> {
       public:
         EuropeanMultiPathPricer(const boost::shared_ptr<BasketPayoff>& payoff,
                                 DiscountFactor discount);
         Real operator()(const MultiPath& multiPath) const;
+        /*! \warning only plain-vanilla payoffs on the minimum,
+                     maximum, average or spread of the underlyings
+                     are supported.
+        */
+        Real operator()(const MultiPath& multiPath,
+                        MultiPath& adjoint) const;
       private:
         boost::shared_ptr<BasketPayoff> payoff_;
         DiscountFactor discount_;
@@ -149,13 +177,15 @@ namespace QuantLib {
                    Size requiredSamples,
                    Real requiredTolerance,
                    Size maxSamples,
-                   BigNatural seed)
+                   BigNatural seed,
+                   bool pathwiseGreeks)
     : McSimulation<MultiVariate,RNG,S>(antitheticVariate, false),
       processes_(processes), timeSteps_(timeSteps),
       timeStepsPerYear_(timeStepsPerYear),
       requiredSamples_(requiredSamples), maxSamples_(maxSamples),
       requiredTolerance_(requiredTolerance),
-      brownianBridge_(brownianBridge), seed_(seed) {
+      brownianBridge_(brownianBridge), seed_(seed),
+      pathwiseGreeks_(pathwiseGreeks) {
         QL_REQUIRE(timeSteps != Null<Size>() ||
                    timeStepsPerYear != Null<Size>(),
                    "no time steps provided");
@@ -200,11 +230,28 @@ namespace QuantLib {
                                                       processes_->process(0));
         QL_REQUIRE(process, "Black-Scholes process required");
 
-        return boost::shared_ptr<
-                    typename MCEuropeanBasketEngine<RNG,S>::path_pricer_type>(
+        boost::shared_ptr<EuropeanMultiPathPricer> pricer(
             new EuropeanMultiPathPricer(payoff,
                                         process->riskFreeRate()->discount(
                                            arguments_.exercise->lastDate())));
+
+        if (!pathwiseGreeks_)
+            return pricer;
+
+        TimeGrid grid = timeGrid();
+        std::vector<BlackScholesPathAdjoint> adjoints;
+        for (Size j=0; j<processes_->size(); ++j) {
+            boost::shared_ptr<GeneralizedBlackScholesProcess> p =
+                boost::dynamic_pointer_cast<GeneralizedBlackScholesProcess>(
+                                                      processes_->process(j));
+            QL_REQUIRE(p, "Black-Scholes processes required "
+                          "for pathwise greeks");
+            adjoints.push_back(BlackScholesPathAdjoint(p, grid));
+        }
+        greeksPricer_ =
+            boost::shared_ptr<PathwiseGreeksPathPricer<MultiPath> >(
+                new PathwiseGreeksPathPricer<MultiPath>(pricer, adjoints));
+        return greeksPricer_;
     }
 
 
@@ -212,7 +259,7 @@ namespace QuantLib {
     inline MakeMCEuropeanBasketEngine<RNG,S>::MakeMCEuropeanBasketEngine(
                      const boost::shared_ptr<StochasticProcessArray>& process)
     : process_(process), brownianBridge_(false), antithetic_(false),
-      steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
+      pathwiseGreeks_(false), steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
       tolerance_(Null<Real>()), seed_(0) {}
 
@@ -279,6 +326,13 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCEuropeanBasketEngine<RNG,S>&
+    MakeMCEuropeanBasketEngine<RNG,S>::withPathwiseGreeks(bool b) {
+        pathwiseGreeks_ = b;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCEuropeanBasketEngine<RNG,S>::operator
@@ -295,7 +349,8 @@ namespace QuantLib {
                                           antithetic_,
                                           samples_, tolerance_,
                                           maxSamples_,
-                                          seed_));
+                                          seed_,
+                                          pathwiseGreeks_));
     }
 
 }
@@ -68,7 +68,7 @@ namespace QuantLib {
         } else {
             std::vector<Time> times = capfloor.mandatoryTimes();
             TimeGrid timeGrid(times.begin(), times.end(), timeSteps_);
-            lattice = model_->tree(timeGrid);
+            lattice = tree(timeGrid);
         }
 
         Time firstTime = dayCounter.yearFraction(referenceDate,
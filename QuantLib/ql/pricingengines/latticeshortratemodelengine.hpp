@@ -26,13 +26,16 @@
 #define quantlib_short_rate_model_engine_hpp
 
 #include <ql/models/model.hpp>
+#include <ql/models/shortrate/shortratetreecache.hpp>
 #include <ql/pricingengines/genericmodelengine.hpp>
 
 namespace QuantLib {
 
     //! Engine for a short-rate model specialized on a lattice
     /*! Derived engines only need to implement the <tt>calculate()</tt>
-        method
+        method; they should obtain the trees for the time grids of the
+        priced instruments through the tree() method, which uses the
+        cache set by setTreeCache() if any.
     */
     template <class Arguments, class Results>
     class LatticeShortRateModelEngine
@@ -48,10 +51,20 @@ namespace QuantLib {
                                const boost::shared_ptr<ShortRateModel>& model,
                                const TimeGrid& timeGrid);
         void update();
+        /*! trees for the time grids of the priced instruments are
+            taken from the given cache, so that they can be shared
+            with other engines pricing instruments with the same
+            times.  Engines built on a fixed time grid are not
+            affected.
+        */
+        void setTreeCache(const boost::shared_ptr<ShortRateTreeCache>&);
       protected:
+        boost::shared_ptr<Lattice> tree(const TimeGrid& grid) const;
+
         TimeGrid timeGrid_;
         Size timeSteps_;
         boost::shared_ptr<Lattice> lattice_;
+        boost::shared_ptr<ShortRateTreeCache> treeCache_;
     };
 
     template <class Arguments, class Results>
@@ -93,6 +106,22 @@ namespace QuantLib {
         GenericModelEngine<ShortRateModel, Arguments, Results>::update();
     }
 
+    template <class Arguments, class Results>
+    void LatticeShortRateModelEngine<Arguments, Results>::setTreeCache(
+                        const boost::shared_ptr<ShortRateTreeCache>& cache) {
+        treeCache_ = cache;
+    }
+
+    template <class Arguments, class Results>
+    boost::shared_ptr<Lattice>
+    LatticeShortRateModelEngine<Arguments, Results>::tree(
+                                               const TimeGrid& grid) const {
+        if (treeCache_)
+            return treeCache_->tree(this->model_.currentLink(), grid);
+        else
+            return this->model_->tree(grid);
+    }
+
 }
 
 
@@ -28,6 +28,7 @@
 
 #include <ql/grid.hpp>
 #include <ql/methods/montecarlo/montecarlomodel.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
 
 namespace QuantLib {
 
@@ -57,6 +58,16 @@ namespace QuantLib {
                           Size minSamples = 1023) const;
         //! simulate a fixed number of samples
         result_type valueWithSamples(Size samples) const;
+        //! add samples until the given wall-clock time (in seconds) is used
+        /*! Samples are added in batches whose size is estimated
+            from the time taken by the previous ones.  If a
+            tolerance is given, the simulation stops as soon as the
+            error estimate falls below it.
+        */
+        result_type valueWithTimeBudget(Real seconds,
+                                        Real tolerance = Null<Real>(),
+                                        Size maxSamples = QL_MAX_INTEGER,
+                                        Size minSamples = 127) const;
         //! error estimated using the samples simulated so far
         result_type errorEstimate() const;
         //! access to the sample accumulator for richer statistics
@@ -64,7 +75,8 @@ namespace QuantLib {
         //! basic calculate method provided to inherited pricing engines
         void calculate(Real requiredTolerance,
                        Size requiredSamples,
-                       Size maxSamples) const;
+                       Size maxSamples,
+                       Real timeBudget = Null<Real>()) const;
       protected:
         McSimulation(bool antitheticVariate,
                      bool controlVariate)
@@ -155,14 +167,64 @@ namespace QuantLib {
     }
 
 
+    template <template <class> class MC, class RNG, class S>
+    inline typename McSimulation<MC,RNG,S>::result_type
+        McSimulation<MC,RNG,S>::valueWithTimeBudget(Real seconds,
+                                                    Real tolerance,
+                                                    Size maxSamples,
+                                                    Size minSamples) const {
+        QL_REQUIRE(seconds > 0.0,
+                   "time budget must be positive, "
+                   << seconds << " not allowed");
+
+        using namespace boost::posix_time;
+        ptime start = microsec_clock::universal_time();
+
+        Size sampleNumber = mcModel_->sampleAccumulator().samples();
+        Size nextBatch = std::max<Size>(minSamples, 1);
+        for (;;) {
+            nextBatch = std::min(nextBatch, maxSamples-sampleNumber);
+            if (nextBatch == 0)
+                break;
+            mcModel_->addSamples(nextBatch);
+            sampleNumber += nextBatch;
+
+            if (tolerance != Null<Real>() &&
+                maxError(mcModel_->sampleAccumulator().errorEstimate())
+                                                               <= tolerance)
+                break;
+
+            Real elapsed =
+                (microsec_clock::universal_time() - start)
+                .total_microseconds() * 1.0e-6;
+            if (elapsed >= seconds)
+                break;
+
+            // fill most of the remaining time, but don't grow the
+            // batch too fast as the first timings might be inaccurate
+            Real rate = elapsed > 0.0 ?
+                static_cast<Real>(nextBatch)/elapsed : QL_MAX_REAL;
+            Real affordable = 0.9*rate*(seconds-elapsed);
+            nextBatch = static_cast<Size>(
+                std::max<Real>(std::min<Real>(affordable,
+                                              2.0*sampleNumber), 1.0));
+        }
+
+        return result_type(mcModel_->sampleAccumulator().mean());
+    }
+
+
     template <template <class> class MC, class RNG, class S>
     inline void McSimulation<MC,RNG,S>::calculate(Real requiredTolerance,
                                                   Size requiredSamples,
-                                                  Size maxSamples) const {
+                                                  Size maxSamples,
+                                                  Real timeBudget) const {
 
         QL_REQUIRE(requiredTolerance != Null<Real>() ||
-                   requiredSamples != Null<Size>(),
-                   "neither tolerance nor number of samples set");
+                   requiredSamples != Null<Size>() ||
+                   timeBudget != Null<Real>(),
+                   "neither tolerance, number of samples "
+                   "nor time budget set");
 
         //! Initialize the one-factor Monte Carlo
         if (this->controlVariate_) {
@@ -195,7 +257,13 @@ namespace QuantLib {
                            this->antitheticVariate_));
         }
 
-        if (requiredTolerance != Null<Real>()) {
+        if (timeBudget != Null<Real>()) {
+            if (maxSamples != Null<Size>())
+                this->valueWithTimeBudget(timeBudget, requiredTolerance,
+                                          maxSamples);
+            else
+                this->valueWithTimeBudget(timeBudget, requiredTolerance);
+        } else if (requiredTolerance != Null<Real>()) {
             if (maxSamples != Null<Size>())
                 this->value(requiredTolerance, maxSamples);
             else
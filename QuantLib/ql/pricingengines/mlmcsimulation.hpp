@@ -0,0 +1,234 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2015 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file mlmcsimulation.hpp
+    \brief framework for multi-level Monte Carlo engines
+*/
+
+#ifndef quantlib_multilevel_montecarlo_engine_hpp
+#define quantlib_multilevel_montecarlo_engine_hpp
+
+#include <ql/methods/montecarlo/multilevelmontecarlomodel.hpp>
+#include <ql/methods/montecarlo/coupledpathgenerator.hpp>
+#include <cmath>
+
+namespace QuantLib {
+
+    //! base class for multi-level Monte Carlo engines
+    /*! Level \f$ l \f$ simulates paths on the coarsest time grid
+        refined by a factor \f$ M^l \f$.  Given a target
+        root-mean-square error \f$ \epsilon \f$, the number of
+        samples at each level is chosen as
+        \f[
+            N_l = \left\lceil \frac{2}{\epsilon^2}
+                  \sqrt{\frac{V_l}{C_l}}
+                  \sum_k \sqrt{V_k C_k} \right\rceil
+        \f]
+        where \f$ V_l \f$ and \f$ C_l \f$ are the variance and the
+        cost of a sample at level \f$ l \f$, so that the statistical
+        error is at most \f$ \epsilon/\sqrt{2} \f$; levels are added
+        until the estimated discretization bias also falls below
+        \f$ \epsilon/\sqrt{2} \f$, assuming first-order weak
+        convergence of the scheme.
+
+        Derived engines must provide the coarsest time grid and
+        build path pricers and coupled path generators for a given
+        level.
+
+        See M.B. Giles, <i>Multilevel Monte Carlo path
+        simulation</i>, Operations Research 56(3), 2008.
+    */
+    template <template <class> class MC, class RNG, class S = Statistics>
+    class MultiLevelMcSimulation {
+      public:
+        typedef MultiLevelMonteCarloModel<MC,RNG,S> model_type;
+        typedef typename model_type::path_generator_type path_generator_type;
+        typedef typename model_type::path_pricer_type path_pricer_type;
+        typedef typename model_type::stats_type stats_type;
+        typedef typename model_type::result_type result_type;
+
+        virtual ~MultiLevelMcSimulation() {}
+        //! add levels and samples until the required RMSE is reached
+        result_type value(Real tolerance) const;
+        //! statistical error estimated on the samples simulated so far
+        result_type errorEstimate() const;
+        //! access to the underlying model for per-level statistics
+        const model_type& model() const;
+        //! basic calculate method provided to inherited pricing engines
+        void calculate(Real requiredTolerance) const;
+      protected:
+        MultiLevelMcSimulation(Size refinementFactor,
+                               Size minLevels,
+                               Size maxLevels,
+                               Size initialSamples);
+        //! path pricer for paths on the given grid
+        virtual boost::shared_ptr<path_pricer_type> pathPricer(
+                                               const TimeGrid& grid) const = 0;
+        /*! the coarse grid is empty for the first level; the level
+            number can be used to choose a different seed for each
+            level.
+        */
+        virtual boost::shared_ptr<path_generator_type> pathGenerator(
+                                               const TimeGrid& fineGrid,
+                                               const TimeGrid& coarseGrid,
+                                               Size level) const = 0;
+        //! time grid of the coarsest level
+        virtual TimeGrid timeGrid() const = 0;
+        //! time grid of the given level
+        TimeGrid levelGrid(Size level) const;
+
+        mutable boost::shared_ptr<model_type> mlmcModel_;
+        Size refinementFactor_, minLevels_, maxLevels_, initialSamples_;
+      private:
+        void addLevel() const;
+    };
+
+
+    // inline definitions
+
+    template <template <class> class MC, class RNG, class S>
+    inline MultiLevelMcSimulation<MC,RNG,S>::MultiLevelMcSimulation(
+                                                        Size refinementFactor,
+                                                        Size minLevels,
+                                                        Size maxLevels,
+                                                        Size initialSamples)
+    : refinementFactor_(refinementFactor), minLevels_(minLevels),
+      maxLevels_(maxLevels), initialSamples_(initialSamples) {
+        QL_REQUIRE(refinementFactor_ >= 2,
+                   "refinement factor must be at least 2, "
+                   << refinementFactor_ << " not allowed");
+        QL_REQUIRE(minLevels_ >= 2,
+                   "at least 2 levels are needed to estimate the bias, "
+                   << minLevels_ << " not allowed");
+        QL_REQUIRE(maxLevels_ >= minLevels_,
+                   "max levels (" << maxLevels_
+                   << ") less than min levels (" << minLevels_ << ")");
+        QL_REQUIRE(initialSamples_ >= 2,
+                   "at least 2 initial samples per level are needed, "
+                   << initialSamples_ << " not allowed");
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline TimeGrid
+    MultiLevelMcSimulation<MC,RNG,S>::levelGrid(Size level) const {
+        Size factor = 1;
+        for (Size l=0; l<level; l++)
+            factor *= refinementFactor_;
+        return refinedTimeGrid(timeGrid(), factor);
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MultiLevelMcSimulation<MC,RNG,S>::addLevel() const {
+        Size level = mlmcModel_->levels();
+        TimeGrid fine = levelGrid(level);
+        TimeGrid coarse =
+            level == 0 ? TimeGrid() : levelGrid(level-1);
+        Real cost = static_cast<Real>(fine.size()-1);
+        boost::shared_ptr<path_pricer_type> coarsePricer;
+        if (level > 0) {
+            cost += static_cast<Real>(coarse.size()-1);
+            coarsePricer = pathPricer(coarse);
+        }
+        mlmcModel_->addLevel(pathGenerator(fine, coarse, level),
+                             pathPricer(fine), coarsePricer, cost);
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline typename MultiLevelMcSimulation<MC,RNG,S>::result_type
+    MultiLevelMcSimulation<MC,RNG,S>::value(Real tolerance) const {
+
+        QL_REQUIRE(tolerance > 0.0,
+                   "tolerance must be positive, "
+                   << tolerance << " not allowed");
+
+        while (mlmcModel_->levels() < minLevels_)
+            addLevel();
+
+        const Real M = static_cast<Real>(refinementFactor_);
+        const Real eps2 = tolerance*tolerance;
+
+        for (;;) {
+            Size L = mlmcModel_->levels();
+
+            // pilot run on the levels added since the last iteration
+            for (Size l=0; l<L; l++) {
+                Size n = mlmcModel_->levelAccumulator(l).samples();
+                if (n < initialSamples_)
+                    mlmcModel_->addSamples(l, initialSamples_-n);
+            }
+
+            // optimal allocation of the samples across levels
+            Real sum = 0.0;
+            for (Size l=0; l<L; l++)
+                sum += std::sqrt(mlmcModel_->levelAccumulator(l).variance()
+                                 * mlmcModel_->cost(l));
+            for (Size l=0; l<L; l++) {
+                Real v = mlmcModel_->levelAccumulator(l).variance();
+                Size n = static_cast<Size>(
+                    std::ceil(2.0/eps2*std::sqrt(v/mlmcModel_->cost(l))*sum));
+                Size samples = mlmcModel_->levelAccumulator(l).samples();
+                if (n > samples)
+                    mlmcModel_->addSamples(l, n-samples);
+            }
+
+            // bias estimated from the corrections on the finest levels
+            Real finest =
+                std::fabs(mlmcModel_->levelAccumulator(L-1).mean());
+            Real previous =
+                std::fabs(mlmcModel_->levelAccumulator(L-2).mean());
+            Real bias = std::max(finest, previous/M)/(M-1.0);
+            if (bias*bias <= 0.5*eps2)
+                break;
+
+            QL_REQUIRE(L < maxLevels_,
+                       "max number of levels (" << maxLevels_
+                       << ") reached, while estimated bias (" << bias
+                       << ") is still above tolerance ("
+                       << tolerance/std::sqrt(2.0) << ")");
+            addLevel();
+        }
+
+        return mlmcModel_->mean();
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline void MultiLevelMcSimulation<MC,RNG,S>::calculate(
+                                              Real requiredTolerance) const {
+        QL_REQUIRE(requiredTolerance != Null<Real>(),
+                   "tolerance not set");
+        mlmcModel_ = boost::shared_ptr<model_type>(new model_type);
+        value(requiredTolerance);
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline typename MultiLevelMcSimulation<MC,RNG,S>::result_type
+    MultiLevelMcSimulation<MC,RNG,S>::errorEstimate() const {
+        return mlmcModel_->errorEstimate();
+    }
+
+    template <template <class> class MC, class RNG, class S>
+    inline const typename MultiLevelMcSimulation<MC,RNG,S>::model_type&
+    MultiLevelMcSimulation<MC,RNG,S>::model() const {
+        return *mlmcModel_;
+    }
+
+}
+
+
+#endif
@@ -68,7 +68,7 @@ namespace QuantLib {
             lattice = lattice_;
         } else {
             TimeGrid timeGrid(times.begin(), times.end(), timeSteps_);
-            lattice = model_->tree(timeGrid);
+            lattice = tree(timeGrid);
         }
 
         swap.initialize(lattice, times.back());
@@ -0,0 +1,435 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2015 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/pricingengines/vanilla/andersenlakeengine.hpp>
+#include <ql/pricingengines/vanilla/baroneadesiwhaleyengine.hpp>
+#include <ql/pricingengines/blackformula.hpp>
+#include <ql/math/distributions/normaldistribution.hpp>
+#include <ql/math/matrix.hpp>
+#include <ql/exercise.hpp>
+#include <numeric>
+
+namespace QuantLib {
+
+    namespace {
+
+        /* Gauss-Legendre nodes and weights on [-1,1] by Newton
+           iteration on the Legendre polynomials; for the number of
+           points used here, this is much faster than the eigenvalue
+           decomposition in GaussLegendreIntegration. */
+        void gaussLegendre(Size n, std::vector<Real>& x,
+                           std::vector<Real>& w) {
+            x.resize(n);
+            w.resize(n);
+            for (Size i=0; i<(n+1)/2; ++i) {
+                Real z = std::cos(M_PI*(i+0.75)/(n+0.5)), dp = 0.0;
+                for (Size iter=0; iter<100; ++iter) {
+                    Real p0 = 1.0, p1 = 0.0;
+                    for (Size j=1; j<=n; ++j) {
+                        const Real p2 = p1;
+                        p1 = p0;
+                        p0 = ((2.0*j-1.0)*z*p1 - (j-1.0)*p2)/j;
+                    }
+                    dp = n*(z*p0 - p1)/(z*z - 1.0);
+                    const Real z1 = z;
+                    z = z1 - p0/dp;
+                    if (std::fabs(z-z1) <= 1.0e-15)
+                        break;
+                }
+                x[i] = -z;
+                x[n-1-i] = z;
+                w[i] = w[n-1-i] = 2.0/((1.0-z*z)*dp*dp);
+            }
+        }
+
+    }
+
+    AndersenLakeCalculator::AndersenLakeCalculator(
+                                            Option::Type type,
+                                            Rate riskFreeRate,
+                                            Rate dividendYield,
+                                            Volatility volatility,
+                                            Time maturity,
+                                            Size collocationPoints,
+                                            Size integrationPoints,
+                                            Size fixedPointIterations)
+    : type_(type), riskFreeRate_(riskFreeRate), dividendYield_(dividendYield),
+      sigma_(volatility), maturity_(maturity) {
+
+        QL_REQUIRE(volatility > 0.0,
+                   "positive volatility required, "
+                   << volatility << " given");
+        QL_REQUIRE(maturity > 0.0,
+                   "positive maturity required, " << maturity << " given");
+        QL_REQUIRE(collocationPoints > 1,
+                   "at least two collocation points required");
+        QL_REQUIRE(integrationPoints > 0,
+                   "at least one integration point required");
+
+        // calls are priced as puts by means of put-call symmetry,
+        // i.e., C(S,K,r,q) = P(K,S,q,r)
+        if (type == Option::Call) {
+            r_ = dividendYield;
+            q_ = riskFreeRate;
+        } else {
+            r_ = riskFreeRate;
+            q_ = dividendYield;
+        }
+
+        // early exercise is never optimal for puts when r <= 0,
+        // unless q < r which gives a double boundary
+        european_ = (r_ <= 0.0);
+        QL_REQUIRE(!european_ || q_ >= r_,
+                   "double exercise boundary not handled");
+        if (european_)
+            return;
+
+        xMax_ = (q_ > 0.0) ? std::min(1.0, r_/q_) : 1.0;
+        // when the boundary starts below the strike, it behaves as
+        // xMax (1 - c sqrt(tau)) close to maturity and ln(B/xMax) is
+        // interpolated directly; otherwise, it behaves as
+        // sqrt(tau ln tau) and its square is interpolated instead.
+        squared_ = (q_ <= r_);
+
+        // Chebyshev-Lobatto nodes in z = 2*sqrt(tau/T) - 1 and the
+        // corresponding barycentric weights
+        const Size n = collocationPoints;
+        z_.resize(n+1);
+        w_.resize(n+1);
+        h_.resize(n+1);
+        for (Size i=0; i<=n; ++i) {
+            z_[i] = -std::cos(i*M_PI/n);
+            w_[i] = (i % 2 == 0) ? 1.0 : -1.0;
+        }
+        w_.front() *= 0.5;
+        w_.back() *= 0.5;
+
+        // Gauss-Legendre nodes mapped on theta in [0, pi/2]; the
+        // integrals over u in [0,tau] are taken with u = tau sin^2(theta),
+        // which removes the singularities at both ends.
+        const Size l = integrationPoints;
+        std::vector<Real> x;
+        gaussLegendre(l, x, weights_);
+        sin_.resize(l);
+        cos_.resize(l);
+        for (Size k=0; k<l; ++k) {
+            const Real theta = M_PI_4*(1.0 + x[k]);
+            sin_[k] = std::sin(theta);
+            cos_[k] = std::cos(theta);
+            weights_[k] *= M_PI_4;
+        }
+
+        // initial guess from the Barone-Adesi and Whaley approximation
+        const boost::shared_ptr<StrikedTypePayoff> payoff(
+                                    new PlainVanillaPayoff(Option::Put, 1.0));
+        h_[0] = 0.0;
+        for (Size i=1; i<=n; ++i) {
+            Time tau = 0.25*maturity_*(1.0+z_[i])*(1.0+z_[i]);
+            Real b = BaroneAdesiWhaleyApproximationEngine::criticalPrice(
+                                 payoff, std::exp(-r_*tau), std::exp(-q_*tau),
+                                 sigma_*sigma_*tau);
+            h_[i] = transform(std::min(b, xMax_));
+        }
+
+        solveBoundary(fixedPointIterations);
+
+        // terms of the early-exercise premium not depending on the spot
+        const Real mu = r_ - q_ + 0.5*sigma_*sigma_;
+        lnBoundary_.resize(l);
+        stdDev_.resize(l);
+        drift_.resize(l);
+        rTerm_.resize(l);
+        qTerm_.resize(l);
+        for (Size k=0; k<l; ++k) {
+            // u = T sin^2(theta), T-u = T cos^2(theta)
+            const Time u = maturity_*sin_[k]*sin_[k];
+            const Time dt = maturity_*cos_[k]*cos_[k];
+            const Real du = 2.0*maturity_*sin_[k]*cos_[k]*weights_[k];
+            lnBoundary_[k] = std::log(putBoundary(u));
+            stdDev_[k] = sigma_*std::sqrt(dt);
+            drift_[k] = mu*dt;
+            rTerm_[k] = r_*std::exp(-r_*dt)*du;
+            qTerm_[k] = q_*std::exp(-q_*dt)*du;
+        }
+    }
+
+    void AndersenLakeCalculator::solveBoundary(Size fixedPointIterations) {
+        const CumulativeNormalDistribution Phi;
+        const NormalDistribution phi;
+
+        const Size n = z_.size()-1, l = sin_.size();
+        const Real mu = r_ - q_ + 0.5*sigma_*sigma_;
+
+        // quantities depending only on the nodes; in particular, the
+        // boundary at the integration points is a linear combination
+        // of its values at the collocation nodes.
+        std::vector<Real> tau(n+1), rTerm(n*l), qTerm(n*l);
+        Matrix interpolation(n*l, n+1, 0.0);
+        for (Size i=1; i<=n; ++i) {
+            tau[i] = 0.25*maturity_*(1.0+z_[i])*(1.0+z_[i]);
+            for (Size k=0; k<l; ++k) {
+                const Size row = (i-1)*l+k;
+                const Time u = tau[i]*sin_[k]*sin_[k];
+                // du/sqrt(tau-u)
+                const Real dv = 2.0*std::sqrt(tau[i])*sin_[k]*weights_[k];
+                rTerm[row] = r_*std::exp(r_*u)*dv/sigma_;
+                qTerm[row] = q_*std::exp(q_*u)*dv;
+
+                const Real zu = (1.0+z_[i])*sin_[k] - 1.0;
+                Real sum = 0.0;
+                for (Size j=0; j<=n; ++j) {
+                    const Real dz = zu - z_[j];
+                    if (dz == 0.0) {
+                        std::fill(interpolation.row_begin(row),
+                                  interpolation.row_end(row), 0.0);
+                        interpolation[row][j] = sum = 1.0;
+                        break;
+                    }
+                    interpolation[row][j] = w_[j]/dz;
+                    sum += w_[j]/dz;
+                }
+                for (Size j=0; j<=n; ++j)
+                    interpolation[row][j] /= sum;
+            }
+        }
+
+        std::vector<Real> g(n+1), gu(l), h(n+1);
+        for (Size iter=0; iter<fixedPointIterations; ++iter) {
+            for (Size i=0; i<=n; ++i)
+                g[i] = squared_ ? std::sqrt(h_[i]) : h_[i];
+
+            // Jacobi iteration on the FP-B system:
+            // B = exp(-(r-q)tau) N(tau,B) / D(tau,B)
+            Real change = 0.0;
+            for (Size i=1; i<=n; ++i) {
+                const Real sqrtTau = std::sqrt(tau[i]);
+                const Real stdDev = sigma_*sqrtTau;
+
+                // ln(B/K), with B = xMax exp(-g)
+                const Real dp =
+                    (std::log(xMax_) - g[i] + mu*tau[i])/stdDev;
+                const Real dm = dp - stdDev;
+                Real N = phi(dm)/stdDev;
+                Real D = phi(dp)/stdDev + Phi(dp);
+
+                for (Size k=0; k<l; ++k) {
+                    const Real hu = std::max(
+                        std::inner_product(h_.begin(), h_.end(),
+                                           interpolation.row_begin((i-1)*l+k),
+                                           0.0),
+                        0.0);
+                    gu[k] = squared_ ? std::sqrt(hu) : hu;
+                }
+
+                for (Size k=0; k<l; ++k) {
+                    const Real sd = stdDev*cos_[k];
+                    // ln(B(tau)/B(u))
+                    const Real dpu =
+                        (gu[k] - g[i] + mu*tau[i]*cos_[k]*cos_[k])/sd;
+                    const Real dmu = dpu - sd;
+
+                    N += rTerm[(i-1)*l+k]*phi(dmu);
+                    D += qTerm[(i-1)*l+k]
+                        *(phi(dpu)/sigma_ + Phi(dpu)*sqrtTau*cos_[k]);
+                }
+
+                const Real b =
+                    std::min(std::exp(-(r_-q_)*tau[i])*N/D, xMax_);
+                h[i] = transform(b);
+                change = std::max(change, std::fabs(h[i]-h_[i]));
+            }
+
+            std::copy(h.begin()+1, h.end(), h_.begin()+1);
+            if (change < 1.0e-14)
+                break;
+        }
+    }
+
+    Real AndersenLakeCalculator::interpolate(Real z) const {
+        // barycentric interpolation on the Chebyshev nodes
+        Real num = 0.0, den = 0.0;
+        for (Size i=0; i<z_.size(); ++i) {
+            const Real dz = z - z_[i];
+            if (dz == 0.0)
+                return h_[i];
+            const Real c = w_[i]/dz;
+            num += c*h_[i];
+            den += c;
+        }
+        return num/den;
+    }
+
+    Real AndersenLakeCalculator::transform(Real b) const {
+        const Real g = -std::log(b/xMax_);
+        return squared_ ? g*g : g;
+    }
+
+    Real AndersenLakeCalculator::putBoundary(Time tau) const {
+        if (tau <= 0.0)
+            return xMax_;
+        const Real z = 2.0*std::sqrt(tau/maturity_) - 1.0;
+        const Real h = std::max(interpolate(z), 0.0);
+        return xMax_*std::exp(squared_ ? -std::sqrt(h) : -h);
+    }
+
+    Real AndersenLakeCalculator::putValue(Real spot) const {
+        if (spot <= putBoundary(maturity_))
+            return 1.0 - spot;
+
+        const CumulativeNormalDistribution Phi;
+        const Real lnSpot = std::log(spot);
+
+        Real premium = 0.0;
+        for (Size k=0; k<lnBoundary_.size(); ++k) {
+            const Real dp = (lnSpot - lnBoundary_[k] + drift_[k])/stdDev_[k];
+            const Real dm = dp - stdDev_[k];
+            premium += rTerm_[k]*Phi(-dm) - spot*qTerm_[k]*Phi(-dp);
+        }
+
+        const Real european =
+            blackFormula(Option::Put, 1.0,
+                         spot*std::exp((r_-q_)*maturity_),
+                         sigma_*std::sqrt(maturity_),
+                         std::exp(-r_*maturity_));
+
+        return std::max(european + premium, 1.0 - spot);
+    }
+
+    Real AndersenLakeCalculator::value(Real spot, Real strike) const {
+        QL_REQUIRE(spot > 0.0, "positive spot required, " << spot << " given");
+        QL_REQUIRE(strike > 0.0,
+                   "positive strike required, " << strike << " given");
+
+        if (european_)
+            return blackFormula(type_, strike,
+                                spot*std::exp((riskFreeRate_-dividendYield_)
+                                              *maturity_),
+                                sigma_*std::sqrt(maturity_),
+                                std::exp(-riskFreeRate_*maturity_));
+
+        if (type_ == Option::Call)
+            return spot*putValue(strike/spot);
+        else
+            return strike*putValue(spot/strike);
+    }
+
+    std::vector<Real> AndersenLakeCalculator::values(
+                                    Real spot,
+                                    const std::vector<Real>& strikes) const {
+        std::vector<Real> result(strikes.size());
+        for (Size i=0; i<strikes.size(); ++i)
+            result[i] = value(spot, strikes[i]);
+        return result;
+    }
+
+    Real AndersenLakeCalculator::exerciseBoundary(Time timeToMaturity,
+                                                  Real strike) const {
+        QL_REQUIRE(!european_, "early exercise is never optimal");
+        QL_REQUIRE(timeToMaturity >= 0.0 && timeToMaturity <= maturity_,
+                   "time to maturity (" << timeToMaturity
+                   << ") outside [0, " << maturity_ << "]");
+
+        if (type_ == Option::Call)
+            return strike/putBoundary(timeToMaturity);
+        else
+            return strike*putBoundary(timeToMaturity);
+    }
+
+
+    AndersenLakeEngine::AndersenLakeEngine(
+              const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+              Size collocationPoints,
+              Size integrationPoints,
+              Size fixedPointIterations)
+    : process_(process), collocationPoints_(collocationPoints),
+      integrationPoints_(integrationPoints),
+      fixedPointIterations_(fixedPointIterations) {
+        registerWith(process_);
+    }
+
+    boost::shared_ptr<AndersenLakeCalculator>
+    AndersenLakeEngine::calculator(Option::Type type,
+                                   Real variance,
+                                   const Date& exerciseDate) const {
+        const Time maturity = process_->time(exerciseDate);
+        QL_REQUIRE(maturity > 0.0, "expired option");
+
+        const Rate r =
+            -std::log(process_->riskFreeRate()->discount(exerciseDate))
+            / maturity;
+        const Rate q =
+            -std::log(process_->dividendYield()->discount(exerciseDate))
+            / maturity;
+
+        return boost::shared_ptr<AndersenLakeCalculator>(
+            new AndersenLakeCalculator(type, r, q,
+                                       std::sqrt(variance/maturity),
+                                       maturity, collocationPoints_,
+                                       integrationPoints_,
+                                       fixedPointIterations_));
+    }
+
+    void AndersenLakeEngine::calculate() const {
+
+        QL_REQUIRE(arguments_.exercise->type() == Exercise::American,
+                   "not an American Option");
+
+        boost::shared_ptr<AmericanExercise> ex =
+            boost::dynamic_pointer_cast<AmericanExercise>(arguments_.exercise);
+        QL_REQUIRE(ex, "non-American exercise given");
+        QL_REQUIRE(!ex->payoffAtExpiry(),
+                   "payoff at expiry not handled");
+
+        boost::shared_ptr<PlainVanillaPayoff> payoff =
+            boost::dynamic_pointer_cast<PlainVanillaPayoff>(arguments_.payoff);
+        QL_REQUIRE(payoff, "non-plain payoff given");
+
+        std::vector<Real> strikes(1, payoff->strike());
+        results_.value =
+            values(payoff->optionType(), strikes, ex->lastDate()).front();
+    }
+
+    std::vector<Real> AndersenLakeEngine::values(
+                                    Option::Type type,
+                                    const std::vector<Real>& strikes,
+                                    const Date& exerciseDate) const {
+
+        const Real spot = process_->x0();
+        QL_REQUIRE(spot > 0.0, "negative or null underlying given");
+
+        std::vector<Real> result(strikes.size());
+        boost::shared_ptr<AndersenLakeCalculator> calculator;
+        Real variance = Null<Real>();
+        for (Size i=0; i<strikes.size(); ++i) {
+            // the boundary is solved again only if the volatility
+            // changes with the strike
+            const Real v =
+                process_->blackVolatility()->blackVariance(exerciseDate,
+                                                           strikes[i]);
+            if (!calculator || v != variance) {
+                variance = v;
+                calculator = this->calculator(type, variance, exerciseDate);
+            }
+            result[i] = calculator->value(spot, strikes[i]);
+        }
+        return result;
+    }
+
+}
+
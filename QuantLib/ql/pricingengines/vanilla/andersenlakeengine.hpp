@@ -0,0 +1,163 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2015 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file andersenlakeengine.hpp
+    \brief Andersen-Lake-Offengenden engine for American options
+*/
+
+#ifndef quantlib_andersen_lake_engine_hpp
+#define quantlib_andersen_lake_engine_hpp
+
+#include <ql/instruments/vanillaoption.hpp>
+#include <ql/processes/blackscholesprocess.hpp>
+
+namespace QuantLib {
+
+    //! American option calculator based on the exercise boundary
+    /*! The early-exercise boundary of the American put is found as
+        the solution of the integral equation given in the reference
+        below (the FP-B fixed-point system) by collocation on
+        Chebyshev nodes in the square root of the time to maturity;
+        the integrals are computed by Gauss-Legendre quadrature.  The
+        option value is then the European value plus the
+        early-exercise premium, integrated along the boundary.
+
+        Calls are priced by put-call symmetry.  Since the boundary
+        is proportional to the strike, the same calculator can price
+        options with any strike and spot for the given rates,
+        volatility and maturity.
+
+        References:
+
+        L. Andersen, M. Lake and D. Offengenden, "High-performance
+        American option pricing", Journal of Computational Finance,
+        20(1), 2016.
+
+        \warning the double exercise boundary arising for negative
+                 rates (e.g., puts with \f$ q < r < 0 \f$) is not
+                 handled.
+    */
+    class AndersenLakeCalculator {
+      public:
+        /*! The rates are continuously compounded; the number of
+            collocation points, integration points and fixed-point
+            iterations control the accuracy of the boundary.
+        */
+        AndersenLakeCalculator(Option::Type type,
+                               Rate riskFreeRate,
+                               Rate dividendYield,
+                               Volatility volatility,
+                               Time maturity,
+                               Size collocationPoints = 12,
+                               Size integrationPoints = 32,
+                               Size fixedPointIterations = 10);
+
+        //! value of the option with the given spot and strike
+        Real value(Real spot, Real strike) const;
+        //! values of the options with the given spot and strikes
+        std::vector<Real> values(Real spot,
+                                 const std::vector<Real>& strikes) const;
+        /*! exercise boundary for the given strike and time to
+            maturity; the option is exercised when the underlying
+            falls below (puts) or rises above (calls) it.
+        */
+        Real exerciseBoundary(Time timeToMaturity, Real strike) const;
+
+        //! whether early exercise is never optimal
+        bool isEuropean() const { return european_; }
+
+      private:
+        // unit-strike put with rates r_ and q_
+        Real putBoundary(Time tau) const;
+        Real putValue(Real spot) const;
+        Real interpolate(Real z) const;
+        Real transform(Real boundary) const;
+        void solveBoundary(Size fixedPointIterations);
+
+        Option::Type type_;
+        Rate riskFreeRate_, dividendYield_;
+        Rate r_, q_;
+        Volatility sigma_;
+        Time maturity_;
+        bool european_;
+        // boundary at maturity
+        Real xMax_;
+        bool squared_;
+        // collocation nodes in [-1,1], interpolation weights and
+        // transformed boundary values
+        std::vector<Real> z_, w_, h_;
+        // Gauss-Legendre nodes and weights mapped on [0, pi/2]
+        std::vector<Real> sin_, cos_, weights_;
+        // terms of the early-exercise premium
+        std::vector<Real> lnBoundary_, stdDev_, drift_, rTerm_, qTerm_;
+    };
+
+
+    //! Andersen-Lake-Offengenden engine for American options
+    /*! The options are priced by means of the
+        AndersenLakeCalculator class, to which we refer for details;
+        the rates and volatility are the constant ones implied by the
+        term structures at the exercise date.  With the default
+        settings, the values agree to about \f$ 10^{-8} \f$ relative
+        to the strike with the ones obtained with many more
+        collocation and integration points.
+
+        The values() method prices a chain of options with the same
+        type and exercise date.  The exercise boundary is solved once
+        for all the strikes with the same volatility.
+
+        \ingroup vanillaengines
+
+        \test the returned values are checked against the ones
+              obtained with a higher number of collocation and
+              integration points, and against finite-difference
+              results extrapolated in time.
+
+        \test the values of a chain of options are checked against
+              the ones of the single options.
+    */
+    class AndersenLakeEngine : public VanillaOption::engine {
+      public:
+        AndersenLakeEngine(
+              const boost::shared_ptr<GeneralizedBlackScholesProcess>&,
+              Size collocationPoints = 12,
+              Size integrationPoints = 32,
+              Size fixedPointIterations = 10);
+        void calculate() const;
+
+        /*! values of American options with the given type, strikes
+            and exercise date on the underlying of the process.
+        */
+        std::vector<Real> values(Option::Type type,
+                                 const std::vector<Real>& strikes,
+                                 const Date& exerciseDate) const;
+      private:
+        boost::shared_ptr<AndersenLakeCalculator> calculator(
+                                            Option::Type type,
+                                            Real variance,
+                                            const Date& exerciseDate) const;
+
+        boost::shared_ptr<GeneralizedBlackScholesProcess> process_;
+        Size collocationPoints_, integrationPoints_, fixedPointIterations_;
+    };
+
+}
+
+
+#endif
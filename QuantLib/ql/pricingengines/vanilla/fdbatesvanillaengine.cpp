@@ -23,6 +23,8 @@
 
 #include <ql/processes/batesprocess.hpp>
 
+#include <ql/methods/finitedifferences/operators/fdmbatesop.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmbatchsolver.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmbatessolver.hpp>
 #include <ql/pricingengines/vanilla/fdbatesvanillaengine.hpp>
 #include <ql/pricingengines/vanilla/fdhestonvanillaengine.hpp>
@@ -43,6 +45,16 @@ namespace QuantLib {
     }
 
     void FdBatesVanillaEngine::calculate() const {
+
+        // cache lookup for results of previous batches
+        if (cache_.lookup(arguments_, results_))
+            return;
+
+        if (!batch_.empty()) {
+            calculateBatch();
+            return;
+        }
+
         FdHestonVanillaEngine helperEngine(model_.currentLink(),
                                            tGrid_, xGrid_, vGrid_,
                                            dampingSteps_, schemeDesc_);
@@ -67,4 +79,60 @@ namespace QuantLib {
         results_.gamma = solver->gammaAt(spot, v0);
         results_.theta = solver->thetaAt(spot, v0);
     }
+
+    void FdBatesVanillaEngine::calculateBatch() const {
+        const std::vector<boost::shared_ptr<StrikedTypePayoff> > payoffs =
+            FdVanillaBatchCache::batchPayoffs(arguments_, batch_);
+
+        FdHestonVanillaEngine helperEngine(model_.currentLink(),
+                                           tGrid_, xGrid_, vGrid_,
+                                           dampingSteps_, schemeDesc_);
+
+        *dynamic_cast<DividendVanillaOption::arguments*>(
+                               helperEngine.getArguments()) = arguments_;
+
+        const FdmSolverDesc solverDesc =
+            helperEngine.getBatchSolverDesc(payoffs);
+
+        const boost::shared_ptr<BatesProcess> process =
+                boost::dynamic_pointer_cast<BatesProcess>(model_->process());
+
+        const boost::shared_ptr<FdmLinearOpComposite> op(
+            new FdmBatesOp(solverDesc.mesher, process, solverDesc.bcSet, 12));
+        const FdmBatchSolver solver(solverDesc, schemeDesc_, op);
+
+        const Real v0   = process->v0();
+        const Real spot = process->s0()->value();
+        const Real x    = std::log(spot);
+
+        cache_.clear();
+        for (Size i=0; i < payoffs.size(); ++i) {
+            DividendVanillaOption::results results;
+            results.reset();
+            results.value = solver.interpolateAt(i, x, v0);
+            results.delta = solver.derivativeX(i, x, v0)/spot;
+            results.gamma = (solver.derivativeXX(i, x, v0)
+                             - solver.derivativeX(i, x, v0))/(spot*spot);
+            results.theta = solver.thetaAt(i, x, v0);
+
+            if (i == 0)
+                results_ = results;
+            else
+                cache_.add(FdVanillaBatchCache::withPayoff(arguments_,
+                                                           payoffs[i]),
+                           results);
+        }
+    }
+
+    void FdBatesVanillaEngine::update() {
+        cache_.clear();
+        GenericModelEngine<BatesModel, DividendVanillaOption::arguments,
+                           DividendVanillaOption::results>::update();
+    }
+
+    void FdBatesVanillaEngine::enableBatch(
+            const std::vector<boost::shared_ptr<StrikedTypePayoff> >& payoffs) {
+        batch_ = payoffs;
+        cache_.clear();
+    }
 }
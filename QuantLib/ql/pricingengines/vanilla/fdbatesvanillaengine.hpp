@@ -28,6 +28,7 @@
 #include <ql/instruments/dividendvanillaoption.hpp>
 #include <ql/pricingengines/genericmodelengine.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
+#include <ql/pricingengines/vanilla/fdvanillabatchcache.hpp>
 
 namespace QuantLib {
 
@@ -49,10 +50,26 @@ namespace QuantLib {
 
         
         void calculate() const;
+
+        // batch pricing
+        void update();
+        /*! the given payoffs are priced together with the option
+            being calculated, in a single backward solve; their
+            results are cached and returned if an option with the
+            same exercise, payoff and dividends is calculated next.
+        */
+        void enableBatch(
+            const std::vector<boost::shared_ptr<StrikedTypePayoff> >& payoffs);
         
       private:
+        void calculateBatch() const;
+
+
         const Size tGrid_, xGrid_, vGrid_, dampingSteps_;
         const FdmSchemeDesc schemeDesc_;
+
+        std::vector<boost::shared_ptr<StrikedTypePayoff> > batch_;
+        mutable FdVanillaBatchCache cache_;
     };
 }
 
@@ -21,16 +21,35 @@
 
 #include <ql/exercise.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
+#include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
+#include <ql/termstructures/volatility/equityfx/blackvariancecurve.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmbatchsolver.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmblackscholessolver.hpp>
+#include <ql/methods/finitedifferences/operators/fdmblackscholesop.hpp>
 #include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmblackscholesmesher.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmblackscholesmultistrikemesher.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
 #include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
 
 namespace QuantLib {
 
+    namespace {
+
+        // the batch is rolled back with the volatility at a single
+        // strike, which is only correct for the other payoffs if the
+        // volatility doesn't depend on the strike
+        bool strikeIndependent(const Handle<BlackVolTermStructure>& vol) {
+            return boost::dynamic_pointer_cast<BlackConstantVol>(
+                                                     vol.currentLink())
+                || boost::dynamic_pointer_cast<BlackVarianceCurve>(
+                                                     vol.currentLink());
+        }
+
+    }
+
     FdBlackScholesVanillaEngine::FdBlackScholesVanillaEngine(
             const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
             Size tGrid, Size xGrid, Size dampingSteps, 
@@ -40,13 +59,25 @@ namespace QuantLib {
       tGrid_(tGrid), xGrid_(xGrid), dampingSteps_(dampingSteps),
       schemeDesc_(schemeDesc), 
       localVol_(localVol),
-      illegalLocalVolOverwrite_(illegalLocalVolOverwrite) {
+      illegalLocalVolOverwrite_(illegalLocalVolOverwrite),
+      sensitivities_(false) {
 
         registerWith(process_);
     }
 
     void FdBlackScholesVanillaEngine::calculate() const {
 
+        // cache lookup for results of previous batches
+        if (cache_.lookup(arguments_, results_))
+            return;
+
+        // otherwise, the option is priced on its own below
+        if (!batch_.empty()
+            && (localVol_ || strikeIndependent(process_->blackVolatility()))) {
+            calculateBatch();
+            return;
+        }
+
         // 1. Mesher
         const boost::shared_ptr<StrikedTypePayoff> payoff =
             boost::dynamic_pointer_cast<StrikedTypePayoff>(arguments_.payoff);
@@ -84,12 +115,103 @@ namespace QuantLib {
                 new FdmBlackScholesSolver(
                              Handle<GeneralizedBlackScholesProcess>(process_),
                              payoff->strike(), solverDesc, schemeDesc_,
-                             localVol_, illegalLocalVolOverwrite_));
+                             localVol_, illegalLocalVolOverwrite_,
+                             sensitivities_));
 
         const Real spot = process_->x0();
         results_.value = solver->valueAt(spot);
         results_.delta = solver->deltaAt(spot);
         results_.gamma = solver->gammaAt(spot);
         results_.theta = solver->thetaAt(spot);
+        if (sensitivities_) {
+            results_.vega = solver->vegaAt(spot);
+            results_.rho = solver->rhoAt(spot);
+            results_.dividendRho = solver->dividendRhoAt(spot);
+        }
+    }
+
+    void FdBlackScholesVanillaEngine::calculateBatch() const {
+        const std::vector<boost::shared_ptr<StrikedTypePayoff> > payoffs =
+            FdVanillaBatchCache::batchPayoffs(arguments_, batch_);
+        const Real strike = payoffs.front()->strike();
+
+        // 1. Mesher, with the payoffs along the last direction
+        const Time maturity = process_->time(arguments_.exercise->lastDate());
+        const boost::shared_ptr<Fdm1dMesher> equityMesher(
+            new FdmBlackScholesMultiStrikeMesher(
+                    xGrid_, process_, maturity,
+                    FdVanillaBatchCache::strikes(payoffs), 0.0001, 1.5,
+                    std::pair<Real, Real>(strike, 0.1)));
+
+        const boost::shared_ptr<FdmMesher> mesher (
+            new FdmMesherComposite(
+                equityMesher, FdVanillaBatchCache::batchMesher(payoffs.size())));
+
+        // 2. Calculator
+        const boost::shared_ptr<FdmInnerValueCalculator> calculator =
+            FdVanillaBatchCache::batchCalculator(payoffs, mesher);
+
+        // 3. Step conditions
+        const boost::shared_ptr<FdmStepConditionComposite> conditions = 
+            FdmStepConditionComposite::vanillaComposite(
+                                    arguments_.cashFlow, arguments_.exercise, 
+                                    mesher, calculator, 
+                                    process_->riskFreeRate()->referenceDate(),
+                                    process_->riskFreeRate()->dayCounter());
+
+        // 4. Boundary conditions
+        const FdmBoundaryConditionSet boundaries;
+
+        // 5. Solver
+        FdmSolverDesc solverDesc = { mesher, boundaries, conditions, calculator,
+                                     maturity, tGrid_, dampingSteps_ };
+
+        const boost::shared_ptr<FdmLinearOpComposite> op(
+            new FdmBlackScholesOp(mesher, process_, strike,
+                                  localVol_, illegalLocalVolOverwrite_));
+
+        const FdmBatchSolver solver(solverDesc, schemeDesc_, op);
+
+        const Real spot = process_->x0();
+        const Real x = std::log(spot);
+        cache_.clear();
+        for (Size i=0; i < payoffs.size(); ++i) {
+            DividendVanillaOption::results results;
+            results.reset();
+            results.value = solver.interpolateAt(i, x);
+            results.delta = solver.derivativeX(i, x)/spot;
+            results.gamma = (solver.derivativeXX(i, x)
+                             - solver.derivativeX(i, x))/(spot*spot);
+            results.theta = solver.thetaAt(i, x);
+
+            if (i == 0)
+                results_ = results;
+            else
+                cache_.add(FdVanillaBatchCache::withPayoff(arguments_,
+                                                           payoffs[i]),
+                           results);
+        }
+    }
+
+    void FdBlackScholesVanillaEngine::update() {
+        cache_.clear();
+        DividendVanillaOption::engine::update();
+    }
+
+    void FdBlackScholesVanillaEngine::enableBatch(
+            const std::vector<boost::shared_ptr<StrikedTypePayoff> >& payoffs) {
+        QL_REQUIRE(!sensitivities_,
+                   "batch pricing not available with sensitivities");
+        batch_ = payoffs;
+        cache_.clear();
+    }
+
+    void FdBlackScholesVanillaEngine::enableSensitivities() {
+        QL_REQUIRE(!localVol_,
+                   "sensitivities not available with local volatility");
+        QL_REQUIRE(batch_.empty(),
+                   "sensitivities not available with batch pricing");
+        sensitivities_ = true;
+        cache_.clear();
     }
 }
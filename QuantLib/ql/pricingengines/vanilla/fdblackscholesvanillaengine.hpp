@@ -29,6 +29,7 @@
 #include <ql/pricingengine.hpp>
 #include <ql/instruments/dividendvanillaoption.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
+#include <ql/pricingengines/vanilla/fdvanillabatchcache.hpp>
 
 namespace QuantLib {
 
@@ -39,6 +40,28 @@ namespace QuantLib {
         \test the correctness of the returned value is tested by
               reproducing results available in web/literature
               and comparison with Black pricing.
+
+        \warning when batch pricing is enabled without local
+                 volatility, the payoffs are priced together only if
+                 the Black volatility doesn't depend on the strike
+                 (i.e., it is a BlackConstantVol or a
+                 BlackVarianceCurve); otherwise, each option is
+                 priced on its own as if the batch were not enabled.
+
+        \test batch prices of American options are checked against
+              the prices of the same options calculated one by one,
+              both on a flat volatility and on a volatility smile.
+
+        \test the price of an American option with dividends using
+              error-controlled time steps is checked against the one
+              obtained with a fine uniform time grid; the number of
+              steps taken is compared with uniform stepping at equal
+              error.
+
+        \test vega and rho from the tangent-linear solve are checked
+              against the analytic ones for European options and
+              against bump-and-reprice for American options with
+              dividends.
     */
     class GeneralizedBlackScholesProcess;
 
@@ -54,12 +77,35 @@ namespace QuantLib {
 
         void calculate() const;
 
+        // batch pricing
+        void update();
+        /*! the given payoffs are priced together with the option
+            being calculated, in a single backward solve; their
+            results are cached and returned if an option with the
+            same exercise, payoff and dividends is calculated next.
+        */
+        void enableBatch(
+            const std::vector<boost::shared_ptr<StrikedTypePayoff> >& payoffs);
+
+        /*! vega, rho and dividend rho are calculated in the same
+            backward solve as the value by means of a tangent-linear
+            solve; local volatility and batch pricing are not
+            supported.
+        */
+        void enableSensitivities();
+
       private:
+        void calculateBatch() const;
+
         const boost::shared_ptr<GeneralizedBlackScholesProcess> process_;
         const Size tGrid_, xGrid_, dampingSteps_;
         const FdmSchemeDesc schemeDesc_;
         const bool localVol_;
         const Real illegalLocalVolOverwrite_;
+
+        bool sensitivities_;
+        std::vector<boost::shared_ptr<StrikedTypePayoff> > batch_;
+        mutable FdVanillaBatchCache cache_;
     };
 }
 
@@ -23,7 +23,9 @@
 #include <ql/processes/batesprocess.hpp>
 #include <ql/pricingengines/vanilla/fdhestonvanillaengine.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmbatchsolver.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmhestonsolver.hpp>
+#include <ql/methods/finitedifferences/operators/fdmhestonop.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmhestonvariancemesher.hpp>
 #include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
 #include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
@@ -61,8 +63,11 @@ namespace QuantLib {
         const boost::shared_ptr<StrikedTypePayoff> payoff =
             boost::dynamic_pointer_cast<StrikedTypePayoff>(arguments_.payoff);
 
+        // cash dividends don't scale with the strike; options paying
+        // them are priced on their own even if multiple strikes
+        // caching is enabled
         boost::shared_ptr<Fdm1dMesher> equityMesher;
-        if (strikes_.empty()) {
+        if (strikes_.empty() || !arguments_.cashFlow.empty()) {
             equityMesher = boost::shared_ptr<Fdm1dMesher>(
                 new FdmBlackScholesMesher(
                     xGrid_, 
@@ -74,8 +79,6 @@ namespace QuantLib {
                       std::pair<Real, Real>(payoff->strike(), 0.1)));
         }
         else {
-            QL_REQUIRE(arguments_.cashFlow.empty(),"multiple strikes engine "
-                       "does not work with discrete dividends");
             equityMesher = boost::shared_ptr<Fdm1dMesher>(
                 new FdmBlackScholesMultiStrikeMesher(
                     xGrid_,
@@ -112,30 +115,69 @@ namespace QuantLib {
        return solverDesc;
     }
 
+    FdmSolverDesc FdHestonVanillaEngine::getBatchSolverDesc(
+        const std::vector<boost::shared_ptr<StrikedTypePayoff> >& payoffs)
+                                                                    const {
+        QL_REQUIRE(!payoffs.empty(), "no payoffs given");
+
+        // 1. Mesher
+        const boost::shared_ptr<HestonProcess> process = model_->process();
+        const Time maturity = process->time(arguments_.exercise->lastDate());
+
+        // 1.1 The variance mesher
+        const Size tGridMin = 5;
+        const boost::shared_ptr<FdmHestonVarianceMesher> varianceMesher(
+            new FdmHestonVarianceMesher(vGrid_, process,
+                                        maturity,std::max(tGridMin,tGrid_/50)));
+
+        // 1.2 The equity mesher, covering the strikes of all payoffs
+        const boost::shared_ptr<Fdm1dMesher> equityMesher(
+            new FdmBlackScholesMultiStrikeMesher(
+                xGrid_,
+                FdmBlackScholesMesher::processHelper(
+                  process->s0(), process->dividendYield(), 
+                  process->riskFreeRate(), varianceMesher->volaEstimate()),
+                maturity, FdVanillaBatchCache::strikes(payoffs), 0.0001, 1.5,
+                std::pair<Real, Real>(payoffs.front()->strike(), 0.075)));
+
+        // 1.3 The payoffs of the batch
+        const boost::shared_ptr<FdmMesher> mesher(
+            new FdmMesherComposite(
+                equityMesher, varianceMesher,
+                FdVanillaBatchCache::batchMesher(payoffs.size())));
+
+        // 2. Calculator
+        const boost::shared_ptr<FdmInnerValueCalculator> calculator =
+            FdVanillaBatchCache::batchCalculator(payoffs, mesher);
+
+        // 3. Step conditions
+        const boost::shared_ptr<FdmStepConditionComposite> conditions = 
+             FdmStepConditionComposite::vanillaComposite(
+                                 arguments_.cashFlow, arguments_.exercise, 
+                                 mesher, calculator, 
+                                 process->riskFreeRate()->referenceDate(),
+                                 process->riskFreeRate()->dayCounter());
+
+        // 4. Boundary conditions
+        const FdmBoundaryConditionSet boundaries;
+
+        // 5. Solver
+        FdmSolverDesc solverDesc = { mesher, boundaries, conditions,
+                                     calculator, maturity,
+                                     tGrid_, dampingSteps_ };
+
+        return solverDesc;
+    }
+
     void FdHestonVanillaEngine::calculate() const {
 
         // cache lookup for precalculated results
-        for (Size i=0; i < cachedArgs2results_.size(); ++i) {
-            if (   cachedArgs2results_[i].first.exercise->type()
-                        == arguments_.exercise->type()
-                && cachedArgs2results_[i].first.exercise->dates()
-                        == arguments_.exercise->dates()) {
-                boost::shared_ptr<PlainVanillaPayoff> p1 =
-                    boost::dynamic_pointer_cast<PlainVanillaPayoff>(
-                                                            arguments_.payoff);
-                boost::shared_ptr<PlainVanillaPayoff> p2 =
-                    boost::dynamic_pointer_cast<PlainVanillaPayoff>(
-                                          cachedArgs2results_[i].first.payoff);
-
-                if (p1 && p1->strike()     == p2->strike()
-                       && p1->optionType() == p2->optionType()) {
-                    QL_REQUIRE(arguments_.cashFlow.empty(),
-                               "multiple strikes engine does "
-                               "not work with discrete dividends");
-                    results_ = cachedArgs2results_[i].second;
-                    return;
-                }
-            }
+        if (cache_.lookup(arguments_, results_))
+            return;
+
+        if (!batch_.empty()) {
+            calculateBatch();
+            return;
         }
 
         const boost::shared_ptr<HestonProcess> process = model_->process();
@@ -152,27 +194,67 @@ namespace QuantLib {
         results_.gamma = solver->gammaAt(spot, v0);
         results_.theta = solver->thetaAt(spot, v0);
         
-        cachedArgs2results_.resize(strikes_.size());
+        cache_.clear();
+        if (!arguments_.cashFlow.empty())
+            return;
+
         const boost::shared_ptr<StrikedTypePayoff> payoff =
             boost::dynamic_pointer_cast<StrikedTypePayoff>(arguments_.payoff);
         for (Size i=0; i < strikes_.size(); ++i) {
-            cachedArgs2results_[i].first.exercise = arguments_.exercise;
-            cachedArgs2results_[i].first.payoff = 
-                boost::shared_ptr<PlainVanillaPayoff>(
-                    new PlainVanillaPayoff(payoff->optionType(), strikes_[i]));
             const Real d = payoff->strike()/strikes_[i];
             
-            DividendVanillaOption::results& 
-                                results = cachedArgs2results_[i].second;
+            DividendVanillaOption::results results;
+            results.reset();
             results.value = solver->valueAt(spot*d, v0)/d;
             results.delta = solver->deltaAt(spot*d, v0);
             results.gamma = solver->gammaAt(spot*d, v0)*d;
             results.theta = solver->thetaAt(spot*d, v0)/d;                
+
+            cache_.add(FdVanillaBatchCache::withPayoff(
+                           arguments_,
+                           boost::shared_ptr<StrikedTypePayoff>(
+                               new PlainVanillaPayoff(payoff->optionType(),
+                                                      strikes_[i]))),
+                       results);
+        }
+    }
+
+    void FdHestonVanillaEngine::calculateBatch() const {
+        const std::vector<boost::shared_ptr<StrikedTypePayoff> > payoffs =
+            FdVanillaBatchCache::batchPayoffs(arguments_, batch_);
+
+        const boost::shared_ptr<HestonProcess> process = model_->process();
+        const FdmSolverDesc solverDesc = getBatchSolverDesc(payoffs);
+
+        const boost::shared_ptr<FdmLinearOpComposite> op(
+                               new FdmHestonOp(solverDesc.mesher, process));
+        const FdmBatchSolver solver(solverDesc, schemeDesc_, op);
+
+        const Real v0   = process->v0();
+        const Real spot = process->s0()->value();
+        const Real x    = std::log(spot);
+
+        cache_.clear();
+        for (Size i=0; i < payoffs.size(); ++i) {
+            DividendVanillaOption::results results;
+            results.reset();
+            results.value = solver.interpolateAt(i, x, v0);
+            results.delta = solver.derivativeX(i, x, v0)/spot;
+            results.gamma = (solver.derivativeXX(i, x, v0)
+                             - solver.derivativeX(i, x, v0))/(spot*spot);
+            results.theta = solver.thetaAt(i, x, v0);
+
+            if (i == 0)
+                results_ = results;
+            else
+                cache_.add(FdVanillaBatchCache::withPayoff(arguments_,
+                                                           payoffs[i]),
+                           results);
         }
     }
     
     void FdHestonVanillaEngine::update() {
-        cachedArgs2results_.clear();
+        cache_.clear();
         GenericModelEngine<HestonModel, DividendVanillaOption::arguments,
                            DividendVanillaOption::results>::update();
     }
@@ -180,6 +262,14 @@ namespace QuantLib {
     void FdHestonVanillaEngine::enableMultipleStrikesCaching(
                                         const std::vector<Real>& strikes) {
         strikes_ = strikes;
-        cachedArgs2results_.clear();
+        batch_.clear();
+        cache_.clear();
+    }
+
+    void FdHestonVanillaEngine::enableBatch(
+            const std::vector<boost::shared_ptr<StrikedTypePayoff> >& payoffs) {
+        batch_ = payoffs;
+        strikes_.clear();
+        cache_.clear();
     }
 }
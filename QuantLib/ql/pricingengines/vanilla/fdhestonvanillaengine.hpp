@@ -31,6 +31,7 @@
 #include <ql/pricingengines/genericmodelengine.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmsolverdesc.hpp>
 #include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
+#include <ql/pricingengines/vanilla/fdvanillabatchcache.hpp>
 
 namespace QuantLib {
 
@@ -41,6 +42,9 @@ namespace QuantLib {
         \test the correctness of the returned value is tested by
               reproducing results available in web/literature
               and comparison with Black pricing.
+
+        \test batch prices of American options are checked against
+              the prices of the same options calculated one by one.
     */
     class FdHestonVanillaEngine
         : public GenericModelEngine<HestonModel,
@@ -58,19 +62,42 @@ namespace QuantLib {
         
         // multiple strikes caching engine
         void update();
+        /*! the results for the given strikes are obtained by scaling
+            the solution of the option being calculated; since cash
+            dividends don't scale with the strike, options paying
+            them are priced on their own and not cached.
+        */
         void enableMultipleStrikesCaching(const std::vector<Real>& strikes);
+
+        // batch pricing
+        /*! the given payoffs are priced together with the option
+            being calculated, in a single backward solve; their
+            results are cached and returned if an option with the
+            same exercise, payoff and dividends is calculated next.
+            This replaces multiple strikes caching, if enabled.
+        */
+        void enableBatch(
+            const std::vector<boost::shared_ptr<StrikedTypePayoff> >& payoffs);
         
-        // helper method for Heston like engines
+        // helper methods for Heston like engines
         FdmSolverDesc getSolverDesc(Real equityScaleFactor) const;
+        /*! the payoffs are enumerated by the last direction of the
+            returned mesher.
+        */
+        FdmSolverDesc getBatchSolverDesc(
+            const std::vector<boost::shared_ptr<StrikedTypePayoff> >& payoffs)
+                                                                        const;
 
       private:
+        void calculateBatch() const;
+
+
         const Size tGrid_, xGrid_, vGrid_, dampingSteps_;
         const FdmSchemeDesc schemeDesc_;
         
         std::vector<Real> strikes_;
-        mutable std::vector<std::pair<DividendVanillaOption::arguments,
-                                      DividendVanillaOption::results> >
-                                                            cachedArgs2results_;
+        std::vector<boost::shared_ptr<StrikedTypePayoff> > batch_;
+        mutable FdVanillaBatchCache cache_;
     };
 
 }
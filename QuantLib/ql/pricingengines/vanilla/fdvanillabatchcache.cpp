@@ -0,0 +1,163 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2015 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/exercise.hpp>
+#include <ql/pricingengines/vanilla/fdvanillabatchcache.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
+#include <ql/methods/finitedifferences/meshers/predefined1dmesher.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
+
+namespace QuantLib {
+
+    bool FdVanillaBatchCache::lookup(const arguments& args,
+                                     results& r) const {
+        for (Size i=0; i < cache_.size(); ++i) {
+            const arguments& cached = cache_[i].first;
+            if (sameExercise(cached, args)
+                && samePayoff(cached.payoff, args.payoff)
+                && sameDividends(cached, args)) {
+                r = cache_[i].second;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void FdVanillaBatchCache::add(const arguments& args, const results& r) {
+        cache_.push_back(std::make_pair(args, r));
+    }
+
+    void FdVanillaBatchCache::clear() {
+        cache_.clear();
+    }
+
+    bool FdVanillaBatchCache::empty() const {
+        return cache_.empty();
+    }
+
+    std::vector<boost::shared_ptr<StrikedTypePayoff> >
+    FdVanillaBatchCache::batchPayoffs(
+        const arguments& args,
+        const std::vector<boost::shared_ptr<StrikedTypePayoff> >& batch) {
+
+        const boost::shared_ptr<StrikedTypePayoff> payoff =
+            boost::dynamic_pointer_cast<StrikedTypePayoff>(args.payoff);
+        QL_REQUIRE(payoff, "non-striked payoff given");
+
+        std::vector<boost::shared_ptr<StrikedTypePayoff> > payoffs(1, payoff);
+        for (Size i=0; i < batch.size(); ++i) {
+            QL_REQUIRE(batch[i], "null payoff in batch");
+            bool found = false;
+            for (Size j=0; j < payoffs.size() && !found; ++j)
+                found = samePayoff(payoffs[j], batch[i]);
+            if (!found)
+                payoffs.push_back(batch[i]);
+        }
+        return payoffs;
+    }
+
+    std::vector<Real> FdVanillaBatchCache::strikes(
+        const std::vector<boost::shared_ptr<StrikedTypePayoff> >& payoffs) {
+        std::vector<Real> strikes(payoffs.size());
+        for (Size i=0; i < payoffs.size(); ++i)
+            strikes[i] = payoffs[i]->strike();
+        return strikes;
+    }
+
+    boost::shared_ptr<Fdm1dMesher> FdVanillaBatchCache::batchMesher(
+                                                                Size size) {
+        std::vector<Real> locations(size);
+        for (Size i=0; i < size; ++i)
+            locations[i] = Real(i);
+        return boost::shared_ptr<Fdm1dMesher>(
+                                        new Predefined1dMesher(locations));
+    }
+
+    boost::shared_ptr<FdmInnerValueCalculator>
+    FdVanillaBatchCache::batchCalculator(
+        const std::vector<boost::shared_ptr<StrikedTypePayoff> >& payoffs,
+        const boost::shared_ptr<FdmMesher>& mesher) {
+
+        std::vector<boost::shared_ptr<FdmInnerValueCalculator> >
+                                                    calculators(payoffs.size());
+        for (Size i=0; i < payoffs.size(); ++i)
+            calculators[i] = boost::shared_ptr<FdmInnerValueCalculator>(
+                                   new FdmLogInnerValue(payoffs[i], mesher, 0));
+
+        return boost::shared_ptr<FdmInnerValueCalculator>(
+            new FdmBatchInnerValue(calculators,
+                                   mesher->layout()->dim().size()-1));
+    }
+
+    FdVanillaBatchCache::arguments FdVanillaBatchCache::withPayoff(
+                            const arguments& args,
+                            const boost::shared_ptr<StrikedTypePayoff>& p) {
+        arguments retVal(args);
+        retVal.payoff = p;
+        return retVal;
+    }
+
+    bool FdVanillaBatchCache::samePayoff(
+                                    const boost::shared_ptr<Payoff>& p1,
+                                    const boost::shared_ptr<Payoff>& p2) {
+        if (p1 == p2)
+            return true;
+
+        const boost::shared_ptr<StrikedTypePayoff> s1 =
+            boost::dynamic_pointer_cast<StrikedTypePayoff>(p1);
+        const boost::shared_ptr<StrikedTypePayoff> s2 =
+            boost::dynamic_pointer_cast<StrikedTypePayoff>(p2);
+
+        // the description covers the additional parameters of
+        // payoffs such as cash-or-nothing or gap ones
+        return s1 && s2
+            && s1->optionType() == s2->optionType()
+            && s1->strike() == s2->strike()
+            && s1->description() == s2->description();
+    }
+
+    bool FdVanillaBatchCache::sameExercise(const arguments& a1,
+                                           const arguments& a2) {
+        if (a1.exercise->type() != a2.exercise->type()
+            || a1.exercise->dates() != a2.exercise->dates())
+            return false;
+
+        const boost::shared_ptr<EarlyExercise> e1 =
+            boost::dynamic_pointer_cast<EarlyExercise>(a1.exercise);
+        const boost::shared_ptr<EarlyExercise> e2 =
+            boost::dynamic_pointer_cast<EarlyExercise>(a2.exercise);
+        if (e1 && e2)
+            return e1->payoffAtExpiry() == e2->payoffAtExpiry();
+        return !e1 && !e2;
+    }
+
+    bool FdVanillaBatchCache::sameDividends(const arguments& a1,
+                                            const arguments& a2) {
+        if (a1.cashFlow.size() != a2.cashFlow.size())
+            return false;
+        for (Size i=0; i < a1.cashFlow.size(); ++i) {
+            if (a1.cashFlow[i]->date() != a2.cashFlow[i]->date()
+                || a1.cashFlow[i]->amount() != a2.cashFlow[i]->amount())
+                return false;
+        }
+        return true;
+    }
+
+}
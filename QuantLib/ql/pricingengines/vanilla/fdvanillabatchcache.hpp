@@ -0,0 +1,110 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2015 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file fdvanillabatchcache.hpp
+    \brief results cache for batches of vanilla options priced together
+*/
+
+#ifndef quantlib_fd_vanilla_batch_cache_hpp
+#define quantlib_fd_vanilla_batch_cache_hpp
+
+#include <ql/instruments/payoffs.hpp>
+#include <ql/instruments/dividendvanillaoption.hpp>
+
+namespace QuantLib {
+
+    class FdmMesher;
+    class Fdm1dMesher;
+    class FdmInnerValueCalculator;
+
+    //! results cache for batches of vanilla options priced together
+    /*! Finite-difference engines can price several payoffs sharing
+        exercise and dividends in a single backward solve.  The
+        results for the payoffs that were not requested are stored
+        here, so that later calculations for the same exercise,
+        payoff and dividends are served without a further solve.
+
+        Engines are expected to clear the cache whenever they are
+        notified of a change in their model or process.
+    */
+    class FdVanillaBatchCache {
+      public:
+        typedef DividendVanillaOption::arguments arguments;
+        typedef DividendVanillaOption::results results;
+
+        //! \name Cache handling
+        //@{
+        /*! returns true and sets the results if the given arguments
+            were priced by a previous batch.
+        */
+        bool lookup(const arguments& args, results& r) const;
+        void add(const arguments& args, const results& r);
+        void clear();
+        bool empty() const;
+        //@}
+
+        //! \name Batch setup
+        //@{
+        /*! returns the payoffs to be priced together: the payoff of
+            the given arguments comes first, followed by the ones in
+            the batch which differ from it.
+        */
+        static std::vector<boost::shared_ptr<StrikedTypePayoff> >
+        batchPayoffs(
+            const arguments& args,
+            const std::vector<boost::shared_ptr<StrikedTypePayoff> >& batch);
+
+        //! strikes of the given payoffs
+        static std::vector<Real> strikes(
+            const std::vector<boost::shared_ptr<StrikedTypePayoff> >&
+                                                                    payoffs);
+
+        /*! returns the mesher of the batch direction, enumerating
+            the given number of payoffs.
+        */
+        static boost::shared_ptr<Fdm1dMesher> batchMesher(Size size);
+
+        /*! returns an inner-value calculator which dispatches to the
+            i-th payoff along the last direction of the mesher; the
+            equity direction is the first one.
+        */
+        static boost::shared_ptr<FdmInnerValueCalculator> batchCalculator(
+            const std::vector<boost::shared_ptr<StrikedTypePayoff> >& payoffs,
+            const boost::shared_ptr<FdmMesher>& mesher);
+
+        /*! returns a copy of the given arguments in which the payoff
+            is replaced by the given one.
+        */
+        static arguments withPayoff(
+                            const arguments& args,
+                            const boost::shared_ptr<StrikedTypePayoff>& p);
+        //@}
+
+      private:
+        static bool samePayoff(const boost::shared_ptr<Payoff>& p1,
+                               const boost::shared_ptr<Payoff>& p2);
+        static bool sameExercise(const arguments& a1, const arguments& a2);
+        static bool sameDividends(const arguments& a1, const arguments& a2);
+
+        std::vector<std::pair<arguments, results> > cache_;
+    };
+
+}
+
+#endif
@@ -27,6 +27,7 @@
 #define quantlib_montecarlo_european_engine_hpp
 
 #include <ql/pricingengines/vanilla/mcvanillaengine.hpp>
+#include <ql/methods/montecarlo/adjointpathpricer.hpp>
 #include <ql/processes/blackscholesprocess.hpp>
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
 #include <ql/termstructures/volatility/equityfx/blackvariancecurve.hpp>
@@ -36,8 +37,18 @@ namespace QuantLib {
     //! European option pricing engine using Monte Carlo simulation
     /*! \ingroup vanillaengines
 
-        \test the correctness of the returned value is tested by
-              checking it against analytic results.
+        When pathwise greeks are enabled, delta and vega are
+        obtained in the same simulation by sweeping the adjoints of
+        the payoff backwards along each path.
+
+        \test
+        - the correctness of the returned value is tested by
+          checking it against analytic results.
+        - the correctness of the returned pathwise greeks is tested
+          by checking them against analytic results.
+        - the reuse of random numbers across bumped scenarios is
+          tested by checking the resulting greeks against analytic
+          results.
     */
     template <class RNG = PseudoRandom, class S = Statistics>
     class MCEuropeanEngine : public MCVanillaEngine<SingleVariate,RNG,S> {
@@ -60,12 +71,58 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed);
+             BigNatural seed,
+             bool pathwiseGreeks = false,
+             bool commonRandomNumbers = false,
+             Real timeBudget = Null<Real>());
+        void calculate() const;
+      protected:
+        boost::shared_ptr<path_pricer_type> pathPricer() const;
+        bool pathwiseGreeks_;
+        mutable boost::shared_ptr<PathwiseGreeksPathPricer<Path> >
+                                                               greeksPricer_;
+    };
+
+    //! European option engine using single-precision Monte Carlo paths
+    /*! Paths are generated and priced in single precision, while
+        the statistics are accumulated in double precision.  The
+        rounding error on the option value is of the order of
+        \f$ 10^{-7} \f$ relative to the underlying, which is
+        negligible with respect to the simulation error for any
+        practical number of samples.
+
+        \ingroup vanillaengines
+
+        \test the returned value is checked against the one obtained
+              in double precision on the same random numbers.
+    */
+    template <class RNG = PseudoRandom, class S = Statistics>
+    class MCEuropeanFloatEngine
+        : public MCVanillaEngine<SingleVariateFloat,RNG,S> {
+      public:
+        typedef
+        typename MCVanillaEngine<SingleVariateFloat,RNG,S>::path_pricer_type
+            path_pricer_type;
+        MCEuropeanFloatEngine(
+             const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+             Size timeSteps,
+             Size timeStepsPerYear,
+             bool brownianBridge,
+             bool antitheticVariate,
+             Size requiredSamples,
+             Real requiredTolerance,
+             Size maxSamples,
+             BigNatural seed,
+             bool commonRandomNumbers = false,
+             Real timeBudget = Null<Real>());
       protected:
         boost::shared_ptr<path_pricer_type> pathPricer() const;
     };
 
     //! Monte Carlo European engine factory
+    /*! If single precision is required, an MCEuropeanFloatEngine is
+        returned instead of an MCEuropeanEngine.
+    */
     template <class RNG = PseudoRandom, class S = Statistics>
     class MakeMCEuropeanEngine {
       public:
@@ -80,28 +137,47 @@ namespace QuantLib {
         MakeMCEuropeanEngine& withMaxSamples(Size samples);
         MakeMCEuropeanEngine& withSeed(BigNatural seed);
         MakeMCEuropeanEngine& withAntitheticVariate(bool b = true);
+        MakeMCEuropeanEngine& withPathwiseGreeks(bool b = true);
+        MakeMCEuropeanEngine& withCommonRandomNumbers(bool b = true);
+        MakeMCEuropeanEngine& withTimeBudget(Real seconds);
+        MakeMCEuropeanEngine& withSinglePrecision(bool b = true);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
       private:
         boost::shared_ptr<GeneralizedBlackScholesProcess> process_;
-        bool antithetic_;
+        bool antithetic_, pathwiseGreeks_, commonRandomNumbers_;
+        bool singlePrecision_;
         Size steps_, stepsPerYear_, samples_, maxSamples_;
-        Real tolerance_;
+        Real tolerance_, timeBudget_;
         bool brownianBridge_;
         BigNatural seed_;
     };
 
-    class EuropeanPathPricer : public PathPricer<Path> {
+    class EuropeanPathPricer : public AdjointPathPricer<Path> {
       public:
         EuropeanPathPricer(Option::Type type,
                            Real strike,
                            DiscountFactor discount);
         Real operator()(const Path& path) const;
+        Real operator()(const Path& path, Path& adjoint) const;
       private:
         PlainVanillaPayoff payoff_;
         DiscountFactor discount_;
     };
 
+    //! European payoff on paths of the given precision
+    template <class T>
+    class BasicEuropeanPathPricer : public PathPricer<BasicPath<T> > {
+      public:
+        BasicEuropeanPathPricer(Option::Type type,
+                                Real strike,
+                                DiscountFactor discount);
+        Real operator()(const BasicPath<T>& path) const;
+      private:
+        T omega_, strike_;
+        DiscountFactor discount_;
+    };
+
 
     // inline definitions
 
@@ -116,7 +192,10 @@ namespace QuantLib {
              Size requiredSamples,
              Real requiredTolerance,
              Size maxSamples,
-             BigNatural seed)
+             BigNatural seed,
+             bool pathwiseGreeks,
+             bool commonRandomNumbers,
+             Real timeBudget)
     : MCVanillaEngine<SingleVariate,RNG,S>(process,
                                            timeSteps,
                                            timeStepsPerYear,
@@ -126,7 +205,21 @@ namespace QuantLib {
                                            requiredSamples,
                                            requiredTolerance,
                                            maxSamples,
-                                           seed) {}
+                                           seed,
+                                           commonRandomNumbers,
+                                           timeBudget),
+      pathwiseGreeks_(pathwiseGreeks) {}
+
+
+    template <class RNG, class S>
+    inline void MCEuropeanEngine<RNG,S>::calculate() const {
+        MCVanillaEngine<SingleVariate,RNG,S>::calculate();
+        if (pathwiseGreeks_) {
+            std::vector<Real> greeks = greeksPricer_->greeks().mean();
+            this->results_.delta = greeks[0];
+            this->results_.vega = greeks[1];
+        }
+    }
 
 
     template <class RNG, class S>
@@ -144,22 +237,85 @@ namespace QuantLib {
                 this->process_);
         QL_REQUIRE(process, "Black-Scholes process required");
 
-        return boost::shared_ptr<
-                       typename MCEuropeanEngine<RNG,S>::path_pricer_type>(
+        TimeGrid grid = this->timeGrid();
+        boost::shared_ptr<EuropeanPathPricer> pricer(
           new EuropeanPathPricer(
               payoff->optionType(),
               payoff->strike(),
-              process->riskFreeRate()->discount(this->timeGrid().back())));
+              process->riskFreeRate()->discount(grid.back())));
+
+        if (!pathwiseGreeks_)
+            return pricer;
+
+        greeksPricer_ = boost::shared_ptr<PathwiseGreeksPathPricer<Path> >(
+            new PathwiseGreeksPathPricer<Path>(
+                pricer,
+                std::vector<BlackScholesPathAdjoint>(
+                            1, BlackScholesPathAdjoint(process, grid))));
+        return greeksPricer_;
+    }
+
+
+    template <class RNG, class S>
+    inline
+    MCEuropeanFloatEngine<RNG,S>::MCEuropeanFloatEngine(
+             const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+             Size timeSteps,
+             Size timeStepsPerYear,
+             bool brownianBridge,
+             bool antitheticVariate,
+             Size requiredSamples,
+             Real requiredTolerance,
+             Size maxSamples,
+             BigNatural seed,
+             bool commonRandomNumbers,
+             Real timeBudget)
+    : MCVanillaEngine<SingleVariateFloat,RNG,S>(process,
+                                                timeSteps,
+                                                timeStepsPerYear,
+                                                brownianBridge,
+                                                antitheticVariate,
+                                                false,
+                                                requiredSamples,
+                                                requiredTolerance,
+                                                maxSamples,
+                                                seed,
+                                                commonRandomNumbers,
+                                                timeBudget) {}
+
+
+    template <class RNG, class S>
+    inline
+    boost::shared_ptr<typename MCEuropeanFloatEngine<RNG,S>::path_pricer_type>
+    MCEuropeanFloatEngine<RNG,S>::pathPricer() const {
+
+        boost::shared_ptr<PlainVanillaPayoff> payoff =
+            boost::dynamic_pointer_cast<PlainVanillaPayoff>(
+                this->arguments_.payoff);
+        QL_REQUIRE(payoff, "non-plain payoff given");
+
+        boost::shared_ptr<GeneralizedBlackScholesProcess> process =
+            boost::dynamic_pointer_cast<GeneralizedBlackScholesProcess>(
+                this->process_);
+        QL_REQUIRE(process, "Black-Scholes process required");
+
+        return boost::shared_ptr<path_pricer_type>(
+            new BasicEuropeanPathPricer<float>(
+                payoff->optionType(),
+                payoff->strike(),
+                process->riskFreeRate()->discount(this->timeGrid().back())));
     }
 
 
     template <class RNG, class S>
     inline MakeMCEuropeanEngine<RNG,S>::MakeMCEuropeanEngine(
              const boost::shared_ptr<GeneralizedBlackScholesProcess>& process)
-    : process_(process), antithetic_(false),
+    : process_(process), antithetic_(false), pathwiseGreeks_(false),
+      commonRandomNumbers_(false), singlePrecision_(false),
       steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), brownianBridge_(false), seed_(0) {}
+      tolerance_(Null<Real>()), timeBudget_(Null<Real>()),
+      brownianBridge_(false), seed_(0) {}
 
     template <class RNG, class S>
     inline MakeMCEuropeanEngine<RNG,S>&
@@ -180,6 +336,8 @@ namespace QuantLib {
     MakeMCEuropeanEngine<RNG,S>::withSamples(Size samples) {
         QL_REQUIRE(tolerance_ == Null<Real>(),
                    "tolerance already set");
+        QL_REQUIRE(timeBudget_ == Null<Real>(),
+                   "time budget already set");
         samples_ = samples;
         return *this;
     }
@@ -224,6 +382,36 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCEuropeanEngine<RNG,S>&
+    MakeMCEuropeanEngine<RNG,S>::withPathwiseGreeks(bool b) {
+        pathwiseGreeks_ = b;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMCEuropeanEngine<RNG,S>&
+    MakeMCEuropeanEngine<RNG,S>::withCommonRandomNumbers(bool b) {
+        commonRandomNumbers_ = b;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMCEuropeanEngine<RNG,S>&
+    MakeMCEuropeanEngine<RNG,S>::withTimeBudget(Real seconds) {
+        QL_REQUIRE(samples_ == Null<Size>(),
+                   "number of samples already set");
+        timeBudget_ = seconds;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMCEuropeanEngine<RNG,S>&
+    MakeMCEuropeanEngine<RNG,S>::withSinglePrecision(bool b) {
+        singlePrecision_ = b;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCEuropeanEngine<RNG,S>::operator boost::shared_ptr<PricingEngine>()
@@ -232,6 +420,22 @@ namespace QuantLib {
                    "number of steps not given");
         QL_REQUIRE(steps_ == Null<Size>() || stepsPerYear_ == Null<Size>(),
                    "number of steps overspecified");
+        if (singlePrecision_) {
+            QL_REQUIRE(!pathwiseGreeks_,
+                       "pathwise greeks not available "
+                       "in single precision");
+            return boost::shared_ptr<PricingEngine>(new
+                MCEuropeanFloatEngine<RNG,S>(process_,
+                                             steps_,
+                                             stepsPerYear_,
+                                             brownianBridge_,
+                                             antithetic_,
+                                             samples_, tolerance_,
+                                             maxSamples_,
+                                             seed_,
+                                             commonRandomNumbers_,
+                                             timeBudget_));
+        }
         return boost::shared_ptr<PricingEngine>(new
             MCEuropeanEngine<RNG,S>(process_,
                                     steps_,
@@ -240,7 +444,10 @@ namespace QuantLib {
                                     antithetic_,
                                     samples_, tolerance_,
                                     maxSamples_,
-                                    seed_));
+                                    seed_,
+                                    pathwiseGreeks_,
+                                    commonRandomNumbers_,
+                                    timeBudget_));
     }
 
 
@@ -258,6 +465,50 @@ namespace QuantLib {
         return payoff_(path.back()) * discount_;
     }
 
+    inline Real EuropeanPathPricer::operator()(const Path& path,
+                                               Path& adjoint) const {
+        Size n = path.length();
+        QL_REQUIRE(n > 0, "the path cannot be empty");
+        for (Size i=0; i<n-1; ++i)
+            adjoint[i] = 0.0;
+
+        Real underlying = path.back();
+        Real strike = payoff_.strike();
+        switch (payoff_.optionType()) {
+          case Option::Call:
+            adjoint.back() = underlying > strike ? discount_ : 0.0;
+            break;
+          case Option::Put:
+            adjoint.back() = underlying < strike ? -discount_ : 0.0;
+            break;
+          default:
+            QL_FAIL("unknown option type");
+        }
+        return payoff_(underlying) * discount_;
+    }
+
+
+    template <class T>
+    inline BasicEuropeanPathPricer<T>::BasicEuropeanPathPricer(
+                                                 Option::Type type,
+                                                 Real strike,
+                                                 DiscountFactor discount)
+    : omega_(type == Option::Call ? T(1) : T(-1)),
+      strike_(static_cast<T>(strike)), discount_(discount) {
+        QL_REQUIRE(type == Option::Call || type == Option::Put,
+                   "unknown option type");
+        QL_REQUIRE(strike>=0.0,
+                   "strike less than zero not allowed");
+    }
+
+    template <class T>
+    inline Real
+    BasicEuropeanPathPricer<T>::operator()(const BasicPath<T>& path) const {
+        QL_REQUIRE(path.length() > 0, "the path cannot be empty");
+        T payoff = std::max<T>(omega_*(path.back()-strike_), T(0));
+        return payoff * discount_;
+    }
+
 }
 
 
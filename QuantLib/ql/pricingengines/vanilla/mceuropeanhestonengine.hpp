@@ -49,7 +49,9 @@ namespace QuantLib {
                                Size requiredSamples,
                                Real requiredTolerance,
                                Size maxSamples,
-                               BigNatural seed);
+                               BigNatural seed,
+                               bool commonRandomNumbers = false,
+                               Real timeBudget = Null<Real>());
       protected:
         boost::shared_ptr<path_pricer_type> pathPricer() const;
     };
@@ -67,13 +69,15 @@ namespace QuantLib {
         MakeMCEuropeanHestonEngine& withMaxSamples(Size samples);
         MakeMCEuropeanHestonEngine& withSeed(BigNatural seed);
         MakeMCEuropeanHestonEngine& withAntitheticVariate(bool b = true);
+        MakeMCEuropeanHestonEngine& withCommonRandomNumbers(bool b = true);
+        MakeMCEuropeanHestonEngine& withTimeBudget(Real seconds);
         // conversion to pricing engine
         operator boost::shared_ptr<PricingEngine>() const;
       private:
         boost::shared_ptr<HestonProcess> process_;
-        bool antithetic_;
+        bool antithetic_, commonRandomNumbers_;
         Size steps_, stepsPerYear_, samples_, maxSamples_;
-        Real tolerance_;
+        Real tolerance_, timeBudget_;
         BigNatural seed_;
     };
 
@@ -97,11 +101,13 @@ namespace QuantLib {
                 const boost::shared_ptr<HestonProcess>& process,
                 Size timeSteps, Size timeStepsPerYear, bool antitheticVariate,
                 Size requiredSamples, Real requiredTolerance,
-                Size maxSamples, BigNatural seed)
+                Size maxSamples, BigNatural seed, bool commonRandomNumbers,
+                Real timeBudget)
     : MCVanillaEngine<MultiVariate,RNG,S>(process, timeSteps, timeStepsPerYear,
                                           false, antitheticVariate, false,
                                           requiredSamples, requiredTolerance,
-                                          maxSamples, seed) {}
+                                          maxSamples, seed,
+                                          commonRandomNumbers, timeBudget) {}
 
 
     template <class RNG, class S>
@@ -132,10 +138,10 @@ namespace QuantLib {
     template <class RNG, class S>
     inline MakeMCEuropeanHestonEngine<RNG,S>::MakeMCEuropeanHestonEngine(
                               const boost::shared_ptr<HestonProcess>& process)
-    : process_(process), antithetic_(false),
+    : process_(process), antithetic_(false), commonRandomNumbers_(false),
       steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
       samples_(Null<Size>()), maxSamples_(Null<Size>()),
-      tolerance_(Null<Real>()), seed_(0) {}
+      tolerance_(Null<Real>()), timeBudget_(Null<Real>()), seed_(0) {}
 
     template <class RNG, class S>
     inline MakeMCEuropeanHestonEngine<RNG,S>&
@@ -160,6 +166,8 @@ namespace QuantLib {
     MakeMCEuropeanHestonEngine<RNG,S>::withSamples(Size samples) {
         QL_REQUIRE(tolerance_ == Null<Real>(),
                    "tolerance already set");
+        QL_REQUIRE(timeBudget_ == Null<Real>(),
+                   "time budget already set");
         samples_ = samples;
         return *this;
     }
@@ -197,6 +205,22 @@ namespace QuantLib {
         return *this;
     }
 
+    template <class RNG, class S>
+    inline MakeMCEuropeanHestonEngine<RNG,S>&
+    MakeMCEuropeanHestonEngine<RNG,S>::withCommonRandomNumbers(bool b) {
+        commonRandomNumbers_ = b;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMCEuropeanHestonEngine<RNG,S>&
+    MakeMCEuropeanHestonEngine<RNG,S>::withTimeBudget(Real seconds) {
+        QL_REQUIRE(samples_ == Null<Size>(),
+                   "number of samples already set");
+        timeBudget_ = seconds;
+        return *this;
+    }
+
     template <class RNG, class S>
     inline
     MakeMCEuropeanHestonEngine<RNG,S>::
@@ -210,7 +234,9 @@ namespace QuantLib {
                                                    antithetic_,
                                                    samples_, tolerance_,
                                                    maxSamples_,
-                                                   seed_));
+                                                   seed_,
+                                                   commonRandomNumbers_,
+                                                   timeBudget_));
     }
 
 
@@ -31,7 +31,20 @@
 namespace QuantLib {
 
     //! Pricing engine for vanilla options using Monte Carlo simulation
-    /*! \ingroup vanillaengines */
+    /*! When common random numbers are enabled, the random sequences
+        drawn in the first calculation are stored by the engine and
+        reused by the following ones; the re-pricing of bumped
+        scenarios then only repeats path construction and pricing,
+        and the resulting finite-difference greeks are not affected
+        by simulation noise.
+
+        When a time budget (in seconds of wall-clock time) is given,
+        samples are added until it is used up, or until the required
+        tolerance, if any, is reached.  The number of samples used
+        is returned as the "samples" additional result.
+
+        \ingroup vanillaengines
+    */
     template <template <class> class MC, class RNG,
               class S = Statistics, class Inst = VanillaOption>
     class MCVanillaEngine : public Inst::engine,
@@ -40,11 +53,14 @@ namespace QuantLib {
         void calculate() const {
             McSimulation<MC,RNG,S>::calculate(requiredTolerance_,
                                               requiredSamples_,
-                                              maxSamples_);
+                                              maxSamples_,
+                                              timeBudget_);
             this->results_.value = this->mcModel_->sampleAccumulator().mean();
             if (RNG::allowsErrorEstimate)
             this->results_.errorEstimate =
                 this->mcModel_->sampleAccumulator().errorEstimate();
+            this->results_.additionalResults["samples"] =
+                this->mcModel_->sampleAccumulator().samples();
         }
       protected:
         typedef typename McSimulation<MC,RNG,S>::path_generator_type
@@ -65,7 +81,9 @@ namespace QuantLib {
                         Size requiredSamples,
                         Real requiredTolerance,
                         Size maxSamples,
-                        BigNatural seed);
+                        BigNatural seed,
+                        bool commonRandomNumbers = false,
+                        Real timeBudget = Null<Real>());
         // McSimulation implementation
         TimeGrid timeGrid() const;
         boost::shared_ptr<path_generator_type> pathGenerator() const {
@@ -74,6 +92,18 @@ namespace QuantLib {
             TimeGrid grid = this->timeGrid();
             typename RNG::rsg_type generator =
                 RNG::make_sequence_generator(dimensions*(grid.size()-1),seed_);
+            if (commonRandomNumbers_) {
+                if (!sequenceCache_ ||
+                    sequenceCache_->dimension() != generator.dimension())
+                    sequenceCache_ = boost::shared_ptr<
+                        SequenceCache<typename RNG::rsg_type> >(
+                            new SequenceCache<typename RNG::rsg_type>(
+                                                                generator));
+                return boost::shared_ptr<path_generator_type>(
+                       new path_generator_type(process_, grid,
+                                               generator, brownianBridge_,
+                                               sequenceCache_));
+            }
             return boost::shared_ptr<path_generator_type>(
                    new path_generator_type(process_, grid,
                                            generator, brownianBridge_));
@@ -83,9 +113,12 @@ namespace QuantLib {
         boost::shared_ptr<StochasticProcess> process_;
         Size timeSteps_, timeStepsPerYear_;
         Size requiredSamples_, maxSamples_;
-        Real requiredTolerance_;
+        Real requiredTolerance_, timeBudget_;
         bool brownianBridge_;
         BigNatural seed_;
+        bool commonRandomNumbers_;
+        mutable boost::shared_ptr<SequenceCache<typename RNG::rsg_type> >
+                                                              sequenceCache_;
     };
 
 
@@ -102,13 +135,16 @@ namespace QuantLib {
                           Size requiredSamples,
                           Real requiredTolerance,
                           Size maxSamples,
-                          BigNatural seed)
+                          BigNatural seed,
+                          bool commonRandomNumbers,
+                          Real timeBudget)
     : McSimulation<MC,RNG,S>(antitheticVariate, controlVariate),
       process_(process), timeSteps_(timeSteps),
       timeStepsPerYear_(timeStepsPerYear),
       requiredSamples_(requiredSamples), maxSamples_(maxSamples),
-      requiredTolerance_(requiredTolerance),
-      brownianBridge_(brownianBridge), seed_(seed) {
+      requiredTolerance_(requiredTolerance), timeBudget_(timeBudget),
+      brownianBridge_(brownianBridge), seed_(seed),
+      commonRandomNumbers_(commonRandomNumbers) {
         QL_REQUIRE(timeSteps != Null<Size>() ||
                    timeStepsPerYear != Null<Size>(),
                    "no time steps provided");
@@ -0,0 +1,280 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2015 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file mlmceuropeanhestonengine.hpp
+    \brief Multi-level Monte Carlo Heston-model engine for European options
+*/
+
+#ifndef quantlib_mlmc_european_heston_engine_hpp
+#define quantlib_mlmc_european_heston_engine_hpp
+
+#include <ql/pricingengines/vanilla/mceuropeanhestonengine.hpp>
+#include <ql/pricingengines/mlmcsimulation.hpp>
+
+namespace QuantLib {
+
+    //! Multi-level Monte Carlo Heston-model engine for European options
+    /*! The variance reduction achieved by the coupling of levels
+        depends on the discretization used by the process; Euler
+        schemes such as HestonProcess::FullTruncation, whose
+        increments are linear in the Gaussian draws, give the best
+        results.
+
+        \ingroup vanillaengines
+
+        \test the correctness of the returned value is tested by
+              checking it against analytic results.
+    */
+    template <class RNG = PseudoRandom, class S = Statistics>
+    class MLMCEuropeanHestonEngine
+        : public VanillaOption::engine,
+          public MultiLevelMcSimulation<MultiVariate,RNG,S> {
+      public:
+        typedef typename MultiLevelMcSimulation<MultiVariate,RNG,S>::
+                                      path_generator_type path_generator_type;
+        typedef typename MultiLevelMcSimulation<MultiVariate,RNG,S>::
+                                            path_pricer_type path_pricer_type;
+        typedef typename MultiLevelMcSimulation<MultiVariate,RNG,S>::
+                                                        stats_type stats_type;
+        MLMCEuropeanHestonEngine(const boost::shared_ptr<HestonProcess>&,
+                                 Size timeSteps,
+                                 Size timeStepsPerYear,
+                                 Real requiredTolerance,
+                                 Size refinementFactor,
+                                 Size minLevels,
+                                 Size maxLevels,
+                                 Size initialSamples,
+                                 BigNatural seed);
+        void calculate() const {
+            MultiLevelMcSimulation<MultiVariate,RNG,S>::calculate(
+                                                          requiredTolerance_);
+            results_.value = this->mlmcModel_->mean();
+            if (RNG::allowsErrorEstimate)
+            results_.errorEstimate = this->mlmcModel_->errorEstimate();
+        }
+      protected:
+        // MultiLevelMcSimulation implementation
+        TimeGrid timeGrid() const;
+        boost::shared_ptr<path_generator_type> pathGenerator(
+                                                const TimeGrid& fineGrid,
+                                                const TimeGrid& coarseGrid,
+                                                Size level) const {
+            Size dimensions = process_->factors();
+            typename RNG::rsg_type gen =
+                RNG::make_sequence_generator(dimensions*(fineGrid.size()-1),
+                                             seed_ == 0 ? 0 : seed_+level);
+            return boost::shared_ptr<path_generator_type>(
+                   new path_generator_type(process_, fineGrid, coarseGrid,
+                                           gen));
+        }
+        boost::shared_ptr<path_pricer_type> pathPricer(
+                                                const TimeGrid& grid) const;
+        // data members
+        boost::shared_ptr<HestonProcess> process_;
+        Size timeSteps_, timeStepsPerYear_;
+        Real requiredTolerance_;
+        BigNatural seed_;
+    };
+
+
+    //! Multi-level Monte Carlo Heston European engine factory
+    template <class RNG = PseudoRandom, class S = Statistics>
+    class MakeMLMCEuropeanHestonEngine {
+      public:
+        MakeMLMCEuropeanHestonEngine(const boost::shared_ptr<HestonProcess>&);
+        // named parameters
+        MakeMLMCEuropeanHestonEngine& withSteps(Size steps);
+        MakeMLMCEuropeanHestonEngine& withStepsPerYear(Size steps);
+        MakeMLMCEuropeanHestonEngine& withAbsoluteTolerance(Real tolerance);
+        MakeMLMCEuropeanHestonEngine& withRefinementFactor(Size factor);
+        MakeMLMCEuropeanHestonEngine& withMinLevels(Size levels);
+        MakeMLMCEuropeanHestonEngine& withMaxLevels(Size levels);
+        MakeMLMCEuropeanHestonEngine& withInitialSamples(Size samples);
+        MakeMLMCEuropeanHestonEngine& withSeed(BigNatural seed);
+        // conversion to pricing engine
+        operator boost::shared_ptr<PricingEngine>() const;
+      private:
+        boost::shared_ptr<HestonProcess> process_;
+        Size steps_, stepsPerYear_;
+        Size refinementFactor_, minLevels_, maxLevels_, initialSamples_;
+        Real tolerance_;
+        BigNatural seed_;
+    };
+
+
+    // template definitions
+
+    template <class RNG, class S>
+    inline MLMCEuropeanHestonEngine<RNG,S>::MLMCEuropeanHestonEngine(
+                              const boost::shared_ptr<HestonProcess>& process,
+                              Size timeSteps,
+                              Size timeStepsPerYear,
+                              Real requiredTolerance,
+                              Size refinementFactor,
+                              Size minLevels,
+                              Size maxLevels,
+                              Size initialSamples,
+                              BigNatural seed)
+    : MultiLevelMcSimulation<MultiVariate,RNG,S>(refinementFactor,
+                                                 minLevels, maxLevels,
+                                                 initialSamples),
+      process_(process), timeSteps_(timeSteps),
+      timeStepsPerYear_(timeStepsPerYear),
+      requiredTolerance_(requiredTolerance), seed_(seed) {
+        QL_REQUIRE(timeSteps != Null<Size>() ||
+                   timeStepsPerYear != Null<Size>(),
+                   "no time steps provided");
+        QL_REQUIRE(timeSteps == Null<Size>() ||
+                   timeStepsPerYear == Null<Size>(),
+                   "both time steps and time steps per year were provided");
+        QL_REQUIRE(timeSteps != 0,
+                   "timeSteps must be positive, " << timeSteps <<
+                   " not allowed");
+        QL_REQUIRE(timeStepsPerYear != 0,
+                   "timeStepsPerYear must be positive, " << timeStepsPerYear <<
+                   " not allowed");
+        registerWith(process_);
+    }
+
+    template <class RNG, class S>
+    inline TimeGrid MLMCEuropeanHestonEngine<RNG,S>::timeGrid() const {
+        Date lastExerciseDate = arguments_.exercise->lastDate();
+        Time t = process_->time(lastExerciseDate);
+        if (timeSteps_ != Null<Size>()) {
+            return TimeGrid(t, timeSteps_);
+        } else if (timeStepsPerYear_ != Null<Size>()) {
+            Size steps = static_cast<Size>(timeStepsPerYear_*t);
+            return TimeGrid(t, std::max<Size>(steps, 1));
+        } else {
+            QL_FAIL("time steps not specified");
+        }
+    }
+
+    template <class RNG, class S>
+    inline boost::shared_ptr<
+        typename MLMCEuropeanHestonEngine<RNG,S>::path_pricer_type>
+    MLMCEuropeanHestonEngine<RNG,S>::pathPricer(const TimeGrid& grid) const {
+
+        boost::shared_ptr<PlainVanillaPayoff> payoff(
+                  boost::dynamic_pointer_cast<PlainVanillaPayoff>(
+                                                          arguments_.payoff));
+        QL_REQUIRE(payoff, "non-plain payoff given");
+
+        return boost::shared_ptr<path_pricer_type>(
+                   new EuropeanHestonPathPricer(
+                              payoff->optionType(),
+                              payoff->strike(),
+                              process_->riskFreeRate()->discount(grid.back())));
+    }
+
+
+    template <class RNG, class S>
+    inline MakeMLMCEuropeanHestonEngine<RNG,S>::MakeMLMCEuropeanHestonEngine(
+                              const boost::shared_ptr<HestonProcess>& process)
+    : process_(process), steps_(Null<Size>()), stepsPerYear_(Null<Size>()),
+      refinementFactor_(2), minLevels_(3), maxLevels_(10),
+      initialSamples_(1000), tolerance_(Null<Real>()), seed_(0) {}
+
+    template <class RNG, class S>
+    inline MakeMLMCEuropeanHestonEngine<RNG,S>&
+    MakeMLMCEuropeanHestonEngine<RNG,S>::withSteps(Size steps) {
+        QL_REQUIRE(stepsPerYear_ == Null<Size>(),
+                   "number of steps per year already set");
+        steps_ = steps;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCEuropeanHestonEngine<RNG,S>&
+    MakeMLMCEuropeanHestonEngine<RNG,S>::withStepsPerYear(Size steps) {
+        QL_REQUIRE(steps_ == Null<Size>(),
+                   "number of steps already set");
+        stepsPerYear_ = steps;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCEuropeanHestonEngine<RNG,S>&
+    MakeMLMCEuropeanHestonEngine<RNG,S>::withAbsoluteTolerance(
+                                                             Real tolerance) {
+        QL_REQUIRE(RNG::allowsErrorEstimate,
+                   "chosen random generator policy "
+                   "does not allow an error estimate");
+        tolerance_ = tolerance;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCEuropeanHestonEngine<RNG,S>&
+    MakeMLMCEuropeanHestonEngine<RNG,S>::withRefinementFactor(Size factor) {
+        refinementFactor_ = factor;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCEuropeanHestonEngine<RNG,S>&
+    MakeMLMCEuropeanHestonEngine<RNG,S>::withMinLevels(Size levels) {
+        minLevels_ = levels;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCEuropeanHestonEngine<RNG,S>&
+    MakeMLMCEuropeanHestonEngine<RNG,S>::withMaxLevels(Size levels) {
+        maxLevels_ = levels;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCEuropeanHestonEngine<RNG,S>&
+    MakeMLMCEuropeanHestonEngine<RNG,S>::withInitialSamples(Size samples) {
+        initialSamples_ = samples;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline MakeMLMCEuropeanHestonEngine<RNG,S>&
+    MakeMLMCEuropeanHestonEngine<RNG,S>::withSeed(BigNatural seed) {
+        seed_ = seed;
+        return *this;
+    }
+
+    template <class RNG, class S>
+    inline
+    MakeMLMCEuropeanHestonEngine<RNG,S>::
+    operator boost::shared_ptr<PricingEngine>() const {
+        QL_REQUIRE(steps_ != Null<Size>() || stepsPerYear_ != Null<Size>(),
+                   "number of steps not given");
+        QL_REQUIRE(tolerance_ != Null<Real>(), "tolerance not given");
+        return boost::shared_ptr<PricingEngine>(
+                 new MLMCEuropeanHestonEngine<RNG,S>(process_,
+                                                     steps_,
+                                                     stepsPerYear_,
+                                                     tolerance_,
+                                                     refinementFactor_,
+                                                     minLevels_,
+                                                     maxLevels_,
+                                                     initialSamples_,
+                                                     seed_));
+    }
+
+}
+
+
+#endif
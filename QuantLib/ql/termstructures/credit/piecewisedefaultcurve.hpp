@@ -148,6 +148,23 @@ namespace QuantLib {
         const std::vector<Real>& data() const;
         std::vector<std::pair<Date, Real> > nodes() const;
         //@}
+        //! \name Sensitivities
+        //@{
+        /*! returns the derivatives of the curve data with respect to
+            the quotes of the helpers; the (i,j) element is the
+            derivative of data()[i] with respect to the quote of the
+            helper whose latest date is dates()[j+1].  They are
+            obtained from the bootstrap solution without
+            bootstrapping the curve again.
+        */
+        const Matrix& jacobian() const;
+        /*! converts the sensitivities of a value to the curve data
+            into its sensitivities to the quotes of the helpers,
+            ordered as the columns of the jacobian() matrix.
+        */
+        std::vector<Real> quoteSensitivities(
+                          const std::vector<Real>& dataSensitivities) const;
+        //@}
         //! \name Observer interface
         //@{
         void update();
@@ -211,8 +228,23 @@ namespace QuantLib {
         return base_curve::nodes();
     }
 
+    template <class C, class I, template <class> class B>
+    inline const Matrix& PiecewiseDefaultCurve<C,I,B>::jacobian() const {
+        calculate();
+        return bootstrap_.jacobian();
+    }
+
+    template <class C, class I, template <class> class B>
+    inline std::vector<Real> PiecewiseDefaultCurve<C,I,B>::quoteSensitivities(
+                   const std::vector<Real>& dataSensitivities) const {
+        calculate();
+        return bootstrap_.quoteSensitivities(dataSensitivities);
+    }
+
     template <class C, class I, template <class> class B>
     inline void PiecewiseDefaultCurve<C,I,B>::update() {
+        // lets the bootstrap tell whether only the helpers changed
+        bootstrap_.update();
         base_curve::update();
         LazyObject::update();
     }
@@ -0,0 +1,265 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2015 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file globalbootstrap.hpp
+    \brief bootstrapper solving all the pillars of a set of curves at once
+*/
+
+#ifndef quantlib_global_bootstrap_hpp
+#define quantlib_global_bootstrap_hpp
+
+#include <ql/termstructures/bootstraphelper.hpp>
+#include <ql/termstructures/multicurvebootstrap.hpp>
+#include <ql/math/interpolations/linearinterpolation.hpp>
+#include <ql/utilities/dataformatters.hpp>
+
+namespace QuantLib {
+
+    //! Bootstrapper solving all the pillars of a set of curves at once
+    /*! The curves sharing the same MultiCurveBootstrap instance are
+        bootstrapped together, which avoids the nested bootstraps
+        that would otherwise be triggered in a multi-curve setup
+        (e.g., by a forwarding curve whose helpers discount on an
+        overnight-indexed curve) whenever one of the curves changes.
+        If no instance is passed, the curve is solved on its own.
+
+        \code
+        typedef PiecewiseYieldCurve<Discount,LogLinear,GlobalBootstrap>
+                                                                   Curve;
+        boost::shared_ptr<MultiCurveBootstrap> curves(
+                                                 new MultiCurveBootstrap);
+        boost::shared_ptr<Curve> ois(new Curve(..., oisHelpers, ...,
+                                               GlobalBootstrap<Curve>(curves)));
+        boost::shared_ptr<Curve> euribor6m(new Curve(..., swapHelpers, ...,
+                                               GlobalBootstrap<Curve>(curves)));
+        // optional; avoids evaluating null derivatives
+        curves->setDependencies(ois.get(),
+                                std::vector<const TermStructure*>());
+        curves->setDependencies(euribor6m.get(),
+                                std::vector<const TermStructure*>(
+                                                         1, ois.get()));
+        \endcode
+
+        \warning the helpers can't be shared among the curves in a
+                 set, since each of them is linked to its own curve
+                 while solving.  The curves must not be copied after
+                 construction either, since the set stores their
+                 addresses.
+    */
+    template <class Curve>
+    class GlobalBootstrap : public MultiCurveBootstrapContributor {
+        // no class-level typedefs on Curve here: the bootstrap can be
+        // instantiated (e.g., when passed to the constructor of the
+        // curve) before the curve is complete.
+      public:
+        explicit GlobalBootstrap(
+                    const boost::shared_ptr<MultiCurveBootstrap>& curves =
+                                   boost::shared_ptr<MultiCurveBootstrap>());
+        ~GlobalBootstrap();
+        void setup(Curve* ts);
+        void calculate() const;
+        //! all the curves in the set are bootstrapped again
+        void update();
+        const boost::shared_ptr<MultiCurveBootstrap>& curves() const {
+            return curves_;
+        }
+        //! \name MultiCurveBootstrapContributor interface
+        //@{
+        Size initialize(bool validData) const;
+        Real value(Size i) const;
+        void setValue(Size i, Real x) const;
+        void setValues(Array::const_iterator x) const;
+        Real quoteError(Size i) const;
+        bool localInterpolation() const;
+        Real accuracy() const;
+        const TermStructure* curve() const;
+        //@}
+      private:
+        Curve* ts_;
+        boost::shared_ptr<MultiCurveBootstrap> curves_;
+        Size n_;
+        mutable Size firstAliveHelper_, alive_;
+    };
+
+
+    // template definitions
+
+    template <class Curve>
+    GlobalBootstrap<Curve>::GlobalBootstrap(
+                    const boost::shared_ptr<MultiCurveBootstrap>& curves)
+    : ts_(0), curves_(curves), n_(0), firstAliveHelper_(0), alive_(0) {}
+
+    template <class Curve>
+    GlobalBootstrap<Curve>::~GlobalBootstrap() {
+        if (ts_ != 0)
+            curves_->remove(this);
+    }
+
+    template <class Curve>
+    void GlobalBootstrap<Curve>::setup(Curve* ts) {
+
+        ts_ = ts;
+        n_ = ts_->instruments_.size();
+        QL_REQUIRE(n_ > 0, "no bootstrap helpers given")
+        for (Size j=0; j<n_; ++j)
+            ts_->registerWith(ts_->instruments_[j]);
+
+        if (!curves_)
+            curves_ = boost::shared_ptr<MultiCurveBootstrap>(
+                                                 new MultiCurveBootstrap);
+        ts_->registerWith(curves_);
+        curves_->add(this);
+
+        // do not initialize yet: instruments could be invalid here
+        // but valid later when bootstrapping is actually required
+    }
+
+    template <class Curve>
+    void GlobalBootstrap<Curve>::calculate() const {
+        // the data of this curve are set by the set while solving
+        curves_->calculate();
+    }
+
+    template <class Curve>
+    void GlobalBootstrap<Curve>::update() {
+        // the set notifies the other curves in turn
+        curves_->update();
+    }
+
+    template <class Curve>
+    Size GlobalBootstrap<Curve>::initialize(bool validData) const {
+        typedef typename Curve::traits_type Traits;
+        typedef typename Curve::interpolator_type Interpolator;
+
+        // ensure helpers are sorted
+        std::sort(ts_->instruments_.begin(), ts_->instruments_.end(),
+                  detail::BootstrapHelperSorter());
+
+        // skip expired helpers
+        Date firstDate = Traits::initialDate(ts_);
+        QL_REQUIRE(ts_->instruments_[n_-1]->latestDate()>firstDate,
+                   "all instruments expired");
+        firstAliveHelper_ = 0;
+        while (ts_->instruments_[firstAliveHelper_]->latestDate() <= firstDate)
+            ++firstAliveHelper_;
+        alive_ = n_-firstAliveHelper_;
+        QL_REQUIRE(alive_>=Interpolator::requiredPoints-1,
+                   "not enough alive instruments: " << alive_ <<
+                   " provided, " << Interpolator::requiredPoints-1 <<
+                   " required");
+
+        // calculate dates and times, setup helpers
+        std::vector<Date>& dates = ts_->dates_;
+        std::vector<Time>& times = ts_->times_;
+        dates.resize(alive_+1);
+        times.resize(alive_+1);
+        dates[0] = firstDate;
+        times[0] = ts_->timeFromReference(dates[0]);
+        for (Size i=1, j=firstAliveHelper_; j<n_; ++i, ++j) {
+            const boost::shared_ptr<typename Traits::helper>& helper =
+                                                        ts_->instruments_[j];
+            dates[i] = helper->latestDate();
+            times[i] = ts_->timeFromReference(dates[i]);
+            // check for duplicated maturity
+            QL_REQUIRE(dates[i-1]!=dates[i],
+                       "more than one instrument with maturity " << dates[i]);
+            // check for valid quote
+            QL_REQUIRE(helper->quote()->isValid(),
+                       io::ordinal(j+1) << " instrument (maturity: " <<
+                       helper->latestDate() << ") has an invalid quote");
+            // don't try this at home!
+            // This call creates helpers, and removes "const".
+            // There is a significant interaction with observability.
+            helper->setTermStructure(const_cast<Curve*>(ts_));
+        }
+
+        std::vector<Real>& data = ts_->data_;
+        if (!validData || data.size()!=alive_+1) {
+            // guess each pillar by extrapolating the previous ones
+            data = std::vector<Real>(alive_+1, Traits::initialValue(ts_));
+            for (Size i=1; i<=alive_; ++i) {
+                try {
+                    ts_->interpolation_ = ts_->interpolator_.interpolate(
+                            times.begin(), times.begin()+i+1, data.begin());
+                } catch (...) {
+                    // use Linear while the target interpolation
+                    // is not usable yet
+                    ts_->interpolation_ = Linear().interpolate(
+                            times.begin(), times.begin()+i+1, data.begin());
+                }
+                ts_->interpolation_.update();
+                Traits::updateGuess(data,
+                                    Traits::guess(i, ts_, false,
+                                                  firstAliveHelper_),
+                                    i);
+            }
+        }
+        ts_->interpolation_ = ts_->interpolator_.interpolate(times.begin(),
+                                                             times.end(),
+                                                             data.begin());
+        ts_->interpolation_.update();
+
+        return alive_;
+    }
+
+    template <class Curve>
+    Real GlobalBootstrap<Curve>::value(Size i) const {
+        return ts_->data_[i+1];
+    }
+
+    template <class Curve>
+    void GlobalBootstrap<Curve>::setValue(Size i, Real x) const {
+        typedef typename Curve::traits_type Traits;
+        Traits::updateGuess(ts_->data_, x, i+1);
+        ts_->interpolation_.update();
+    }
+
+    template <class Curve>
+    void GlobalBootstrap<Curve>::setValues(Array::const_iterator x) const {
+        typedef typename Curve::traits_type Traits;
+        // the interpolation is updated only after all the values
+        // are set, since intermediate ones might not be valid
+        for (Size i=1; i<=alive_; ++i, ++x)
+            Traits::updateGuess(ts_->data_, *x, i);
+        ts_->interpolation_.update();
+    }
+
+    template <class Curve>
+    Real GlobalBootstrap<Curve>::quoteError(Size i) const {
+        return ts_->instruments_[firstAliveHelper_+i]->quoteError();
+    }
+
+    template <class Curve>
+    bool GlobalBootstrap<Curve>::localInterpolation() const {
+        return !Curve::interpolator_type::global;
+    }
+
+    template <class Curve>
+    Real GlobalBootstrap<Curve>::accuracy() const {
+        return ts_->accuracy_;
+    }
+
+    template <class Curve>
+    const TermStructure* GlobalBootstrap<Curve>::curve() const {
+        return ts_;
+    }
+
+}
+
+#endif
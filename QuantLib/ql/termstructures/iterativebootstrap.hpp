@@ -29,23 +29,81 @@
 #include <ql/termstructures/bootstraphelper.hpp>
 #include <ql/termstructures/bootstraperror.hpp>
 #include <ql/math/interpolations/linearinterpolation.hpp>
+#include <ql/math/matrix.hpp>
 #include <ql/math/solvers1d/finitedifferencenewtonsafe.hpp>
 #include <ql/math/solvers1d/brent.hpp>
 #include <ql/utilities/dataformatters.hpp>
+#include <algorithm>
+#include <functional>
 
 namespace QuantLib {
 
+    namespace detail {
+
+        //! counts the notifications sent by a bootstrap helper
+        template <class Helper>
+        class BootstrapHelperTracker : public Observer {
+          public:
+            explicit BootstrapHelperTracker(
+                                      const boost::shared_ptr<Helper>& helper)
+            : helper_(helper), notifications_(0) {
+                registerWith(helper_);
+            }
+            void update() { ++notifications_; }
+            const boost::shared_ptr<Helper>& helper() const {
+                return helper_;
+            }
+            Size notifications() const { return notifications_; }
+            void reset() { notifications_ = 0; }
+          private:
+            boost::shared_ptr<Helper> helper_;
+            Size notifications_;
+        };
+
+    }
+
     //! Universal piecewise-term-structure boostrapper.
+    /*! If the interpolation is local and the curve forwards its
+        notifications by calling the update() method, the bootstrap
+        keeps track of the helpers that changed since the last
+        calculation; the pillars before the earliest affected one
+        keep their values, and the later ones are solved again
+        starting from their previous values.  Any notification not
+        coming from a helper causes the whole curve to be
+        bootstrapped again.
+
+        The derivatives of the curve data with respect to the helper
+        quotes can be obtained from the solution without
+        bootstrapping the curve again: since the bootstrapped data
+        \f$ x \f$ reprice the helpers, i.e., \f$ q = Q(x) \f$ where
+        \f$ Q \f$ are the implied quotes, they are given by the
+        inverse of the Jacobian \f$ \partial Q / \partial x \f$ (which
+        is lower triangular for local interpolations.)
+    */
     template <class Curve>
     class IterativeBootstrap {
         typedef typename Curve::traits_type Traits;
         typedef typename Curve::interpolator_type Interpolator;
+        typedef detail::BootstrapHelperTracker<typename Traits::helper>
+                                                                   tracker;
       public:
         IterativeBootstrap();
         void setup(Curve* ts);
         void calculate() const;
+        //! to be called by the curve whenever it's notified
+        void update();
+        /*! derivatives of the curve data with respect to the quotes
+            of the alive helpers, sorted by maturity.
+        */
+        const Matrix& jacobian() const;
+        /*! converts sensitivities to the curve data into
+            sensitivities to the quotes of the alive helpers.
+        */
+        std::vector<Real> quoteSensitivities(
+                          const std::vector<Real>& dataSensitivities) const;
       private:
         void initialize() const;
+        Size firstChangedPillar() const;
         Curve* ts_;
         Size n_;
         Brent firstSolver_;
@@ -54,6 +112,9 @@ namespace QuantLib {
         mutable Size firstAliveHelper_, alive_;
         mutable std::vector<Real> previousData_;
         mutable std::vector<boost::shared_ptr<BootstrapError<Curve> > > errors_;
+        mutable std::vector<boost::shared_ptr<tracker> > trackers_;
+        mutable Size notifications_;
+        mutable Matrix jacobian_;
     };
 
 
@@ -61,7 +122,8 @@ namespace QuantLib {
 
     template <class Curve>
     IterativeBootstrap<Curve>::IterativeBootstrap()
-        : ts_(0), initialized_(false), validCurve_(false) {}
+        : ts_(0), initialized_(false), validCurve_(false),
+          notifications_(0) {}
 
     template <class Curve>
     void IterativeBootstrap<Curve>::setup(Curve* ts) {
@@ -69,8 +131,12 @@ namespace QuantLib {
         ts_ = ts;
         n_ = ts_->instruments_.size();
         QL_REQUIRE(n_ > 0, "no bootstrap helpers given")
-        for (Size j=0; j<n_; ++j)
+        trackers_.resize(n_);
+        for (Size j=0; j<n_; ++j) {
             ts_->registerWith(ts_->instruments_[j]);
+            trackers_[j] = boost::shared_ptr<tracker>(
+                                         new tracker(ts_->instruments_[j]));
+        }
 
         // do not initialize yet: instruments could be invalid here
         // but valid later when bootstrapping is actually required
@@ -81,6 +147,13 @@ namespace QuantLib {
         // ensure helpers are sorted
         std::sort(ts_->instruments_.begin(), ts_->instruments_.end(),
                   detail::BootstrapHelperSorter());
+        // and keep the trackers in the same order
+        for (Size j=0; j<n_; ++j) {
+            Size k = j;
+            while (trackers_[k]->helper() != ts_->instruments_[j])
+                ++k;
+            std::swap(trackers_[j], trackers_[k]);
+        }
 
         // skip expired helpers
         Date firstDate = Traits::initialDate(ts_);
@@ -128,6 +201,34 @@ namespace QuantLib {
         initialized_ = true;
     }
 
+    template <class Curve>
+    void IterativeBootstrap<Curve>::update() {
+        ++notifications_;
+    }
+
+    template <class Curve>
+    Size IterativeBootstrap<Curve>::firstChangedPillar() const {
+        Size helperNotifications = 0, firstPillar = alive_+1;
+        for (Size j=0; j<n_; ++j) {
+            if (trackers_[j]->notifications() > 0) {
+                helperNotifications += trackers_[j]->notifications();
+                if (j >= firstAliveHelper_)
+                    firstPillar = std::min(firstPillar,
+                                           j-firstAliveHelper_+1);
+            }
+        }
+
+        // the whole curve is bootstrapped if it's not valid yet, if
+        // the interpolation is global, or if the curve was notified
+        // by something else than the helpers (or didn't tell us)
+        if (!validCurve_ || Interpolator::global
+            || helperNotifications == 0
+            || helperNotifications != notifications_)
+            return 1;
+        else
+            return firstPillar;
+    }
+
     template <class Curve>
     void IterativeBootstrap<Curve>::calculate() const {
 
@@ -139,8 +240,12 @@ namespace QuantLib {
         if (!initialized_ || ts_->moving_)
             initialize();
 
+        // pillars before this one don't need to be solved again
+        Size firstPillar = firstChangedPillar();
+        jacobian_ = Matrix();
+
         // setup helpers
-        for (Size j=firstAliveHelper_; j<n_; ++j) {
+        for (Size j=firstAliveHelper_+firstPillar-1; j<n_; ++j) {
             const boost::shared_ptr<typename Traits::helper>& helper =
                                                         ts_->instruments_[j];
             // check for valid quote
@@ -162,7 +267,7 @@ namespace QuantLib {
         for (Size iteration=0; ; ++iteration) {
             previousData_ = ts_->data_;
 
-            for (Size i=1; i<=alive_; ++i) { // pillar loop
+            for (Size i=firstPillar; i<=alive_; ++i) { // pillar loop
 
                 bool validData = validCurve_ || iteration>0;
 
@@ -230,6 +335,93 @@ namespace QuantLib {
                        ", required accuracy " << accuracy);
         }
         validCurve_ = true;
+
+        // the notifications are forgotten only now; if the bootstrap
+        // fails, the next one still knows which helpers changed
+        for (Size j=0; j<n_; ++j)
+            trackers_[j]->reset();
+        notifications_ = 0;
+    }
+
+    template <class Curve>
+    const Matrix& IterativeBootstrap<Curve>::jacobian() const {
+        QL_REQUIRE(validCurve_, "curve not bootstrapped");
+        if (!jacobian_.empty())
+            return jacobian_;
+
+        // the helpers might have been used by another curve meanwhile
+        for (Size j=firstAliveHelper_; j<n_; ++j)
+            ts_->instruments_[j]->setTermStructure(const_cast<Curve*>(ts_));
+
+        // derivatives of the implied quotes with respect to the
+        // pillar values, by central differences
+        const std::vector<Real>& data = ts_->data_;
+        const Real h = 1.0e-6;
+        const Real x0 = data[0];
+        Real dx0 = 0.0;
+        Matrix dq(alive_, alive_, 0.0);
+        for (Size k=1; k<=alive_; ++k) {
+            const Real x = data[k];
+            // with local interpolations, the earlier helpers don't
+            // depend on the value at this pillar
+            const Size first = Interpolator::global ? 1 : k;
+
+            (*errors_[k])(x+h);
+            const Real x0Up = data[0];
+            for (Size i=first; i<=alive_; ++i)
+                dq[i-1][k-1] = errors_[i]->helper()->impliedQuote();
+
+            (*errors_[k])(x-h);
+            const Real x0Down = data[0];
+            for (Size i=first; i<=alive_; ++i)
+                dq[i-1][k-1] = (dq[i-1][k-1]
+                                - errors_[i]->helper()->impliedQuote())/(2*h);
+
+            (*errors_[k])(x);
+            // some traits move the first value with the first pillar
+            if (k == 1) {
+                dx0 = (x0Up - x0Down)/(2*h);
+                ts_->data_[0] = x0;
+                ts_->interpolation_.update();
+            }
+        }
+
+        Matrix dx(alive_, alive_, 0.0);
+        if (Interpolator::global) {
+            dx = inverse(dq);
+        } else {
+            // forward substitution
+            for (Size j=0; j<alive_; ++j) {
+                for (Size i=j; i<alive_; ++i) {
+                    Real sum = (i == j) ? 1.0 : 0.0;
+                    for (Size k=j; k<i; ++k)
+                        sum -= dq[i][k]*dx[k][j];
+                    dx[i][j] = sum/dq[i][i];
+                }
+            }
+        }
+
+        jacobian_ = Matrix(alive_+1, alive_, 0.0);
+        std::transform(dx.row_begin(0), dx.row_end(0),
+                       jacobian_.row_begin(0),
+                       std::bind1st(std::multiplies<Real>(), dx0));
+        std::copy(dx.begin(), dx.end(), jacobian_.row_begin(1));
+        return jacobian_;
+    }
+
+    template <class Curve>
+    std::vector<Real> IterativeBootstrap<Curve>::quoteSensitivities(
+                   const std::vector<Real>& dataSensitivities) const {
+        const Matrix& j = jacobian();
+        QL_REQUIRE(dataSensitivities.size() == j.rows(),
+                   "wrong number of sensitivities: "
+                   << dataSensitivities.size() << " given, "
+                   << j.rows() << " required");
+        std::vector<Real> result(j.columns(), 0.0);
+        for (Size i=0; i<j.rows(); ++i)
+            for (Size k=0; k<j.columns(); ++k)
+                result[k] += dataSensitivities[i]*j[i][k];
+        return result;
     }
 
 }
@@ -91,6 +91,8 @@ namespace QuantLib {
                        bool forcePositive = true);
         void setup(Curve* ts);
         void calculate() const;
+        //! the whole curve is always bootstrapped again
+        void update() {}
 
       private:
         mutable bool validCurve_;
@@ -0,0 +1,309 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2015 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+#include <ql/termstructures/multicurvebootstrap.hpp>
+#include <ql/math/matrixutilities/qrdecomposition.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace QuantLib {
+
+    namespace {
+
+        // bump of the unknowns for the finite-difference Jacobian
+        const Real bump = 1.0e-7;
+        // reduction of the quote errors below which the Jacobian of
+        // a previous iteration is calculated again
+        const Real contraction = 0.1;
+        const Real minStep = 1.0e-6;
+
+    }
+
+    MultiCurveBootstrap::MultiCurveBootstrap(Size maxIterations)
+    : maxIterations_(maxIterations), validData_(false), iterations_(0) {}
+
+    void MultiCurveBootstrap::add(
+                              const MultiCurveBootstrapContributor* curve) {
+        QL_REQUIRE(curve != 0, "null curve given");
+        if (std::find(curves_.begin(), curves_.end(), curve)
+                                                        == curves_.end()) {
+            curves_.push_back(curve);
+            sizes_.clear();
+            update();
+        }
+    }
+
+    void MultiCurveBootstrap::remove(
+                              const MultiCurveBootstrapContributor* curve) {
+        // called by the curves being destroyed: no notification
+        std::vector<const MultiCurveBootstrapContributor*>::iterator i =
+            std::find(curves_.begin(), curves_.end(), curve);
+        if (i != curves_.end()) {
+            curves_.erase(i);
+            dependencies_.erase(curve->curve());
+            sizes_.clear();
+        }
+    }
+
+    void MultiCurveBootstrap::setDependencies(
+                         const TermStructure* curve,
+                         const std::vector<const TermStructure*>& others) {
+        QL_REQUIRE(curve != 0, "null curve given");
+        dependencies_[curve] = others;
+        sizes_.clear();
+        update();
+    }
+
+    void MultiCurveBootstrap::calculate() const {
+        LazyObject::calculate();
+    }
+
+    Size MultiCurveBootstrap::iterations() const {
+        calculate();
+        return iterations_;
+    }
+
+    void MultiCurveBootstrap::performCalculations() const {
+        try {
+            solve();
+        } catch (...) {
+            validData_ = false;
+            sizes_.clear();
+            // the curves calculated while solving hold invalid data
+            const_cast<MultiCurveBootstrap*>(this)->update();
+            throw;
+        }
+    }
+
+    void MultiCurveBootstrap::solve() const {
+        QL_REQUIRE(!curves_.empty(), "no curves given");
+
+        std::vector<Size> sizes(curves_.size());
+        Real accuracy = QL_MAX_REAL;
+        for (Size c=0; c<curves_.size(); ++c) {
+            sizes[c] = curves_[c]->initialize(validData_);
+            accuracy = std::min(accuracy, curves_[c]->accuracy());
+        }
+        validData_ = false;
+
+        if (sizes != sizes_) {
+            // the pillars changed; derivatives must be calculated anew
+            sizes_ = sizes;
+            locations_.clear();
+            for (Size c=0; c<curves_.size(); ++c)
+                for (Size i=0; i<sizes_[c]; ++i)
+                    locations_.push_back(std::make_pair(c, i));
+            setupBlocks();
+            jacobian_ = Matrix();
+        }
+        Size n = locations_.size();
+
+        Array x(n), errors(n);
+        for (Size k=0; k<n; ++k)
+            x[k] = curves_[locations_[k].first]->value(locations_[k].second);
+        Real error = quoteErrors(errors);
+
+        Array y(n), newErrors(n);
+        bool updated = false;
+        iterations_ = 0;
+        while (error > accuracy) {
+            QL_REQUIRE(iterations_ < maxIterations_,
+                       "convergence not reached after " << iterations_ <<
+                       " iterations; quote error: " << error);
+
+            if (jacobian_.rows() != n) {
+                updateJacobian(x, errors);
+                updated = true;
+            }
+
+            const Array dx = newtonStep(errors);
+            Real newError = tryStep(x, dx, 1.0, y, newErrors);
+
+            if (newError > contraction*error && !updated) {
+                // the Jacobian of a previous iteration is no longer
+                // good enough; calculate it again at the current point
+                setValues(x);
+                jacobian_ = Matrix();
+                continue;
+            }
+
+            for (Real lambda = 0.5; newError >= error; lambda /= 2.0) {
+                QL_REQUIRE(lambda >= minStep,
+                           "unable to reduce the quote errors after " <<
+                           iterations_ << " iterations; quote error: " <<
+                           error);
+                newError = tryStep(x, dx, lambda, y, newErrors);
+            }
+
+            std::swap(x, y);
+            std::swap(errors, newErrors);
+            error = newError;
+            updated = false;
+            ++iterations_;
+        }
+
+        validData_ = true;
+    }
+
+    Real MultiCurveBootstrap::quoteErrors(Array& errors) const {
+        Real error = 0.0;
+        for (Size k=0; k<locations_.size(); ++k) {
+            errors[k] = curves_[locations_[k].first]->quoteError(
+                                                     locations_[k].second);
+            error = std::max(error, std::fabs(errors[k]));
+        }
+        return error;
+    }
+
+    void MultiCurveBootstrap::setValues(const Array& x) const {
+        Array::const_iterator i = x.begin();
+        for (Size c=0; c<curves_.size(); ++c) {
+            curves_[c]->setValues(i);
+            i += sizes_[c];
+        }
+    }
+
+    Real MultiCurveBootstrap::tryStep(const Array& x, const Array& dx,
+                                      Real lambda,
+                                      Array& y, Array& errors) const {
+        for (Size k=0; k<x.size(); ++k)
+            y[k] = x[k] - lambda*dx[k];
+        try {
+            setValues(y);
+            return quoteErrors(errors);
+        } catch (std::exception&) {
+            // e.g., the step led out of the domain of the curve
+            return QL_MAX_REAL;
+        }
+    }
+
+    void MultiCurveBootstrap::updateJacobian(const Array& x,
+                                             const Array& errors) const {
+        Size n = x.size();
+        jacobian_ = Matrix(n, n, 0.0);
+
+        // all the entries are evaluated, except the ones known to be
+        // null because of local interpolation or of the declared
+        // dependencies; the others can't be assumed to stay null,
+        // since they change when the dates or the helpers do
+        for (Size k=0; k<n; ++k) {
+            Size c = locations_[k].first, i = locations_[k].second;
+            curves_[c]->setValue(i, x[k] + bump);
+            bool local = curves_[c]->localInterpolation();
+            for (Size j=0; j<n; ++j) {
+                Size d = locations_[j].first, l = locations_[j].second;
+                if (!depends_[d][c] || (d == c && local && l < i))
+                    continue;
+                Real e = curves_[d]->quoteError(l);
+                jacobian_[j][k] = (e - errors[j])/bump;
+            }
+            curves_[c]->setValue(i, x[k]);
+        }
+    }
+
+
+    void MultiCurveBootstrap::setupBlocks() const {
+        Size m = curves_.size();
+
+        offsets_.resize(m);
+        for (Size c=0, offset=0; c<m; offset+=sizes_[c], ++c)
+            offsets_[c] = offset;
+
+        depends_ = std::vector<std::vector<bool> >(
+                                          m, std::vector<bool>(m, true));
+        for (Size d=0; d<m; ++d) {
+            std::map<const TermStructure*,
+                     std::vector<const TermStructure*> >::const_iterator i =
+                dependencies_.find(curves_[d]->curve());
+            if (i == dependencies_.end())
+                continue;
+            for (Size c=0; c<m; ++c)
+                depends_[d][c] = (c == d) ||
+                    std::find(i->second.begin(), i->second.end(),
+                              curves_[c]->curve()) != i->second.end();
+        }
+
+        // each curve whose dependencies are solved makes a block on
+        // its own; if none is left, the remaining curves depend on
+        // each other and are solved together
+        blocks_.clear();
+        std::vector<bool> solved(m, false);
+        Size left = m;
+        while (left > 0) {
+            std::vector<Size> ready;
+            for (Size d=0; d<m; ++d) {
+                if (solved[d])
+                    continue;
+                bool isReady = true;
+                for (Size c=0; c<m && isReady; ++c)
+                    isReady = c == d || solved[c] || !depends_[d][c];
+                if (isReady)
+                    ready.push_back(d);
+            }
+            if (ready.empty()) {
+                blocks_.push_back(std::vector<Size>());
+                for (Size d=0; d<m; ++d)
+                    if (!solved[d])
+                        blocks_.back().push_back(d);
+                break;
+            }
+            for (Size k=0; k<ready.size(); ++k) {
+                blocks_.push_back(std::vector<Size>(1, ready[k]));
+                solved[ready[k]] = true;
+                --left;
+            }
+        }
+    }
+
+    Disposable<Array>
+    MultiCurveBootstrap::newtonStep(const Array& errors) const {
+        Size n = errors.size();
+        Array dx(n, 0.0);
+
+        // the Jacobian is block-triangular in the order of the
+        // blocks, so that each block is solved after moving the
+        // changes in the previous ones to the right-hand side
+        for (Size b=0; b<blocks_.size(); ++b) {
+            std::vector<Size> rows;
+            for (Size k=0; k<blocks_[b].size(); ++k) {
+                Size c = blocks_[b][k];
+                for (Size i=0; i<sizes_[c]; ++i)
+                    rows.push_back(offsets_[c]+i);
+            }
+            Size m = rows.size();
+
+            Matrix J(m, m);
+            Array rhs(m);
+            for (Size r=0; r<m; ++r) {
+                rhs[r] = errors[rows[r]];
+                for (Size j=0; j<n; ++j)
+                    rhs[r] -= jacobian_[rows[r]][j]*dx[j];
+                for (Size q=0; q<m; ++q)
+                    J[r][q] = jacobian_[rows[r]][rows[q]];
+            }
+
+            const Array y = qrSolve(J, rhs);
+            for (Size r=0; r<m; ++r)
+                dx[rows[r]] = y[r];
+        }
+
+        return dx;
+    }
+
+}
@@ -0,0 +1,141 @@
+/* -*- mode: c++; tab-width: 4; indent-tabs-mode: nil; c-basic-offset: 4 -*- */
+
+/*
+ Copyright (C) 2015 StatPro Italia srl
+
+ This file is part of QuantLib, a free-software/open-source library
+ for financial quantitative analysts and developers - http://quantlib.org/
+
+ QuantLib is free software: you can redistribute it and/or modify it
+ under the terms of the QuantLib license.  You should have received a
+ copy of the license along with this program; if not, please email
+ <quantlib-dev@lists.sf.net>. The license is also available online at
+ <http://quantlib.org/license.shtml>.
+
+ This program is distributed in the hope that it will be useful, but WITHOUT
+ ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+ FOR A PARTICULAR PURPOSE.  See the license for more details.
+*/
+
+/*! \file multicurvebootstrap.hpp
+    \brief simultaneous bootstrap of a set of curves
+*/
+
+#ifndef quantlib_multi_curve_bootstrap_hpp
+#define quantlib_multi_curve_bootstrap_hpp
+
+#include <ql/patterns/lazyobject.hpp>
+#include <ql/math/matrix.hpp>
+#include <ql/math/array.hpp>
+#include <map>
+#include <vector>
+
+namespace QuantLib {
+
+    class TermStructure;
+
+    //! curve taking part in a multi-curve bootstrap
+    /*! The unknowns of the curve are the data at its pillars (the
+        first excluded) and the residuals are the quote errors of
+        its alive helpers, sorted by maturity.
+    */
+    class MultiCurveBootstrapContributor {
+      public:
+        virtual ~MultiCurveBootstrapContributor() {}
+        /*! sets up the curve and its helpers for the bootstrap and
+            returns the number of unknowns.  If the current data
+            can't be used, they are replaced by an initial guess.
+        */
+        virtual Size initialize(bool validData) const = 0;
+        virtual Real value(Size i) const = 0;
+        virtual void setValue(Size i, Real x) const = 0;
+        //! sets all the unknowns at once, starting from the given one
+        virtual void setValues(Array::const_iterator x) const = 0;
+        virtual Real quoteError(Size i) const = 0;
+        /*! whether the i-th quote error is known not to depend on
+            the j-th unknown of the same curve for j > i
+        */
+        virtual bool localInterpolation() const = 0;
+        virtual Real accuracy() const = 0;
+        //! the curve being bootstrapped
+        virtual const TermStructure* curve() const = 0;
+    };
+
+
+    //! simultaneous bootstrap of a set of curves
+    /*! The curves in the set (e.g., an overnight-indexed discount
+        curve and the forwarding curves whose helpers discount on it)
+        are solved together by a Newton method on the quote errors
+        of all their helpers.
+
+        The Jacobian is obtained by finite differences, skipping
+        the entries that local interpolations make null.  By default,
+        the helpers of each curve are assumed to depend on all the
+        curves in the set; when their actual dependencies are
+        declared (e.g., the helpers of the overnight-indexed curve
+        don't depend on the forwarding curves) the blocks of the
+        Jacobian known to be null are not evaluated, and each Newton
+        step is solved one block of curves at a time, in the order
+        of their dependencies.  Curves depending on each other are
+        solved together.  The Jacobian is kept
+        from one calculation to the next and recomputed only when
+        the iterations stop converging fast enough; therefore, after
+        a change in the quotes the curves are usually solved again
+        in a couple of iterations with no further derivatives.
+
+        Any notification received by one of the curves causes all of
+        them to be solved again.
+
+        \ingroup yieldtermstructures
+    */
+    class MultiCurveBootstrap : public LazyObject {
+      public:
+        explicit MultiCurveBootstrap(Size maxIterations = 50);
+        //! \name Curve set
+        //@{
+        void add(const MultiCurveBootstrapContributor* curve);
+        void remove(const MultiCurveBootstrapContributor* curve);
+        /*! declares that the helpers of the given curve depend only
+            on the curve itself and on the given ones; other curves,
+            if any, must not be passed to the helpers.  Curves not
+            belonging to the set are ignored.
+        */
+        void setDependencies(
+                         const TermStructure* curve,
+                         const std::vector<const TermStructure*>& others);
+        //@}
+        //! solves for the curves in the set, if needed
+        void calculate() const;
+        //! iterations performed in the last calculation
+        Size iterations() const;
+      private:
+        void performCalculations() const;
+        void solve() const;
+        Real quoteErrors(Array& errors) const;
+        void setValues(const Array& x) const;
+        Real tryStep(const Array& x, const Array& dx, Real lambda,
+                     Array& y, Array& errors) const;
+        void updateJacobian(const Array& x, const Array& errors) const;
+        void setupBlocks() const;
+        Disposable<Array> newtonStep(const Array& errors) const;
+        std::vector<const MultiCurveBootstrapContributor*> curves_;
+        std::map<const TermStructure*,
+                 std::vector<const TermStructure*> > dependencies_;
+        Size maxIterations_;
+        mutable bool validData_;
+        mutable Size iterations_;
+        mutable std::vector<Size> sizes_;
+        // curve and index in the curve of each unknown
+        mutable std::vector<std::pair<Size,Size> > locations_;
+        // first unknown of each curve
+        mutable std::vector<Size> offsets_;
+        // whether the quote errors of a curve depend on another one
+        mutable std::vector<std::vector<bool> > depends_;
+        // curves solved together, in the order they're solved
+        mutable std::vector<std::vector<Size> > blocks_;
+        mutable Matrix jacobian_;
+    };
+
+}
+
+#endif
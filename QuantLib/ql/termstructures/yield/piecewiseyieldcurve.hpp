@@ -28,6 +28,7 @@
 
 #include <ql/termstructures/iterativebootstrap.hpp>
 #include <ql/termstructures/localbootstrap.hpp>
+#include <ql/termstructures/globalbootstrap.hpp>
 #include <ql/termstructures/yield/bootstraptraits.hpp>
 #include <ql/patterns/lazyobject.hpp>
 
@@ -167,6 +168,23 @@ namespace QuantLib {
         const std::vector<Real>& data() const;
         std::vector<std::pair<Date, Real> > nodes() const;
         //@}
+        //! \name Sensitivities
+        //@{
+        /*! returns the derivatives of the curve data with respect to
+            the quotes of the helpers; the (i,j) element is the
+            derivative of data()[i] with respect to the quote of the
+            helper whose latest date is dates()[j+1].  They are
+            obtained from the bootstrap solution without
+            bootstrapping the curve again.
+        */
+        const Matrix& jacobian() const;
+        /*! converts the sensitivities of a value to the curve data
+            into its sensitivities to the quotes of the helpers,
+            ordered as the columns of the jacobian() matrix.
+        */
+        std::vector<Real> quoteSensitivities(
+                          const std::vector<Real>& dataSensitivities) const;
+        //@}
         //! \name Observer interface
         //@{
         void update();
@@ -226,9 +244,25 @@ namespace QuantLib {
         return base_curve::nodes();
     }
 
+    template <class C, class I, template <class> class B>
+    inline const Matrix& PiecewiseYieldCurve<C,I,B>::jacobian() const {
+        calculate();
+        return bootstrap_.jacobian();
+    }
+
+    template <class C, class I, template <class> class B>
+    inline std::vector<Real> PiecewiseYieldCurve<C,I,B>::quoteSensitivities(
+                   const std::vector<Real>& dataSensitivities) const {
+        calculate();
+        return bootstrap_.quoteSensitivities(dataSensitivities);
+    }
+
     template <class C, class I, template <class> class B>
     inline void PiecewiseYieldCurve<C,I,B>::update() {
 
+        // lets the bootstrap tell whether only the helpers changed
+        bootstrap_.update();
+
         // it dispatches notifications only if (!calculated_ && !frozen_)
         LazyObject::update();
 
@@ -22,12 +22,25 @@
 #include "americanoption.hpp"
 #include "utilities.hpp"
 #include <ql/time/daycounters/actual360.hpp>
+#include <ql/time/daycounters/actual365fixed.hpp>
 #include <ql/instruments/vanillaoption.hpp>
+#include <ql/instruments/dividendvanillaoption.hpp>
 #include <ql/pricingengines/vanilla/baroneadesiwhaleyengine.hpp>
 #include <ql/pricingengines/vanilla/bjerksundstenslandengine.hpp>
 #include <ql/pricingengines/vanilla/juquadraticengine.hpp>
 #include <ql/pricingengines/vanilla/fdamericanengine.hpp>
 #include <ql/pricingengines/vanilla/fdshoutengine.hpp>
+#include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
+#include <ql/pricingengines/vanilla/andersenlakeengine.hpp>
+#include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
+#include <ql/methods/finitedifferences/solvers/fdmbackwardsolver.hpp>
+#include <ql/methods/finitedifferences/operators/fdmblackscholesop.hpp>
+#include <ql/methods/finitedifferences/operators/fdmlinearoplayout.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmblackscholesmesher.hpp>
+#include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
+#include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
+#include <ql/methods/finitedifferences/utilities/fdminnervaluecalculator.hpp>
+#include <ql/math/interpolations/cubicinterpolation.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
 #include <ql/termstructures/volatility/equityfx/blackconstantvol.hpp>
 #include <ql/utilities/dataformatters.hpp>
@@ -68,6 +81,82 @@ namespace {
         Real result;   // expected result
     };
 
+    // counts the time steps taken by the schemes using it
+    class StepCountingOp : public FdmLinearOpComposite {
+      public:
+        explicit StepCountingOp(
+                      const boost::shared_ptr<FdmLinearOpComposite>& op)
+        : op_(op), steps_(0) {}
+        Size steps() const { return steps_; }
+        Size size() const { return op_->size(); }
+        void setTime(Time t1, Time t2) { ++steps_; op_->setTime(t1, t2); }
+        Disposable<Array> apply(const Array& r) const {
+            return op_->apply(r);
+        }
+        Disposable<Array> apply_mixed(const Array& r) const {
+            return op_->apply_mixed(r);
+        }
+        Disposable<Array> apply_direction(Size direction,
+                                          const Array& r) const {
+            return op_->apply_direction(direction, r);
+        }
+        Disposable<Array> solve_splitting(Size direction,
+                                          const Array& r, Real s) const {
+            return op_->solve_splitting(direction, r, s);
+        }
+        Disposable<Array> preconditioner(const Array& r, Real s) const {
+            return op_->preconditioner(r, s);
+        }
+      private:
+        boost::shared_ptr<FdmLinearOpComposite> op_;
+        Size steps_;
+    };
+
+    // value at the spot after rolling back on a 200-point grid;
+    // the number of time steps taken is returned in timeSteps
+    Real fdValue(
+              const boost::shared_ptr<GeneralizedBlackScholesProcess>& process,
+              const boost::shared_ptr<StrikedTypePayoff>& payoff,
+              const boost::shared_ptr<Exercise>& exercise,
+              const DividendSchedule& dividends,
+              Size steps, const FdmSchemeDesc& schemeDesc,
+              Size& timeSteps) {
+
+        const Time maturity = process->time(exercise->lastDate());
+        const boost::shared_ptr<FdmMesher> mesher(
+            new FdmMesherComposite(boost::shared_ptr<Fdm1dMesher>(
+                new FdmBlackScholesMesher(
+                    200, process, maturity, payoff->strike(),
+                    Null<Real>(), Null<Real>(), 0.0001, 1.5,
+                    std::pair<Real, Real>(payoff->strike(), 0.1)))));
+        const boost::shared_ptr<FdmInnerValueCalculator> calculator(
+                                   new FdmLogInnerValue(payoff, mesher, 0));
+        const boost::shared_ptr<FdmStepConditionComposite> conditions =
+            FdmStepConditionComposite::vanillaComposite(
+                dividends, exercise, mesher, calculator,
+                process->riskFreeRate()->referenceDate(),
+                process->riskFreeRate()->dayCounter());
+        const boost::shared_ptr<StepCountingOp> op(new StepCountingOp(
+            boost::shared_ptr<FdmLinearOpComposite>(
+                new FdmBlackScholesOp(mesher, process, payoff->strike()))));
+
+        const boost::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
+        Array x(layout->size()), a(layout->size());
+        for (FdmLinearOpIterator iter = layout->begin();
+             iter != layout->end(); ++iter) {
+            x[iter.index()] = mesher->location(iter, 0);
+            a[iter.index()] = calculator->avgInnerValue(iter, maturity);
+        }
+
+        FdmBackwardSolver(op, FdmBoundaryConditionSet(),
+                          conditions, schemeDesc)
+            .rollback(a, maturity, 0.0, steps, 0);
+        timeSteps = op->steps();
+
+        return MonotonicCubicNaturalSpline(x.begin(), x.end(), a.begin())(
+                                                      std::log(process->x0()));
+    }
+
 }
 
 
@@ -569,6 +658,307 @@ void AmericanOptionTest::testFdShoutGreeks() {
     testFdGreeks<FDShoutEngine<CrankNicolson> >();
 }
 
+void AmericanOptionTest::testFdAdaptiveTimeSteps() {
+    BOOST_TEST_MESSAGE("Testing error-controlled time steps "
+                       "for American options with dividends...");
+
+    SavedSettings backup;
+
+    Date today = Date(28, March, 2004);
+    Settings::instance().evaluationDate() = today;
+    DayCounter dc = Actual360();
+
+    Handle<Quote> spot(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> qTS(flatRate(today, 0.02, dc));
+    Handle<YieldTermStructure> rTS(flatRate(today, 0.05, dc));
+    Handle<BlackVolTermStructure> volTS(flatVol(today, 0.25, dc));
+
+    boost::shared_ptr<BlackScholesMertonProcess> process(
+              new BlackScholesMertonProcess(spot, qTS, rTS, volTS));
+
+    boost::shared_ptr<StrikedTypePayoff> payoff(
+                                  new PlainVanillaPayoff(Option::Put, 100.0));
+    boost::shared_ptr<Exercise> exercise(
+                     new AmericanExercise(today, Date(28, March, 2005)));
+
+    DividendVanillaOption option(payoff, exercise,
+                                 std::vector<Date>(1, Date(28, Sep, 2004)),
+                                 std::vector<Real>(1, 2.0));
+
+    const Size xGrid = 200, dampingSteps = 2;
+
+    option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+        new FdBlackScholesVanillaEngine(process, 2000, xGrid, dampingSteps)));
+    const Real expected = option.NPV();
+
+    // the initial step only sets the refinement near the stopping
+    // times; the steps are then chosen by the error control
+    option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+        new FdBlackScholesVanillaEngine(
+            process, 20, xGrid, dampingSteps,
+            FdmSchemeDesc::Douglas().withTolerance(3e-6))));
+    const Real calculated = option.NPV();
+
+    const Real tolerance = 1e-3;
+    if (std::fabs(calculated - expected) > tolerance) {
+        BOOST_ERROR("failed to reproduce American option price "
+                    "with error-controlled time steps"
+                    << "\n    calculated: " << calculated
+                    << "\n    expected:   " << expected
+                    << "\n    tolerance:  " << tolerance);
+    }
+
+    /* Error-controlled steps must also pay off: the number of steps
+       they take, counting the rejected trials and the three steps of
+       each trial, is compared with uniform stepping at equal error.
+       Step doubling gains most for European exercise, where the
+       extrapolation is of higher order; the early-exercise boundary
+       limits the gain for American options. */
+    DividendSchedule dividends(1, boost::shared_ptr<Dividend>(
+                          new FixedDividend(2.0, Date(28, Sep, 2004))));
+
+    struct {
+        boost::shared_ptr<Exercise> exercise;
+        Real tolerance;
+        Size stepRatio;
+    } cases[] = {
+        { boost::shared_ptr<Exercise>(
+                            new EuropeanExercise(Date(28, March, 2005))),
+          1e-7, 3 },
+        { exercise, 3e-6, 1 }
+    };
+
+    for (Size i=0; i<LENGTH(cases); ++i) {
+        Size steps;
+        const Real reference =
+            fdValue(process, payoff, cases[i].exercise, dividends,
+                    10000, FdmSchemeDesc::Douglas(), steps);
+        const Real adaptive =
+            fdValue(process, payoff, cases[i].exercise, dividends, 20,
+                    FdmSchemeDesc::Douglas().withTolerance(
+                                                      cases[i].tolerance),
+                    steps);
+        const Size uniformSteps = cases[i].stepRatio*steps;
+        Size unused;
+        const Real uniform =
+            fdValue(process, payoff, cases[i].exercise, dividends,
+                    uniformSteps, FdmSchemeDesc::Douglas(), unused);
+
+        const Real adaptiveError = std::fabs(adaptive - reference);
+        const Real uniformError = std::fabs(uniform - reference);
+        if (adaptiveError >= uniformError) {
+            BOOST_ERROR("error-controlled time steps less accurate than "
+                        "uniform ones for "
+                        << exerciseTypeToString(cases[i].exercise)
+                        << " option"
+                        << QL_SCIENTIFIC
+                        << "\n    error-controlled steps: " << steps
+                        << ", error: " << adaptiveError
+                        << "\n    uniform steps:          " << uniformSteps
+                        << ", error: " << uniformError);
+        }
+    }
+}
+
+void AmericanOptionTest::testAndersenLakeValues() {
+    BOOST_TEST_MESSAGE("Testing Andersen-Lake-Offengenden engine "
+                       "for American options...");
+
+    SavedSettings backup;
+
+    /* The reference values were obtained with the same engine using
+       64 collocation points, 128 integration points and 40
+       fixed-point iterations, and are used to check the convergence
+       of the default settings.  Independently, the values are checked
+       below against finite-difference results extrapolated in time. */
+    AmericanOptionData values[] = {
+        //      type, strike,   spot,    q,      r,            t,  vol, value
+      { Option::Put,  100.0, 100.0, 0.00, 0.05,   1.0, 0.20, 6.09037059096 },
+      { Option::Put,  120.0, 100.0, 0.02, 0.05,   3.0, 0.30, 28.1501431504 },
+      { Option::Put,  100.0, 100.0, 0.08, 0.02,   2.0, 0.25, 18.8685568358 },
+      { Option::Call, 100.0, 110.0, 0.07, 0.03,   3.0, 0.20, 14.4434013536 },
+      { Option::Call, 100.0, 100.0, 0.03, 0.07,   3.0, 0.30, 23.3484081657 },
+      { Option::Put,   80.0, 100.0, 0.05, 0.10, 182.0/365, 0.40, 2.57924285696 },
+      { Option::Call, 110.0, 100.0, 0.06, 0.06,  10.0, 0.15, 10.3162753948 },
+      { Option::Put,   40.0,  40.0, 0.00, 0.0488, 30.0/365, 0.30, 1.30165081573 }
+    };
+
+    Date today = Date(4, May, 2015);
+    Settings::instance().evaluationDate() = today;
+    DayCounter dc = Actual365Fixed();
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(0.0));
+    boost::shared_ptr<SimpleQuote> qRate(new SimpleQuote(0.0));
+    boost::shared_ptr<YieldTermStructure> qTS = flatRate(today, qRate, dc);
+    boost::shared_ptr<SimpleQuote> rRate(new SimpleQuote(0.0));
+    boost::shared_ptr<YieldTermStructure> rTS = flatRate(today, rRate, dc);
+    boost::shared_ptr<SimpleQuote> vol(new SimpleQuote(0.0));
+    boost::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, vol, dc);
+
+    boost::shared_ptr<BlackScholesMertonProcess> stochProcess(new
+        BlackScholesMertonProcess(Handle<Quote>(spot),
+                                  Handle<YieldTermStructure>(qTS),
+                                  Handle<YieldTermStructure>(rTS),
+                                  Handle<BlackVolTermStructure>(volTS)));
+    boost::shared_ptr<PricingEngine> engine(
+                                    new AndersenLakeEngine(stochProcess));
+
+    // the time-discretization error of the finite-difference engine
+    // is of first order at the exercise boundary; a Richardson
+    // extrapolation in time leaves an error of a few 1e-5
+    boost::shared_ptr<PricingEngine> fdEngine(
+                     new FdBlackScholesVanillaEngine(stochProcess, 800, 1600));
+    boost::shared_ptr<PricingEngine> coarseFdEngine(
+                     new FdBlackScholesVanillaEngine(stochProcess, 400, 1600));
+
+    Real tolerance = 1.0e-6;
+    Real fdTolerance = 1.0e-4;
+
+    for (Size i=0; i<LENGTH(values); i++) {
+
+        boost::shared_ptr<StrikedTypePayoff> payoff(new
+            PlainVanillaPayoff(values[i].type, values[i].strike));
+        Date exDate = today + Integer(values[i].t*365+0.5);
+        boost::shared_ptr<Exercise> exercise(
+                                         new AmericanExercise(today, exDate));
+
+        spot ->setValue(values[i].s);
+        qRate->setValue(values[i].q);
+        rRate->setValue(values[i].r);
+        vol  ->setValue(values[i].v);
+
+        VanillaOption option(payoff, exercise);
+        option.setPricingEngine(engine);
+
+        Real calculated = option.NPV();
+        Real error = std::fabs(calculated-values[i].result);
+        if (error > tolerance) {
+            REPORT_FAILURE("value", payoff, exercise, values[i].s, values[i].q,
+                           values[i].r, today, values[i].v, values[i].result,
+                           calculated, error, tolerance);
+        }
+
+        option.setPricingEngine(fdEngine);
+        Real fine = option.NPV();
+        option.setPricingEngine(coarseFdEngine);
+        Real coarse = option.NPV();
+        Real expected = 2.0*fine - coarse;
+        error = std::fabs(calculated-expected);
+        if (error > fdTolerance) {
+            REPORT_FAILURE("value against finite differences", payoff,
+                           exercise, values[i].s, values[i].q, values[i].r,
+                           today, values[i].v, expected, calculated,
+                           error, fdTolerance);
+        }
+    }
+
+    // with a non-positive rate, early exercise of puts is never optimal
+    spot ->setValue(100.0);
+    qRate->setValue(0.01);
+    rRate->setValue(-0.005);
+    vol  ->setValue(0.25);
+
+    boost::shared_ptr<StrikedTypePayoff> payoff(
+                                  new PlainVanillaPayoff(Option::Put, 105.0));
+    Date exDate = today + 365;
+
+    VanillaOption american(payoff, boost::shared_ptr<Exercise>(
+                                       new AmericanExercise(today, exDate)));
+    american.setPricingEngine(engine);
+    VanillaOption european(payoff, boost::shared_ptr<Exercise>(
+                                       new EuropeanExercise(exDate)));
+    european.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                  new AnalyticEuropeanEngine(stochProcess)));
+
+    Real calculated = american.NPV();
+    Real expected = european.NPV();
+    if (std::fabs(calculated-expected) > 1.0e-12) {
+        BOOST_ERROR("failed to reproduce European value "
+                    "for non-positive rates"
+                    << QL_FIXED << std::setprecision(10)
+                    << "\n    calculated: " << calculated
+                    << "\n    expected:   " << expected);
+    }
+}
+
+void AmericanOptionTest::testAndersenLakeChain() {
+    BOOST_TEST_MESSAGE("Testing Andersen-Lake-Offengenden engine "
+                       "for chains of American options...");
+
+    SavedSettings backup;
+
+    Date today = Date(4, May, 2015);
+    Settings::instance().evaluationDate() = today;
+    DayCounter dc = Actual365Fixed();
+
+    Handle<Quote> spot(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+    Handle<YieldTermStructure> qTS(flatRate(today, 0.03, dc));
+    Handle<YieldTermStructure> rTS(flatRate(today, 0.06, dc));
+    Handle<BlackVolTermStructure> volTS(flatVol(today, 0.25, dc));
+
+    boost::shared_ptr<BlackScholesMertonProcess> process(
+              new BlackScholesMertonProcess(spot, qTS, rTS, volTS));
+    boost::shared_ptr<AndersenLakeEngine> engine(
+                                          new AndersenLakeEngine(process));
+
+    Date exDate = today + 270;
+    boost::shared_ptr<Exercise> exercise(new AmericanExercise(today, exDate));
+
+    std::vector<Real> strikes;
+    for (Real k=70.0; k<=130.0; k+=5.0)
+        strikes.push_back(k);
+
+    Option::Type types[] = { Option::Put, Option::Call };
+
+    for (Size i=0; i<LENGTH(types); ++i) {
+        std::vector<Real> calculated =
+            engine->values(types[i], strikes, exDate);
+
+        for (Size j=0; j<strikes.size(); ++j) {
+            boost::shared_ptr<StrikedTypePayoff> payoff(
+                                new PlainVanillaPayoff(types[i], strikes[j]));
+            VanillaOption option(payoff, exercise);
+            option.setPricingEngine(engine);
+
+            Real expected = option.NPV();
+            if (std::fabs(calculated[j]-expected) > 1.0e-12) {
+                BOOST_ERROR("failed to reproduce single option value "
+                            "in chain"
+                            << "\n    type:       " << types[i]
+                            << "\n    strike:     " << strikes[j]
+                            << QL_FIXED << std::setprecision(10)
+                            << "\n    calculated: " << calculated[j]
+                            << "\n    expected:   " << expected);
+            }
+        }
+
+        // by smooth pasting, the value must match the exercise value
+        // to second order just outside the exercise region
+        Time t = dc.yearFraction(today, exDate);
+        AndersenLakeCalculator calculator(types[i], 0.06, 0.03, 0.25, t);
+        for (Size j=0; j<strikes.size(); ++j) {
+            Real boundary = calculator.exerciseBoundary(t, strikes[j]);
+            Real s = (types[i] == Option::Put)
+                ? boundary*(1.0+1.0e-4)
+                : boundary*(1.0-1.0e-4);
+            Real exercised = (types[i] == Option::Put)
+                ? strikes[j] - s
+                : s - strikes[j];
+            Real value = calculator.value(s, strikes[j]);
+            if (std::fabs(value - exercised) > 1.0e-5) {
+                BOOST_ERROR("option value close to exercise boundary "
+                            "differs from exercise value"
+                            << "\n    type:       " << types[i]
+                            << "\n    strike:     " << strikes[j]
+                            << QL_FIXED << std::setprecision(10)
+                            << "\n    boundary:   " << boundary
+                            << "\n    spot:       " << s
+                            << "\n    value:      " << value
+                            << "\n    exercise:   " << exercised);
+            }
+        }
+    }
+}
+
 test_suite* AmericanOptionTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("American option tests");
     suite->add(
@@ -583,6 +973,12 @@ test_suite* AmericanOptionTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&AmericanOptionTest::testFdAmericanGreeks));
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(&AmericanOptionTest::testFdShoutGreeks));
+    suite->add(
+        QUANTLIB_TEST_CASE(&AmericanOptionTest::testFdAdaptiveTimeSteps));
+    suite->add(
+        QUANTLIB_TEST_CASE(&AmericanOptionTest::testAndersenLakeValues));
+    suite->add(
+        QUANTLIB_TEST_CASE(&AmericanOptionTest::testAndersenLakeChain));
     return suite;
 }
 
@@ -35,6 +35,9 @@ class AmericanOptionTest {
     static void testFdValues();
     static void testFdAmericanGreeks();
     static void testFdShoutGreeks();
+    static void testFdAdaptiveTimeSteps();
+    static void testAndersenLakeValues();
+    static void testAndersenLakeChain();
     static boost::unit_test_framework::test_suite* suite();
 };
 
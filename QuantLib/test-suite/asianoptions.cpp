@@ -30,6 +30,7 @@
 #include <ql/pricingengines/asian/mc_discr_geom_av_price.hpp>
 #include <ql/pricingengines/asian/mc_discr_arith_av_price.hpp>
 #include <ql/pricingengines/asian/mc_discr_arith_av_strike.hpp>
+#include <ql/pricingengines/asian/mlmc_discr_arith_av_price.hpp>
 #include <ql/pricingengines/asian/fdblackscholesasianengine.hpp>
 #include <ql/experimental/exoticoptions/continuousarithmeticasianlevyengine.hpp>
 #include <ql/experimental/exoticoptions/continuousarithmeticasianvecerengine.hpp>
@@ -688,6 +689,67 @@ void AsianOptionTest::testMCDiscreteArithmeticAveragePrice() {
 }
 
 
+void AsianOptionTest::testMLMCDiscreteArithmeticAveragePrice() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing multi-level Monte Carlo discrete arithmetic average-price Asians...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(90.0));
+    boost::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.06, dc);
+    boost::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.025, dc);
+    boost::shared_ptr<SimpleQuote> vol(new SimpleQuote(0.13));
+    boost::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, vol, dc);
+
+    boost::shared_ptr<BlackScholesMertonProcess> stochProcess(new
+        BlackScholesMertonProcess(Handle<Quote>(spot),
+                                  Handle<YieldTermStructure>(qTS),
+                                  Handle<YieldTermStructure>(rTS),
+                                  Handle<BlackVolTermStructure>(volTS)));
+
+    Average::Type averageType = Average::Arithmetic;
+    Real runningSum = 0.0;
+    Size pastFixings = 0;
+
+    boost::shared_ptr<StrikedTypePayoff> payoff(new
+        PlainVanillaPayoff(Option::Put, 87.0));
+
+    // same fixing schedule as in the Levy data set
+    Size fixings = 12;
+    Time length = 11.0/12.0;
+    std::vector<Date> fixingDates(fixings);
+    for (Size i=0; i<fixings; i++) {
+        Time t = i*length/(fixings-1);
+        fixingDates[i] = today + Integer(t*360+0.5);
+    }
+    boost::shared_ptr<Exercise> exercise(new
+                                    EuropeanExercise(fixingDates.back()));
+
+    DiscreteAveragingAsianOption option(averageType, runningSum,
+                                        pastFixings, fixingDates,
+                                        payoff, exercise);
+
+    Real tolerance = 1.0e-2;
+    option.setPricingEngine(
+        MakeMLMCDiscreteArithmeticAPEngine<PseudoRandom>(stochProcess)
+        .withAbsoluteTolerance(tolerance)
+        .withSeed(42));
+
+    Real calculated = option.NPV();
+    Real expected = 1.6980019214;
+    if (std::fabs(calculated-expected) > 2.0*tolerance) {
+        REPORT_FAILURE("value", averageType, runningSum, pastFixings,
+                       fixingDates, payoff, exercise, spot->value(),
+                       0.06, 0.025, today, vol->value(),
+                       expected, calculated, 2.0*tolerance);
+    }
+}
+
 void AsianOptionTest::testMCDiscreteArithmeticAverageStrike() {
 
     BOOST_TEST_MESSAGE(
@@ -826,6 +888,90 @@ void AsianOptionTest::testMCDiscreteArithmeticAverageStrike() {
 
 }
 
+void AsianOptionTest::testMCDiscreteArithmeticAveragePriceGreeks() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing pathwise greeks of discrete arithmetic average-price Asians...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    boost::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.03, dc);
+    boost::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.06, dc);
+    boost::shared_ptr<SimpleQuote> vol(new SimpleQuote(0.20));
+    boost::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, vol, dc);
+
+    boost::shared_ptr<BlackScholesMertonProcess> stochProcess(new
+        BlackScholesMertonProcess(Handle<Quote>(spot),
+                                  Handle<YieldTermStructure>(qTS),
+                                  Handle<YieldTermStructure>(rTS),
+                                  Handle<BlackVolTermStructure>(volTS)));
+
+    std::vector<Date> fixingDates;
+    for (Size i=1; i<=12; i++)
+        fixingDates.push_back(today + i*30);
+    boost::shared_ptr<Exercise> exercise(new
+                                    EuropeanExercise(fixingDates.back()));
+
+    Average::Type averageType = Average::Arithmetic;
+    Real runningSum = 0.0;
+    Size pastFixings = 0;
+    Option::Type types[] = { Option::Call, Option::Put };
+
+    for (Size k=0; k<LENGTH(types); k++) {
+        boost::shared_ptr<StrikedTypePayoff> payoff(new
+            PlainVanillaPayoff(types[k], 100.0));
+
+        DiscreteAveragingAsianOption option(averageType, runningSum,
+                                            pastFixings, fixingDates,
+                                            payoff, exercise);
+        option.setPricingEngine(
+            MakeMCDiscreteArithmeticAPEngine<PseudoRandom>(stochProcess)
+            .withSamples(20000)
+            .withPathwiseGreeks()
+            .withSeed(42));
+
+        Real calculatedDelta = option.delta();
+        Real calculatedVega = option.vega();
+
+        // bump-and-revalue on the same random numbers
+        Real u = spot->value(), du = 1.0e-4*u;
+        spot->setValue(u+du);
+        Real pPlus = option.NPV();
+        spot->setValue(u-du);
+        Real pMinus = option.NPV();
+        spot->setValue(u);
+        Real expectedDelta = (pPlus-pMinus)/(2*du);
+
+        Volatility v = vol->value(), dv = 1.0e-5;
+        vol->setValue(v+dv);
+        pPlus = option.NPV();
+        vol->setValue(v-dv);
+        pMinus = option.NPV();
+        vol->setValue(v);
+        Real expectedVega = (pPlus-pMinus)/(2*dv);
+
+        Real tolerance = 1.0e-4;
+        if (std::fabs(calculatedDelta-expectedDelta) > tolerance) {
+            REPORT_FAILURE("delta", averageType, runningSum, pastFixings,
+                           fixingDates, payoff, exercise, u,
+                           0.03, 0.06, today, v,
+                           expectedDelta, calculatedDelta, tolerance);
+        }
+        tolerance = 1.0e-2;
+        if (std::fabs(calculatedVega-expectedVega) > tolerance) {
+            REPORT_FAILURE("vega", averageType, runningSum, pastFixings,
+                           fixingDates, payoff, exercise, u,
+                           0.03, 0.06, today, v,
+                           expectedVega, calculatedVega, tolerance);
+        }
+    }
+}
+
 void AsianOptionTest::testAnalyticDiscreteGeometricAveragePriceGreeks() {
 
     BOOST_TEST_MESSAGE("Testing discrete-averaging geometric Asian greeks...");
@@ -1322,6 +1468,10 @@ test_suite* AsianOptionTest::suite() {
         &AsianOptionTest::testMCDiscreteGeometricAveragePrice));
     suite->add(QUANTLIB_TEST_CASE(
         &AsianOptionTest::testMCDiscreteArithmeticAveragePrice));
+    suite->add(QUANTLIB_TEST_CASE(
+        &AsianOptionTest::testMCDiscreteArithmeticAveragePriceGreeks));
+    suite->add(QUANTLIB_TEST_CASE(
+        &AsianOptionTest::testMLMCDiscreteArithmeticAveragePrice));
     suite->add(QUANTLIB_TEST_CASE(
         &AsianOptionTest::testMCDiscreteArithmeticAverageStrike));
     suite->add(QUANTLIB_TEST_CASE(
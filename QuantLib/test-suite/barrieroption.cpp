@@ -34,6 +34,7 @@
 #include <ql/pricingengines/barrier/fdhestonbarrierengine.hpp>
 #include <ql/pricingengines/barrier/fdblackscholesbarrierengine.hpp>
 #include <ql/pricingengines/barrier/mcbarrierengine.hpp>
+#include <ql/pricingengines/barrier/mlmcbarrierengine.hpp>
 #include <ql/pricingengines/blackformula.hpp>
 #include <ql/experimental/barrieroption/perturbativebarrieroptionengine.hpp>
 #include <ql/experimental/barrieroption/doublebarrieroption.hpp>
@@ -1298,6 +1299,89 @@ void BarrierOptionTest::testVannaVolgaDoubleBarrierValues() {
 }
 
 
+void BarrierOptionTest::testMultiLevelMonteCarlo() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing multi-level Monte Carlo barrier engine...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+
+    boost::shared_ptr<SimpleQuote> underlying =
+        boost::make_shared<SimpleQuote>(100.0);
+    boost::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.02, dc);
+    boost::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.05, dc);
+    boost::shared_ptr<BlackVolTermStructure> volTS =
+        flatVol(today, 0.25, dc);
+
+    boost::shared_ptr<BlackScholesMertonProcess> stochProcess =
+        boost::make_shared<BlackScholesMertonProcess>(
+                                      Handle<Quote>(underlying),
+                                      Handle<YieldTermStructure>(qTS),
+                                      Handle<YieldTermStructure>(rTS),
+                                      Handle<BlackVolTermStructure>(volTS));
+
+    boost::shared_ptr<Exercise> exercise =
+        boost::make_shared<EuropeanExercise>(today+360);
+    boost::shared_ptr<StrikedTypePayoff> payoff =
+        boost::make_shared<PlainVanillaPayoff>(Option::Call, 100.0);
+
+    Barrier::Type types[] = { Barrier::DownOut, Barrier::UpIn };
+    Real barriers[] = { 90.0, 120.0 };
+
+    for (Size i=0; i<LENGTH(types); i++) {
+        BarrierOption option(types[i], barriers[i], 0.0, payoff, exercise);
+
+        option.setPricingEngine(
+                  boost::make_shared<AnalyticBarrierEngine>(stochProcess));
+        Real expected = option.NPV();
+
+        Real tolerance = 0.05;
+        boost::shared_ptr<PricingEngine> engine =
+            MakeMLMCBarrierEngine<PseudoRandom>(stochProcess)
+            .withSteps(4)
+            .withAbsoluteTolerance(tolerance)
+            .withSeed(42);
+        option.setPricingEngine(engine);
+        Real calculated = option.NPV();
+        Real error = std::fabs(calculated-expected);
+        if (error > 3.0*tolerance) {
+            REPORT_FAILURE("value", types[i], barriers[i], 0.0, payoff,
+                           exercise, underlying->value(), 0.02, 0.05,
+                           today, 0.25, expected, calculated, error,
+                           3.0*tolerance);
+        }
+
+        // the fine and coarse values of each correction are
+        // coupled, so that their difference is small compared to
+        // the values themselves and shrinks with the step
+        const MultiLevelMonteCarloModel<SingleVariate,PseudoRandom>& model =
+            boost::dynamic_pointer_cast<MLMCBarrierEngine<PseudoRandom> >(
+                                                            engine)->model();
+        Real valueVariance = model.levelAccumulator(0).variance();
+        for (Size l=1; l<model.levels(); ++l) {
+            Real variance = model.levelAccumulator(l).variance();
+            if (variance > 0.1*valueVariance)
+                BOOST_ERROR("level correction not coupled for "
+                            << types[i] << " option:"
+                            << "\n    level 0 variance: " << valueVariance
+                            << "\n    level " << l << " variance: "
+                            << variance);
+            Real coarserVariance = model.levelAccumulator(l-1).variance();
+            if (l > 1 && variance >= coarserVariance)
+                BOOST_ERROR("level variances not decreasing for "
+                            << types[i] << " option:"
+                            << "\n    level " << l-1 << ": "
+                            << coarserVariance
+                            << "\n    level " << l << ": " << variance);
+        }
+    }
+}
+
+
 test_suite* BarrierOptionTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Barrier option tests");
     suite->add(QUANTLIB_TEST_CASE(&BarrierOptionTest::testHaugValues));
@@ -1305,6 +1389,8 @@ test_suite* BarrierOptionTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&BarrierOptionTest::testBeagleholeValues));
     suite->add(QUANTLIB_TEST_CASE(
                         &BarrierOptionTest::testLocalVolAndHestonComparison));
+    suite->add(QUANTLIB_TEST_CASE(
+                               &BarrierOptionTest::testMultiLevelMonteCarlo));
     return suite;
 }
 
@@ -943,6 +943,103 @@ void BasketOptionTest::testOddSamples() {
     }
 }
 
+void BasketOptionTest::testPathwiseGreeks() {
+
+    BOOST_TEST_MESSAGE("Testing pathwise greeks of European basket options...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+
+    boost::shared_ptr<SimpleQuote> spot1(new SimpleQuote(100.0));
+    boost::shared_ptr<SimpleQuote> spot2(new SimpleQuote(95.0));
+    boost::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.02, dc);
+    boost::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.05, dc);
+    boost::shared_ptr<SimpleQuote> vol1(new SimpleQuote(0.30));
+    boost::shared_ptr<SimpleQuote> vol2(new SimpleQuote(0.20));
+
+    boost::shared_ptr<SimpleQuote> spots[] = { spot1, spot2 };
+    boost::shared_ptr<SimpleQuote> vols[] = { vol1, vol2 };
+
+    std::vector<boost::shared_ptr<StochasticProcess1D> > procs;
+    for (Size j=0; j<2; j++)
+        procs.push_back(boost::shared_ptr<StochasticProcess1D>(new
+            BlackScholesMertonProcess(Handle<Quote>(spots[j]),
+                                      Handle<YieldTermStructure>(qTS),
+                                      Handle<YieldTermStructure>(rTS),
+                                      Handle<BlackVolTermStructure>(
+                                                flatVol(today, vols[j], dc)))));
+
+    Matrix correlation(2, 2, 0.5);
+    correlation[0][0] = correlation[1][1] = 1.0;
+    boost::shared_ptr<StochasticProcessArray> process(
+                               new StochasticProcessArray(procs,correlation));
+
+    boost::shared_ptr<PricingEngine> engine =
+        MakeMCEuropeanBasketEngine<PseudoRandom>(process)
+        .withSteps(4)
+        .withSamples(10000)
+        .withPathwiseGreeks()
+        .withSeed(42);
+
+    boost::shared_ptr<Exercise> exercise(new EuropeanExercise(today + 360));
+    boost::shared_ptr<PlainVanillaPayoff> payoff(new
+        PlainVanillaPayoff(Option::Call, 100.0));
+
+    std::vector<boost::shared_ptr<BasketPayoff> > payoffs;
+    payoffs.push_back(basketTypeToPayoff(MinBasket, payoff));
+    payoffs.push_back(basketTypeToPayoff(MaxBasket, payoff));
+    payoffs.push_back(basketTypeToPayoff(SpreadBasket, payoff));
+    payoffs.push_back(boost::shared_ptr<BasketPayoff>(
+                                     new AverageBasketPayoff(payoff, 2)));
+
+    for (Size i=0; i<payoffs.size(); i++) {
+        BasketOption option(payoffs[i], exercise);
+        option.setPricingEngine(engine);
+
+        std::vector<Real> deltas =
+            option.result<std::vector<Real> >("deltas");
+        std::vector<Real> vegas =
+            option.result<std::vector<Real> >("vegas");
+
+        for (Size j=0; j<2; j++) {
+            // bump-and-revalue on the same random numbers
+            Real u = spots[j]->value(), du = 1.0e-4*u;
+            spots[j]->setValue(u+du);
+            Real pPlus = option.NPV();
+            spots[j]->setValue(u-du);
+            Real pMinus = option.NPV();
+            spots[j]->setValue(u);
+            Real expectedDelta = (pPlus-pMinus)/(2*du);
+
+            Volatility v = vols[j]->value(), dv = 1.0e-5;
+            vols[j]->setValue(v+dv);
+            pPlus = option.NPV();
+            vols[j]->setValue(v-dv);
+            pMinus = option.NPV();
+            vols[j]->setValue(v);
+            Real expectedVega = (pPlus-pMinus)/(2*dv);
+
+            Real tolerance = 1.0e-4;
+            if (std::fabs(deltas[j]-expectedDelta) > tolerance)
+                BOOST_ERROR("failed to reproduce delta of asset " << j
+                            << " for " << payoffs[i]->name() << " payoff"
+                            << "\n    calculated: " << deltas[j]
+                            << "\n    expected:   " << expectedDelta
+                            << "\n    tolerance:  " << tolerance);
+            tolerance = 1.0e-2;
+            if (std::fabs(vegas[j]-expectedVega) > tolerance)
+                BOOST_ERROR("failed to reproduce vega of asset " << j
+                            << " for " << payoffs[i]->name() << " payoff"
+                            << "\n    calculated: " << vegas[j]
+                            << "\n    expected:   " << expectedVega
+                            << "\n    tolerance:  " << tolerance);
+        }
+    }
+}
+
 test_suite* BasketOptionTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Basket option tests");
     suite->add(QUANTLIB_TEST_CASE(&BasketOptionTest::testEuroTwoValues));
@@ -952,6 +1049,7 @@ test_suite* BasketOptionTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&BasketOptionTest::testTavellaValues));
     suite->add(QUANTLIB_TEST_CASE(&BasketOptionTest::testOneDAmericanValues));
     suite->add(QUANTLIB_TEST_CASE(&BasketOptionTest::testOddSamples));
+    suite->add(QUANTLIB_TEST_CASE(&BasketOptionTest::testPathwiseGreeks));
 
     return suite;
 }
@@ -23,6 +23,8 @@
 #include <ql/pricingengines/swaption/treeswaptionengine.hpp>
 #include <ql/pricingengines/swap/discountingswapengine.hpp>
 #include <ql/pricingengines/swaption/fdhullwhiteswaptionengine.hpp>
+#include <ql/pricingengines/swaption/discretizedswaption.hpp>
+#include <ql/models/shortrate/shortratetreecache.hpp>
 #include <ql/models/shortrate/onefactormodels/hullwhite.hpp>
 #include <ql/cashflows/coupon.hpp>
 #include <ql/time/daycounters/thirty360.hpp>
@@ -225,9 +227,143 @@ void BermudanSwaptionTest::testCachedValues() {
 }
 
 
+void BermudanSwaptionTest::testTreeCache() {
+
+    BOOST_TEST_MESSAGE("Testing Bermudan swaptions sharing a short-rate tree...");
+
+    CommonVars vars;
+
+    vars.today = Date(15, February, 2002);
+
+    Settings::instance().evaluationDate() = vars.today;
+
+    vars.settlement = Date(19, February, 2002);
+    vars.termStructure.linkTo(flatRate(vars.settlement,
+                                          0.04875825,
+                                          Actual365Fixed()));
+
+    Rate atmRate = vars.makeSwap(0.0)->fairRate();
+
+    Real a = 0.048696, sigma = 0.0058904;
+    boost::shared_ptr<HullWhite> model(new HullWhite(vars.termStructure,
+                                                     a, sigma));
+
+    std::vector<boost::shared_ptr<VanillaSwap> > swaps;
+    for (Real moneyness = 0.8; moneyness < 1.25; moneyness += 0.1)
+        swaps.push_back(vars.makeSwap(moneyness*atmRate));
+
+    std::vector<Date> exerciseDates;
+    const Leg& leg = swaps.front()->fixedLeg();
+    for (Size i=0; i<leg.size(); i++) {
+        boost::shared_ptr<Coupon> coupon =
+            boost::dynamic_pointer_cast<Coupon>(leg[i]);
+        exerciseDates.push_back(coupon->accrualStartDate());
+    }
+    boost::shared_ptr<Exercise> exercise(new BermudanExercise(exerciseDates));
+
+    const Size timeSteps = 50;
+    boost::shared_ptr<ShortRateTreeCache> cache(new ShortRateTreeCache);
+    boost::shared_ptr<PricingEngine> treeEngine(
+                                     new TreeSwaptionEngine(model, timeSteps));
+
+    const Real tolerance = 1.0e-10;
+
+    std::vector<Real> expected(swaps.size());
+    std::vector<boost::shared_ptr<Swaption> > swaptions(swaps.size());
+    for (Size i=0; i<swaps.size(); i++) {
+        swaptions[i] = boost::shared_ptr<Swaption>(
+                                           new Swaption(swaps[i], exercise));
+        swaptions[i]->setPricingEngine(treeEngine);
+        expected[i] = swaptions[i]->NPV();
+
+        boost::shared_ptr<TreeSwaptionEngine> cachedEngine(
+                                     new TreeSwaptionEngine(model, timeSteps));
+        cachedEngine->setTreeCache(cache);
+        swaptions[i]->setPricingEngine(cachedEngine);
+        Real calculated = swaptions[i]->NPV();
+
+        if (std::fabs(calculated-expected[i]) > tolerance)
+            BOOST_ERROR("failed to reproduce swaption value "
+                        "with shared tree:\n"
+                        << std::setprecision(12)
+                        << "    calculated: " << calculated << "\n"
+                        << "    expected:   " << expected[i]);
+    }
+
+    if (cache->size() != 1)
+        BOOST_ERROR("swaptions with the same dates should share one tree:\n"
+                    << "    trees in cache: " << cache->size());
+
+    // roll all the swaptions back together on the shared tree
+    DayCounter dayCounter = vars.termStructure->dayCounter();
+    std::vector<boost::shared_ptr<DiscretizedAsset> > assets(swaps.size());
+    for (Size i=0; i<swaps.size(); i++) {
+        Swaption::arguments arguments;
+        swaptions[i]->setupArguments(&arguments);
+        assets[i] = boost::shared_ptr<DiscretizedAsset>(
+                         new DiscretizedSwaption(arguments,
+                                                 vars.settlement, dayCounter));
+    }
+    DiscretizedPortfolio portfolio(assets);
+
+    std::vector<Time> times = portfolio.mandatoryTimes();
+    boost::shared_ptr<Lattice> lattice =
+        cache->tree(model, TimeGrid(times.begin(), times.end(), timeSteps));
+
+    if (cache->size() != 1)
+        BOOST_ERROR("portfolio should use the cached tree:\n"
+                    << "    trees in cache: " << cache->size());
+
+    Time lastExercise = dayCounter.yearFraction(vars.settlement,
+                                                exerciseDates.back());
+    Time firstExercise = dayCounter.yearFraction(vars.settlement,
+                                                 exerciseDates.front());
+    for (Size i=0; i<assets.size(); i++)
+        assets[i]->initialize(lattice, lastExercise);
+    portfolio.rollback(firstExercise);
+
+    std::vector<Real> values = portfolio.presentValues();
+    for (Size i=0; i<swaps.size(); i++) {
+        if (std::fabs(values[i]-expected[i]) > tolerance)
+            BOOST_ERROR("failed to reproduce swaption value "
+                        "with portfolio rollback:\n"
+                        << std::setprecision(12)
+                        << "    calculated: " << values[i] << "\n"
+                        << "    expected:   " << expected[i]);
+    }
+
+    // a change in the model parameters must invalidate the trees
+    Array params = model->params();
+    params[1] *= 1.1;
+    model->setParams(params);
+
+    if (cache->size() != 0)
+        BOOST_ERROR("trees not discarded after model change:\n"
+                    << "    trees in cache: " << cache->size());
+
+    boost::shared_ptr<TreeSwaptionEngine> cachedEngine(
+                                     new TreeSwaptionEngine(model, timeSteps));
+    cachedEngine->setTreeCache(cache);
+    swaptions[0]->setPricingEngine(cachedEngine);
+    Real calculated = swaptions[0]->NPV();
+    swaptions[0]->setPricingEngine(treeEngine);
+    Real expectedAfterChange = swaptions[0]->NPV();
+
+    if (std::fabs(calculated-expectedAfterChange) > tolerance)
+        BOOST_ERROR("failed to reproduce swaption value "
+                    "with shared tree after model change:\n"
+                    << std::setprecision(12)
+                    << "    calculated: " << calculated << "\n"
+                    << "    expected:   " << expectedAfterChange);
+    if (std::fabs(calculated-expected[0]) < 1.0e-4)
+        BOOST_ERROR("swaption value unchanged after model change");
+}
+
+
 test_suite* BermudanSwaptionTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Bermudan swaption tests");
     suite->add(QUANTLIB_TEST_CASE(&BermudanSwaptionTest::testCachedValues));
+    suite->add(QUANTLIB_TEST_CASE(&BermudanSwaptionTest::testTreeCache));
     return suite;
 }
 
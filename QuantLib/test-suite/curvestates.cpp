@@ -129,6 +129,84 @@ void CurveStatesTest::testLMMCurveState() {
     BOOST_TEST_MESSAGE("Testing Libor-market-model curve state...");
 
     CommonVars vars;
+
+    Size N = vars.todaysForwards.size();
+    Real tolerance = 1.0e-12;
+
+    LMMCurveState cs(vars.rateTimes);
+    cs.setOnForwardRates(vars.todaysForwards);
+
+    for (Size i=0; i<N; ++i) {
+        Real expected = vars.todaysDiscounts[i]/vars.todaysDiscounts[N];
+        Real calculated = cs.discountRatio(i, N);
+        if (std::fabs(calculated-expected) > tolerance)
+            BOOST_ERROR("failed to reproduce discount ratio " << i
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << expected);
+        expected = vars.todaysCoterminalSwapRates[i];
+        calculated = cs.coterminalSwapRate(i);
+        if (std::fabs(calculated-expected) > tolerance)
+            BOOST_ERROR("failed to reproduce coterminal swap rate " << i
+                        << "\n    calculated: " << io::rate(calculated)
+                        << "\n    expected:   " << io::rate(expected));
+        expected = vars.coterminalAnnuity[i]/vars.todaysDiscounts[N];
+        calculated = cs.coterminalSwapAnnuity(N, i);
+        if (std::fabs(calculated-expected) > tolerance)
+            BOOST_ERROR("failed to reproduce coterminal annuity " << i
+                        << "\n    calculated: " << calculated
+                        << "\n    expected:   " << expected);
+        expected = vars.todaysForwards[i];
+        calculated = cs.cmSwapRate(i, 1);
+        if (std::fabs(calculated-expected) > tolerance)
+            BOOST_ERROR("failed to reproduce one-period swap rate " << i
+                        << "\n    calculated: " << io::rate(calculated)
+                        << "\n    expected:   " << io::rate(expected));
+    }
+
+    // the state is updated on a few changed rates (and later on a
+    // shorter curve) and compared with one built from scratch
+    std::vector<Rate> forwards = vars.todaysForwards;
+    forwards[3] += 0.0010;
+    forwards[N-4] -= 0.0020;
+
+    for (Size first=0; first<4; first+=3) {
+        cs.setOnForwardRates(forwards, first);
+        LMMCurveState fresh(vars.rateTimes);
+        fresh.setOnForwardRates(forwards, first);
+
+        const std::vector<Rate>& cmRates = cs.cmSwapRates(2);
+        const std::vector<Rate>& freshCmRates = fresh.cmSwapRates(2);
+        for (Size i=first; i<N; ++i) {
+            Real calculated = cs.discountRatio(i, first),
+                 expected = fresh.discountRatio(i, first);
+            if (std::fabs(calculated-expected) > tolerance)
+                BOOST_ERROR("updated discount ratio " << i
+                            << " different from fresh one"
+                            << "\n    updated: " << calculated
+                            << "\n    fresh:   " << expected);
+            calculated = cs.coterminalSwapAnnuity(first, i);
+            expected = fresh.coterminalSwapAnnuity(first, i);
+            if (std::fabs(calculated-expected) > tolerance)
+                BOOST_ERROR("updated coterminal annuity " << i
+                            << " different from fresh one"
+                            << "\n    updated: " << calculated
+                            << "\n    fresh:   " << expected);
+            calculated = cs.coterminalSwapRate(i);
+            expected = fresh.coterminalSwapRates()[i];
+            if (std::fabs(calculated-expected) > tolerance)
+                BOOST_ERROR("updated coterminal swap rate " << i
+                            << " different from fresh one"
+                            << "\n    updated: " << io::rate(calculated)
+                            << "\n    fresh:   " << io::rate(expected));
+            if (std::fabs(cmRates[i]-freshCmRates[i]) > tolerance)
+                BOOST_ERROR("updated cm swap rate " << i
+                            << " different from fresh one"
+                            << "\n    updated: " << io::rate(cmRates[i])
+                            << "\n    fresh:   " << io::rate(freshCmRates[i]));
+        }
+
+        forwards[N-1] += 0.0005;
+    }
 }
 
 void CurveStatesTest::testCoterminalSwapCurveState() {
@@ -136,6 +214,86 @@ void CurveStatesTest::testCoterminalSwapCurveState() {
     BOOST_TEST_MESSAGE("Testing coterminal-swap-market-model curve state...");
 
     CommonVars vars;
+
+    Size N = vars.todaysForwards.size();
+    Real tolerance = 1.0e-12;
+
+    CoterminalSwapCurveState cs(vars.rateTimes);
+    cs.setOnCoterminalSwapRates(vars.todaysCoterminalSwapRates);
+
+    for (Size i=0; i<N; ++i) {
+        Real expected = vars.todaysForwards[i];
+        Real calculated = cs.forwardRate(i);
+        if (std::fabs(calculated-expected) > tolerance)
+            BOOST_ERROR("failed to reproduce forward rate " << i
+                        << "\n    calculated: " << io::rate(calculated)
+                        << "\n    expected:   " << io::rate(expected));
+        calculated = cs.forwardRates()[i];
+        if (std::fabs(calculated-expected) > tolerance)
+            BOOST_ERROR("failed to reproduce forward rate " << i
+                        << " from the whole vector"
+                        << "\n    calculated: " << io::rate(calculated)
+                        << "\n    expected:   " << io::rate(expected));
+    }
+
+    // the state is updated on a single changed rate and compared with
+    // one built from scratch
+    std::vector<Rate> swapRates = vars.todaysCoterminalSwapRates;
+    swapRates[N/2] += 0.0010;
+    cs.setOnCoterminalSwapRates(swapRates);
+    CoterminalSwapCurveState fresh(vars.rateTimes);
+    fresh.setOnCoterminalSwapRates(swapRates);
+
+    for (Size i=0; i<N; ++i) {
+        Real calculated = cs.discountRatio(i, N),
+             expected = fresh.discountRatio(i, N);
+        if (std::fabs(calculated-expected) > tolerance)
+            BOOST_ERROR("updated discount ratio " << i
+                        << " different from fresh one"
+                        << "\n    updated: " << calculated
+                        << "\n    fresh:   " << expected);
+        calculated = cs.forwardRate(i);
+        expected = fresh.forwardRates()[i];
+        if (std::fabs(calculated-expected) > tolerance)
+            BOOST_ERROR("updated forward rate " << i
+                        << " different from fresh one"
+                        << "\n    updated: " << io::rate(calculated)
+                        << "\n    fresh:   " << io::rate(expected));
+        calculated = cs.cmSwapRate(i, 2);
+        expected = fresh.cmSwapRate(i, 2);
+        if (std::fabs(calculated-expected) > tolerance)
+            BOOST_ERROR("updated cm swap rate " << i
+                        << " different from fresh one"
+                        << "\n    updated: " << io::rate(calculated)
+                        << "\n    fresh:   " << io::rate(expected));
+    }
+
+    // the state is then updated on a shorter curve, and set back on
+    // the whole one with only the rates before the shorter one changed
+    swapRates[N-2] += 0.0010;
+    cs.setOnCoterminalSwapRates(swapRates, 4);
+    swapRates[1] -= 0.0010;
+    cs.setOnCoterminalSwapRates(swapRates);
+    fresh.setOnCoterminalSwapRates(swapRates);
+
+    for (Size i=0; i<N; ++i) {
+        Real calculated = cs.discountRatio(i, N),
+             expected = fresh.discountRatio(i, N);
+        if (std::fabs(calculated-expected) > tolerance)
+            BOOST_ERROR("discount ratio " << i
+                        << " updated after a shorter curve"
+                        << " different from fresh one"
+                        << "\n    updated: " << calculated
+                        << "\n    fresh:   " << expected);
+        calculated = cs.coterminalSwapAnnuity(N, i);
+        expected = fresh.coterminalSwapAnnuity(N, i);
+        if (std::fabs(calculated-expected) > tolerance)
+            BOOST_ERROR("coterminal annuity " << i
+                        << " updated after a shorter curve"
+                        << " different from fresh one"
+                        << "\n    updated: " << calculated
+                        << "\n    fresh:   " << expected);
+    }
 }
 
 
@@ -203,8 +361,8 @@ void CurveStatesTest::testCMSwapCurveState() {
 // --- Call the desired tests
 test_suite* CurveStatesTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Curve States tests");
-    //suite->add(QUANTLIB_TEST_CASE(&CurveStatesTest::testLMMCurveState));
-    //suite->add(QUANTLIB_TEST_CASE(&CurveStatesTest::testCoterminalSwapCurveState));
+    suite->add(QUANTLIB_TEST_CASE(&CurveStatesTest::testLMMCurveState));
+    suite->add(QUANTLIB_TEST_CASE(&CurveStatesTest::testCoterminalSwapCurveState));
     suite->add(QUANTLIB_TEST_CASE(&CurveStatesTest::testCMSwapCurveState));
     return suite;
 }
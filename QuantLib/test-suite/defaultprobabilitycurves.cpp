@@ -386,6 +386,103 @@ void DefaultProbabilityCurveTest::testUpfrontBootstrap() {
         BOOST_ERROR("Cash-flow settings improperly modified");
 }
 
+void DefaultProbabilityCurveTest::testIncrementalBootstrap() {
+    BOOST_TEST_MESSAGE("Testing incremental default-curve bootstrap...");
+
+    Calendar calendar = TARGET();
+
+    Date today = Settings::instance().evaluationDate();
+
+    Integer settlementDays = 1;
+
+    Real spreads[] = { 0.005, 0.006, 0.008, 0.009, 0.010, 0.011 };
+    Integer years[] = { 1, 2, 3, 5, 7, 10 };
+
+    Frequency frequency = Quarterly;
+    BusinessDayConvention convention = Following;
+    DateGeneration::Rule rule = DateGeneration::TwentiethIMM;
+    DayCounter dayCounter = Actual360();
+    Real recoveryRate = 0.4;
+
+    RelinkableHandle<YieldTermStructure> discountCurve;
+    discountCurve.linkTo(boost::shared_ptr<YieldTermStructure>(
+                                    new FlatForward(today,0.06,Actual360())));
+
+    std::vector<boost::shared_ptr<SimpleQuote> > quotes;
+    std::vector<boost::shared_ptr<DefaultProbabilityHelper> > helpers;
+    for (Size i=0; i<LENGTH(spreads); i++) {
+        quotes.push_back(boost::shared_ptr<SimpleQuote>(
+                                               new SimpleQuote(spreads[i])));
+        helpers.push_back(boost::shared_ptr<DefaultProbabilityHelper>(
+                new SpreadCdsHelper(Handle<Quote>(quotes[i]),
+                                    Period(years[i], Years),
+                                    settlementDays, calendar,
+                                    frequency, convention, rule,
+                                    dayCounter, recoveryRate,
+                                    discountCurve)));
+    }
+
+    PiecewiseDefaultCurve<HazardRate,BackwardFlat> curve(today, helpers,
+                                                         dayCounter);
+    std::vector<Real> previous = curve.data();
+
+    Real tolerance = 1.0e-10;
+
+    Size changed[] = { 4, 1, 5 };
+    for (Size k=0; k<LENGTH(changed); ++k) {
+        Size j = changed[k];
+        quotes[j]->setValue(quotes[j]->value() + 0.001);
+        std::vector<Real> incremental = curve.data();
+
+        // earlier pillars are not solved again...
+        for (Size i=0; i<=j; ++i) {
+            if (incremental[i] != previous[i])
+                BOOST_ERROR("pillar " << i << " changed after change of "
+                            << io::ordinal(j+1) << " quote"
+                            << std::setprecision(16)
+                            << "\n    before: " << previous[i]
+                            << "\n    after:  " << incremental[i]);
+        }
+
+        // ...and the later ones match a full bootstrap
+        curve.recalculate();
+        std::vector<Real> full = curve.data();
+        for (Size i=j+1; i<full.size(); ++i) {
+            if (std::fabs(incremental[i] - full[i]) > tolerance)
+                BOOST_ERROR("pillar " << i << " after change of "
+                            << io::ordinal(j+1) << " quote "
+                            << "differs from full bootstrap"
+                            << std::setprecision(16)
+                            << "\n    incremental: " << incremental[i]
+                            << "\n    full:        " << full[i]);
+        }
+        previous = full;
+    }
+
+    // an invalid quote makes the calculation fail; the helpers
+    // changed meanwhile are still taken into account afterwards
+    quotes[0]->setValue(quotes[0]->value() + 0.001);
+    quotes[3]->setValue(Null<Real>());
+    try {
+        curve.data();
+        BOOST_ERROR("invalid quote was not detected");
+    } catch (Error&) {
+        // as expected
+    }
+    quotes[3]->setValue(spreads[3]);
+    std::vector<Real> calculated = curve.data();
+    curve.recalculate();
+    std::vector<Real> expected = curve.data();
+    for (Size i=1; i<expected.size(); ++i) {
+        if (std::fabs(calculated[i] - expected[i]) > tolerance)
+            BOOST_ERROR("pillar " << i << " after invalid quote "
+                        << "differs from full bootstrap"
+                        << std::setprecision(16)
+                        << "\n    calculated: " << calculated[i]
+                        << "\n    expected:   " << expected[i]);
+    }
+}
+
 
 test_suite* DefaultProbabilityCurveTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Default-probability curve tests");
@@ -405,5 +502,7 @@ test_suite* DefaultProbabilityCurveTest::suite() {
                 &DefaultProbabilityCurveTest::testSingleInstrumentBootstrap));
     suite->add(QUANTLIB_TEST_CASE(
                          &DefaultProbabilityCurveTest::testUpfrontBootstrap));
+    suite->add(QUANTLIB_TEST_CASE(
+                     &DefaultProbabilityCurveTest::testIncrementalBootstrap));
     return suite;
 }
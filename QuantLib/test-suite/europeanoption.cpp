@@ -24,6 +24,7 @@
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/daycounters/actual360.hpp>
 #include <ql/instruments/europeanoption.hpp>
+#include <ql/instruments/dividendvanillaoption.hpp>
 #include <ql/math/randomnumbers/rngtraits.hpp>
 #include <ql/math/interpolations/bicubicsplineinterpolation.hpp>
 #include <ql/math/interpolations/bilinearinterpolation.hpp>
@@ -1280,6 +1281,295 @@ void EuropeanOptionTest::testFFTEngines() {
     testEngineConsistency(engine,steps,samples,relativeTol);
 }
 
+void EuropeanOptionTest::testMcPathwiseGreeks() {
+
+    BOOST_TEST_MESSAGE("Testing Monte Carlo pathwise greeks "
+                       "against analytic results...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    boost::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.02, dc);
+    boost::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.05, dc);
+    boost::shared_ptr<BlackVolTermStructure> volTS =
+                                                  flatVol(today, 0.25, dc);
+    boost::shared_ptr<GeneralizedBlackScholesProcess> process =
+                                          makeProcess(spot, qTS, rTS, volTS);
+
+    Option::Type types[] = { Option::Call, Option::Put };
+    Real strikes[] = { 80.0, 100.0, 120.0 };
+
+    boost::shared_ptr<Exercise> exercise(
+                                     new EuropeanExercise(today + 360));
+
+    for (Size i=0; i<LENGTH(types); i++) {
+        for (Size j=0; j<LENGTH(strikes); j++) {
+            boost::shared_ptr<StrikedTypePayoff> payoff(
+                               new PlainVanillaPayoff(types[i], strikes[j]));
+            EuropeanOption option(payoff, exercise);
+
+            option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                        new AnalyticEuropeanEngine(process)));
+            Real expectedDelta = option.delta();
+            Real expectedVega = option.vega();
+
+            option.setPricingEngine(
+                MakeMCEuropeanEngine<PseudoRandom>(process)
+                .withSteps(4)
+                .withSamples(50000)
+                .withAntitheticVariate()
+                .withPathwiseGreeks()
+                .withSeed(42));
+            Real calculatedDelta = option.delta();
+            Real calculatedVega = option.vega();
+
+            Real tolerance = 5.0e-3;
+            Real error = std::fabs(calculatedDelta-expectedDelta);
+            if (error > tolerance) {
+                REPORT_FAILURE("delta", payoff, exercise, spot->value(),
+                               0.02, 0.05, today, 0.25,
+                               expectedDelta, calculatedDelta,
+                               error, tolerance);
+            }
+            tolerance = 0.5;
+            error = std::fabs(calculatedVega-expectedVega);
+            if (error > tolerance) {
+                REPORT_FAILURE("vega", payoff, exercise, spot->value(),
+                               0.02, 0.05, today, 0.25,
+                               expectedVega, calculatedVega,
+                               error, tolerance);
+            }
+        }
+    }
+}
+
+
+void EuropeanOptionTest::testMcCommonRandomNumbers() {
+
+    BOOST_TEST_MESSAGE("Testing Monte Carlo bump-and-revalue greeks "
+                       "on common random numbers...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    boost::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.02, dc);
+    boost::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.05, dc);
+    boost::shared_ptr<SimpleQuote> vol(new SimpleQuote(0.25));
+    boost::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, vol, dc);
+    boost::shared_ptr<GeneralizedBlackScholesProcess> process =
+                                          makeProcess(spot, qTS, rTS, volTS);
+
+    boost::shared_ptr<StrikedTypePayoff> payoff(
+                                new PlainVanillaPayoff(Option::Call, 100.0));
+    boost::shared_ptr<Exercise> exercise(
+                                     new EuropeanExercise(today + 360));
+    EuropeanOption option(payoff, exercise);
+
+    option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                        new AnalyticEuropeanEngine(process)));
+    Real expectedDelta = option.delta();
+    Real expectedVega = option.vega();
+
+    // no seed is given: without common random numbers, each
+    // calculation would use different draws
+    option.setPricingEngine(
+        MakeMCEuropeanEngine<PseudoRandom>(process)
+        .withSteps(4)
+        .withSamples(50000)
+        .withCommonRandomNumbers());
+
+    Real npv = option.NPV();
+    option.recalculate();
+    Real replayed = option.NPV();
+    if (replayed != npv) {
+        BOOST_ERROR("failed to replay cached random numbers"
+                    << "\n    first run:  " << npv
+                    << "\n    second run: " << replayed);
+    }
+
+    Real u = spot->value(), du = 1.0e-4*u;
+    spot->setValue(u+du);
+    Real pPlus = option.NPV();
+    spot->setValue(u-du);
+    Real pMinus = option.NPV();
+    spot->setValue(u);
+    Real calculatedDelta = (pPlus-pMinus)/(2*du);
+
+    Volatility v = vol->value(), dv = 1.0e-4;
+    vol->setValue(v+dv);
+    pPlus = option.NPV();
+    vol->setValue(v-dv);
+    pMinus = option.NPV();
+    vol->setValue(v);
+    Real calculatedVega = (pPlus-pMinus)/(2*dv);
+
+    Real tolerance = 1.0e-2;
+    Real error = std::fabs(calculatedDelta-expectedDelta);
+    if (error > tolerance) {
+        REPORT_FAILURE("delta", payoff, exercise, u,
+                       0.02, 0.05, today, v,
+                       expectedDelta, calculatedDelta,
+                       error, tolerance);
+    }
+    tolerance = 1.0;
+    error = std::fabs(calculatedVega-expectedVega);
+    if (error > tolerance) {
+        REPORT_FAILURE("vega", payoff, exercise, u,
+                       0.02, 0.05, today, v,
+                       expectedVega, calculatedVega,
+                       error, tolerance);
+    }
+}
+
+
+void EuropeanOptionTest::testMcTimeBudget() {
+
+    BOOST_TEST_MESSAGE("Testing time-budgeted Monte Carlo engine...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    boost::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.02, dc);
+    boost::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.05, dc);
+    boost::shared_ptr<SimpleQuote> vol(new SimpleQuote(0.25));
+    boost::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, vol, dc);
+    boost::shared_ptr<GeneralizedBlackScholesProcess> process =
+                                          makeProcess(spot, qTS, rTS, volTS);
+
+    boost::shared_ptr<StrikedTypePayoff> payoff(
+                                new PlainVanillaPayoff(Option::Put, 100.0));
+    boost::shared_ptr<Exercise> exercise(
+                                     new EuropeanExercise(today + 360));
+    EuropeanOption option(payoff, exercise);
+
+    option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                        new AnalyticEuropeanEngine(process)));
+    Real expected = option.NPV();
+
+    option.setPricingEngine(
+        MakeMCEuropeanEngine<PseudoRandom>(process)
+        .withSteps(1)
+        .withTimeBudget(0.1)
+        .withSeed(42));
+
+    Real calculated = option.NPV();
+    Real errorEstimate = option.errorEstimate();
+    Size samples = option.result<Size>("samples");
+    if (samples == 0)
+        BOOST_ERROR("no samples simulated within time budget");
+    if (std::fabs(calculated-expected) > 4.0*errorEstimate) {
+        BOOST_ERROR("failed to reproduce analytic value within budget"
+                    << "\n    samples:        " << samples
+                    << "\n    calculated:     " << calculated
+                    << "\n    expected:       " << expected
+                    << "\n    error estimate: " << errorEstimate);
+    }
+
+    // with a required tolerance, the simulation stops as soon as
+    // it is reached even though time would be left
+    Real tolerance = 0.05;
+    option.setPricingEngine(
+        MakeMCEuropeanEngine<PseudoRandom>(process)
+        .withSteps(1)
+        .withTimeBudget(60.0)
+        .withAbsoluteTolerance(tolerance)
+        .withSeed(42));
+
+    calculated = option.NPV();
+    errorEstimate = option.errorEstimate();
+    if (errorEstimate > tolerance) {
+        BOOST_ERROR("failed to reach required tolerance"
+                    << "\n    samples:        "
+                    << option.result<Size>("samples")
+                    << "\n    error estimate: " << errorEstimate
+                    << "\n    tolerance:      " << tolerance);
+    }
+    if (std::fabs(calculated-expected) > 4.0*tolerance) {
+        BOOST_ERROR("failed to reproduce analytic value"
+                    << "\n    calculated:     " << calculated
+                    << "\n    expected:       " << expected
+                    << "\n    tolerance:      " << tolerance);
+    }
+}
+
+
+void EuropeanOptionTest::testMcSinglePrecision() {
+
+    BOOST_TEST_MESSAGE("Testing single-precision Monte Carlo engine...");
+
+    SavedSettings backup;
+
+    DayCounter dc = Actual360();
+    Date today = Date::todaysDate();
+    Settings::instance().evaluationDate() = today;
+
+    boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    boost::shared_ptr<YieldTermStructure> qTS = flatRate(today, 0.03, dc);
+    boost::shared_ptr<YieldTermStructure> rTS = flatRate(today, 0.06, dc);
+    boost::shared_ptr<SimpleQuote> vol(new SimpleQuote(0.3));
+    boost::shared_ptr<BlackVolTermStructure> volTS = flatVol(today, vol, dc);
+    boost::shared_ptr<GeneralizedBlackScholesProcess> process =
+                                          makeProcess(spot, qTS, rTS, volTS);
+
+    Option::Type types[] = { Option::Call, Option::Put };
+    Real strikes[] = { 80.0, 100.0, 120.0 };
+    bool bridges[] = { false, true };
+
+    boost::shared_ptr<Exercise> exercise(
+                                     new EuropeanExercise(today + 720));
+
+    for (Size i=0; i<LENGTH(types); ++i) {
+      for (Size j=0; j<LENGTH(strikes); ++j) {
+        for (Size k=0; k<LENGTH(bridges); ++k) {
+
+          boost::shared_ptr<StrikedTypePayoff> payoff(
+                              new PlainVanillaPayoff(types[i], strikes[j]));
+          EuropeanOption option(payoff, exercise);
+
+          option.setPricingEngine(
+              MakeMCEuropeanEngine<PseudoRandom>(process)
+              .withSteps(8)
+              .withBrownianBridge(bridges[k])
+              .withAntitheticVariate()
+              .withSamples(10000)
+              .withSeed(42));
+          Real expected = option.NPV();
+
+          option.setPricingEngine(
+              MakeMCEuropeanEngine<PseudoRandom>(process)
+              .withSteps(8)
+              .withBrownianBridge(bridges[k])
+              .withAntitheticVariate()
+              .withSamples(10000)
+              .withSeed(42)
+              .withSinglePrecision());
+          Real calculated = option.NPV();
+
+          // same random numbers: the only difference is rounding
+          Real tolerance = 1.0e-4;
+          Real error = std::fabs(calculated-expected);
+          if (error > tolerance) {
+              REPORT_FAILURE("value", payoff, exercise, spot->value(),
+                             0.03, 0.06, today, vol->value(),
+                             expected, calculated, error, tolerance);
+          }
+        }
+      }
+    }
+}
+
 
 void EuropeanOptionTest::testPriceCurve() {
 
@@ -1514,6 +1804,105 @@ void EuropeanOptionTest::testLocalVolatility() {
 }
 
 
+void EuropeanOptionTest::testFdSensitivities() {
+    BOOST_TEST_MESSAGE("Testing finite-differences vega and rho "
+                       "from a tangent-linear solve...");
+
+    SavedSettings backup;
+
+    const Date today(28, March, 2004);
+    Settings::instance().evaluationDate() = today;
+    const DayCounter dc = Actual360();
+
+    const boost::shared_ptr<SimpleQuote> spot(new SimpleQuote(100.0));
+    const boost::shared_ptr<SimpleQuote> qRate(new SimpleQuote(0.02));
+    const boost::shared_ptr<SimpleQuote> rRate(new SimpleQuote(0.05));
+    const boost::shared_ptr<SimpleQuote> vol(new SimpleQuote(0.25));
+
+    const boost::shared_ptr<BlackScholesMertonProcess> process(
+        new BlackScholesMertonProcess(
+            Handle<Quote>(spot),
+            Handle<YieldTermStructure>(flatRate(today, qRate, dc)),
+            Handle<YieldTermStructure>(flatRate(today, rRate, dc)),
+            Handle<BlackVolTermStructure>(flatVol(today, vol, dc))));
+
+    const boost::shared_ptr<FdBlackScholesVanillaEngine> fdEngine(
+                        new FdBlackScholesVanillaEngine(process, 100, 400));
+    fdEngine->enableSensitivities();
+
+    const Date maturity(28, March, 2005);
+    const Option::Type types[] = { Option::Call, Option::Put };
+    const Real strikes[] = { 80.0, 100.0, 120.0 };
+
+    // European options against the analytic sensitivities
+    for (Size i=0; i < LENGTH(types); ++i) {
+        for (Size j=0; j < LENGTH(strikes); ++j) {
+            const boost::shared_ptr<StrikedTypePayoff> payoff(
+                                new PlainVanillaPayoff(types[i], strikes[j]));
+            EuropeanOption option(payoff, boost::shared_ptr<Exercise>(
+                                             new EuropeanExercise(maturity)));
+
+            option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                                         new AnalyticEuropeanEngine(process)));
+            const Real expected[] = { option.vega(), option.rho(),
+                                      option.dividendRho() };
+
+            option.setPricingEngine(fdEngine);
+            const Real calculated[] = { option.vega(), option.rho(),
+                                        option.dividendRho() };
+
+            const std::string names[] = { "vega", "rho", "dividend rho" };
+            for (Size k=0; k < LENGTH(names); ++k) {
+                const Real tol = 5e-3*std::fabs(expected[k]) + 1e-2;
+                if (std::fabs(calculated[k] - expected[k]) > tol) {
+                    BOOST_ERROR("failed to reproduce European " << names[k]
+                                << "\n    type:       " << types[i]
+                                << "\n    strike:     " << strikes[j]
+                                << "\n    calculated: " << calculated[k]
+                                << "\n    expected:   " << expected[k]);
+                }
+            }
+        }
+    }
+
+    // American options with dividends against bump and reprice
+    const boost::shared_ptr<StrikedTypePayoff> payoff(
+                                 new PlainVanillaPayoff(Option::Put, 100.0));
+    DividendVanillaOption option(
+        payoff,
+        boost::shared_ptr<Exercise>(new AmericanExercise(today, maturity)),
+        std::vector<Date>(1, Date(28, September, 2004)),
+        std::vector<Real>(1, 2.0));
+
+    option.setPricingEngine(fdEngine);
+    const Real calculated[] = { option.vega(), option.rho(),
+                                option.dividendRho() };
+
+    option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+                        new FdBlackScholesVanillaEngine(process, 100, 400)));
+
+    const boost::shared_ptr<SimpleQuote> quotes[] = { vol, rRate, qRate };
+    const std::string names[] = { "vega", "rho", "dividend rho" };
+    const Real h = 1e-4;
+    for (Size k=0; k < LENGTH(quotes); ++k) {
+        const Real x = quotes[k]->value();
+        quotes[k]->setValue(x + h);
+        const Real up = option.NPV();
+        quotes[k]->setValue(x - h);
+        const Real down = option.NPV();
+        quotes[k]->setValue(x);
+
+        const Real expected = (up - down)/(2*h);
+        const Real tol = 1e-2*std::fabs(expected);
+        if (std::fabs(calculated[k] - expected) > tol) {
+            BOOST_ERROR("failed to reproduce American " << names[k]
+                        << "\n    calculated: " << calculated[k]
+                        << "\n    expected:   " << expected);
+        }
+    }
+}
+
+
 test_suite* EuropeanOptionTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("European option tests");
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testValues));
@@ -1537,10 +1926,17 @@ test_suite* EuropeanOptionTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testIntegralEngines));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testMcEngines));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testQmcEngines));
+    suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testMcPathwiseGreeks));
+    suite->add(QUANTLIB_TEST_CASE(
+                           &EuropeanOptionTest::testMcCommonRandomNumbers));
+    suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testMcTimeBudget));
+    suite->add(QUANTLIB_TEST_CASE(
+                           &EuropeanOptionTest::testMcSinglePrecision));
 
     // FLOATING_POINT_EXCEPTION
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testPriceCurve));
     suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testLocalVolatility));
+    suite->add(QUANTLIB_TEST_CASE(&EuropeanOptionTest::testFdSensitivities));
 
     return suite;
 }
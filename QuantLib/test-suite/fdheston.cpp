@@ -37,12 +37,18 @@
 #include <ql/math/integrals/trapezoidintegral.hpp>
 #include <ql/math/integrals/twodimensionalintegral.hpp>
 #include <ql/models/equity/hestonmodel.hpp>
+#include <ql/models/equity/batesmodel.hpp>
+#include <ql/processes/batesprocess.hpp>
+#include <ql/time/calendars/nullcalendar.hpp>
+#include <ql/termstructures/volatility/equityfx/blackvariancesurface.hpp>
 #include <ql/termstructures/yield/zerocurve.hpp>
 #include <ql/pricingengines/barrier/analyticbarrierengine.hpp>
 #include <ql/pricingengines/vanilla/analytichestonengine.hpp>
 #include <ql/pricingengines/vanilla/analyticeuropeanengine.hpp>
 #include <ql/pricingengines/barrier/fdhestonbarrierengine.hpp>
 #include <ql/pricingengines/vanilla/fdhestonvanillaengine.hpp>
+#include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
+#include <ql/pricingengines/vanilla/fdbatesvanillaengine.hpp>
 #include <ql/pricingengines/barrier/fdblackscholesbarrierengine.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmmesher.hpp>
 #include <ql/methods/finitedifferences/meshers/fdmmeshercomposite.hpp>
@@ -56,6 +62,8 @@
 #include <ql/experimental/finitedifferences/fdmblackscholesfwdop.hpp>
 #include <ql/experimental/finitedifferences/fdmsquarerootfwdop.hpp>
 #include <ql/experimental/finitedifferences/fdmhestonfwdop.hpp>
+#include <ql/experimental/finitedifferences/fdmfwdeuropeangridsolver.hpp>
+#include <ql/pricingengines/blackformula.hpp>
 #if defined(__GNUC__) && (((__GNUC__ == 4) && (__GNUC_MINOR__ >= 8)) || (__GNUC__ > 4))
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-local-typedefs"
@@ -343,6 +351,132 @@ void FdHestonTest::testFdmHestonAmerican() {
 }
 
 
+void FdHestonTest::testFdmHestonBatchPricing() {
+
+    BOOST_TEST_MESSAGE("Testing FDM batch pricing of American options "
+                       "in Heston, Bates and Black-Scholes models...");
+
+    SavedSettings backup;
+
+    Handle<Quote> s0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+
+    Handle<YieldTermStructure> rTS(flatRate(0.05, Actual365Fixed()));
+    Handle<YieldTermStructure> qTS(flatRate(0.02, Actual365Fixed()));
+
+    boost::shared_ptr<HestonModel> hestonModel(new HestonModel(
+        boost::shared_ptr<HestonProcess>(
+            new HestonProcess(rTS, qTS, s0, 0.04, 2.5, 0.04, 0.66, -0.8))));
+
+    boost::shared_ptr<BatesModel> batesModel(new BatesModel(
+        boost::shared_ptr<BatesProcess>(
+            new BatesProcess(rTS, qTS, s0, 0.04, 2.5, 0.04, 0.66, -0.8,
+                             0.5, -0.1, 0.15))));
+
+    boost::shared_ptr<GeneralizedBlackScholesProcess> bsProcess(
+        new BlackScholesMertonProcess(
+            s0, qTS, rTS,
+            Handle<BlackVolTermStructure>(flatVol(0.2, Actual365Fixed()))));
+
+    Settings::instance().evaluationDate() = Date(28, March, 2004);
+    Date exerciseDate(28, March, 2005);
+
+    // a volatility smile, on which the payoffs must not be priced
+    // with the volatility at a single strike
+    std::vector<Date> smileDates;
+    smileDates.push_back(Date(28, September, 2004));
+    smileDates.push_back(exerciseDate);
+    smileDates.push_back(Date(28, March, 2006));
+    std::vector<Real> smileStrikes;
+    Matrix smileVols(5, 3);
+    const Real smile[] = { 0.32, 0.26, 0.21, 0.19, 0.18 };
+    for (Size i=0; i < LENGTH(smile); ++i) {
+        smileStrikes.push_back(60.0 + 20.0*i);
+        for (Size j=0; j < smileDates.size(); ++j)
+            smileVols[i][j] = smile[i] - 0.01*j;
+    }
+    boost::shared_ptr<GeneralizedBlackScholesProcess> smileProcess(
+        new BlackScholesMertonProcess(
+            s0, qTS, rTS,
+            Handle<BlackVolTermStructure>(boost::shared_ptr<BlackVolTermStructure>(
+                new BlackVarianceSurface(
+                    Settings::instance().evaluationDate(), NullCalendar(),
+                    smileDates, smileStrikes, smileVols, Actual365Fixed(),
+                    BlackVarianceSurface::ConstantExtrapolation,
+                    BlackVarianceSurface::ConstantExtrapolation)))));
+
+    boost::shared_ptr<Exercise> exercise(new AmericanExercise(exerciseDate));
+
+    std::vector<boost::shared_ptr<StrikedTypePayoff> > payoffs;
+    payoffs.push_back(boost::shared_ptr<StrikedTypePayoff>(
+                                    new PlainVanillaPayoff(Option::Put, 80)));
+    payoffs.push_back(boost::shared_ptr<StrikedTypePayoff>(
+                                    new PlainVanillaPayoff(Option::Put, 100)));
+    payoffs.push_back(boost::shared_ptr<StrikedTypePayoff>(
+                                    new PlainVanillaPayoff(Option::Put, 120)));
+    payoffs.push_back(boost::shared_ptr<StrikedTypePayoff>(
+                                    new PlainVanillaPayoff(Option::Call, 110)));
+
+    const std::string models[] = { "Heston", "Bates", "Black-Scholes",
+                                   "Black-Scholes smile" };
+    std::vector<boost::shared_ptr<PricingEngine> > batchEngines, engines;
+
+    const boost::shared_ptr<FdHestonVanillaEngine> hestonBatchEngine(
+                new FdHestonVanillaEngine(hestonModel, 100, 200, 50));
+    hestonBatchEngine->enableBatch(payoffs);
+    batchEngines.push_back(hestonBatchEngine);
+    engines.push_back(boost::shared_ptr<PricingEngine>(
+                new FdHestonVanillaEngine(hestonModel, 100, 200, 50)));
+
+    const boost::shared_ptr<FdBatesVanillaEngine> batesBatchEngine(
+                new FdBatesVanillaEngine(batesModel, 100, 200, 50));
+    batesBatchEngine->enableBatch(payoffs);
+    batchEngines.push_back(batesBatchEngine);
+    engines.push_back(boost::shared_ptr<PricingEngine>(
+                new FdBatesVanillaEngine(batesModel, 100, 200, 50)));
+
+    const boost::shared_ptr<FdBlackScholesVanillaEngine> bsBatchEngine(
+                new FdBlackScholesVanillaEngine(bsProcess, 100, 400));
+    bsBatchEngine->enableBatch(payoffs);
+    batchEngines.push_back(bsBatchEngine);
+    engines.push_back(boost::shared_ptr<PricingEngine>(
+                new FdBlackScholesVanillaEngine(bsProcess, 100, 400)));
+
+    const boost::shared_ptr<FdBlackScholesVanillaEngine> smileBatchEngine(
+                new FdBlackScholesVanillaEngine(smileProcess, 100, 400));
+    smileBatchEngine->enableBatch(payoffs);
+    batchEngines.push_back(smileBatchEngine);
+    engines.push_back(boost::shared_ptr<PricingEngine>(
+                new FdBlackScholesVanillaEngine(smileProcess, 100, 400)));
+
+    const Real tol = 0.01;
+    for (Size i=0; i < payoffs.size(); ++i) {
+        VanillaOption option(payoffs[i], exercise);
+
+        for (Size j=0; j < LENGTH(models); ++j) {
+            option.setPricingEngine(batchEngines[j]);
+            const Real batchNpv = option.NPV();
+            const Real batchDelta = option.delta();
+
+            option.setPricingEngine(engines[j]);
+            const Real npv = option.NPV();
+            const Real delta = option.delta();
+
+            if (std::fabs(batchNpv - npv) > tol
+                || std::fabs(batchDelta - delta) > tol) {
+                BOOST_ERROR("Failed to reproduce single-option results "
+                            "with batch pricing in " << models[j] << " model"
+                            << "\n    payoff:       " 
+                            << payoffs[i]->description()
+                            << "\n    batch npv:    " << batchNpv
+                            << "\n    npv:          " << npv
+                            << "\n    batch delta:  " << batchDelta
+                            << "\n    delta:        " << delta
+                            << "\n    tolerance:    " << tol);
+            }
+        }
+    }
+}
+
 void FdHestonTest::testFdmHestonIkonenToivanen() {
 
     BOOST_TEST_MESSAGE("Testing FDM Heston for Ikonen and Toivanen tests...");
@@ -794,6 +928,79 @@ void FdHestonTest::testBlackScholesFokkerPlanckFwdEquation() {
 }
 
 
+void FdHestonTest::testBlackScholesFwdEuropeanGrid() {
+    BOOST_TEST_MESSAGE("Testing strike-by-expiry grid of European prices "
+                       "from one Fokker-Planck forward solve...");
+
+    SavedSettings backup;
+
+    const DayCounter dc = Actual365Fixed();
+    const Date todaysDate = Date(28, Dec, 2012);
+    Settings::instance().evaluationDate() = todaysDate;
+
+    const Real s0 = 100;
+    const Rate r = 0.035;
+    const Rate q = 0.01;
+    const Volatility v = 0.35;
+
+    const Handle<Quote> spot(boost::shared_ptr<Quote>(new SimpleQuote(s0)));
+    const Handle<YieldTermStructure> qTS(flatRate(q, dc));
+    const Handle<YieldTermStructure> rTS(flatRate(r, dc));
+    const Handle<BlackVolTermStructure> vTS(flatVol(v, dc));
+
+    const boost::shared_ptr<GeneralizedBlackScholesProcess> process(
+        new GeneralizedBlackScholesProcess(spot, qTS, rTS, vTS));
+
+    std::vector<Time> expiries;
+    expiries.push_back(0.5);
+    expiries.push_back(1.0);
+    expiries.push_back(2.0);
+
+    std::vector<Real> strikes;
+    for (Real strike=60.0; strike <= 160.0; strike+=20.0)
+        strikes.push_back(strike);
+
+    const boost::shared_ptr<FdmMesher> mesher(
+        new FdmMesherComposite(boost::shared_ptr<Fdm1dMesher>(
+            new FdmBlackScholesMesher(401, process, expiries.back(), s0))));
+
+    const boost::shared_ptr<FdmLinearOpComposite> fwdOp(
+        new FdmBlackScholesFwdOp(mesher, process, s0, 0));
+
+    const FdmFwdEuropeanGridSolver solver(
+        mesher, fwdOp, std::vector<Real>(1, std::log(s0)), rTS,
+        FdmSchemeDesc::Douglas(), 10);
+
+    const Option::Type types[] = { Option::Call, Option::Put };
+    const Real tol = 0.01;
+
+    for (Size t=0; t < LENGTH(types); ++t) {
+        const Matrix npv = solver.npv(types[t], expiries, strikes, 400);
+
+        for (Size i=0; i < expiries.size(); ++i) {
+            const Time T = expiries[i];
+            const Real fwd = s0*qTS->discount(T)/rTS->discount(T);
+            for (Size j=0; j < strikes.size(); ++j) {
+                const Real expected = rTS->discount(T)
+                    * blackFormula(types[t], strikes[j], fwd, v*std::sqrt(T));
+                const Real calculated = npv[i][j];
+
+                if (std::fabs(expected - calculated) > tol) {
+                    BOOST_ERROR("failed to reproduce european option price"
+                                << "\n   type:       " << types[t]
+                                << "\n   expiry:     " << T
+                                << "\n   strike:     " << strikes[j]
+                                << QL_FIXED << std::setprecision(8)
+                                << "\n   calculated: " << calculated
+                                << "\n   expected:   " << expected
+                                << "\n   tolerance:  " << tol);
+                }
+            }
+        }
+    }
+}
+
+
 namespace {
 
     Real squareRootGreensFct(Real v0, Real kappa, Real theta,
@@ -1288,12 +1495,120 @@ void FdHestonTest::testHestonFokkerPlanckFwdEquation() {
     }
 }
 
+void FdHestonTest::testHestonFwdEuropeanGrid() {
+    BOOST_TEST_MESSAGE("Testing strike-by-expiry grid of European prices "
+                       "from one Heston Fokker-Planck forward solve...");
+
+    SavedSettings backup;
+
+    const DayCounter dc = Actual365Fixed();
+    const Date todaysDate = Date(28, Dec, 2012);
+    Settings::instance().evaluationDate() = todaysDate;
+
+    const Real s0 = 100;
+    const Rate r = 0.05;
+    const Rate q = 0.02;
+
+    const Real kappa =  1.5;
+    const Real theta =  0.09;
+    const Real rho   = -0.75;
+    const Real sigma =  0.3;
+    const Real v0    =  0.08;
+
+    const Handle<Quote> spot(boost::shared_ptr<Quote>(new SimpleQuote(s0)));
+    const Handle<YieldTermStructure> rTS(flatRate(r, dc));
+    const Handle<YieldTermStructure> qTS(flatRate(q, dc));
+
+    const boost::shared_ptr<HestonProcess> process(
+        new HestonProcess(rTS, qTS, spot, v0, kappa, theta, sigma, rho));
+
+    const Period tenors[] = { Period(6, Months), Period(1, Years),
+                              Period(2, Years) };
+    std::vector<Date> maturityDates;
+    std::vector<Time> expiries;
+    for (Size i=0; i < LENGTH(tenors); ++i) {
+        maturityDates.push_back(todaysDate + tenors[i]);
+        expiries.push_back(dc.yearFraction(todaysDate,
+                                           maturityDates.back()));
+    }
+
+    std::vector<Real> strikes;
+    for (Real strike=70.0; strike <= 140.0; strike+=10.0)
+        strikes.push_back(strike);
+
+    const Real vol = sigma*std::sqrt(theta/(2*kappa));
+    const Real upperBound = std::max(v0+6*vol, theta+6*vol);
+    const Real lowerBound = std::max(0.0025, std::min(v0-6*vol, theta-6*vol));
+
+    const boost::shared_ptr<Fdm1dMesher> varianceMesher(
+        new Uniform1dMesher(lowerBound, upperBound, 401));
+    const boost::shared_ptr<Fdm1dMesher> equityMesher(
+        new FdmBlackScholesMesher(
+            201,
+            FdmBlackScholesMesher::processHelper(
+                process->s0(), process->dividendYield(),
+                process->riskFreeRate(), std::sqrt(upperBound)),
+            expiries.back(), s0, Null<Real>(), Null<Real>(), 0.0001, 1.5,
+            std::pair<Real, Real>(s0, 0.1)));
+
+    const boost::shared_ptr<FdmMesher> mesher(
+        new FdmMesherComposite(equityMesher, varianceMesher));
+
+    const boost::shared_ptr<FdmLinearOpComposite> fwdOp(
+        new FdmHestonFwdOp(mesher, process));
+
+    std::vector<Real> initialState;
+    initialState.push_back(std::log(s0));
+    initialState.push_back(v0);
+
+    const FdmFwdEuropeanGridSolver solver(
+        mesher, fwdOp, initialState, rTS, FdmSchemeDesc::Hundsdorfer());
+
+    const boost::shared_ptr<PricingEngine> engine(
+        new AnalyticHestonEngine(boost::shared_ptr<HestonModel>(
+                                              new HestonModel(process))));
+
+    const Option::Type types[] = { Option::Call, Option::Put };
+    const Real tol = 0.05;
+
+    for (Size t=0; t < LENGTH(types); ++t) {
+        const Matrix npv = solver.npv(types[t], expiries, strikes, 200);
+
+        for (Size i=0; i < expiries.size(); ++i) {
+            const boost::shared_ptr<Exercise> exercise(
+                new EuropeanExercise(maturityDates[i]));
+            for (Size j=0; j < strikes.size(); ++j) {
+                VanillaOption option(
+                    boost::shared_ptr<StrikedTypePayoff>(
+                        new PlainVanillaPayoff(types[t], strikes[j])),
+                    exercise);
+                option.setPricingEngine(engine);
+
+                const Real expected = option.NPV();
+                const Real calculated = npv[i][j];
+
+                if (std::fabs(expected - calculated) > tol) {
+                    BOOST_ERROR("failed to reproduce Heston prices"
+                                << "\n   type:       " << types[t]
+                                << "\n   expiry:     " << expiries[i]
+                                << "\n   strike:     " << strikes[j]
+                                << QL_FIXED << std::setprecision(8)
+                                << "\n   calculated: " << calculated
+                                << "\n   expected:   " << expected
+                                << "\n   tolerance:  " << tol);
+                }
+            }
+        }
+    }
+}
+
 test_suite* FdHestonTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Finite Difference Heston tests");
     suite->add(QUANTLIB_TEST_CASE(&FdHestonTest::testFdmHestonBarrier));
     suite->add(QUANTLIB_TEST_CASE(
                          &FdHestonTest::testFdmHestonBarrierVsBlackScholes));
     suite->add(QUANTLIB_TEST_CASE(&FdHestonTest::testFdmHestonAmerican));
+    suite->add(QUANTLIB_TEST_CASE(&FdHestonTest::testFdmHestonBatchPricing));
     suite->add(QUANTLIB_TEST_CASE(&FdHestonTest::testFdmHestonIkonenToivanen));
     suite->add(QUANTLIB_TEST_CASE(&FdHestonTest::testFdmHestonBlackScholes));
     suite->add(QUANTLIB_TEST_CASE(
@@ -1307,6 +1622,8 @@ test_suite* FdHestonTest::experimental() {
     test_suite* suite = BOOST_TEST_SUITE("Finite Difference Heston tests");
     suite->add(QUANTLIB_TEST_CASE(
         &FdHestonTest::testBlackScholesFokkerPlanckFwdEquation));
+    suite->add(QUANTLIB_TEST_CASE(
+        &FdHestonTest::testBlackScholesFwdEuropeanGrid));
     suite->add(QUANTLIB_TEST_CASE(&FdHestonTest::testSquareRootZeroFlowBC));
     suite->add(QUANTLIB_TEST_CASE(&FdHestonTest::testTransformedZeroFlowBC));
     suite->add(QUANTLIB_TEST_CASE(
@@ -1315,6 +1632,8 @@ test_suite* FdHestonTest::experimental() {
         &FdHestonTest::testSquareRootFokkerPlanckFwdEquation));
     suite->add(QUANTLIB_TEST_CASE(
         &FdHestonTest::testHestonFokkerPlanckFwdEquation));
+    suite->add(QUANTLIB_TEST_CASE(
+        &FdHestonTest::testHestonFwdEuropeanGrid));
 
     return suite;
 }
@@ -30,16 +30,19 @@ public:
     static void testFdmHestonBarrier();
     static void testFdmHestonBarrierVsBlackScholes();
     static void testFdmHestonAmerican();
+    static void testFdmHestonBatchPricing();
     static void testFdmHestonIkonenToivanen();
     static void testFdmHestonEuropeanWithDividends();
     static void testFdmHestonConvergence();
     static void testFdmHestonBlackScholes();
     static void testBlackScholesFokkerPlanckFwdEquation();
+    static void testBlackScholesFwdEuropeanGrid();
     static void testSquareRootZeroFlowBC();
     static void testTransformedZeroFlowBC();
     static void testSquareRootEvolveWithStationaryDensity();
     static void testSquareRootFokkerPlanckFwdEquation();
     static void testHestonFokkerPlanckFwdEquation();
+    static void testHestonFwdEuropeanGrid();
 
     static boost::unit_test_framework::test_suite* suite();
     static boost::unit_test_framework::test_suite* experimental();
@@ -62,6 +62,8 @@
 #include <ql/methods/finitedifferences/stepconditions/fdmamericanstepcondition.hpp>
 #include <ql/methods/finitedifferences/stepconditions/fdmstepconditioncomposite.hpp>
 #include <ql/methods/finitedifferences/utilities/fdmdividendhandler.hpp>
+#include <ql/methods/finitedifferences/utilities/fdmlocalinterpolation.hpp>
+#include <ql/methods/finitedifferences/meshers/concentrating1dmesher.hpp>
 #include <ql/methods/finitedifferences/operators/firstderivativeop.hpp>
 #include <ql/methods/finitedifferences/operators/secondderivativeop.hpp>
 #include <ql/methods/finitedifferences/operators/secondordermixedderivativeop.hpp>
@@ -1316,6 +1318,59 @@ void FdmLinearOpTest::testSparseMatrixZeroAssignment() {
 #endif
 }
 
+void FdmLinearOpTest::testFdmLocalInterpolation() {
+
+    BOOST_TEST_MESSAGE("Testing local interpolation on non-uniform grids...");
+
+    const boost::shared_ptr<FdmMesher> mesher(
+        new FdmMesherComposite(
+            boost::shared_ptr<Fdm1dMesher>(new Concentrating1dMesher(
+                -1.0, 2.0, 21, std::pair<Real, Real>(0.5, 0.1))),
+            boost::shared_ptr<Fdm1dMesher>(new Uniform1dMesher(0.0, 1.0, 7)),
+            boost::shared_ptr<Fdm1dMesher>(new Concentrating1dMesher(
+                1.0, 3.0, 11, std::pair<Real, Real>(1.0, 0.2)))));
+
+    const boost::shared_ptr<FdmLinearOpLayout> layout = mesher->layout();
+
+    // tensor products of cubics are reproduced exactly
+    Array values(layout->size());
+    const FdmLinearOpIterator endIter = layout->end();
+    for (FdmLinearOpIterator iter = layout->begin(); iter != endIter;
+         ++iter) {
+        const Real x = mesher->location(iter, 0);
+        const Real y = mesher->location(iter, 1);
+        const Real z = mesher->location(iter, 2);
+        values[iter.index()] = x*x*x*y - 2.0*x*y*y*z + z*z*z + 1.0;
+    }
+
+    const FdmLocalInterpolation interpolation(mesher);
+
+    const Real tol = 1e-10;
+    std::vector<Real> p(3);
+    for (Size i=0; i <= 12; ++i) {
+        for (Size j=0; j <= 5; ++j) {
+            for (Size k=0; k <= 8; ++k) {
+                p[0] = -1.0 + 0.25*i;
+                p[1] = 0.2*j;
+                p[2] = 1.0 + 0.25*k;
+
+                const Real expected = p[0]*p[0]*p[0]*p[1]
+                    - 2.0*p[0]*p[1]*p[1]*p[2] + p[2]*p[2]*p[2] + 1.0;
+                const Real calculated = interpolation(values, p);
+
+                if (std::fabs(calculated - expected) > tol) {
+                    BOOST_FAIL("failed to reproduce cubic polynomial"
+                               << "\n    x:          " << p[0]
+                               << "\n    y:          " << p[1]
+                               << "\n    z:          " << p[2]
+                               << "\n    calculated: " << calculated
+                               << "\n    expected:   " << expected);
+                }
+            }
+        }
+    }
+}
+
 test_suite* FdmLinearOpTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("linear operator tests");
 
@@ -1342,6 +1397,8 @@ test_suite* FdmLinearOpTest::suite() {
         QUANTLIB_TEST_CASE(&FdmLinearOpTest::testSpareMatrixReference));
     suite->add(
         QUANTLIB_TEST_CASE(&FdmLinearOpTest::testSparseMatrixZeroAssignment));
+    suite->add(
+        QUANTLIB_TEST_CASE(&FdmLinearOpTest::testFdmLocalInterpolation));
 
     return suite;
     
@@ -43,6 +43,7 @@ public:
     static void testCrankNicolsonWithDamping();
     static void testSpareMatrixReference();
     static void testSparseMatrixZeroAssignment();
+    static void testFdmLocalInterpolation();
     static boost::unit_test_framework::test_suite* suite();
 };
 
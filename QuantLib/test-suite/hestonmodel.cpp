@@ -38,6 +38,7 @@
 #include <ql/pricingengines/vanilla/fdblackscholesvanillaengine.hpp>
 #include <ql/pricingengines/vanilla/fdhestonvanillaengine.hpp>
 #include <ql/pricingengines/vanilla/mceuropeanhestonengine.hpp>
+#include <ql/pricingengines/vanilla/mlmceuropeanhestonengine.hpp>
 #include <ql/experimental/exoticoptions/analyticpdfhestonengine.hpp>
 #include <ql/pricingengines/blackformula.hpp>
 #include <ql/time/calendars/target.hpp>
@@ -509,6 +510,54 @@ void HestonModelTest::testMcVsCached() {
     }
 }
 
+void HestonModelTest::testMultiLevelMcVsAnalytic() {
+    BOOST_TEST_MESSAGE(
+        "Testing multi-level Monte Carlo Heston engine against analytic...");
+
+    SavedSettings backup;
+
+    Date settlementDate(27, December, 2004);
+    Settings::instance().evaluationDate() = settlementDate;
+
+    DayCounter dayCounter = ActualActual();
+    Date exerciseDate(27, December, 2005);
+
+    boost::shared_ptr<StrikedTypePayoff> payoff(
+                                   new PlainVanillaPayoff(Option::Call, 100.0));
+    boost::shared_ptr<Exercise> exercise(new EuropeanExercise(exerciseDate));
+
+    Handle<YieldTermStructure> riskFreeTS(flatRate(0.05, dayCounter));
+    Handle<YieldTermStructure> dividendTS(flatRate(0.02, dayCounter));
+
+    Handle<Quote> s0(boost::shared_ptr<Quote>(new SimpleQuote(100.0)));
+
+    boost::shared_ptr<HestonProcess> process(new HestonProcess(
+                   riskFreeTS, dividendTS, s0, 0.04, 1.5, 0.04, 0.3, -0.5,
+                   HestonProcess::FullTruncation));
+
+    VanillaOption option(payoff, exercise);
+
+    option.setPricingEngine(boost::shared_ptr<PricingEngine>(
+        new AnalyticHestonEngine(boost::shared_ptr<HestonModel>(
+                                              new HestonModel(process)), 64)));
+    Real expected = option.NPV();
+
+    Real tolerance = 0.05;
+    option.setPricingEngine(
+        MakeMLMCEuropeanHestonEngine<PseudoRandom>(process)
+        .withSteps(2)
+        .withAbsoluteTolerance(tolerance)
+        .withSeed(1234));
+    Real calculated = option.NPV();
+
+    if (std::fabs(calculated - expected) > 3.0*tolerance) {
+        BOOST_ERROR("Failed to reproduce analytic price"
+                    << "\n    calculated: " << calculated
+                    << "\n    expected:   " << expected
+                    << "\n    tolerance:  " << tolerance);
+    }
+}
+
 void HestonModelTest::testFdBarrierVsCached() {
     BOOST_TEST_MESSAGE("Testing FD barrier Heston engine against cached values...");
 
@@ -1015,6 +1064,31 @@ void HestonModelTest::testMultipleStrikesEngine() {
                        << "\n    error:      " << QL_SCIENTIFIC << relTol);
         }
     }
+
+    // cash dividends don't scale with the strike; such options must
+    // not be served by the results cached for the other strikes
+    std::vector<Date> dividendDates(1, Date(27, September, 2005));
+    std::vector<Real> dividends(1, 0.05);
+    for (Size i=0; i < strikes.size(); ++i) {
+        boost::shared_ptr<StrikedTypePayoff> payoff(
+                           new PlainVanillaPayoff(Option::Put, strikes[i]));
+
+        DividendVanillaOption aOption(payoff, exercise,
+                                      dividendDates, dividends);
+        aOption.setPricingEngine(multiStrikeEngine);
+        Real npvCalculated = aOption.NPV();
+
+        aOption.setPricingEngine(singleStrikeEngine);
+        Real npvExpected = aOption.NPV();
+
+        if (std::fabs(npvCalculated-npvExpected) > 1e-12) {
+            BOOST_FAIL("failed to reproduce price with dividends "
+                       "and FD multi strike engine"
+                       << "\n    strike:     " << strikes[i]
+                       << "\n    calculated: " << npvCalculated
+                       << "\n    expected:   " << npvExpected);
+        }
+    }
 }
 
 
@@ -1504,6 +1578,8 @@ test_suite* HestonModelTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testFdVanillaVsCached));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testMultipleStrikesEngine));
     suite->add(QUANTLIB_TEST_CASE(&HestonModelTest::testMcVsCached));
+    suite->add(QUANTLIB_TEST_CASE(
+                    &HestonModelTest::testMultiLevelMcVsAnalytic));
     suite->add(QUANTLIB_TEST_CASE(
                     &HestonModelTest::testAnalyticPiecewiseTimeDependent));
     suite->add(QUANTLIB_TEST_CASE(
@@ -25,6 +25,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include "marketmodel.hpp"
 #include "utilities.hpp"
 #include <ql/models/marketmodels/accountingengine.hpp>
+#include <ql/models/marketmodels/parallelaccountingengine.hpp>
 #include <ql/models/marketmodels/browniangenerators/mtbrowniangenerator.hpp>
 #include <ql/models/marketmodels/browniangenerators/sobolbrowniangenerator.hpp>
 #include <ql/models/marketmodels/callability/collectnodedata.hpp>
@@ -42,6 +43,7 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/models/marketmodels/evolvers/lognormalfwdrateipc.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdrateballand.hpp>
 #include <ql/models/marketmodels/evolvers/lognormalfwdratepc.hpp>
+#include <ql/models/marketmodels/evolvers/lognormalfwdratepcblock.hpp>
 #include <ql/models/marketmodels/evolvers/normalfwdratepc.hpp>
 #include <ql/models/marketmodels/discounter.hpp>
 #include <ql/models/marketmodels/models/abcdvol.hpp>
@@ -109,8 +111,13 @@ FOR A PARTICULAR PURPOSE.  See the license for more details.
 #include <ql/models/marketmodels/products/multistep/multisteppathwisewrapper.hpp>
 
 #include <boost/math/special_functions/fpclassify.hpp>
+#include <boost/timer.hpp>
 #include <sstream>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #if defined(BOOST_MSVC)
 #include <float.h>
 //namespace { unsigned int u = _controlfp(_EM_INEXACT, _MCW_EM); }
@@ -3013,10 +3020,9 @@ void MarketModelTest::testPathwiseVegas()
 
                 std::vector<Size> numberCashFlowsThisStep(product.numberOfProducts());
 
-                std::vector<std::vector<MarketModelMultiProduct::CashFlow> > cashFlowsGenerated(product.numberOfProducts());
-
-                for (Size i=0; i < product.numberOfProducts(); ++i)
-                    cashFlowsGenerated[i].resize(product.maxNumberOfCashFlowsPerProductPerStep());
+                MarketModelMultiProduct::CashFlowBuffer cashFlowsGenerated(
+                                 product.numberOfProducts(),
+                                 product.maxNumberOfCashFlowsPerProductPerStep());
 
                 Matrix B(pseudoBumps.size(),evolution.numberOfRates());
                 Matrix B2(pseudoBumps.size(),evolution.numberOfRates());
@@ -3894,18 +3900,15 @@ void MarketModelTest::testPathwiseMarketVegas()
 
     std::vector<Size> numberCashFlowsThisStep1(swaptionsDeflated.numberOfProducts());
 
-    std::vector<std::vector<MarketModelPathwiseMultiProduct::CashFlow> > cashFlowsGenerated1(swaptionsDeflated.numberOfProducts());
-
-
-    for (Size i=0; i < swaptionsDeflated.numberOfProducts(); ++i)
-    {
-        cashFlowsGenerated1[i].resize(swaptionsDeflated.maxNumberOfCashFlowsPerProductPerStep());
-        for (Size j=0; j < swaptionsDeflated.maxNumberOfCashFlowsPerProductPerStep(); ++j)
-            cashFlowsGenerated1[i][j].amount.resize(numberRates+1);
-    }
+    MarketModelPathwiseMultiProduct::CashFlow cashFlow;
+    cashFlow.amount.resize(numberRates+1);
+    MarketModelPathwiseMultiProduct::CashFlowBuffer cashFlowsGenerated1(
+                       swaptionsDeflated.numberOfProducts(),
+                       swaptionsDeflated.maxNumberOfCashFlowsPerProductPerStep(),
+                       cashFlow);
 
     std::vector<Size> numberCashFlowsThisStep2(numberCashFlowsThisStep1);
-    std::vector<std::vector<MarketModelPathwiseMultiProduct::CashFlow> >
+    MarketModelPathwiseMultiProduct::CashFlowBuffer
         cashFlowsGenerated2(cashFlowsGenerated1);
 
 
@@ -4746,6 +4749,372 @@ void MarketModelTest::testDriftCalculator() {
     }
 }
 
+void MarketModelTest::testBlockEvolver() {
+
+    BOOST_TEST_MESSAGE("Testing predictor-corrector evolution "
+                       "on blocks of paths...");
+
+    setup();
+
+    MultiProductComposite product;
+    std::vector<SubProductExpectedValues> subProductExpectedValues;
+    addForwards(product, subProductExpectedValues);
+    addOptionLets(product, subProductExpectedValues);
+    addCoterminalSwapsAndSwaptions(product, subProductExpectedValues);
+    product.finalize();
+
+    EvolutionDescription evolution = product.evolution();
+    Real tolerance = 1.0e-12;
+    Size blockSize = 16;
+
+    Size testedFactors[] = { 3, todaysForwards.size() };
+    MeasureType measures[] = { Terminal, MoneyMarketPlus, MoneyMarket };
+
+    for (Size m=0; m<LENGTH(testedFactors); ++m) {
+        for (Size k=0; k<LENGTH(measures); ++k) {
+            std::vector<Size> numeraires = makeMeasure(product, measures[k]);
+            boost::shared_ptr<MarketModel> marketModel =
+                makeMarketModel(true, evolution, testedFactors[m],
+                                ExponentialCorrelationAbcdVolatility);
+            Real initialNumeraireValue =
+                todaysDiscounts[numeraires.front()];
+
+            MTBrownianGeneratorFactory generatorFactory(seed_);
+
+            boost::shared_ptr<MarketModelEvolver> evolver(
+                new LogNormalFwdRatePc(marketModel, generatorFactory,
+                                       numeraires));
+            AccountingEngine engine(evolver, product, initialNumeraireValue);
+            SequenceStatisticsInc stats(product.numberOfProducts());
+            engine.multiplePathValues(stats, paths_);
+
+            boost::shared_ptr<MarketModelBlockEvolver> blockEvolver(
+                new LogNormalFwdRatePcBlock(marketModel, generatorFactory,
+                                            numeraires, blockSize));
+            AccountingEngine blockEngine(blockEvolver, product,
+                                         initialNumeraireValue);
+            SequenceStatisticsInc blockStats(product.numberOfProducts());
+            blockEngine.multiplePathValues(blockStats, paths_);
+
+            std::vector<Real> expected = stats.mean();
+            std::vector<Real> calculated = blockStats.mean();
+            for (Size i=0; i<expected.size(); ++i) {
+                Real error = std::fabs(calculated[i]-expected[i]);
+                if (error > tolerance)
+                    BOOST_ERROR(testedFactors[m] << " factors, "
+                                << measureTypeToString(measures[k]) << ", "
+                                << io::ordinal(i+1) << " product:"
+                                << "\n    one-path evolver: " << expected[i]
+                                << "\n    block evolver:    " << calculated[i]
+                                << "\n    error:            " << error
+                                << "\n    tolerance:        " << tolerance);
+            }
+        }
+    }
+}
+
+void MarketModelTest::testParallelAccountingEngines() {
+
+    BOOST_TEST_MESSAGE("Testing accounting engines on several threads...");
+
+    setup();
+
+    MultiProductComposite product;
+    std::vector<SubProductExpectedValues> subProductExpectedValues;
+    addForwards(product, subProductExpectedValues);
+    addOptionLets(product, subProductExpectedValues);
+    addCoterminalSwapsAndSwaptions(product, subProductExpectedValues);
+    product.finalize();
+
+    EvolutionDescription evolution = product.evolution();
+    Real tolerance = 1.0e-12;
+    Size workers = 3;
+
+    boost::shared_ptr<BrownianGeneratorFactory> generatorFactory(
+                                      new MTBrownianGeneratorFactory(seed_));
+
+    MeasureType measures[] = { Terminal, MoneyMarket };
+    for (Size k=0; k<LENGTH(measures); ++k) {
+        std::vector<Size> numeraires = makeMeasure(product, measures[k]);
+        boost::shared_ptr<MarketModel> marketModel =
+            makeMarketModel(true, evolution, 3,
+                            ExponentialCorrelationAbcdVolatility);
+        Real initialNumeraireValue = todaysDiscounts[numeraires.front()];
+
+        boost::shared_ptr<MarketModelEvolver> evolver(
+            new LogNormalFwdRatePc(marketModel, *generatorFactory,
+                                   numeraires));
+        AccountingEngine engine(evolver, product, initialNumeraireValue);
+        SequenceStatisticsInc stats(product.numberOfProducts());
+        engine.multiplePathValues(stats, paths_);
+
+        boost::shared_ptr<MarketModelEvolverFactory> evolverFactory(
+            new GenericMarketModelEvolverFactory<LogNormalFwdRatePc>(
+                                                   marketModel, numeraires));
+        ParallelAccountingEngine parallelEngine(evolverFactory,
+                                                generatorFactory, product,
+                                                initialNumeraireValue,
+                                                workers);
+        SequenceStatisticsInc parallelStats(product.numberOfProducts());
+        parallelEngine.multiplePathValues(parallelStats, paths_);
+
+        if (parallelStats.samples() != stats.samples())
+            BOOST_ERROR(measureTypeToString(measures[k]) << ": "
+                        << parallelStats.samples() << " samples instead of "
+                        << stats.samples());
+
+        std::vector<Real> expected = stats.mean();
+        std::vector<Real> calculated = parallelStats.mean();
+        for (Size i=0; i<expected.size(); ++i) {
+            Real error = std::fabs(calculated[i]-expected[i]);
+            if (error > tolerance)
+                BOOST_ERROR(measureTypeToString(measures[k]) << ", "
+                            << io::ordinal(i+1) << " product:"
+                            << "\n    serial engine:   " << expected[i]
+                            << "\n    parallel engine: " << calculated[i]
+                            << "\n    error:           " << error
+                            << "\n    tolerance:       " << tolerance);
+        }
+    }
+
+    // pathwise vegas, bumped by step
+    MarketModelPathwiseMultiCaplet caplets(rateTimes, accruals,
+                                           paymentTimes, todaysForwards);
+    EvolutionDescription capletEvolution = caplets.evolution();
+    Size factors = 3, steps = capletEvolution.numberOfSteps();
+    std::vector<std::vector<Matrix> > vegaBumps(steps);
+    for (Size l=0; l<steps; ++l) {
+        for (Size b=0; b<steps; ++b) {
+            Matrix bump(capletEvolution.numberOfRates(), factors, 0.0);
+            if (l == b) {
+                for (Size r=l; r<capletEvolution.numberOfRates(); ++r)
+                    bump[r][0] = 1.0e-4;
+            }
+            vegaBumps[l].push_back(bump);
+        }
+    }
+
+    std::vector<Size> numeraires = moneyMarketMeasure(capletEvolution);
+    boost::shared_ptr<MarketModel> marketModel =
+        makeMarketModel(true, capletEvolution, factors,
+                        ExponentialCorrelationAbcdVolatility);
+    Real initialNumeraireValue = todaysDiscounts[numeraires.front()];
+
+    Size vegaPaths = paths_/8;
+    std::vector<Real> values, errors;
+    PathwiseVegasOuterAccountingEngine engine(
+        boost::shared_ptr<LogNormalFwdRateEuler>(
+                  new LogNormalFwdRateEuler(marketModel, *generatorFactory,
+                                            numeraires)),
+        caplets, marketModel, vegaBumps, initialNumeraireValue);
+    engine.multiplePathValues(values, errors, vegaPaths);
+
+    std::vector<Real> parallelValues, parallelErrors;
+    boost::shared_ptr<MarketModelEvolverFactory> evolverFactory(
+        new GenericMarketModelEvolverFactory<LogNormalFwdRateEuler>(
+                                                   marketModel, numeraires));
+    ParallelPathwiseVegasOuterAccountingEngine parallelEngine(
+        evolverFactory, generatorFactory, caplets, marketModel, vegaBumps,
+        initialNumeraireValue, workers);
+    parallelEngine.multiplePathValues(parallelValues, parallelErrors,
+                                      vegaPaths);
+
+    if (parallelValues.size() != values.size())
+        BOOST_FAIL("pathwise vegas: " << parallelValues.size()
+                   << " values instead of " << values.size());
+
+    for (Size i=0; i<values.size(); ++i) {
+        Real error = std::fabs(parallelValues[i]-values[i]);
+        if (error > tolerance)
+            BOOST_ERROR("pathwise vegas, " << io::ordinal(i+1) << " value:"
+                        << "\n    serial engine:   " << values[i]
+                        << "\n    parallel engine: " << parallelValues[i]
+                        << "\n    error:           " << error
+                        << "\n    tolerance:       " << tolerance);
+    }
+}
+
+namespace {
+
+    // boost::timer measures the processor time, which is summed
+    // over threads; the wall-clock time is needed to compare a
+    // threaded run with a serial one.
+    class WallClockTimer {
+      public:
+        WallClockTimer() { restart(); }
+        void restart() {
+            #ifdef _OPENMP
+            start_ = omp_get_wtime();
+            #else
+            timer_.restart();
+            #endif
+        }
+        Real elapsed() const {
+            #ifdef _OPENMP
+            return omp_get_wtime() - start_;
+            #else
+            return timer_.elapsed();
+            #endif
+        }
+      private:
+        #ifdef _OPENMP
+        Real start_;
+        #else
+        boost::timer timer_;
+        #endif
+    };
+
+}
+
+void MarketModelTest::testParallelUpperBound() {
+
+    BOOST_TEST_MESSAGE("Testing upper-bound estimation on several threads...");
+
+    setup();
+
+    Real fixedRate = 0.04;
+    MultiStepSwap receiverSwap(rateTimes, accruals, accruals, paymentTimes,
+                               fixedRate, false);
+
+    std::vector<Rate> exerciseTimes(rateTimes);
+    exerciseTimes.pop_back();
+    std::vector<Rate> swapTriggers(exerciseTimes.size(), fixedRate);
+    SwapRateTrigger naifStrategy(rateTimes, swapTriggers, exerciseTimes);
+    NothingExerciseValue nullRebate(rateTimes);
+
+    CallSpecifiedMultiProduct dummyProduct =
+        CallSpecifiedMultiProduct(receiverSwap, naifStrategy,
+                                  ExerciseAdapter(nullRebate));
+    EvolutionDescription evolution = dummyProduct.evolution();
+
+    std::vector<Size> numeraires =
+        makeMeasure(dummyProduct, MoneyMarketPlus);
+    boost::shared_ptr<MarketModel> marketModel =
+        makeMarketModel(true, evolution, 4,
+                        ExponentialCorrelationFlatVolatility);
+    Real initialNumeraireValue = todaysDiscounts[numeraires.front()];
+
+    typedef GenericMarketModelEvolverFactory<LogNormalFwdRatePc> PcFactory;
+    boost::shared_ptr<MarketModelEvolverFactory> evolverFactory(
+                                     new PcFactory(marketModel, numeraires));
+    boost::shared_ptr<BrownianGeneratorFactory> generatorFactory(
+                                new MTBrownianGeneratorFactory(seed_+142));
+
+    std::vector<boost::shared_ptr<MarketModelEvolverFactory> >
+        innerEvolverFactories;
+    std::vector<boost::shared_ptr<BrownianGeneratorFactory> >
+        innerGeneratorFactories;
+    std::vector<boost::shared_ptr<MarketModelEvolver> > innerEvolvers;
+    std::valarray<bool> isExerciseTime =
+        isInSubset(evolution.evolutionTimes(), naifStrategy.exerciseTimes());
+    for (Size s=0; s<isExerciseTime.size(); ++s) {
+        if (isExerciseTime[s]) {
+            innerEvolverFactories.push_back(
+                boost::shared_ptr<MarketModelEvolverFactory>(
+                                  new PcFactory(marketModel, numeraires, s)));
+            innerGeneratorFactories.push_back(
+                boost::shared_ptr<BrownianGeneratorFactory>(
+                                  new MTBrownianGeneratorFactory(seed_+s)));
+            innerEvolvers.push_back(innerEvolverFactories.back()->create(
+                                           *innerGeneratorFactories.back()));
+        }
+    }
+
+    Size outerPaths = 255, innerPaths = 32;
+
+    boost::timer timer;
+    UpperBoundEngine engine(evolverFactory->create(*generatorFactory),
+                            innerEvolvers,
+                            receiverSwap, nullRebate,
+                            receiverSwap, nullRebate,
+                            naifStrategy, initialNumeraireValue);
+    Statistics stats;
+    engine.multiplePathValues(stats, outerPaths, innerPaths);
+    Real serialTime = timer.elapsed();
+
+    timer.restart();
+    ParallelUpperBoundEngine parallelEngine(evolverFactory, generatorFactory,
+                                            innerEvolverFactories,
+                                            innerGeneratorFactories,
+                                            receiverSwap, nullRebate,
+                                            receiverSwap, nullRebate,
+                                            naifStrategy,
+                                            initialNumeraireValue, 3);
+    Statistics parallelStats;
+    parallelEngine.multiplePathValues(parallelStats, outerPaths, innerPaths);
+    Real parallelTime = timer.elapsed();
+
+    if (printReport_)
+        BOOST_TEST_MESSAGE("    serial engine:   " << serialTime << " s\n"
+                           << "    parallel engine: " << parallelTime
+                           << " s");
+
+    if (parallelStats.samples() != stats.samples())
+        BOOST_FAIL(parallelStats.samples() << " samples instead of "
+                   << stats.samples());
+
+    Real tolerance = 1.0e-12;
+    Real error = std::fabs(parallelStats.mean()-stats.mean());
+    if (error > tolerance)
+        BOOST_ERROR("failed to reproduce serial upper bound:"
+                    << "\n    serial engine:   " << stats.mean()
+                    << "\n    parallel engine: " << parallelStats.mean()
+                    << "\n    error:           " << error
+                    << "\n    tolerance:       " << tolerance);
+}
+
+void MarketModelTest::testSobolGeneratorSkipping() {
+
+    BOOST_TEST_MESSAGE("Testing path skipping in Sobol Brownian generator...");
+
+    Size factors = 3, steps = 7;
+    // paths drawn before and after skipping
+    Size drawn[] = { 0, 1, 5 };
+    Size skipped[] = { 0, 1, 6, 42 };
+
+    std::vector<Real> expected(factors), calculated(factors);
+    for (Size i=0; i<LENGTH(drawn); i++) {
+        for (Size j=0; j<LENGTH(skipped); j++) {
+            SobolBrownianGenerator generator1(factors, steps,
+                                              SobolBrownianGenerator::Diagonal,
+                                              42, SobolRsg::JoeKuoD7);
+            SobolBrownianGenerator generator2(factors, steps,
+                                              SobolBrownianGenerator::Diagonal,
+                                              42, SobolRsg::JoeKuoD7);
+            for (Size k=0; k<drawn[i]+skipped[j]; k++)
+                generator1.nextPath();
+            for (Size k=0; k<drawn[i]; k++)
+                generator2.nextPath();
+            generator2.skip(skipped[j]);
+
+            for (Size k=0; k<drawn[i]+1; k++) {
+                generator1.nextPath();
+                generator2.nextPath();
+                for (Size l=0; l<steps; l++) {
+                    generator1.nextStep(expected);
+                    generator2.nextStep(calculated);
+                    for (Size m=0; m<factors; m++) {
+                        if (calculated[m] != expected[m])
+                            BOOST_ERROR("failed to reproduce variates "
+                                        "after skipping paths:"
+                                        << "\n    paths drawn:   "
+                                        << drawn[i]
+                                        << "\n    paths skipped: "
+                                        << skipped[j]
+                                        << "\n    path:          " << k
+                                        << "\n    step:          " << l
+                                        << "\n    factor:        " << m
+                                        << "\n    expected:      "
+                                        << expected[m]
+                                        << "\n    calculated:    "
+                                        << calculated[m]);
+                    }
+                }
+            }
+        }
+    }
+}
+
 void MarketModelTest::testIsInSubset() {
 
     // Performance test for isInSubset function (temporary)
@@ -4904,6 +5273,12 @@ test_suite* MarketModelTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testPeriodAdapter));
 
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testDriftCalculator));
+    suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testBlockEvolver));
+    suite->add(QUANTLIB_TEST_CASE(
+                       &MarketModelTest::testParallelAccountingEngines));
+    suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testParallelUpperBound));
+    suite->add(QUANTLIB_TEST_CASE(
+                               &MarketModelTest::testSobolGeneratorSkipping));
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testIsInSubset));
 
     suite->add(QUANTLIB_TEST_CASE(&MarketModelTest::testAbcdDegenerateCases));
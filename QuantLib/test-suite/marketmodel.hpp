@@ -47,6 +47,10 @@ class MarketModelTest {
     static void testAbcdVolatilityCompare();
     static void testAbcdVolatilityFit();
     static void testDriftCalculator();
+    static void testBlockEvolver();
+    static void testParallelAccountingEngines();
+    static void testParallelUpperBound();
+    static void testSobolGeneratorSkipping();
     static void testIsInSubset();
     static void testAbcdDegenerateCases();
     static void testCovariance();
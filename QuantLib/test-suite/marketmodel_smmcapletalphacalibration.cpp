@@ -348,6 +348,33 @@ void MarketModelSmmCapletAlphaCalibrationTest::testFunction() {
                         "\n error:            " << error <<
                         "\n tolerance:        " << capletTolerance);
     }
+
+    // check that a calibration restarted from the previous solution
+    // reproduces the caplet fit in a single iteration
+    CTSMMCapletAlphaFormCalibration warmCalibrator(evolution,
+                                                   corr,
+                                                   swapVariances,
+                                                   capletVols_,
+                                                   cs,
+                                                   displacement_,
+                                                   calibrator.alpha(),
+                                                   alphaMax,
+                                                   alphaMin,
+                                                   maximizeHomogeneity);
+    warmCalibrator.setCapletVolAdjustments(
+                                      calibrator.capletVolAdjustments());
+    result = warmCalibrator.calibrate(numberOfFactors_,
+                                      1,
+                                      capletTolerance,
+                                      innerMaxIterations,
+                                      innerTolerance);
+    if (!result)
+        BOOST_ERROR("warm-started calibration failed");
+    if (warmCalibrator.capletRmsError()>capletTolerance)
+        BOOST_ERROR("failed to reproduce caplet vols "
+                    "from the previous solution:"
+                    "\n caplet rms error: " << warmCalibrator.capletRmsError() <<
+                    "\n tolerance:        " << capletTolerance);
 }
 
 
@@ -25,6 +25,7 @@
 #include <ql/methods/finitedifferences/dplusdminus.hpp>
 #include <ql/methods/finitedifferences/bsmoperator.hpp>
 #include <ql/methods/finitedifferences/bsmtermoperator.hpp>
+#include <ql/methods/finitedifferences/mixedscheme.hpp>
 #include <ql/time/daycounters/actual360.hpp>
 #include <ql/quotes/simplequote.hpp>
 #include <ql/utilities/dataformatters.hpp>
@@ -54,6 +55,16 @@ void OperatorTest::testTridiagonal() {
 
     Array intermediate = T.applyTo(original);
 
+    Array applied(n, 0.0);
+    T.applyTo(original, applied);
+    for (Size i=0; i<n; ++i) {
+        if (applied[i]!=intermediate[i])
+            BOOST_FAIL("\n applyTo without allocation gives different result:"
+                       "\n        original vector: " << original <<
+                       "\n     transformed vector: " << intermediate <<
+                       "\n in-place applied vector: " << applied);
+    }
+
     Array final(intermediate);
     T.solveFor(final, final);
     for (Size i=0; i<n; ++i) {
@@ -119,6 +130,19 @@ void OperatorTest::testTridiagonal() {
                    "\n inverse transformed vector: " << final <<
                    "\n                      error: " << error <<
                    "\n                  tolerance: " << tolerance);
+
+    // a null step must leave the values unchanged
+    MixedScheme<TridiagonalOperator> scheme(
+                   T, 0.5, MixedScheme<TridiagonalOperator>::bc_set());
+    scheme.setStep(0.0);
+    final = original;
+    scheme.step(final, 1.0);
+    for (Size i=0; i<n; ++i) {
+        if (final[i]!=original[i])
+            BOOST_FAIL("\n null step does not equal identity:"
+                       "\n original vector: " << original <<
+                       "\n stepped vector:  " << final);
+    }
 }
 
 void OperatorTest::testConsistency() {
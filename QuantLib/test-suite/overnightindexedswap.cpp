@@ -425,12 +425,206 @@ void OvernightIndexedSwapTest::testBootstrap() {
 }
 
 
+void OvernightIndexedSwapTest::testMultiCurveBootstrap() {
+
+    BOOST_TEST_MESSAGE("Testing simultaneous bootstrap of Eonia "
+                       "and Euribor curves...");
+
+    CommonVars vars;
+
+    typedef PiecewiseYieldCurve<Discount,LogLinear,GlobalBootstrap>
+                                                                JointCurve;
+
+    shared_ptr<IborIndex> euribor3m(new Euribor3M);
+    shared_ptr<Eonia> eonia(new Eonia);
+
+    std::vector<shared_ptr<SimpleQuote> > depositQuotes, fraQuotes,
+                                          eoniaQuotes, swapQuotes;
+    for (Size i = 0; i < LENGTH(depositData); i++)
+        depositQuotes.push_back(shared_ptr<SimpleQuote>(
+                               new SimpleQuote(0.01*depositData[i].rate)));
+    for (Size i = 0; i < LENGTH(fraData); i++)
+        fraQuotes.push_back(shared_ptr<SimpleQuote>(
+                                   new SimpleQuote(0.01*fraData[i].rate)));
+    for (Size i = 0; i < LENGTH(eoniaSwapData); i++)
+        eoniaQuotes.push_back(shared_ptr<SimpleQuote>(
+                             new SimpleQuote(0.01*eoniaSwapData[i].rate)));
+    for (Size i = 0; i < LENGTH(swapData); i++)
+        swapQuotes.push_back(shared_ptr<SimpleQuote>(
+                                  new SimpleQuote(0.01*swapData[i].rate)));
+
+    // the same quotes are used for the nested bootstrap (first set
+    // of helpers) and the simultaneous one (second set); helpers
+    // can't be shared between the curves.
+    RelinkableHandle<YieldTermStructure> discountCurves[2];
+    std::vector<shared_ptr<RateHelper> > eoniaHelpers[2], swap3mHelpers[2];
+
+    for (Size k = 0; k < 2; k++) {
+        for (Size i = 0; i < LENGTH(depositData); i++) {
+            Period term = depositData[i].n * depositData[i].unit;
+            for (Size l = 0; l < 2; l++) {
+                shared_ptr<RateHelper> helper(new
+                    DepositRateHelper(Handle<Quote>(depositQuotes[i]),
+                                      term,
+                                      depositData[i].settlementDays,
+                                      euribor3m->fixingCalendar(),
+                                      euribor3m->businessDayConvention(),
+                                      euribor3m->endOfMonth(),
+                                      euribor3m->dayCounter()));
+                if (l == 0 && term <= 2*Days)
+                    eoniaHelpers[k].push_back(helper);
+                if (l == 1 && term <= 3*Months)
+                    swap3mHelpers[k].push_back(helper);
+            }
+        }
+
+        for (Size i = 0; i < LENGTH(fraData); i++) {
+            shared_ptr<RateHelper> helper(new
+                FraRateHelper(Handle<Quote>(fraQuotes[i]),
+                              fraData[i].nExpiry,
+                              fraData[i].nMaturity,
+                              fraData[i].settlementDays,
+                              euribor3m->fixingCalendar(),
+                              euribor3m->businessDayConvention(),
+                              euribor3m->endOfMonth(),
+                              euribor3m->dayCounter()));
+            swap3mHelpers[k].push_back(helper);
+        }
+
+        for (Size i = 0; i < LENGTH(eoniaSwapData); i++) {
+            Period term = eoniaSwapData[i].n * eoniaSwapData[i].unit;
+            shared_ptr<RateHelper> helper(new
+                OISRateHelper(eoniaSwapData[i].settlementDays,
+                              term,
+                              Handle<Quote>(eoniaQuotes[i]),
+                              eonia));
+            eoniaHelpers[k].push_back(helper);
+        }
+
+        for (Size i = 0; i < LENGTH(swapData); i++) {
+            Period term = swapData[i].nTermUnits * swapData[i].termUnit;
+            shared_ptr<RateHelper> helper(new
+                SwapRateHelper(Handle<Quote>(swapQuotes[i]),
+                               term,
+                               vars.calendar,
+                               vars.fixedSwapFrequency,
+                               vars.fixedSwapConvention,
+                               vars.fixedSwapDayCount,
+                               euribor3m,
+                               Handle<Quote>(),
+                               0*Days,
+                               discountCurves[k]));
+            swap3mHelpers[k].push_back(helper);
+        }
+    }
+
+    shared_ptr<PiecewiseFlatForward> nestedEonia(new
+        PiecewiseFlatForward(vars.today, eoniaHelpers[0], Actual365Fixed()));
+    discountCurves[0].linkTo(nestedEonia);
+    shared_ptr<PiecewiseFlatForward> nestedEuribor(new
+        PiecewiseFlatForward(vars.today, swap3mHelpers[0], Actual365Fixed()));
+
+    shared_ptr<MultiCurveBootstrap> curves(new MultiCurveBootstrap);
+    shared_ptr<JointCurve> jointEonia(new
+        JointCurve(vars.today, eoniaHelpers[1], Actual365Fixed(),
+                   std::vector<Handle<Quote> >(), std::vector<Date>(),
+                   1.0e-12, LogLinear(), GlobalBootstrap<JointCurve>(curves)));
+    discountCurves[1].linkTo(jointEonia);
+    shared_ptr<JointCurve> jointEuribor(new
+        JointCurve(vars.today, swap3mHelpers[1], Actual365Fixed(),
+                   std::vector<Handle<Quote> >(), std::vector<Date>(),
+                   1.0e-12, LogLinear(), GlobalBootstrap<JointCurve>(curves)));
+
+    Flag flag;
+    flag.registerWith(jointEuribor);
+
+    Real tolerance = 1.0e-10;
+    Size maxIterations[] = { 10, 6, 6 };
+
+    for (Size m = 0; m < 3; m++) {
+
+        if (m > 0) {
+            flag.lower();
+            if (m == 2) {
+                // the Eonia helpers don't depend on the Euribor
+                // curve; the curves are then solved one after the
+                // other
+                curves->setDependencies(
+                             jointEonia.get(),
+                             std::vector<const TermStructure*>());
+                curves->setDependencies(
+                             jointEuribor.get(),
+                             std::vector<const TermStructure*>(
+                                                     1, jointEonia.get()));
+            }
+            // move the discount curve
+            eoniaQuotes[21]->setValue(eoniaQuotes[21]->value() + 0.0001);
+            if (!flag.isUp())
+                BOOST_ERROR("forwarding curve not notified of "
+                            "change in discount-curve quote");
+        }
+
+        // the Euribor curve is asked first; the Eonia one is
+        // solved with it
+        std::vector<Date> dates = nestedEuribor->dates();
+        for (Size i = 0; i < dates.size(); i++) {
+            DiscountFactor expected = nestedEuribor->discount(dates[i]);
+            DiscountFactor calculated = jointEuribor->discount(dates[i]);
+            if (std::fabs(expected - calculated) > tolerance)
+                BOOST_ERROR("failed to reproduce nested bootstrap "
+                            "of Euribor curve:" << std::setprecision(12) <<
+                            "\n    date:       " << dates[i] <<
+                            "\n    calculated: " << calculated <<
+                            "\n    expected:   " << expected);
+        }
+        Size iterations = curves->iterations();
+
+        dates = nestedEonia->dates();
+        for (Size i = 0; i < dates.size(); i++) {
+            DiscountFactor expected = nestedEonia->discount(dates[i]);
+            DiscountFactor calculated = jointEonia->discount(dates[i]);
+            if (std::fabs(expected - calculated) > tolerance)
+                BOOST_ERROR("failed to reproduce nested bootstrap "
+                            "of Eonia curve:" << std::setprecision(12) <<
+                            "\n    date:       " << dates[i] <<
+                            "\n    calculated: " << calculated <<
+                            "\n    expected:   " << expected);
+        }
+
+        if (curves->iterations() != iterations)
+            BOOST_ERROR("curves solved again when asked for Eonia curve");
+        if (iterations > maxIterations[m])
+            BOOST_ERROR("too many iterations: " << iterations <<
+                        "\n    expected at most " << maxIterations[m]);
+
+        for (Size i = 0; i < swap3mHelpers[1].size(); i++) {
+            Real error = swap3mHelpers[1][i]->quoteError();
+            if (std::fabs(error) > 1.0e-12)
+                BOOST_ERROR("failed to reprice Euribor helper:" <<
+                            "\n    maturity:    " <<
+                            swap3mHelpers[1][i]->latestDate() <<
+                            "\n    quote error: " << error);
+        }
+        for (Size i = 0; i < eoniaHelpers[1].size(); i++) {
+            Real error = eoniaHelpers[1][i]->quoteError();
+            if (std::fabs(error) > 1.0e-12)
+                BOOST_ERROR("failed to reprice Eonia helper:" <<
+                            "\n    maturity:    " <<
+                            eoniaHelpers[1][i]->latestDate() <<
+                            "\n    quote error: " << error);
+        }
+    }
+}
+
+
 test_suite* OvernightIndexedSwapTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Overnight-indexed swap tests");
     suite->add(QUANTLIB_TEST_CASE(&OvernightIndexedSwapTest::testFairRate));
     suite->add(QUANTLIB_TEST_CASE(&OvernightIndexedSwapTest::testFairSpread));
     suite->add(QUANTLIB_TEST_CASE(&OvernightIndexedSwapTest::testCachedValue));
     suite->add(QUANTLIB_TEST_CASE(&OvernightIndexedSwapTest::testBootstrap));
+    suite->add(QUANTLIB_TEST_CASE(
+                        &OvernightIndexedSwapTest::testMultiCurveBootstrap));
     return suite;
 }
 
@@ -31,6 +31,7 @@ class OvernightIndexedSwapTest {
     static void testFairSpread();
     static void testCachedValue();
     static void testBootstrap();
+    static void testMultiCurveBootstrap();
     static boost::unit_test_framework::test_suite* suite();
 };
 
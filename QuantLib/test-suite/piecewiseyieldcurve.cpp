@@ -23,6 +23,7 @@
 #include <ql/termstructures/yield/ratehelpers.hpp>
 #include <ql/termstructures/yield/bondhelpers.hpp>
 #include <ql/termstructures/yield/flatforward.hpp>
+#include <ql/termstructures/yield/discountcurve.hpp>
 #include <ql/time/calendars/target.hpp>
 #include <ql/time/calendars/japan.hpp>
 #include <ql/time/calendars/jointcalendar.hpp>
@@ -906,6 +907,209 @@ void PiecewiseYieldCurveTest::testZeroCopy() {
 }
 
 
+void PiecewiseYieldCurveTest::testIncrementalBootstrap() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing incremental bootstrap of piecewise yield curve...");
+
+    CommonVars vars;
+
+    boost::shared_ptr<SimpleQuote> jump(new SimpleQuote(0.999));
+    std::vector<Handle<Quote> > jumps(1, Handle<Quote>(jump));
+    std::vector<Date> jumpDates(1, vars.calendar.advance(vars.settlement,
+                                                         18, Months));
+
+    PiecewiseYieldCurve<Discount,LogLinear> curve(vars.settlement,
+                                                  vars.instruments,
+                                                  Actual360(),
+                                                  jumps, jumpDates);
+    std::vector<Real> previous = curve.data();
+
+    Real tolerance = 1.0e-10;
+
+    // the helpers are sorted by maturity, so that the i-th quote
+    // corresponds to the (i+1)-th pillar
+    Size n = vars.rates.size();
+    Size changed[] = { n-1, n-4, vars.deposits+2, 0 };
+
+    for (Size k=0; k<LENGTH(changed); ++k) {
+        Size j = changed[k];
+        vars.rates[j]->setValue(vars.rates[j]->value() + 0.001);
+        std::vector<Real> incremental = curve.data();
+
+        // earlier pillars are not solved again...
+        for (Size i=0; i<=j; ++i) {
+            if (incremental[i] != previous[i])
+                BOOST_ERROR("pillar " << i << " changed after change of "
+                            << io::ordinal(j+1) << " quote"
+                            << std::setprecision(16)
+                            << "\n    before: " << previous[i]
+                            << "\n    after:  " << incremental[i]);
+        }
+
+        // ...and the later ones match a full bootstrap
+        curve.recalculate();
+        std::vector<Real> full = curve.data();
+        for (Size i=j+1; i<full.size(); ++i) {
+            if (std::fabs(incremental[i] - full[i]) > tolerance)
+                BOOST_ERROR("pillar " << i << " after change of "
+                            << io::ordinal(j+1) << " quote "
+                            << "differs from full bootstrap"
+                            << std::setprecision(16)
+                            << "\n    incremental: " << incremental[i]
+                            << "\n    full:        " << full[i]);
+        }
+        previous = full;
+    }
+
+    // a failed calculation doesn't lose track of the changed helpers;
+    // here, the earlier quote changes and the later one is invalid
+    Size early = vars.deposits+1, late = n-2;
+    Rate lateQuote = vars.rates[late]->value();
+    vars.rates[early]->setValue(vars.rates[early]->value() + 0.001);
+    vars.rates[late]->setValue(Null<Real>());
+    try {
+        curve.data();
+        BOOST_ERROR("invalid quote was not detected");
+    } catch (Error&) {
+        // as expected
+    }
+    vars.rates[late]->setValue(lateQuote);
+    std::vector<Real> rebuilt = curve.data();
+    curve.recalculate();
+    std::vector<Real> full = curve.data();
+    for (Size i=1; i<full.size(); ++i) {
+        if (std::fabs(rebuilt[i] - full[i]) > tolerance)
+            BOOST_ERROR("pillar " << i << " after invalid quote "
+                        << "differs from full bootstrap"
+                        << std::setprecision(16)
+                        << "\n    calculated: " << rebuilt[i]
+                        << "\n    expected:   " << full[i]);
+    }
+
+    // a change in the curve itself (here, a jump) requires a full
+    // bootstrap even if a helper changed too
+    jump->setValue(0.998);
+    vars.rates[n-1]->setValue(vars.rates[n-1]->value() - 0.001);
+    std::vector<Real> calculated = curve.data();
+    curve.recalculate();
+    std::vector<Real> expected = curve.data();
+    for (Size i=1; i<expected.size(); ++i) {
+        if (std::fabs(calculated[i] - expected[i]) > tolerance)
+            BOOST_ERROR("pillar " << i << " after change of jump "
+                        << "differs from full bootstrap"
+                        << std::setprecision(16)
+                        << "\n    calculated: " << calculated[i]
+                        << "\n    expected:   " << expected[i]);
+    }
+}
+
+namespace {
+
+    template <class T, class I>
+    void testCurveJacobian(CommonVars& vars,
+                           const I& interpolator = I()) {
+
+        PiecewiseYieldCurve<T,I> curve(vars.settlement, vars.instruments,
+                                       Actual360(),
+                                       1.0e-12,
+                                       interpolator);
+        Matrix jacobian = curve.jacobian();
+
+        // the helpers are sorted by maturity, so that the j-th quote
+        // corresponds to the j-th column
+        const Real h = 1.0e-5, tolerance = 1.0e-5;
+        for (Size j=0; j<vars.rates.size(); ++j) {
+            Real q = vars.rates[j]->value();
+            vars.rates[j]->setValue(q+h);
+            std::vector<Real> up = curve.data();
+            vars.rates[j]->setValue(q-h);
+            std::vector<Real> down = curve.data();
+            vars.rates[j]->setValue(q);
+
+            for (Size i=0; i<up.size(); ++i) {
+                Real expected = (up[i]-down[i])/(2*h);
+                if (std::fabs(jacobian[i][j]-expected) > tolerance)
+                    BOOST_ERROR("failed to reproduce derivative of "
+                                << io::ordinal(i+1) << " node with respect "
+                                << "to " << io::ordinal(j+1) << " quote"
+                                << std::setprecision(10)
+                                << "\n    calculated: " << jacobian[i][j]
+                                << "\n    expected:   " << expected);
+            }
+        }
+    }
+
+}
+
+
+void PiecewiseYieldCurveTest::testBootstrapJacobian() {
+
+    BOOST_TEST_MESSAGE(
+        "Testing sensitivities of piecewise yield curve to quotes...");
+
+    CommonVars vars;
+
+    testCurveJacobian<Discount,LogLinear>(vars);
+    testCurveJacobian<ZeroYield,Cubic>(
+                   vars,
+                   Cubic(CubicInterpolation::Spline, true,
+                         CubicInterpolation::SecondDerivative, 0.0,
+                         CubicInterpolation::SecondDerivative, 0.0));
+
+    // quote sensitivities of a swap which is not among the helpers,
+    // obtained from its sensitivities to the curve nodes
+    boost::shared_ptr<PiecewiseYieldCurve<Discount,LogLinear> > curve(
+        new PiecewiseYieldCurve<Discount,LogLinear>(vars.settlement,
+                                                    vars.instruments,
+                                                    Actual360()));
+    RelinkableHandle<YieldTermStructure> curveHandle;
+    boost::shared_ptr<IborIndex> index(new Euribor6M(curveHandle));
+    VanillaSwap swap = MakeVanillaSwap(7*Years + 3*Months, index, 0.05)
+        .withDiscountingTermStructure(curveHandle);
+
+    const Real h = 1.0e-5, tolerance = 1.0e-5;
+
+    std::vector<Date> dates = curve->dates();
+    std::vector<Real> data = curve->data();
+    // the first discount is fixed at 1
+    std::vector<Real> nodeSensitivities(data.size(), 0.0);
+    for (Size i=1; i<data.size(); ++i) {
+        std::vector<Real> bumped = data;
+        bumped[i] = data[i] + h;
+        curveHandle.linkTo(boost::shared_ptr<YieldTermStructure>(
+            new InterpolatedDiscountCurve<LogLinear>(dates, bumped,
+                                                     Actual360())));
+        Real up = swap.NPV();
+        bumped[i] = data[i] - h;
+        curveHandle.linkTo(boost::shared_ptr<YieldTermStructure>(
+            new InterpolatedDiscountCurve<LogLinear>(dates, bumped,
+                                                     Actual360())));
+        Real down = swap.NPV();
+        nodeSensitivities[i] = (up-down)/(2*h);
+    }
+
+    std::vector<Real> calculated =
+        curve->quoteSensitivities(nodeSensitivities);
+
+    curveHandle.linkTo(curve);
+    for (Size j=0; j<vars.rates.size(); ++j) {
+        Real q = vars.rates[j]->value();
+        vars.rates[j]->setValue(q+h);
+        Real up = swap.NPV();
+        vars.rates[j]->setValue(q-h);
+        Real down = swap.NPV();
+        vars.rates[j]->setValue(q);
+
+        Real expected = (up-down)/(2*h);
+        if (std::fabs(calculated[j]-expected) > tolerance)
+            BOOST_ERROR("failed to reproduce swap sensitivity to "
+                        << io::ordinal(j+1) << " quote"
+                        << std::setprecision(10)
+                        << "\n    calculated: " << calculated[j]
+                        << "\n    expected:   " << expected);
+    }
+}
 
 
 test_suite* PiecewiseYieldCurveTest::suite() {
@@ -955,5 +1159,10 @@ test_suite* PiecewiseYieldCurveTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testForwardCopy));
     suite->add(QUANTLIB_TEST_CASE(&PiecewiseYieldCurveTest::testZeroCopy));
 
+    suite->add(QUANTLIB_TEST_CASE(
+                     &PiecewiseYieldCurveTest::testIncrementalBootstrap));
+    suite->add(QUANTLIB_TEST_CASE(
+                     &PiecewiseYieldCurveTest::testBootstrapJacobian));
+
     return suite;
 }
@@ -71,6 +71,15 @@
  13. gcc-4.6.3, -O3
  14. gcc-3.4.3, -O2 -g on a Zaurus PDA
 
+  Run times of the test cases are printed together with the mflops.
+  Run times of the cases using the legacy finite-difference framework
+  before and after the in-place rollback of MixedScheme (g++ -O2,
+  one core):
+      AmericanOption::FdAmericanGreeks      1.26s -> 0.96s
+      AmericanOption::FdShoutGreeks         1.27s -> 0.96s
+      DividendOption::FdAmericanGreeks      2.68s -> 2.08s
+      DividendOption::FdEuropeanGreeks      2.14s -> 1.61s
+
   This benchmark is derived from quantlibtestsuite.cpp. Please see the
   copyrights therein.
 */
@@ -192,9 +201,9 @@ namespace {
         #endif
 
         std::cout << std::endl
-                  << std::string(56,'-') << std::endl;
+                  << std::string(66,'-') << std::endl;
         std::cout << header << std::endl;
-        std::cout << std::string(56,'-')
+        std::cout << std::string(66,'-')
                   << std::endl << std::endl;
 
         double sum=0;
@@ -207,13 +216,15 @@ namespace {
                       << std::string(42-iterBM->getName().length(),' ') << ":"
                       << std::fixed << std::setw(6) << std::setprecision(1)
                       << mflopsPerSec
-                      << " mflops" << std::endl;
+                      << " mflops"
+                      << std::setw(8) << std::setprecision(2) << *iterT
+                      << " s" << std::endl;
 
             sum+=mflopsPerSec;
             iterT++;
             iterBM++;
         }
-        std::cout << std::string(56,'-') << std::endl
+        std::cout << std::string(66,'-') << std::endl
                   << "QuantLib Benchmark Index                  :"
                   << std::fixed << std::setw(6) << std::setprecision(1)
                   << sum/runTimes.size()
@@ -427,6 +427,48 @@ void ShortRateModelTest::testFuturesConvexityBias() {
     }
 }
 
+void ShortRateModelTest::testTreeStepback() {
+    BOOST_TEST_MESSAGE("Testing short-rate tree stepback...");
+
+    SavedSettings backup;
+
+    Date today = Settings::instance().evaluationDate();
+    Handle<YieldTermStructure> termStructure(
+                                 flatRate(today, 0.04, Actual365Fixed()));
+
+    // strong mean reversion, so that the branching changes
+    // at the edges of the tree
+    boost::shared_ptr<HullWhite> model(
+                                  new HullWhite(termStructure, 0.5, 0.02));
+    TimeGrid grid(10.0, 100);
+    boost::shared_ptr<OneFactorModel::ShortRateTree> tree =
+        boost::dynamic_pointer_cast<OneFactorModel::ShortRateTree>(
+                                                        model->tree(grid));
+    QL_REQUIRE(tree, "unexpected tree type");
+
+    for (Size i=0; i<grid.size()-1; i++) {
+        Array values(tree->size(i+1));
+        for (Size j=0; j<values.size(); j++)
+            values[j] = std::sin(Real(j+i));
+
+        Array calculated(tree->size(i)), expected(tree->size(i));
+        tree->stepback(i, values, calculated);
+        tree->TreeLattice<OneFactorModel::ShortRateTree>::stepback(
+                                                       i, values, expected);
+
+        for (Size j=0; j<expected.size(); j++) {
+            if (std::fabs(calculated[j]-expected[j]) > 1.0e-15) {
+                BOOST_FAIL("failed to reproduce generic stepback"
+                           << QL_SCIENTIFIC
+                           << "\n    level:      " << i
+                           << "\n    node:       " << j
+                           << "\n    calculated: " << calculated[j]
+                           << "\n    expected:   " << expected[j]);
+            }
+        }
+    }
+}
+
 test_suite* ShortRateModelTest::suite() {
     test_suite* suite = BOOST_TEST_SUITE("Short-rate model tests");
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testCachedHullWhite));
@@ -434,6 +476,7 @@ test_suite* ShortRateModelTest::suite() {
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testCachedHullWhite2));
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testSwaps));
     suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testFuturesConvexityBias));
+    suite->add(QUANTLIB_TEST_CASE(&ShortRateModelTest::testTreeStepback));
     return suite;
 }
 
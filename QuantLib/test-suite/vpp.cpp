@@ -644,7 +644,11 @@ void VPPTest::testVPPPricing() {
     vppOption.setPricingEngine(engine);
 
     const Real fdmPrice = vppOption.NPV();
-    const Real expectedFdmPrice = 5217.68;
+    // the results on the grid are interpolated locally by cubic
+    // Hermite polynomials; the multi-dimensional spline used before
+    // gave 5217.68, the difference being due to the interpolation
+    // on this very coarse grid.
+    const Real expectedFdmPrice = 5217.57;
     if (std::fabs(fdmPrice - expectedFdmPrice) > 0.1) {
        BOOST_ERROR("Failed to reproduce finite difference price"
                    << "\n    calculated: " << fdmPrice